@@ -48,8 +48,11 @@ bigtable_client_hdrs = [
     "internal/common_client.h",
     "internal/conjunction.h",
     "internal/google_bytes_traits.h",
+    "internal/parallel_row_scanner.h",
+    "internal/parallel_scan_shards.h",
     "internal/prefix_range_end.h",
     "internal/readrowsparser.h",
+    "internal/row_view_builder.h",
     "internal/rowreaderiterator.h",
     "internal/rpc_policy_parameters.h",
     "internal/rpc_policy_parameters.inc",
@@ -57,6 +60,7 @@ bigtable_client_hdrs = [
     "metadata_update_policy.h",
     "mutation_batcher.h",
     "mutations.h",
+    "parallel_read_rows_options.h",
     "polling_policy.h",
     "read_modify_write_rule.h",
     "row.h",
@@ -65,6 +69,7 @@ bigtable_client_hdrs = [
     "row_range.h",
     "row_reader.h",
     "row_set.h",
+    "row_view.h",
     "rpc_backoff_policy.h",
     "rpc_retry_policy.h",
     "table.h",
@@ -92,8 +97,11 @@ bigtable_client_srcs = [
     "internal/bulk_mutator.cc",
     "internal/common_client.cc",
     "internal/google_bytes_traits.cc",
+    "internal/parallel_row_scanner.cc",
+    "internal/parallel_scan_shards.cc",
     "internal/prefix_range_end.cc",
     "internal/readrowsparser.cc",
+    "internal/row_view_builder.cc",
     "internal/rowreaderiterator.cc",
     "metadata_update_policy.cc",
     "mutation_batcher.cc",
@@ -102,6 +110,7 @@ bigtable_client_srcs = [
     "row_range.cc",
     "row_reader.cc",
     "row_set.cc",
+    "row_view.cc",
     "rpc_backoff_policy.cc",
     "rpc_retry_policy.cc",
     "table.cc",
@@ -43,8 +43,12 @@ bigtable_client_unit_tests = [
     "internal/async_longrunning_op_test.cc",
     "internal/async_retry_multi_page_test.cc",
     "internal/bulk_mutator_test.cc",
+    "internal/common_client_test.cc",
     "internal/google_bytes_traits_test.cc",
+    "internal/parallel_row_scanner_test.cc",
+    "internal/parallel_scan_shards_test.cc",
     "internal/prefix_range_end_test.cc",
+    "internal/row_view_builder_test.cc",
     "mutation_batcher_test.cc",
     "mutations_test.cc",
     "table_admin_test.cc",
@@ -54,12 +58,14 @@ bigtable_client_unit_tests = [
     "table_config_test.cc",
     "table_readrow_test.cc",
     "table_readrows_test.cc",
+    "table_parallel_read_rows_test.cc",
     "table_sample_row_keys_test.cc",
     "table_test.cc",
     "table_readmodifywriterow_test.cc",
     "read_modify_write_rule_test.cc",
     "row_reader_test.cc",
     "row_test.cc",
+    "row_view_test.cc",
     "row_range_test.cc",
     "row_set_test.cc",
     "rpc_backoff_policy_test.cc",
@@ -79,6 +79,10 @@ inline std::size_t CalculateDefaultConnectionPoolSize() {
 ClientOptions::ClientOptions(std::shared_ptr<grpc::ChannelCredentials> creds)
     : credentials_(std::move(creds)),
       connection_pool_size_(CalculateDefaultConnectionPoolSize()),
+      channel_selection_policy_(ChannelSelectionPolicy::kRoundRobin),
+      channel_warm_up_timeout_(0),
+      channel_refresh_period_(0),
+      channel_health_check_period_(0),
       data_endpoint_("bigtable.googleapis.com"),
       admin_endpoint_("bigtableadmin.googleapis.com"),
       instance_admin_endpoint_("bigtableadmin.googleapis.com") {
@@ -19,6 +19,8 @@
 #include "google/cloud/status.h"
 #include <grpcpp/grpcpp.h>
 #include <grpcpp/resource_quota.h>
+#include <algorithm>
+#include <chrono>
 
 namespace google {
 namespace cloud {
@@ -31,6 +33,19 @@ std::string DefaultAdminEndpoint();
 std::string DefaultInstanceAdminEndpoint();
 }  // namespace internal
 
+/// How the client picks a channel from the connection pool for each request.
+enum class ChannelSelectionPolicy {
+  /// Rotate through the channels in the pool.
+  kRoundRobin,
+  /**
+   * Pick the channel with the fewest requests in progress.
+   *
+   * Streams count as in progress until they are closed, so channels busy with
+   * long scans receive fewer new requests.
+   */
+  kLeastOutstandingRpcs,
+};
+
 /**
  * Configuration options for the Bigtable Client.
  *
@@ -123,6 +138,82 @@ class ClientOptions {
 
   std::size_t connection_pool_size() const { return connection_pool_size_; }
 
+  /// Set how requests are distributed across the connection pool.
+  ClientOptions& set_channel_selection_policy(ChannelSelectionPolicy policy) {
+    channel_selection_policy_ = policy;
+    return *this;
+  }
+
+  /// Return how requests are distributed across the connection pool.
+  ChannelSelectionPolicy channel_selection_policy() const {
+    return channel_selection_policy_;
+  }
+
+  /**
+   * Connect the channels in the connection pool when the client is created.
+   *
+   * By default the channels connect on the first request, and that request
+   * pays for the name resolution, TCP and TLS handshakes.  With a non-zero
+   * @p timeout the client connects all the channels when it is created and
+   * waits up to @p timeout for them.  Channels that are not ready by then keep
+   * connecting in the background.
+   */
+  ClientOptions& set_channel_warm_up_timeout(
+      std::chrono::milliseconds timeout) {
+    channel_warm_up_timeout_ = timeout;
+    return *this;
+  }
+
+  /// Return how long the client waits for the channels when it is created.
+  std::chrono::milliseconds channel_warm_up_timeout() const {
+    return channel_warm_up_timeout_;
+  }
+
+  /**
+   * Periodically replace the channels in the connection pool.
+   *
+   * Servers close connections once they reach a maximum age, and the requests
+   * that follow pay for a new connection.  With a non-zero @p period each
+   * channel is replaced at a random time between `period / 2` and `period`
+   * after it was created.  The replacement connects before it receives any
+   * requests, and requests in progress finish on the old channel.  Use a
+   * period smaller than the maximum connection age configured in the server.
+   * Zero or negative values disable the refresh.
+   *
+   * Refreshing (or monitoring) the channels uses a background thread for each
+   * client.
+   */
+  ClientOptions& set_channel_refresh_period(std::chrono::milliseconds period) {
+    channel_refresh_period_ = (std::max)(period, std::chrono::milliseconds(0));
+    return *this;
+  }
+
+  /// Return how often the channels are replaced, zero if they are not.
+  std::chrono::milliseconds channel_refresh_period() const {
+    return channel_refresh_period_;
+  }
+
+  /**
+   * Monitor the connectivity state of the channels in the connection pool.
+   *
+   * With a non-zero @p period the client checks its channels at this interval.
+   * Channels that fail to connect receive no requests until they recover,
+   * unless all the channels are failing.  Idle channels, for example, after
+   * the server closed their connection, are reconnected, and channels that
+   * were shut down are replaced.  Zero or negative values disable the checks.
+   */
+  ClientOptions& set_channel_health_check_period(
+      std::chrono::milliseconds period) {
+    channel_health_check_period_ =
+        (std::max)(period, std::chrono::milliseconds(0));
+    return *this;
+  }
+
+  /// Return how often the channels are checked, zero if they are not.
+  std::chrono::milliseconds channel_health_check_period() const {
+    return channel_health_check_period_;
+  }
+
   /// Return the current credentials.
   std::shared_ptr<grpc::ChannelCredentials> credentials() const {
     return credentials_;
@@ -307,6 +398,10 @@ class ClientOptions {
   grpc::ChannelArguments channel_arguments_;
   std::string connection_pool_name_;
   std::size_t connection_pool_size_;
+  ChannelSelectionPolicy channel_selection_policy_;
+  std::chrono::milliseconds channel_warm_up_timeout_;
+  std::chrono::milliseconds channel_refresh_period_;
+  std::chrono::milliseconds channel_health_check_period_;
   std::string data_endpoint_;
   std::string admin_endpoint_;
   // The endpoint for instance admin operations, in most scenarios this should
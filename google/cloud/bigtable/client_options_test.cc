@@ -271,6 +271,42 @@ TEST(ClientOptionsTest, ResetToDefaultConnectionPoolSize) {
   EXPECT_LE(1UL, returned.connection_pool_size());
 }
 
+TEST(ClientOptionsTest, EditChannelSelectionPolicy) {
+  bigtable::ClientOptions client_options_object;
+  EXPECT_EQ(bigtable::ChannelSelectionPolicy::kRoundRobin,
+            client_options_object.channel_selection_policy());
+  auto& returned = client_options_object.set_channel_selection_policy(
+      bigtable::ChannelSelectionPolicy::kLeastOutstandingRpcs);
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(bigtable::ChannelSelectionPolicy::kLeastOutstandingRpcs,
+            returned.channel_selection_policy());
+}
+
+TEST(ClientOptionsTest, EditChannelMaintenance) {
+  bigtable::ClientOptions client_options_object;
+  EXPECT_EQ(0, client_options_object.channel_warm_up_timeout().count());
+  EXPECT_EQ(0, client_options_object.channel_refresh_period().count());
+  EXPECT_EQ(0, client_options_object.channel_health_check_period().count());
+  auto& returned =
+      client_options_object
+          .set_channel_warm_up_timeout(std::chrono::seconds(5))
+          .set_channel_refresh_period(std::chrono::minutes(30))
+          .set_channel_health_check_period(std::chrono::seconds(10));
+  EXPECT_EQ(&returned, &client_options_object);
+  EXPECT_EQ(std::chrono::seconds(5), returned.channel_warm_up_timeout());
+  EXPECT_EQ(std::chrono::minutes(30), returned.channel_refresh_period());
+  EXPECT_EQ(std::chrono::seconds(10), returned.channel_health_check_period());
+}
+
+TEST(ClientOptionsTest, NegativeChannelMaintenancePeriods) {
+  bigtable::ClientOptions client_options_object;
+  client_options_object
+      .set_channel_refresh_period(std::chrono::milliseconds(-100))
+      .set_channel_health_check_period(std::chrono::seconds(-1));
+  EXPECT_EQ(0, client_options_object.channel_refresh_period().count());
+  EXPECT_EQ(0, client_options_object.channel_health_check_period().count());
+}
+
 TEST(ClientOptionsTest, SetGrpclbFallbackTimeoutMS) {
   // Test milliseconds are set properly to channel_arguments
   bigtable::ClientOptions client_options_object = bigtable::ClientOptions();
@@ -22,6 +22,59 @@ namespace cloud {
 namespace bigtable {
 inline namespace BIGTABLE_CLIENT_NS {
 namespace internal {
+namespace {
+/**
+ * Keep a stub alive for as long as a stream is open.
+ *
+ * With `ChannelSelectionPolicy::kLeastOutstandingRpcs` the stub returned by
+ * `CommonClient::Stub()` counts as an outstanding call on its channel, holding
+ * it with the stream counts the stream until it is closed.
+ */
+template <typename StubPtr, typename Response>
+class StubHoldingReader : public grpc::ClientReaderInterface<Response> {
+ public:
+  StubHoldingReader(
+      StubPtr stub,
+      std::unique_ptr<grpc::ClientReaderInterface<Response>> reader)
+      : stub_(std::move(stub)), reader_(std::move(reader)) {}
+
+  grpc::Status Finish() override { return reader_->Finish(); }
+  bool NextMessageSize(std::uint32_t* sz) override {
+    return reader_->NextMessageSize(sz);
+  }
+  bool Read(Response* msg) override { return reader_->Read(msg); }
+  void WaitForInitialMetadata() override { reader_->WaitForInitialMetadata(); }
+
+ private:
+  StubPtr stub_;
+  std::unique_ptr<grpc::ClientReaderInterface<Response>> reader_;
+};
+
+/// Like `StubHoldingReader`, for asynchronous streams.
+template <typename StubPtr, typename Response>
+class StubHoldingAsyncReader
+    : public grpc::ClientAsyncReaderInterface<Response> {
+ public:
+  StubHoldingAsyncReader(
+      StubPtr stub,
+      std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader)
+      : stub_(std::move(stub)), reader_(std::move(reader)) {}
+
+  void StartCall(void* tag) override { reader_->StartCall(tag); }
+  void ReadInitialMetadata(void* tag) override {
+    reader_->ReadInitialMetadata(tag);
+  }
+  void Finish(grpc::Status* status, void* tag) override {
+    reader_->Finish(status, tag);
+  }
+  void Read(Response* msg, void* tag) override { reader_->Read(msg, tag); }
+
+ private:
+  StubPtr stub_;
+  std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader_;
+};
+}  // namespace
+
 /**
  * Implement a simple DataClient.
  *
@@ -106,14 +159,16 @@ class DefaultDataClient : public DataClient {
   std::unique_ptr<grpc::ClientReaderInterface<btproto::ReadRowsResponse>>
   ReadRows(grpc::ClientContext* context,
            btproto::ReadRowsRequest const& request) override {
-    return impl_.Stub()->ReadRows(context, request);
+    auto stub = impl_.Stub();
+    return HoldStub(stub, stub->ReadRows(context, request));
   }
 
   std::unique_ptr<grpc::ClientAsyncReaderInterface<btproto::ReadRowsResponse>>
   AsyncReadRows(grpc::ClientContext* context,
                 const google::bigtable::v2::ReadRowsRequest& request,
                 grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncReadRows(context, request, cq, tag);
+    auto stub = impl_.Stub();
+    return HoldStub(stub, stub->AsyncReadRows(context, request, cq, tag));
   }
 
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
@@ -121,13 +176,15 @@ class DefaultDataClient : public DataClient {
   PrepareAsyncReadRows(::grpc::ClientContext* context,
                        const ::google::bigtable::v2::ReadRowsRequest& request,
                        ::grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->PrepareAsyncReadRows(context, request, cq);
+    auto stub = impl_.Stub();
+    return HoldStub(stub, stub->PrepareAsyncReadRows(context, request, cq));
   }
 
   std::unique_ptr<grpc::ClientReaderInterface<btproto::SampleRowKeysResponse>>
   SampleRowKeys(grpc::ClientContext* context,
                 btproto::SampleRowKeysRequest const& request) override {
-    return impl_.Stub()->SampleRowKeys(context, request);
+    auto stub = impl_.Stub();
+    return HoldStub(stub, stub->SampleRowKeys(context, request));
   }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::SampleRowKeysResponse>>
@@ -135,20 +192,23 @@ class DefaultDataClient : public DataClient {
       ::grpc::ClientContext* context,
       const ::google::bigtable::v2::SampleRowKeysRequest& request,
       ::grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncSampleRowKeys(context, request, cq, tag);
+    auto stub = impl_.Stub();
+    return HoldStub(stub, stub->AsyncSampleRowKeys(context, request, cq, tag));
   }
 
   std::unique_ptr<grpc::ClientReaderInterface<btproto::MutateRowsResponse>>
   MutateRows(grpc::ClientContext* context,
              btproto::MutateRowsRequest const& request) override {
-    return impl_.Stub()->MutateRows(context, request);
+    auto stub = impl_.Stub();
+    return HoldStub(stub, stub->MutateRows(context, request));
   }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::MutateRowsResponse>>
   AsyncMutateRows(::grpc::ClientContext* context,
                   const ::google::bigtable::v2::MutateRowsRequest& request,
                   ::grpc::CompletionQueue* cq, void* tag) override {
-    return impl_.Stub()->AsyncMutateRows(context, request, cq, tag);
+    auto stub = impl_.Stub();
+    return HoldStub(stub, stub->AsyncMutateRows(context, request, cq, tag));
   }
   std::unique_ptr<::grpc::ClientAsyncReaderInterface<
       ::google::bigtable::v2::MutateRowsResponse>>
@@ -156,10 +216,31 @@ class DefaultDataClient : public DataClient {
       ::grpc::ClientContext* context,
       const ::google::bigtable::v2::MutateRowsRequest& request,
       ::grpc::CompletionQueue* cq) override {
-    return impl_.Stub()->PrepareAsyncMutateRows(context, request, cq);
+    auto stub = impl_.Stub();
+    return HoldStub(stub, stub->PrepareAsyncMutateRows(context, request, cq));
   }
 
  private:
+  template <typename Response>
+  std::unique_ptr<grpc::ClientReaderInterface<Response>> HoldStub(
+      Impl::StubPtr const& stub,
+      std::unique_ptr<grpc::ClientReaderInterface<Response>> reader) {
+    if (!impl_.TracksOutstandingCalls()) return reader;
+    return std::unique_ptr<grpc::ClientReaderInterface<Response>>(
+        new StubHoldingReader<Impl::StubPtr, Response>(stub,
+                                                       std::move(reader)));
+  }
+
+  template <typename Response>
+  std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> HoldStub(
+      Impl::StubPtr const& stub,
+      std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>> reader) {
+    if (!impl_.TracksOutstandingCalls()) return reader;
+    return std::unique_ptr<grpc::ClientAsyncReaderInterface<Response>>(
+        new StubHoldingAsyncReader<Impl::StubPtr, Response>(
+            stub, std::move(reader)));
+  }
+
   std::string project_;
   std::string instance_;
   Impl impl_;
@@ -17,7 +17,18 @@
 
 #include "google/cloud/bigtable/client_options.h"
 #include "google/cloud/bigtable/version.h"
+#include "google/cloud/internal/random.h"
 #include <grpcpp/grpcpp.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -29,6 +40,16 @@ namespace internal {
 std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
     std::string const& endpoint, bigtable::ClientOptions const& options);
 
+/**
+ * Create the channel for position @p id in the connection pool.
+ *
+ * Channels with different @p generation values use different connections, a
+ * channel replacing another one in the pool uses a new generation.
+ */
+std::shared_ptr<grpc::Channel> CreateChannel(
+    std::string const& endpoint, bigtable::ClientOptions const& options,
+    int id, int generation);
+
 /**
  * Refactor implementation of `bigtable::{Data,Admin,InstanceAdmin}Client`.
  *
@@ -40,6 +61,17 @@ std::vector<std::shared_ptr<grpc::Channel>> CreateChannelPool(
  * The class exposes the channels because they are needed for clients that
  * use more than one type of Stub.
  *
+ * Every RPC calls `Stub()` or `Channel()`, so selecting a channel does not
+ * take any locks. The channels and stubs are kept in an immutable pool,
+ * published through an atomic pointer. When the pool is replaced the old pool
+ * is retired, and deleted once no thread can be reading it: selection counts
+ * the threads inside it, and retired pools are deleted when that count drops
+ * to zero.
+ *
+ * Depending on the client options, the pool is created and connected when the
+ * client is created, and a background thread monitors the channels and
+ * replaces them periodically.  Replacing a channel also replaces the pool.
+ *
  * @tparam Traits encapsulates variations between the clients.  Currently, which
  *   `*_endpoint()` member function is used.
  * @tparam Interface the gRPC object returned by `Stub()`.
@@ -54,7 +86,29 @@ class CommonClient {
   //@}
 
   CommonClient(bigtable::ClientOptions options)
-      : options_(std::move(options)), current_index_(0) {}
+      : options_(std::move(options)),
+        pool_(nullptr),
+        readers_(0),
+        has_retired_(false),
+        current_index_(0),
+        generation_(0),
+        stopping_(false) {
+    if (options_.channel_warm_up_timeout().count() != 0) WarmUp();
+    if (options_.channel_refresh_period().count() > 0 ||
+        options_.channel_health_check_period().count() > 0) {
+      monitor_ = std::thread(&CommonClient::Monitor, this);
+    }
+  }
+
+  ~CommonClient() {
+    {
+      std::lock_guard<std::mutex> lk(monitor_mu_);
+      stopping_ = true;
+    }
+    monitor_cv_.notify_all();
+    if (monitor_.joinable()) monitor_.join();
+    delete pool_.load();
+  }
 
   /**
    * Reset the channel and stub.
@@ -64,81 +118,310 @@ class CommonClient {
    * and/or when the credentials require explicit refresh.
    */
   void reset() {
-    std::lock_guard<std::mutex> lk(mu_);
-    stubs_.clear();
+    std::unique_lock<std::mutex> lk(mu_);
+    auto* old = pool_.exchange(nullptr);
+    if (old == nullptr) return;
+    retired_.emplace_back(old);
+    has_retired_ = true;
+    Reclaim(lk);
   }
 
-  /// Return the next Stub to make a call.
+  /**
+   * Return the next Stub to make a call.
+   *
+   * With `ChannelSelectionPolicy::kLeastOutstandingRpcs` the call counts as
+   * outstanding on its channel until the returned pointer, and any copies of
+   * it, are released.
+   */
   StubPtr Stub() {
-    std::unique_lock<std::mutex> lk(mu_);
-    CheckConnections(lk);
-    auto stub = stubs_[GetIndex()];
-    return stub;
+    auto slot = Select();
+    if (options_.channel_selection_policy() !=
+        ChannelSelectionPolicy::kLeastOutstandingRpcs) {
+      return slot->stub;
+    }
+    auto call = std::make_shared<OutstandingCall>(std::move(slot));
+    return StubPtr(call, call->slot->stub.get());
   }
 
   /// Return the next Channel to make a call.
-  ChannelPtr Channel() {
-    std::unique_lock<std::mutex> lk(mu_);
-    CheckConnections(lk);
-    auto channel = channels_[GetIndex()];
-    return channel;
+  ChannelPtr Channel() { return Select()->channel; }
+
+  /// Whether the stubs returned by `Stub()` track outstanding calls.
+  bool TracksOutstandingCalls() const {
+    return options_.channel_selection_policy() ==
+           ChannelSelectionPolicy::kLeastOutstandingRpcs;
   }
 
  private:
-  /// Make sure the connections exit, and create them if needed.
-  void CheckConnections(std::unique_lock<std::mutex>& lk) {
-    if (!stubs_.empty()) {
-      return;
+  using Clock = std::chrono::steady_clock;
+
+  /// A channel, its stub, and the number of calls in progress on it.
+  struct Slot {
+    Slot(int i, ChannelPtr c, StubPtr s)
+        : id(i),
+          channel(std::move(c)),
+          stub(std::move(s)),
+          outstanding(0),
+          healthy(true) {}
+
+    int id;
+    ChannelPtr channel;
+    StubPtr stub;
+    std::atomic<std::int64_t> outstanding;
+    std::atomic<bool> healthy;
+    // When to replace the channel, only used by the monitor thread.
+    Clock::time_point refresh_at;
+  };
+
+  /// An immutable snapshot of the connection pool.
+  struct Pool {
+    std::vector<std::shared_ptr<Slot>> slots;
+  };
+
+  /// Count a call as outstanding on a channel while this object exists.
+  struct OutstandingCall {
+    explicit OutstandingCall(std::shared_ptr<Slot> s) : slot(std::move(s)) {
+      ++slot->outstanding;
+    }
+    ~OutstandingCall() { --slot->outstanding; }
+
+    std::shared_ptr<Slot> slot;
+  };
+
+  /// Pick the slot for the next call, creating the pool if needed.
+  std::shared_ptr<Slot> Select() {
+    while (true) {
+      ++readers_;
+      auto const* pool = pool_.load();
+      if (pool != nullptr) {
+        auto slot = Pick(*pool);
+        Release();
+        return slot;
+      }
+      Release();
+      CreatePool();
+    }
+  }
+
+  std::shared_ptr<Slot> Pick(Pool const& pool) {
+    auto const size = pool.slots.size();
+    // Round robin through the connections.
+    auto start = current_index_.fetch_add(1) % size;
+    // Skip the channels that fail to connect, unless all of them do.
+    for (std::size_t i = 0; i != size; ++i) {
+      auto const candidate = (start + i) % size;
+      if (!pool.slots[candidate]->healthy.load()) continue;
+      start = candidate;
+      break;
+    }
+    if (options_.channel_selection_policy() !=
+        ChannelSelectionPolicy::kLeastOutstandingRpcs) {
+      return pool.slots[start];
+    }
+    // Start from the round robin position so ties are spread evenly.
+    auto best = start;
+    auto best_count = pool.slots[best]->outstanding.load();
+    for (std::size_t i = 1; i != size && best_count != 0; ++i) {
+      auto const candidate = (start + i) % size;
+      if (!pool.slots[candidate]->healthy.load()) continue;
+      auto const count = pool.slots[candidate]->outstanding.load();
+      if (count < best_count) {
+        best = candidate;
+        best_count = count;
+      }
     }
-    // Release the lock while making remote calls.  gRPC uses the current
+    return pool.slots[best];
+  }
+
+  /// Leave the pool, deleting any retired pools if this was the last reader.
+  void Release() {
+    if (--readers_ != 0 || !has_retired_.load()) return;
+    std::unique_lock<std::mutex> lk(mu_, std::try_to_lock);
+    if (!lk.owns_lock()) return;
+    Reclaim(lk);
+  }
+
+  /// Delete the retired pools if no thread can be reading them.
+  void Reclaim(std::unique_lock<std::mutex>& lk) {
+    // Retired pools are no longer published, threads entering `Select()`
+    // after this point cannot find them.
+    if (readers_.load() != 0) return;
+    std::vector<std::unique_ptr<Pool>> retired;
+    retired.swap(retired_);
+    has_retired_ = false;
+    // Release the lock while closing the channels to minimize contention.
+    lk.unlock();
+    retired.clear();
+    lk.lock();
+  }
+
+  /// Create the connection pool and publish it, unless another thread did.
+  void CreatePool() {
+    // Do not hold the lock while making remote calls.  gRPC uses the current
     // thread to make remote connections (and probably authenticate), holding
-    // a lock for long operations like that is a bad practice.  Releasing
-    // the lock here can result in wasted work, but that is a smaller problem
-    // than a deadlock or an unbounded priority inversion.
+    // a lock for long operations like that is a bad practice.  This can result
+    // in wasted work, but that is a smaller problem than a deadlock or an
+    // unbounded priority inversion.
     // Note that only one connection per application is created by gRPC, even
     // if multiple threads are calling this function at the same time. gRPC
     // only opens one socket per destination+attributes combo, we artificially
     // introduce attributes in the implementation of CreateChannelPool() to
     // create one socket per element in the pool.
-    lk.unlock();
     auto channels = CreateChannelPool(Traits::Endpoint(options_), options_);
-    std::vector<StubPtr> tmp;
-    std::transform(channels.begin(), channels.end(), std::back_inserter(tmp),
-                   [](std::shared_ptr<grpc::Channel> ch) {
-                     return Interface::NewStub(ch);
-                   });
-    lk.lock();
-    if (stubs_.empty()) {
-      channels.swap(channels_);
-      tmp.swap(stubs_);
-      current_index_ = 0;
-    } else {
-      // Some other thread created the pool and saved it in `stubs_`. The work
-      // in this thread was superfluous. We release the lock while clearing the
-      // channels to minimize contention.
+    std::unique_ptr<Pool> pool(new Pool);
+    int id = 0;
+    for (auto& ch : channels) {
+      StubPtr stub = Interface::NewStub(ch);
+      pool->slots.push_back(
+          std::make_shared<Slot>(id++, std::move(ch), std::move(stub)));
+    }
+    std::unique_lock<std::mutex> lk(mu_);
+    if (pool_.load() == nullptr) {
+      pool_.store(pool.release());
+      return;
+    }
+    // Some other thread created the pool and published it. The work in this
+    // thread was superfluous. We release the lock while clearing the channels
+    // to minimize contention.
+    lk.unlock();
+  }
+
+  /// Create the pool and wait until its channels connect, or the timeout.
+  void WarmUp() {
+    CreatePool();
+    auto const deadline =
+        std::chrono::system_clock::now() + options_.channel_warm_up_timeout();
+    auto slots = Slots();
+    // Start all the connections before waiting for any of them.
+    for (auto const& slot : slots) slot->channel->GetState(true);
+    for (auto const& slot : slots) slot->channel->WaitForConnected(deadline);
+  }
+
+  /// Return the slots in the current pool, if any.
+  std::vector<std::shared_ptr<Slot>> Slots() {
+    // The current pool is only retired while holding the lock.
+    std::lock_guard<std::mutex> lk(mu_);
+    auto const* pool = pool_.load();
+    if (pool == nullptr) return {};
+    return pool->slots;
+  }
+
+  /// The body of the background thread checking and refreshing channels.
+  void Monitor() {
+    auto generator = google::cloud::internal::MakeDefaultPRNG();
+    std::unique_lock<std::mutex> lk(monitor_mu_);
+    while (!stopping_) {
       lk.unlock();
-      tmp.clear();
-      channels.clear();
+      auto const wake_up = CheckChannels(generator);
       lk.lock();
+      monitor_cv_.wait_until(lk, wake_up, [this] { return stopping_; });
     }
   }
 
-  /// Get the current index for round-robin over connections.
-  std::size_t GetIndex() {
-    std::size_t current = current_index_++;
-    // Round robin through the connections.
-    if (current_index_ >= stubs_.size()) {
-      current_index_ = 0;
+  /// Check and refresh the channels, return when to check them again.
+  Clock::time_point CheckChannels(
+      google::cloud::internal::DefaultPRNG& generator) {
+    auto const health_period = options_.channel_health_check_period();
+    auto const refresh_period = options_.channel_refresh_period();
+    auto const now = Clock::now();
+    auto wake_up =
+        now + (health_period.count() > 0 ? health_period : refresh_period);
+    // Non-positive periods are disabled, they would make the monitor spin and
+    // give the jitter distribution invalid bounds.
+    auto const refresh_ms = (std::max)(refresh_period.count(),
+                                       std::chrono::milliseconds::rep(0));
+    std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(
+        refresh_ms / 2, refresh_ms);
+    for (auto const& slot : Slots()) {
+      bool replace = false;
+      if (health_period.count() > 0) {
+        auto const state = slot->channel->GetState(false);
+        slot->healthy = state != GRPC_CHANNEL_TRANSIENT_FAILURE &&
+                        state != GRPC_CHANNEL_SHUTDOWN;
+        // Reconnect idle channels, for example, after the server closed their
+        // connection, so the next request does not wait for it.
+        if (state == GRPC_CHANNEL_IDLE) slot->channel->GetState(true);
+        replace = state == GRPC_CHANNEL_SHUTDOWN;
+      }
+      if (refresh_period.count() > 0) {
+        if (slot->refresh_at == Clock::time_point{}) {
+          slot->refresh_at =
+              now + std::chrono::milliseconds(jitter(generator));
+        }
+        replace = replace || slot->refresh_at <= now;
+        wake_up = (std::min)(wake_up, slot->refresh_at);
+      }
+      if (replace) Replace(slot);
+    }
+    return wake_up;
+  }
+
+  /// Replace the channel in @p old with a new, connected, channel.
+  void Replace(std::shared_ptr<Slot> const& old) {
+    auto channel =
+        CreateChannel(Traits::Endpoint(options_), options_, old->id,
+                      ++generation_);
+    // Connect the new channel before publishing it, requests keep using the
+    // old channel in the meantime.
+    channel->GetState(true);
+    auto const timeout = options_.channel_warm_up_timeout().count() != 0
+                             ? options_.channel_warm_up_timeout()
+                             : std::chrono::milliseconds(10000);
+    if (!WaitForConnected(*channel, timeout)) return;
+    StubPtr stub = Interface::NewStub(channel);
+    auto slot = std::make_shared<Slot>(old->id, std::move(channel),
+                                       std::move(stub));
+
+    std::unique_lock<std::mutex> lk(mu_);
+    auto const* current = pool_.load();
+    if (current == nullptr) return;
+    auto pos = std::find(current->slots.begin(), current->slots.end(), old);
+    // The pool was reset while the new channel was connecting.
+    if (pos == current->slots.end()) return;
+    std::unique_ptr<Pool> pool(new Pool(*current));
+    pool->slots[std::distance(current->slots.begin(), pos)] = std::move(slot);
+    retired_.emplace_back(pool_.exchange(pool.release()));
+    has_retired_ = true;
+    Reclaim(lk);
+  }
+
+  /**
+   * Wait until @p channel connects, the timeout expires, or the client stops.
+   *
+   * Returns false if the client is stopping.  A channel that does not connect
+   * in time is still used, it keeps connecting in the background.
+   */
+  bool WaitForConnected(grpc::Channel& channel,
+                        std::chrono::milliseconds timeout) {
+    auto const deadline = std::chrono::system_clock::now() + timeout;
+    // Wake up periodically, the destructor should not wait for the timeout.
+    auto const poll_period = std::chrono::milliseconds(100);
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lk(monitor_mu_);
+        if (stopping_) return false;
+      }
+      auto const step = (std::min)(
+          deadline, std::chrono::system_clock::now() + poll_period);
+      if (channel.WaitForConnected(step) || step == deadline) return true;
     }
-    return current;
   }
 
  private:
   std::mutex mu_;
   ClientOptions options_;
-  std::vector<ChannelPtr> channels_;
-  std::vector<StubPtr> stubs_;
-  std::size_t current_index_;
+  std::atomic<Pool*> pool_;
+  // The number of threads in `Select()`, which may be reading a retired pool.
+  std::atomic<std::size_t> readers_;
+  std::atomic<bool> has_retired_;
+  std::vector<std::unique_ptr<Pool>> retired_;
+  std::atomic<std::size_t> current_index_;
+  // The monitor thread state, the thread is created last.
+  std::atomic<int> generation_;
+  std::mutex monitor_mu_;
+  std::condition_variable monitor_cv_;
+  bool stopping_;
+  std::thread monitor_;
 };
 
 }  // namespace internal
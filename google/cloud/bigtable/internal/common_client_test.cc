@@ -0,0 +1,240 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/bigtable/internal/common_client.h"
+#include <grpcpp/generic/async_generic_service.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <set>
+#include <string>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+/// A minimal stand-in for the gRPC generated service class.
+struct FakeService {
+  class StubInterface {
+   public:
+    virtual ~StubInterface() = default;
+  };
+
+  class Stub : public StubInterface {
+   public:
+    explicit Stub(std::shared_ptr<grpc::Channel> channel)
+        : channel_(std::move(channel)) {}
+
+    std::shared_ptr<grpc::Channel> channel_;
+  };
+
+  static std::unique_ptr<Stub> NewStub(std::shared_ptr<grpc::Channel> c) {
+    return std::unique_ptr<Stub>(new Stub(std::move(c)));
+  }
+};
+
+struct FakeTraits {
+  static std::string const& Endpoint(ClientOptions& options) {
+    return options.data_endpoint();
+  }
+};
+
+using Client = CommonClient<FakeTraits, FakeService>;
+
+ClientOptions TestOptions(std::size_t pool_size) {
+  // The channels connect lazily, so the endpoint does not need to exist.
+  return ClientOptions(grpc::InsecureChannelCredentials())
+      .set_data_endpoint("localhost:1")
+      .set_connection_pool_size(pool_size);
+}
+
+TEST(CommonClientTest, RoundRobin) {
+  Client client(TestOptions(4));
+  std::vector<FakeService::StubInterface*> stubs;
+  for (int i = 0; i != 8; ++i) stubs.push_back(client.Stub().get());
+  EXPECT_EQ(4, std::set<FakeService::StubInterface*>(stubs.begin(),
+                                                     stubs.end())
+                   .size());
+  for (int i = 0; i != 4; ++i) EXPECT_EQ(stubs[i], stubs[i + 4]);
+
+  std::set<grpc::Channel*> channels;
+  for (int i = 0; i != 4; ++i) channels.insert(client.Channel().get());
+  EXPECT_EQ(4, channels.size());
+}
+
+TEST(CommonClientTest, ResetCreatesNewPool) {
+  // With a single channel `Stub()` and `Channel()` use the same slot.
+  Client client(TestOptions(1));
+  auto old_stub = client.Stub();
+  auto old_channel = client.Channel();
+  client.reset();
+  for (int i = 0; i != 4; ++i) {
+    EXPECT_NE(old_stub.get(), client.Stub().get());
+    EXPECT_NE(old_channel.get(), client.Channel().get());
+  }
+  // The stubs returned before the reset are still usable.
+  auto const* stub = dynamic_cast<FakeService::Stub*>(old_stub.get());
+  ASSERT_NE(nullptr, stub);
+  EXPECT_EQ(old_channel.get(), stub->channel_.get());
+}
+
+TEST(CommonClientTest, LeastOutstandingRpcs) {
+  auto options = TestOptions(3).set_channel_selection_policy(
+      ChannelSelectionPolicy::kLeastOutstandingRpcs);
+  Client client(options);
+  EXPECT_TRUE(client.TracksOutstandingCalls());
+
+  auto a = client.Stub();
+  auto b = client.Stub();
+  auto c = client.Stub();
+  EXPECT_EQ(3, std::set<FakeService::StubInterface*>({a.get(), b.get(),
+                                                      c.get()})
+                   .size());
+
+  // Only the channel of `b` has no calls in progress.
+  auto const* idle = b.get();
+  b.reset();
+  auto d = client.Stub();
+  EXPECT_EQ(idle, d.get());
+
+  // Copies of a stub count as the same call, it ends with the last copy.
+  auto const* busy = a.get();
+  auto const* c_stub = c.get();
+  auto a_copy = a;
+  a.reset();
+  c.reset();
+  auto g = client.Stub();
+  EXPECT_EQ(c_stub, g.get());
+  a_copy.reset();
+  auto h = client.Stub();
+  EXPECT_EQ(busy, h.get());
+}
+
+TEST(CommonClientTest, ConcurrentSelectionAndReset) {
+  for (auto policy : {ChannelSelectionPolicy::kRoundRobin,
+                      ChannelSelectionPolicy::kLeastOutstandingRpcs}) {
+    Client client(TestOptions(4).set_channel_selection_policy(policy));
+    std::vector<std::thread> threads;
+    for (int t = 0; t != 8; ++t) {
+      threads.emplace_back([&client] {
+        for (int i = 0; i != 2000; ++i) {
+          auto stub = client.Stub();
+          EXPECT_NE(nullptr, stub.get());
+          EXPECT_NE(nullptr, client.Channel().get());
+        }
+      });
+    }
+    for (int i = 0; i != 20; ++i) client.reset();
+    for (auto& t : threads) t.join();
+  }
+}
+
+/// Wait up to 10 seconds for @p predicate to become true.
+template <typename Predicate>
+bool Eventually(Predicate predicate) {
+  auto const deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return true;
+}
+
+/// Run a server, with no RPC implementations, so the channels can connect.
+class CommonClientServerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    grpc::ServerBuilder builder;
+    builder.AddListeningPort("localhost:0", grpc::InsecureServerCredentials(),
+                             &port_);
+    builder.RegisterAsyncGenericService(&service_);
+    cq_ = builder.AddCompletionQueue();
+    server_ = builder.BuildAndStart();
+    ASSERT_NE(nullptr, server_);
+    ASSERT_NE(0, port_);
+    cq_thread_ = std::thread([this] {
+      void* tag;
+      bool ok;
+      while (cq_->Next(&tag, &ok)) {
+      }
+    });
+  }
+
+  void TearDown() override {
+    if (server_) server_->Shutdown();
+    cq_->Shutdown();
+    if (cq_thread_.joinable()) cq_thread_.join();
+  }
+
+  ClientOptions ServerOptions(std::size_t pool_size) {
+    return TestOptions(pool_size).set_data_endpoint("localhost:" +
+                                                    std::to_string(port_));
+  }
+
+  grpc::AsyncGenericService service_;
+  int port_ = 0;
+  std::unique_ptr<grpc::ServerCompletionQueue> cq_;
+  std::unique_ptr<grpc::Server> server_;
+  std::thread cq_thread_;
+};
+
+TEST_F(CommonClientServerTest, WarmUpConnectsChannels) {
+  Client client(
+      ServerOptions(2).set_channel_warm_up_timeout(std::chrono::seconds(10)));
+  for (int i = 0; i != 2; ++i) {
+    EXPECT_EQ(GRPC_CHANNEL_READY, client.Channel()->GetState(false));
+  }
+}
+
+TEST_F(CommonClientServerTest, RefreshReplacesChannels) {
+  Client client(ServerOptions(2).set_channel_refresh_period(
+      std::chrono::milliseconds(50)));
+  auto old_stub = client.Stub();
+  std::set<grpc::Channel*> initial;
+  for (int i = 0; i != 2; ++i) initial.insert(client.Channel().get());
+  ASSERT_EQ(2, initial.size());
+
+  std::vector<std::shared_ptr<grpc::Channel>> current;
+  EXPECT_TRUE(Eventually([&] {
+    current = {client.Channel(), client.Channel()};
+    return initial.count(current[0].get()) == 0 &&
+           initial.count(current[1].get()) == 0;
+  }));
+  // The replacements are connected before they receive any requests.
+  for (auto const& c : current) {
+    EXPECT_NE(GRPC_CHANNEL_IDLE, c->GetState(false));
+  }
+  // The stubs returned before the refresh are still usable.
+  auto const* stub = dynamic_cast<FakeService::Stub*>(old_stub.get());
+  ASSERT_NE(nullptr, stub);
+  EXPECT_EQ(1, initial.count(stub->channel_.get()));
+}
+
+TEST_F(CommonClientServerTest, HealthCheckConnectsIdleChannels) {
+  Client client(ServerOptions(1).set_channel_health_check_period(
+      std::chrono::milliseconds(10)));
+  auto channel = client.Channel();
+  EXPECT_TRUE(Eventually(
+      [&] { return channel->GetState(false) == GRPC_CHANNEL_READY; }));
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
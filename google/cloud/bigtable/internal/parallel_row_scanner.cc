@@ -0,0 +1,256 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/bigtable/internal/parallel_row_scanner.h"
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+ParallelRowScanner::ParallelRowScanner(ParallelScanShards shards,
+                                       ParallelReadRowsOptions const& options,
+                                       ReaderFactory factory)
+    : options_(options),
+      factory_(std::move(factory)),
+      shards_(std::move(shards)),
+      active_workers_(0),
+      cancelled_(false) {
+  options_.max_streams = (std::max)(options_.max_streams, std::size_t(1));
+  options_.max_buffered_rows =
+      (std::max)(options_.max_buffered_rows, std::size_t(1));
+}
+
+Status ParallelRowScanner::Run(std::function<bool(Row)> const& on_row) {
+  // Start all the streams, even if there are fewer shards: idle streams pick
+  // up work by splitting the shards of busy streams.
+  active_workers_ = options_.max_streams;
+  std::vector<std::thread> workers;
+  for (std::size_t i = 0; i != options_.max_streams; ++i) {
+    workers.emplace_back(&ParallelRowScanner::Worker, this);
+  }
+
+  std::unique_lock<std::mutex> lk(mu_);
+  for (auto row = NextRow(lk); row; row = NextRow(lk)) {
+    lk.unlock();
+    bool const more = on_row(*std::move(row));
+    lk.lock();
+    if (!more) break;
+  }
+  // Stop any streams still running, including any waiting for buffer space.
+  cancelled_ = true;
+  cv_.notify_all();
+  lk.unlock();
+  for (auto& t : workers) t.join();
+  return status_;
+}
+
+void ParallelRowScanner::Worker() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (!cancelled_) {
+    auto id = shards_.Next();
+    if (!id) break;
+    ReadShard(lk, *id);
+  }
+  --active_workers_;
+  cv_.notify_all();
+}
+
+void ParallelRowScanner::ReadShard(std::unique_lock<std::mutex>& lk,
+                                   RowKeyType const& id) {
+  running_.insert(id);
+  // Buffers are only removed once their shard is not running, so this
+  // reference remains valid.
+  auto& buffer = buffers_[id];
+  auto row_set = shards_.ShardRowSet(id);
+  lk.unlock();
+
+  Status status;
+  auto reader = factory_(std::move(row_set));
+  for (auto& row : reader) {
+    if (!row) {
+      status = std::move(row).status();
+      break;
+    }
+    lk.lock();
+    cv_.wait(lk, [this, &buffer] {
+      return cancelled_ || buffer.size() < options_.max_buffered_rows;
+    });
+    // The shard may have been split while this row was in flight, in that
+    // case the row (and the rest of the stream) belong to the new shard.
+    bool const accepted = !cancelled_ && shards_.Accept(id, row->row_key());
+    if (accepted) {
+      buffer.push_back(*std::move(row));
+      cv_.notify_all();
+    }
+    lk.unlock();
+    if (!accepted) {
+      reader.Cancel();
+      break;
+    }
+  }
+
+  lk.lock();
+  if (!status.ok()) {
+    if (status_.ok()) status_ = std::move(status);
+    cancelled_ = true;
+  }
+  shards_.Finish(id);
+  running_.erase(id);
+  cv_.notify_all();
+}
+
+optional<Row> ParallelRowScanner::NextRow(std::unique_lock<std::mutex>& lk) {
+  while (!cancelled_) {
+    auto row = options_.ordered ? PopOrdered() : PopAny();
+    if (row) {
+      // Wake up any stream waiting for buffer space.
+      cv_.notify_all();
+      return row;
+    }
+    if (active_workers_ == 0) break;
+    cv_.wait(lk);
+  }
+  return {};
+}
+
+optional<Row> ParallelRowScanner::PopOrdered() {
+  auto const first = shards_.FirstUnfinished();
+  while (!buffers_.empty()) {
+    auto b = buffers_.begin();
+    // Rows after an unfinished shard must wait until it is done.
+    if (first && *first < b->first) break;
+    if (!b->second.empty()) {
+      auto row = std::move(b->second.front());
+      b->second.pop_front();
+      return row;
+    }
+    if (running_.count(b->first) != 0) break;
+    buffers_.erase(b);
+  }
+  return {};
+}
+
+optional<Row> ParallelRowScanner::PopAny() {
+  // Drain the fullest buffer, as its stream is the most likely to be paused.
+  auto best = buffers_.end();
+  for (auto b = buffers_.begin(); b != buffers_.end();) {
+    if (b->second.empty() && running_.count(b->first) == 0) {
+      b = buffers_.erase(b);
+      continue;
+    }
+    if (best == buffers_.end() || best->second.size() < b->second.size()) {
+      best = b;
+    }
+    ++b;
+  }
+  if (best == buffers_.end() || best->second.empty()) return {};
+  auto row = std::move(best->second.front());
+  best->second.pop_front();
+  return row;
+}
+
+future<Status> AsyncParallelRowScanner::Start(ParallelScanShards shards,
+                                              std::size_t max_streams,
+                                              ReaderFactory factory,
+                                              RowFunctor on_row) {
+  std::shared_ptr<AsyncParallelRowScanner> self(new AsyncParallelRowScanner(
+      std::move(shards), max_streams, std::move(factory), std::move(on_row)));
+  auto result = self->done_.get_future();
+  std::unique_lock<std::mutex> lk(self->mu_);
+  self->StartShards(lk);
+  return result;
+}
+
+AsyncParallelRowScanner::AsyncParallelRowScanner(ParallelScanShards shards,
+                                                 std::size_t max_streams,
+                                                 ReaderFactory factory,
+                                                 RowFunctor on_row)
+    : max_streams_((std::max)(max_streams, std::size_t(1))),
+      factory_(std::move(factory)),
+      on_row_(std::move(on_row)),
+      shards_(std::move(shards)),
+      running_(0),
+      cancelled_(false) {}
+
+void AsyncParallelRowScanner::StartShards(std::unique_lock<std::mutex>& lk) {
+  std::vector<std::pair<RowKeyType, RowSet>> shards;
+  while (!cancelled_ && running_ < max_streams_) {
+    auto id = shards_.Next();
+    if (!id) break;
+    ++running_;
+    shards.emplace_back(*id, shards_.ShardRowSet(*id));
+  }
+  if (running_ == 0) {
+    // Nothing is running and there is nothing left to start.
+    auto status = status_;
+    lk.unlock();
+    done_.set_value(std::move(status));
+    return;
+  }
+  lk.unlock();
+
+  // The streams may finish (and call `OnFinish()`) before `factory_` returns,
+  // so they are started without holding the lock.
+  auto self = shared_from_this();
+  for (auto& s : shards) {
+    auto id = s.first;
+    factory_(
+        std::move(s.second),
+        [self, id](Row row) { return self->OnRow(id, std::move(row)); },
+        [self, id](Status status) { self->OnFinish(id, std::move(status)); });
+  }
+}
+
+future<bool> AsyncParallelRowScanner::OnRow(RowKeyType const& id, Row row) {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    if (cancelled_ || !shards_.Accept(id, row.row_key())) {
+      stopped_.insert(id);
+      return make_ready_future(false);
+    }
+  }
+  auto self = shared_from_this();
+  return on_row_(std::move(row)).then([self, id](future<bool> f) {
+    bool const more = f.get();
+    if (!more) {
+      std::lock_guard<std::mutex> lk(self->mu_);
+      self->cancelled_ = true;
+      self->stopped_.insert(id);
+    }
+    return more;
+  });
+}
+
+void AsyncParallelRowScanner::OnFinish(RowKeyType const& id, Status status) {
+  std::unique_lock<std::mutex> lk(mu_);
+  bool const stopped = stopped_.erase(id) != 0;
+  if (!status.ok() && !stopped) {
+    if (status_.ok()) status_ = std::move(status);
+    cancelled_ = true;
+  }
+  shards_.Finish(id);
+  --running_;
+  StartShards(lk);
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,133 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PARALLEL_ROW_SCANNER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PARALLEL_ROW_SCANNER_H
+
+#include "google/cloud/bigtable/internal/parallel_scan_shards.h"
+#include "google/cloud/bigtable/parallel_read_rows_options.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_reader.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/optional.h"
+#include "google/cloud/status.h"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Implement `Table::ParallelReadRows()`.
+ *
+ * A pool of threads reads the shards, each thread runs one `RowReader` at a
+ * time and queues the rows in a per-shard buffer. The thread calling `Run()`
+ * drains the buffers and invokes the callback, so the callback is never called
+ * concurrently. In ordered mode the buffers are drained in key order, a stream
+ * pauses when its buffer is full, which bounds the memory used by the scan.
+ */
+class ParallelRowScanner {
+ public:
+  using ReaderFactory = std::function<RowReader(RowSet)>;
+
+  ParallelRowScanner(ParallelScanShards shards,
+                     ParallelReadRowsOptions const& options,
+                     ReaderFactory factory);
+
+  /**
+   * Read all the shards, calling @p on_row for each row.
+   *
+   * @returns the first error returned by any of the streams, the scan stops
+   *     after an error. Returning `false` from @p on_row also stops the scan,
+   *     and the function returns an OK status.
+   */
+  Status Run(std::function<bool(Row)> const& on_row);
+
+ private:
+  void Worker();
+  void ReadShard(std::unique_lock<std::mutex>& lk, RowKeyType const& id);
+  optional<Row> NextRow(std::unique_lock<std::mutex>& lk);
+  optional<Row> PopOrdered();
+  optional<Row> PopAny();
+
+  ParallelReadRowsOptions options_;
+  ReaderFactory factory_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  ParallelScanShards shards_;
+  std::map<RowKeyType, std::deque<Row>> buffers_;
+  std::set<RowKeyType> running_;
+  std::size_t active_workers_;
+  bool cancelled_;
+  Status status_;
+};
+
+/**
+ * Implement `Table::AsyncParallelReadRows()`.
+ *
+ * Keeps up to `max_streams` asynchronous streams running, starting a new one
+ * each time a shard finishes. Rows are passed to the callback as they arrive,
+ * each stream waits for the future returned by the callback before delivering
+ * its next row, but different streams may call it concurrently.
+ */
+class AsyncParallelRowScanner
+    : public std::enable_shared_from_this<AsyncParallelRowScanner> {
+ public:
+  using RowFunctor = std::function<future<bool>(Row)>;
+  using FinishFunctor = std::function<void(Status)>;
+  using ReaderFactory =
+      std::function<void(RowSet, RowFunctor, FinishFunctor)>;
+
+  static future<Status> Start(ParallelScanShards shards,
+                              std::size_t max_streams, ReaderFactory factory,
+                              RowFunctor on_row);
+
+ private:
+  AsyncParallelRowScanner(ParallelScanShards shards, std::size_t max_streams,
+                          ReaderFactory factory, RowFunctor on_row);
+
+  void StartShards(std::unique_lock<std::mutex>& lk);
+  future<bool> OnRow(RowKeyType const& id, Row row);
+  void OnFinish(RowKeyType const& id, Status status);
+
+  std::size_t max_streams_;
+  ReaderFactory factory_;
+  RowFunctor on_row_;
+
+  std::mutex mu_;
+  ParallelScanShards shards_;
+  std::size_t running_;
+  // Shards whose stream we stopped ourselves, their `kCancelled` status is
+  // expected.
+  std::set<RowKeyType> stopped_;
+  bool cancelled_;
+  Status status_;
+  promise<Status> done_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PARALLEL_ROW_SCANNER_H
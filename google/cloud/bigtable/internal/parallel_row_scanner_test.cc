@@ -0,0 +1,165 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/bigtable/internal/parallel_row_scanner.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <deque>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using Scanner = AsyncParallelRowScanner;
+
+/// Capture the streams started by the scanner, so the test can drive them.
+class AsyncParallelRowScannerTest : public ::testing::Test {
+ protected:
+  struct Stream {
+    RowSet row_set;
+    Scanner::RowFunctor on_row;
+    Scanner::FinishFunctor on_finish;
+  };
+
+  future<Status> Start(std::vector<RowKeySample> const& samples,
+                       std::size_t shard_count, std::size_t max_streams,
+                       bool user_continues = true) {
+    return Scanner::Start(
+        ParallelScanShards(RowSet(), samples, shard_count), max_streams,
+        [this](RowSet row_set, Scanner::RowFunctor on_row,
+               Scanner::FinishFunctor on_finish) {
+          streams_.push_back(
+              Stream{std::move(row_set), std::move(on_row),
+                     std::move(on_finish)});
+        },
+        [this, user_continues](Row row) {
+          rows_.push_back(row.row_key());
+          return make_ready_future(user_continues);
+        });
+  }
+
+  /// The first key in the shard read by the @p i-th stream.
+  RowKeyType Begin(std::size_t i) {
+    return streams_.at(i).row_set.as_proto().row_ranges(0).start_key_closed();
+  }
+
+  /// The end of the shard read by the @p i-th stream.
+  RowKeyType End(std::size_t i) {
+    return streams_.at(i).row_set.as_proto().row_ranges(0).end_key_open();
+  }
+
+  // Streams are added while the callbacks of other streams run, a deque keeps
+  // the existing elements in place.
+  std::deque<Stream> streams_;
+  std::vector<RowKeyType> rows_;
+};
+
+bool Ready(future<Status> const& f) {
+  return f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+std::vector<RowKeySample> Samples(std::vector<std::string> const& keys) {
+  std::vector<RowKeySample> samples;
+  std::int64_t offset = 0;
+  for (auto const& k : keys) samples.push_back(RowKeySample{k, ++offset});
+  return samples;
+}
+
+TEST_F(AsyncParallelRowScannerTest, BoundedConcurrency) {
+  auto result = Start(Samples({"b", "c", "d"}), 4, 2);
+  ASSERT_EQ(2, streams_.size());
+  EXPECT_EQ("", Begin(0));
+  EXPECT_EQ("b", End(0));
+  EXPECT_EQ("b", Begin(1));
+  EXPECT_EQ("c", End(1));
+
+  EXPECT_TRUE(streams_[0].on_row(Row("a", {})).get());
+  EXPECT_TRUE(streams_[1].on_row(Row("b1", {})).get());
+  streams_[0].on_finish(Status());
+  ASSERT_EQ(3, streams_.size());
+  EXPECT_EQ("c", Begin(2));
+  streams_[1].on_finish(Status());
+  ASSERT_EQ(4, streams_.size());
+  EXPECT_EQ("d", Begin(3));
+  EXPECT_FALSE(Ready(result));
+
+  streams_[2].on_finish(Status());
+  streams_[3].on_finish(Status());
+  EXPECT_EQ(4, streams_.size());
+  ASSERT_TRUE(Ready(result));
+  EXPECT_STATUS_OK(result.get());
+  EXPECT_EQ((std::vector<RowKeyType>{"a", "b1"}), rows_);
+}
+
+TEST_F(AsyncParallelRowScannerTest, StreamError) {
+  auto result = Start(Samples({"b"}), 2, 2);
+  ASSERT_EQ(2, streams_.size());
+
+  streams_[0].on_finish(Status(StatusCode::kPermissionDenied, "uh-oh"));
+  EXPECT_FALSE(Ready(result));
+  // The other stream is stopped at its next row.
+  EXPECT_FALSE(streams_[1].on_row(Row("b1", {})).get());
+  streams_[1].on_finish(Status(StatusCode::kCancelled, "User cancelled"));
+
+  ASSERT_TRUE(Ready(result));
+  EXPECT_EQ(StatusCode::kPermissionDenied, result.get().code());
+  EXPECT_TRUE(rows_.empty());
+}
+
+TEST_F(AsyncParallelRowScannerTest, UserStops) {
+  auto result = Start(Samples({"b"}), 2, 1, false);
+  ASSERT_EQ(1, streams_.size());
+
+  EXPECT_FALSE(streams_[0].on_row(Row("a", {})).get());
+  streams_[0].on_finish(Status(StatusCode::kCancelled, "User cancelled"));
+  EXPECT_EQ(1, streams_.size());
+  ASSERT_TRUE(Ready(result));
+  EXPECT_STATUS_OK(result.get());
+  EXPECT_EQ(std::vector<RowKeyType>{"a"}, rows_);
+}
+
+TEST_F(AsyncParallelRowScannerTest, SplitSlowShard) {
+  auto result = Start(Samples({"b", "c", "d", "e", ""}), 2, 2);
+  ASSERT_EQ(2, streams_.size());
+  EXPECT_EQ("d", End(0));
+  EXPECT_EQ("d", Begin(1));
+
+  EXPECT_TRUE(streams_[0].on_row(Row("a", {})).get());
+  // The second stream finishes early and takes over half of the first shard.
+  streams_[1].on_finish(Status());
+  ASSERT_EQ(3, streams_.size());
+  EXPECT_EQ("c", Begin(2));
+  EXPECT_EQ("d", End(2));
+
+  // Rows past the split point are not delivered by the first stream.
+  EXPECT_FALSE(streams_[0].on_row(Row("c1", {})).get());
+  streams_[0].on_finish(Status(StatusCode::kCancelled, "User cancelled"));
+  EXPECT_TRUE(streams_[2].on_row(Row("c1", {})).get());
+  streams_[2].on_finish(Status());
+
+  EXPECT_EQ(3, streams_.size());
+  ASSERT_TRUE(Ready(result));
+  EXPECT_STATUS_OK(result.get());
+  EXPECT_EQ((std::vector<RowKeyType>{"a", "c1"}), rows_);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
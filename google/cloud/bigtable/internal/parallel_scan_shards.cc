@@ -0,0 +1,165 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/bigtable/internal/parallel_scan_shards.h"
+#include <algorithm>
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+ParallelScanShards::ParallelScanShards(RowSet row_set,
+                                       std::vector<RowKeySample> const& samples,
+                                       std::size_t shard_count)
+    : row_set_(std::move(row_set)) {
+  // The empty row key marks the end of the table, it is not a split point, but
+  // its offset is the best estimate for the size of the table.
+  std::int64_t total = 0;
+  for (auto const& s : samples) total = (std::max)(total, s.offset_bytes);
+  std::vector<RowKeySample> sorted;
+  std::copy_if(samples.begin(), samples.end(), std::back_inserter(sorted),
+               [](RowKeySample const& s) { return !s.row_key.empty(); });
+  std::sort(sorted.begin(), sorted.end(),
+            [](RowKeySample const& a, RowKeySample const& b) {
+              return a.row_key < b.row_key;
+            });
+  sorted.erase(std::unique(sorted.begin(), sorted.end(),
+                           [](RowKeySample const& a, RowKeySample const& b) {
+                             return a.row_key == b.row_key;
+                           }),
+               sorted.end());
+  for (auto const& s : sorted) split_points_.push_back(s.row_key);
+
+  std::vector<RowKeyType> bounds;
+  if (shard_count <= 1) {
+    // A single shard covering the whole table.
+  } else if (sorted.size() < shard_count) {
+    bounds = split_points_;
+  } else if (total > 0) {
+    // Pick the first split point past each multiple of total / shard_count.
+    std::size_t next = 1;
+    auto threshold = [&] {
+      return static_cast<double>(total) * next / shard_count;
+    };
+    for (auto const& s : sorted) {
+      if (next == shard_count) break;
+      if (static_cast<double>(s.offset_bytes) < threshold()) continue;
+      bounds.push_back(s.row_key);
+      while (next != shard_count &&
+             static_cast<double>(s.offset_bytes) >= threshold()) {
+        ++next;
+      }
+    }
+  } else {
+    // Without size estimates just pick evenly spaced split points.
+    for (std::size_t i = 1; i != shard_count; ++i) {
+      bounds.push_back(sorted[i * sorted.size() / shard_count].row_key);
+    }
+  }
+
+  RowKeyType begin;
+  for (auto& b : bounds) {
+    auto end = b;
+    AddShard(std::move(begin), std::move(end), State::kPending);
+    begin = std::move(b);
+  }
+  AddShard(std::move(begin), RowKeyType(), State::kPending);
+}
+
+optional<RowKeyType> ParallelScanShards::Next() {
+  for (auto& kv : shards_) {
+    if (kv.second.state != State::kPending) continue;
+    if (ShardRowSet(kv.first).IsEmpty()) {
+      kv.second.state = State::kDone;
+      continue;
+    }
+    kv.second.state = State::kRunning;
+    return kv.first;
+  }
+  return Split();
+}
+
+RowSet ParallelScanShards::ShardRowSet(RowKeyType const& id) const {
+  auto loc = shards_.find(id);
+  if (loc == shards_.end()) return RowSet(RowRange::Empty());
+  return row_set_.Intersect(RowRange::RightOpen(id, loc->second.end));
+}
+
+bool ParallelScanShards::Accept(RowKeyType const& id,
+                                RowKeyType const& row_key) {
+  auto loc = shards_.find(id);
+  if (loc == shards_.end()) return false;
+  auto& shard = loc->second;
+  if (!shard.end.empty() && shard.end <= row_key) return false;
+  shard.last_key = row_key;
+  shard.has_rows = true;
+  return true;
+}
+
+void ParallelScanShards::Finish(RowKeyType const& id) {
+  auto loc = shards_.find(id);
+  if (loc == shards_.end()) return;
+  loc->second.state = State::kDone;
+}
+
+optional<RowKeyType> ParallelScanShards::FirstUnfinished() const {
+  for (auto const& kv : shards_) {
+    if (kv.second.state != State::kDone) return kv.first;
+  }
+  return {};
+}
+
+void ParallelScanShards::AddShard(RowKeyType begin, RowKeyType end,
+                                  State state) {
+  shards_.emplace(std::move(begin), Shard{std::move(end), {}, false, state});
+}
+
+optional<RowKeyType> ParallelScanShards::Split() {
+  // Find the running shard with the most split points left to read, i.e.,
+  // the split points after the last row received and before its end.
+  auto best = shards_.end();
+  std::vector<RowKeyType>::const_iterator best_lo;
+  std::ptrdiff_t best_count = 0;
+  for (auto i = shards_.begin(); i != shards_.end(); ++i) {
+    auto const& shard = i->second;
+    if (shard.state != State::kRunning) continue;
+    auto const& lower = shard.has_rows ? shard.last_key : i->first;
+    auto lo = std::upper_bound(split_points_.cbegin(), split_points_.cend(),
+                               lower);
+    auto hi = shard.end.empty()
+                  ? split_points_.cend()
+                  : std::lower_bound(lo, split_points_.cend(), shard.end);
+    auto count = std::distance(lo, hi);
+    if (count > best_count) {
+      best = i;
+      best_lo = lo;
+      best_count = count;
+    }
+  }
+  if (best == shards_.end()) return {};
+
+  // The running stream keeps the first half, the caller gets the second half.
+  RowKeyType begin = *std::next(best_lo, best_count / 2);
+  AddShard(begin, best->second.end, State::kRunning);
+  best->second.end = begin;
+  return begin;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
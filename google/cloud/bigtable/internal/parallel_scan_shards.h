@@ -0,0 +1,104 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PARALLEL_SCAN_SHARDS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PARALLEL_SCAN_SHARDS_H
+
+#include "google/cloud/bigtable/row_key.h"
+#include "google/cloud/bigtable/row_key_sample.h"
+#include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/optional.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Keep track of the shards in a parallel scan.
+ *
+ * The key space is partitioned into contiguous `[begin, end)` ranges, using the
+ * row keys returned by `Table::SampleRows()` as split points, and weighting
+ * them by `offset_bytes` so the shards have similar sizes. Each shard is
+ * identified by its `begin` key.
+ *
+ * Shards are assigned in key order. Once there are no pending shards, a stream
+ * asking for more work takes over the second half of the running shard with
+ * the most split points left, which is how slow shards get rebalanced. The
+ * stream that was reading that shard learns about the split via `Accept()`.
+ *
+ * This class is not thread-safe, the callers serialize access to it.
+ */
+class ParallelScanShards {
+ public:
+  ParallelScanShards(RowSet row_set, std::vector<RowKeySample> const& samples,
+                     std::size_t shard_count);
+
+  /// The number of shards, including any finished shards.
+  std::size_t size() const { return shards_.size(); }
+
+  /**
+   * Assign a shard to a new stream.
+   *
+   * Returns the pending shard with the smallest key. If there are no pending
+   * shards it splits a running shard. Returns an empty optional if there is
+   * no work left to assign.
+   */
+  optional<RowKeyType> Next();
+
+  /// The rows in shard @p id, i.e. the scanned row set restricted to the shard.
+  RowSet ShardRowSet(RowKeyType const& id) const;
+
+  /**
+   * Record that the stream for shard @p id received @p row_key.
+   *
+   * @returns false if the row belongs to a different shard, which happens
+   *     after @p id is split. The stream should stop without delivering the
+   *     row, it is read again as part of the new shard.
+   */
+  bool Accept(RowKeyType const& id, RowKeyType const& row_key);
+
+  /// Mark shard @p id as finished.
+  void Finish(RowKeyType const& id);
+
+  /// The first unfinished shard in key order, empty when the scan is done.
+  optional<RowKeyType> FirstUnfinished() const;
+
+ private:
+  enum class State { kPending, kRunning, kDone };
+  struct Shard {
+    RowKeyType end;
+    RowKeyType last_key;
+    bool has_rows;
+    State state;
+  };
+
+  void AddShard(RowKeyType begin, RowKeyType end, State state);
+  optional<RowKeyType> Split();
+
+  RowSet row_set_;
+  std::vector<RowKeyType> split_points_;
+  std::map<RowKeyType, Shard> shards_;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_PARALLEL_SCAN_SHARDS_H
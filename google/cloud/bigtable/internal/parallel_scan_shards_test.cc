@@ -0,0 +1,157 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/bigtable/internal/parallel_scan_shards.h"
+#include <gtest/gtest.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::vector<RowKeySample> Samples(
+    std::vector<std::pair<std::string, std::int64_t>> const& keys) {
+  std::vector<RowKeySample> samples;
+  for (auto const& k : keys) {
+    samples.push_back(RowKeySample{k.first, k.second});
+  }
+  return samples;
+}
+
+/// Assign the initial shards, without splitting any of them.
+std::vector<RowKeyType> AssignInitial(ParallelScanShards& shards) {
+  std::vector<RowKeyType> ids;
+  for (auto n = shards.size(); n != 0; --n) {
+    auto id = shards.Next();
+    if (!id) break;
+    ids.push_back(*id);
+  }
+  return ids;
+}
+
+TEST(ParallelScanShardsTest, NoSamples) {
+  ParallelScanShards shards(RowSet(), {}, 4);
+  EXPECT_EQ(1, shards.size());
+  EXPECT_EQ(std::vector<RowKeyType>{""}, AssignInitial(shards));
+
+  auto rows = shards.ShardRowSet("").as_proto();
+  EXPECT_EQ(1, rows.row_ranges_size());
+  EXPECT_EQ("", rows.row_ranges(0).start_key_closed());
+  EXPECT_EQ("", rows.row_ranges(0).end_key_open());
+
+  ASSERT_TRUE(shards.FirstUnfinished().has_value());
+  EXPECT_EQ("", *shards.FirstUnfinished());
+  shards.Finish("");
+  EXPECT_FALSE(shards.FirstUnfinished().has_value());
+}
+
+TEST(ParallelScanShardsTest, SplitByOffset) {
+  ParallelScanShards shards(
+      RowSet(), Samples({{"a", 100}, {"b", 200}, {"c", 300}, {"", 500}}), 2);
+  EXPECT_EQ(2, shards.size());
+  EXPECT_EQ((std::vector<RowKeyType>{"", "c"}), AssignInitial(shards));
+
+  auto rows = shards.ShardRowSet("").as_proto();
+  ASSERT_EQ(1, rows.row_ranges_size());
+  EXPECT_EQ("", rows.row_ranges(0).start_key_closed());
+  EXPECT_EQ("c", rows.row_ranges(0).end_key_open());
+  rows = shards.ShardRowSet("c").as_proto();
+  ASSERT_EQ(1, rows.row_ranges_size());
+  EXPECT_EQ("c", rows.row_ranges(0).start_key_closed());
+  EXPECT_EQ("", rows.row_ranges(0).end_key_open());
+}
+
+TEST(ParallelScanShardsTest, FewerSamplesThanShards) {
+  ParallelScanShards shards(RowSet(), Samples({{"n", 20}, {"k", 10}}), 8);
+  EXPECT_EQ(3, shards.size());
+  EXPECT_EQ((std::vector<RowKeyType>{"", "k", "n"}), AssignInitial(shards));
+}
+
+TEST(ParallelScanShardsTest, NoOffsets) {
+  ParallelScanShards shards(
+      RowSet(), Samples({{"a", 0}, {"b", 0}, {"c", 0}, {"d", 0}}), 2);
+  EXPECT_EQ(2, shards.size());
+  EXPECT_EQ((std::vector<RowKeyType>{"", "c"}), AssignInitial(shards));
+}
+
+TEST(ParallelScanShardsTest, SkipsEmptyShards) {
+  ParallelScanShards shards(RowSet(RowRange::Range("k1", "k9")),
+                            Samples({{"k", 10}, {"n", 20}}), 8);
+  EXPECT_EQ(std::vector<RowKeyType>{"k"}, AssignInitial(shards));
+
+  auto rows = shards.ShardRowSet("k").as_proto();
+  ASSERT_EQ(1, rows.row_ranges_size());
+  EXPECT_EQ("k1", rows.row_ranges(0).start_key_closed());
+  EXPECT_EQ("k9", rows.row_ranges(0).end_key_open());
+
+  ASSERT_TRUE(shards.FirstUnfinished().has_value());
+  EXPECT_EQ("k", *shards.FirstUnfinished());
+  shards.Finish("k");
+  EXPECT_FALSE(shards.FirstUnfinished().has_value());
+}
+
+TEST(ParallelScanShardsTest, ShardRowSetKeys) {
+  ParallelScanShards shards(RowSet("a", "m"), Samples({{"k", 10}}), 2);
+  auto rows = shards.ShardRowSet("").as_proto();
+  ASSERT_EQ(1, rows.row_keys_size());
+  EXPECT_EQ("a", rows.row_keys(0));
+  rows = shards.ShardRowSet("k").as_proto();
+  ASSERT_EQ(1, rows.row_keys_size());
+  EXPECT_EQ("m", rows.row_keys(0));
+}
+
+TEST(ParallelScanShardsTest, SplitRunningShard) {
+  ParallelScanShards shards(
+      RowSet(), Samples({{"b", 1}, {"c", 2}, {"d", 3}, {"e", 4}}), 1);
+  ASSERT_EQ(1, shards.size());
+  auto first = shards.Next();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ("", *first);
+  EXPECT_TRUE(shards.Accept("", "a"));
+
+  // There are no pending shards, the split uses the median split point.
+  auto second = shards.Next();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ("d", *second);
+  EXPECT_EQ(2, shards.size());
+  EXPECT_TRUE(shards.Accept("", "c"));
+  EXPECT_FALSE(shards.Accept("", "d"));
+  EXPECT_TRUE(shards.Accept("d", "d"));
+
+  // Only the split points after the last key received are considered.
+  auto third = shards.Next();
+  ASSERT_TRUE(third.has_value());
+  EXPECT_EQ("e", *third);
+  EXPECT_FALSE(shards.Next().has_value());
+
+  EXPECT_EQ("", *shards.FirstUnfinished());
+  shards.Finish("");
+  EXPECT_EQ("d", *shards.FirstUnfinished());
+}
+
+TEST(ParallelScanShardsTest, NoSplitAfterFinish) {
+  ParallelScanShards shards(RowSet(), Samples({{"b", 1}, {"c", 2}}), 1);
+  auto first = shards.Next();
+  ASSERT_TRUE(first.has_value());
+  shards.Finish(*first);
+  EXPECT_FALSE(shards.Next().has_value());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -86,13 +86,14 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
 
   // Last chunk in the cell has zero for value size
   if (chunk.value_size() == 0) {
-    if (cells_.empty()) {
+    if (cell_count_ == 0) {
       if (cell_.row.empty()) {
         status = grpc::Status(grpc::StatusCode::INTERNAL,
                               "Missing row key at last chunk in cell");
         return;
       }
       row_key_ = cell_.row;
+      if (build_views_) view_.SetRowKey(row_key_);
     } else {
       if (row_key_ != cell_.row) {
         status = grpc::Status(grpc::StatusCode::INTERNAL,
@@ -100,12 +101,24 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
         return;
       }
     }
-    cells_.emplace_back(MovePartialToCell());
+    if (build_views_) {
+      // The view copies the data into its buffer, keep the strings (and their
+      // capacity) in `cell_`.
+      view_.AddCell(cell_.family, cell_.column, cell_.timestamp, cell_.value,
+                    cell_.labels);
+      cell_.value.clear();
+      cell_.labels.clear();
+    } else {
+      cells_.emplace_back(MovePartialToCell());
+    }
+    ++cell_count_;
     cell_first_chunk_ = true;
   }
 
   if (chunk.reset_row()) {
     cells_.clear();
+    view_.Clear();
+    cell_count_ = 0;
     cell_ = {};
     if (!cell_first_chunk_) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
@@ -118,7 +131,7 @@ void ReadRowsParser::HandleChunk(ReadRowsResponse_CellChunk chunk,
                             "Commit row with an unfinished cell");
       return;
     }
-    if (cells_.empty()) {
+    if (cell_count_ == 0) {
       status = grpc::Status(grpc::StatusCode::INTERNAL,
                             "Commit row missing the row key");
       return;
@@ -143,7 +156,7 @@ void ReadRowsParser::HandleEndOfStream(grpc::Status& status) {
     return;
   }
 
-  if (cells_.begin() != cells_.end() && !row_ready_) {
+  if (cell_count_ != 0 && !row_ready_) {
     status = grpc::Status(grpc::StatusCode::INTERNAL,
                           "end of stream with unfinished row");
     return;
@@ -158,10 +171,36 @@ Row ReadRowsParser::Next(grpc::Status& status) {
         grpc::Status(grpc::StatusCode::INTERNAL, "Next with row not ready");
     return Row("", {});
   }
+  if (build_views_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "Next called on a parser building views");
+    return Row("", {});
+  }
   row_ready_ = false;
 
   Row row(std::move(row_key_), std::move(cells_));
   row_key_.clear();
+  cell_count_ = 0;
+
+  return row;
+}
+
+RowView ReadRowsParser::NextView(grpc::Status& status) {
+  if (!row_ready_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "NextView with row not ready");
+    return RowViewBuilder().Build();
+  }
+  if (!build_views_) {
+    status = grpc::Status(grpc::StatusCode::INTERNAL,
+                          "NextView called on a parser building rows");
+    return RowViewBuilder().Build();
+  }
+  row_ready_ = false;
+
+  RowView row = view_.Build();
+  row_key_.clear();
+  cell_count_ = 0;
 
   return row;
 }
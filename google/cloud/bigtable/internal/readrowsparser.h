@@ -16,7 +16,9 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_READROWSPARSER_H
 
 #include "google/cloud/bigtable/cell.h"
+#include "google/cloud/bigtable/internal/row_view_builder.h"
 #include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/row_view.h"
 #include "google/cloud/bigtable/version.h"
 #include "google/cloud/internal/make_unique.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
@@ -54,11 +56,13 @@ class ReadRowsParser {
   ReadRowsParser()
       : row_key_(""),
         cells_(),
+        cell_count_(0),
         cell_first_chunk_(true),
         cell_(),
         last_seen_row_key_(""),
         row_ready_(false),
-        end_of_stream_(false) {}
+        end_of_stream_(false),
+        build_views_(false) {}
 
   virtual ~ReadRowsParser() = default;
 
@@ -98,6 +102,21 @@ class ReadRowsParser {
    */
   virtual Row Next(grpc::Status& status);
 
+  /**
+   * Build the following rows as `RowView`s instead of `Row`s.
+   *
+   * Once called, the rows must be extracted using `NextView()`, and `Next()`
+   * returns an error. It should be called before handling any chunks.
+   */
+  virtual void BuildViews() { build_views_ = true; }
+
+  /**
+   * Extract the data in a row built as a `RowView`.
+   *
+   * Use HasNext() first to find out if there are rows available.
+   */
+  virtual RowView NextView(grpc::Status& status);
+
  private:
   /// Holds partially formed data until a full Row is ready.
   struct ParseCell {
@@ -124,6 +143,9 @@ class ReadRowsParser {
   /// Parsed cells of a yet unfinished row.
   std::vector<Cell> cells_;
 
+  /// Number of cells parsed in the yet unfinished row.
+  std::size_t cell_count_;
+
   /// Is the next incoming chunk the first in a cell?
   bool cell_first_chunk_;
 
@@ -138,6 +160,12 @@ class ReadRowsParser {
 
   /// Have we received the end of stream call?
   bool end_of_stream_;
+
+  /// If true the cells are accumulated in `view_` instead of `cells_`.
+  bool build_views_;
+
+  /// Accumulates the cells when building `RowView`s.
+  RowViewBuilder view_;
 };
 
 /// Factory for creating parser instances, defined for testability.
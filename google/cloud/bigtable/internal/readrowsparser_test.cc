@@ -133,6 +133,85 @@ TEST(ReadRowsParserTest, NextWithNoDataThrows) {
   EXPECT_FALSE(status.ok());
 }
 
+TEST(ReadRowsParserTest, SingleChunkViewSucceeds) {
+  using google::protobuf::TextFormat;
+  ReadRowsParser parser;
+  parser.BuildViews();
+  ReadRowsResponse_CellChunk chunk;
+  std::string chunk1 = R"(
+    row_key: "RK"
+    family_name: < value: "F">
+    qualifier: < value: "C">
+    timestamp_micros: 42
+    labels: "L"
+    value: "V"
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk1, &chunk));
+  grpc::Status status;
+  EXPECT_FALSE(parser.HasNext());
+  parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  EXPECT_TRUE(parser.HasNext());
+
+  auto row = parser.NextView(status);
+  EXPECT_TRUE(status.ok());
+  EXPECT_FALSE(parser.HasNext());
+  EXPECT_EQ("RK", row.row_key());
+  ASSERT_EQ(1U, row.cells().size());
+  auto const& cell = row.cells()[0];
+  EXPECT_EQ("RK", cell.row_key());
+  EXPECT_EQ("F", cell.family_name());
+  EXPECT_EQ("C", cell.column_qualifier());
+  EXPECT_EQ("V", cell.value());
+  EXPECT_EQ(42, cell.timestamp().count());
+  ASSERT_EQ(1U, cell.labels().size());
+  EXPECT_EQ("L", cell.labels()[0]);
+
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+}
+
+TEST(ReadRowsParserTest, NextAndNextViewMismatchFails) {
+  using google::protobuf::TextFormat;
+  ReadRowsResponse_CellChunk chunk;
+  std::string chunk1 = R"(
+    row_key: "RK"
+    family_name: < value: "F">
+    qualifier: < value: "C">
+    timestamp_micros: 42
+    value: "V"
+    commit_row: true
+    )";
+  ASSERT_TRUE(TextFormat::ParseFromString(chunk1, &chunk));
+
+  ReadRowsParser rows_parser;
+  grpc::Status status;
+  rows_parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  rows_parser.NextView(status);
+  EXPECT_FALSE(status.ok());
+
+  ReadRowsParser views_parser;
+  views_parser.BuildViews();
+  status = grpc::Status();
+  views_parser.HandleChunk(chunk, status);
+  EXPECT_TRUE(status.ok());
+  views_parser.Next(status);
+  EXPECT_FALSE(status.ok());
+}
+
+TEST(ReadRowsParserTest, NextViewWithNoDataThrows) {
+  ReadRowsParser parser;
+  parser.BuildViews();
+  grpc::Status status;
+  parser.HandleEndOfStream(status);
+  EXPECT_TRUE(status.ok());
+  EXPECT_FALSE(parser.HasNext());
+  parser.NextView(status);
+  EXPECT_FALSE(status.ok());
+}
+
 // **** Acceptance tests helpers ****
 
 namespace google {
@@ -168,13 +247,9 @@ std::string CellToString(Cell const& cell) {
 class AcceptanceTest : public ::testing::Test {
  protected:
   std::vector<std::string> ExtractCells() {
-    std::vector<std::string> cells;
-
-    for (auto const& r : rows_) {
-      std::transform(r.cells().begin(), r.cells().end(),
-                     std::back_inserter(cells),
-                     google::cloud::bigtable::CellToString);
-    }
+    auto cells = CellStrings(rows_);
+    // The parser must produce the same results when building views.
+    EXPECT_EQ(cells, CellStrings(view_rows_));
     return cells;
   }
 
@@ -195,30 +270,57 @@ class AcceptanceTest : public ::testing::Test {
   }
 
   google::cloud::Status FeedChunks(
-      std::vector<ReadRowsResponse_CellChunk> chunks) {
+      std::vector<ReadRowsResponse_CellChunk> const& chunks) {
+    auto status = Feed(parser_, false, chunks, rows_);
+    view_parser_.BuildViews();
+    auto view_status = Feed(view_parser_, true, chunks, view_rows_);
+    EXPECT_EQ(status.code(), view_status.code());
+    return status;
+  }
+
+ private:
+  static std::vector<std::string> CellStrings(
+      std::vector<google::cloud::bigtable::Row> const& rows) {
+    std::vector<std::string> cells;
+
+    for (auto const& r : rows) {
+      std::transform(r.cells().begin(), r.cells().end(),
+                     std::back_inserter(cells),
+                     google::cloud::bigtable::CellToString);
+    }
+    return cells;
+  }
+
+  static google::cloud::Status Feed(
+      ReadRowsParser& parser, bool views,
+      std::vector<ReadRowsResponse_CellChunk> const& chunks,
+      std::vector<google::cloud::bigtable::Row>& rows) {
     grpc::Status status;
     for (auto const& chunk : chunks) {
-      parser_.HandleChunk(chunk, status);
+      parser.HandleChunk(chunk, status);
       if (!status.ok()) {
         return ::google::cloud::MakeStatusFromRpcError(status);
       }
-      if (parser_.HasNext()) {
-        rows_.emplace_back(parser_.Next(status));
+      if (parser.HasNext()) {
+        // Views are converted to `Row` to compare the results.
+        rows.emplace_back(views ? parser.NextView(status).ToRow()
+                                : parser.Next(status));
         if (!status.ok()) {
           return ::google::cloud::MakeStatusFromRpcError(status);
         }
       }
     }
-    parser_.HandleEndOfStream(status);
+    parser.HandleEndOfStream(status);
     if (!status.ok()) {
       return ::google::cloud::MakeStatusFromRpcError(status);
     }
     return google::cloud::Status{};
   }
 
- private:
   ReadRowsParser parser_;
   std::vector<google::cloud::bigtable::Row> rows_;
+  ReadRowsParser view_parser_;
+  std::vector<google::cloud::bigtable::Row> view_rows_;
 };
 
 // Auto-generated acceptance tests
@@ -0,0 +1,115 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_view_builder.h"
+#include <algorithm>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+
+void RowViewBuilder::SetRowKey(std::string const& row_key) {
+  if (buffer_.capacity() < size_hint_) buffer_.reserve(size_hint_);
+  row_key_ = Append(row_key);
+}
+
+void RowViewBuilder::AddCell(std::string const& family_name,
+                             std::string const& column_qualifier,
+                             std::int64_t timestamp, std::string const& value,
+                             std::vector<std::string> const& labels) {
+  // Rows rarely have more than a handful of column families, a linear search
+  // is faster than any associative container.
+  auto f = std::find_if(family_names_.begin(), family_names_.end(),
+                        [this, &family_name](Span s) {
+                          return Equals(s, family_name);
+                        });
+  Span family;
+  if (f != family_names_.end()) {
+    family = *f;
+  } else {
+    family = Append(family_name);
+    family_names_.push_back(family);
+  }
+
+  if (!has_column_qualifier_ ||
+      !Equals(column_qualifier_, column_qualifier)) {
+    column_qualifier_ = Append(column_qualifier);
+    has_column_qualifier_ = true;
+  }
+
+  auto const labels_begin = labels_.size();
+  for (auto const& l : labels) {
+    labels_.push_back(Append(l));
+  }
+  cells_.push_back(PendingCell{family, column_qualifier_, timestamp,
+                               Append(value), labels_begin, labels_.size()});
+}
+
+void RowViewBuilder::Clear() {
+  buffer_.clear();
+  row_key_ = {0, 0};
+  family_names_.clear();
+  column_qualifier_ = {0, 0};
+  has_column_qualifier_ = false;
+  labels_.clear();
+  cells_.clear();
+}
+
+RowView RowViewBuilder::Build() {
+  size_hint_ = buffer_.size();
+  // The views must be created once the buffer is in its final location, as
+  // moving a `std::string` may move its data too (e.g. with small strings).
+  auto buffer = std::make_shared<std::string const>(std::move(buffer_));
+  char const* base = buffer->data();
+  auto ref = [base](Span s) {
+    return grpc::string_ref(base + s.offset, s.size);
+  };
+
+  std::vector<CellView> cells;
+  cells.reserve(cells_.size());
+  for (auto const& c : cells_) {
+    std::vector<grpc::string_ref> labels;
+    if (c.labels_begin != c.labels_end) {
+      labels.reserve(c.labels_end - c.labels_begin);
+      for (auto i = c.labels_begin; i != c.labels_end; ++i) {
+        labels.push_back(ref(labels_[i]));
+      }
+    }
+    cells.emplace_back(ref(row_key_), ref(c.family_name),
+                       ref(c.column_qualifier), c.timestamp, ref(c.value),
+                       std::move(labels));
+  }
+  RowView row(std::move(buffer), ref(row_key_), std::move(cells));
+  Clear();
+  return row;
+}
+
+RowViewBuilder::Span RowViewBuilder::Append(std::string const& data) {
+  Span span{buffer_.size(), data.size()};
+  buffer_.append(data);
+  return span;
+}
+
+bool RowViewBuilder::Equals(Span span, std::string const& data) const {
+  return buffer_.compare(span.offset, span.size, data) == 0;
+}
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,94 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_VIEW_BUILDER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_VIEW_BUILDER_H
+
+#include "google/cloud/bigtable/row_view.h"
+#include "google/cloud/bigtable/version.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+/**
+ * Accumulates the cells of a row into a single buffer and creates a `RowView`.
+ *
+ * The row key is stored once. Family names are stored once per row, and
+ * consecutive cells with the same column qualifier (i.e., multiple versions of
+ * a column) share the qualifier. The buffer for each row is reserved using the
+ * size of the previous row as a hint, so in a scan with rows of similar size
+ * each row requires a single allocation for its data.
+ */
+class RowViewBuilder {
+ public:
+  RowViewBuilder() = default;
+
+  /// Set the row key, must be called before adding any cells.
+  void SetRowKey(std::string const& row_key);
+
+  /// Add a cell to the current row.
+  void AddCell(std::string const& family_name,
+               std::string const& column_qualifier, std::int64_t timestamp,
+               std::string const& value,
+               std::vector<std::string> const& labels);
+
+  /// True if there are no cells in the current row.
+  bool empty() const { return cells_.empty(); }
+
+  /// Discard the current row.
+  void Clear();
+
+  /// Create a `RowView` with the current row and start a new row.
+  RowView Build();
+
+ private:
+  struct Span {
+    std::size_t offset;
+    std::size_t size;
+  };
+  struct PendingCell {
+    Span family_name;
+    Span column_qualifier;
+    std::int64_t timestamp;
+    Span value;
+    std::size_t labels_begin;
+    std::size_t labels_end;
+  };
+
+  Span Append(std::string const& data);
+  bool Equals(Span span, std::string const& data) const;
+
+  std::string buffer_;
+  Span row_key_ = {0, 0};
+  std::vector<Span> family_names_;
+  Span column_qualifier_ = {0, 0};
+  bool has_column_qualifier_ = false;
+  std::vector<Span> labels_;
+  std::vector<PendingCell> cells_;
+  std::size_t size_hint_ = 0;
+};
+
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_INTERNAL_ROW_VIEW_BUILDER_H
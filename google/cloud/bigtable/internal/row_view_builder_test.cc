@@ -0,0 +1,127 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/internal/row_view_builder.h"
+#include <gtest/gtest.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace internal {
+namespace {
+
+TEST(RowViewBuilderTest, Simple) {
+  RowViewBuilder builder;
+  EXPECT_TRUE(builder.empty());
+  builder.SetRowKey("r1");
+  builder.AddCell("fam", "col", 1000, "value", {});
+  EXPECT_FALSE(builder.empty());
+
+  auto row = builder.Build();
+  EXPECT_TRUE(builder.empty());
+  EXPECT_EQ("r1", row.row_key());
+  ASSERT_EQ(1, row.cells().size());
+  auto const& cell = row.cells()[0];
+  EXPECT_EQ("r1", cell.row_key());
+  EXPECT_EQ("fam", cell.family_name());
+  EXPECT_EQ("col", cell.column_qualifier());
+  EXPECT_EQ(std::chrono::microseconds(1000), cell.timestamp());
+  EXPECT_EQ("value", cell.value());
+  EXPECT_TRUE(cell.labels().empty());
+}
+
+TEST(RowViewBuilderTest, InternsKeysFamiliesAndQualifiers) {
+  RowViewBuilder builder;
+  builder.SetRowKey("r1");
+  builder.AddCell("fam1", "col1", 2000, "v1", {});
+  builder.AddCell("fam1", "col1", 1000, "v2", {});
+  builder.AddCell("fam1", "col2", 1000, "v3", {});
+  builder.AddCell("fam2", "col1", 1000, "v4", {});
+  builder.AddCell("fam1", "col1", 1000, "v5", {});
+
+  auto row = builder.Build();
+  auto const& cells = row.cells();
+  ASSERT_EQ(5, cells.size());
+  for (auto const& c : cells) {
+    EXPECT_EQ(row.row_key().data(), c.row_key().data());
+  }
+  // Family names are stored once per row.
+  EXPECT_EQ(cells[0].family_name().data(), cells[1].family_name().data());
+  EXPECT_EQ(cells[0].family_name().data(), cells[2].family_name().data());
+  EXPECT_NE(cells[0].family_name().data(), cells[3].family_name().data());
+  EXPECT_EQ(cells[0].family_name().data(), cells[4].family_name().data());
+  EXPECT_EQ("fam2", cells[3].family_name());
+  // Consecutive cells share the column qualifier.
+  EXPECT_EQ(cells[0].column_qualifier().data(),
+            cells[1].column_qualifier().data());
+  EXPECT_EQ("col2", cells[2].column_qualifier());
+  EXPECT_EQ("col1", cells[3].column_qualifier());
+  std::vector<std::string> values;
+  for (auto const& c : cells) {
+    values.emplace_back(c.value().data(), c.value().size());
+  }
+  EXPECT_EQ((std::vector<std::string>{"v1", "v2", "v3", "v4", "v5"}), values);
+}
+
+TEST(RowViewBuilderTest, Labels) {
+  RowViewBuilder builder;
+  builder.SetRowKey("r1");
+  builder.AddCell("fam", "col1", 1000, "v1", {"l1", "l2"});
+  builder.AddCell("fam", "col2", 1000, "v2", {});
+  builder.AddCell("fam", "col3", 1000, "v3", {"l3"});
+
+  auto row = builder.Build();
+  auto const& cells = row.cells();
+  ASSERT_EQ(3, cells.size());
+  ASSERT_EQ(2, cells[0].labels().size());
+  EXPECT_EQ("l1", cells[0].labels()[0]);
+  EXPECT_EQ("l2", cells[0].labels()[1]);
+  EXPECT_TRUE(cells[1].labels().empty());
+  ASSERT_EQ(1, cells[2].labels().size());
+  EXPECT_EQ("l3", cells[2].labels()[0]);
+}
+
+TEST(RowViewBuilderTest, ClearAndMultipleRows) {
+  RowViewBuilder builder;
+  builder.SetRowKey("discarded");
+  builder.AddCell("fam", "col", 1000, "discarded", {});
+  builder.Clear();
+  EXPECT_TRUE(builder.empty());
+
+  builder.SetRowKey("r1");
+  builder.AddCell("fam", "col", 1000, std::string(1024, 'a'), {});
+  auto r1 = builder.Build();
+
+  builder.SetRowKey("r2");
+  builder.AddCell("fam", "col", 1000, "b", {});
+  auto r2 = builder.Build();
+
+  // Each row owns its buffer, building a row does not invalidate others.
+  EXPECT_EQ("r1", r1.row_key());
+  ASSERT_EQ(1, r1.cells().size());
+  EXPECT_EQ("fam", r1.cells()[0].family_name());
+  EXPECT_EQ(std::string(1024, 'a'), r1.cells()[0].value());
+  EXPECT_EQ("r2", r2.row_key());
+  ASSERT_EQ(1, r2.cells().size());
+  EXPECT_EQ("col", r2.cells()[0].column_qualifier());
+  EXPECT_EQ("b", r2.cells()[0].value());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
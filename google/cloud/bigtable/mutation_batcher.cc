@@ -15,6 +15,7 @@
 #include "google/cloud/bigtable/mutation_batcher.h"
 #include "google/cloud/bigtable/internal/client_options_defaults.h"
 #include "google/cloud/grpc_error_delegate.h"
+#include <algorithm>
 #include <sstream>
 
 namespace google {
@@ -31,12 +32,20 @@ auto constexpr kDefaultMaxSizePerBatch =
 auto constexpr kDefaultMaxBatches = 8;
 auto constexpr kDefaultMaxOutstandingSize =
     kDefaultMaxSizePerBatch * kDefaultMaxBatches;
+auto constexpr kDefaultTargetBatchLatency = std::chrono::milliseconds(500);
+// With adaptive flow control batches do not shrink below this fraction of
+// `max_size_per_batch`, and grow back in steps of this fraction.
+auto constexpr kMinBatchSizeDivisor = 64;
+auto constexpr kBatchSizeIncreaseDivisor = 8;
 
 MutationBatcher::Options::Options()
     : max_mutations_per_batch(kBigtableMutationLimit),
       max_size_per_batch(kDefaultMaxSizePerBatch),
       max_batches(kDefaultMaxBatches),
-      max_outstanding_size(kDefaultMaxOutstandingSize) {}
+      max_outstanding_size(kDefaultMaxOutstandingSize),
+      adaptive_flow_control(false),
+      target_batch_latency(kDefaultTargetBatchLatency),
+      linger(0) {}
 
 std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
     CompletionQueue& cq, SingleRowMutation mut) {
@@ -66,6 +75,9 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
 
   if (!CanAppendToBatch(pending)) {
     pending_mutations_.push(std::move(pending));
+    // With a linger the current batch may be waiting for more mutations, this
+    // one does not fit, so send the batch if possible.
+    if (options_.linger.count() != 0) SatisfyPromises(TryAdmit(cq), lk);
     return res;
   }
   std::vector<AdmissionPromise> admission_promises_to_satisfy;
@@ -79,7 +91,7 @@ std::pair<future<void>, future<Status>> MutationBatcher::AsyncApply(
 
 future<void> MutationBatcher::AsyncWaitForNoPendingRequests() {
   std::unique_lock<std::mutex> lk(mu_);
-  if (num_requests_pending_ == 0) {
+  if (num_requests_pending_ == 0 && num_linger_timers_ == 0) {
     return make_ready_future();
   }
   no_more_pending_promises_.emplace_back();
@@ -127,21 +139,43 @@ grpc::Status MutationBatcher::IsValid(PendingSingleRowMutation& mut) const {
 }
 
 bool MutationBatcher::HasSpaceFor(PendingSingleRowMutation const& mut) const {
+  // A valid mutation always fits in an empty batch, even if adaptive flow
+  // control reduced the batch size below the mutation size.
   return outstanding_size_ + mut.request_size <=
              options_.max_outstanding_size &&
-         cur_batch_->requests_size + mut.request_size <=
-             options_.max_size_per_batch &&
+         (cur_batch_->num_mutations == 0 ||
+          cur_batch_->requests_size + mut.request_size <= MaxSizePerBatch()) &&
          cur_batch_->num_mutations + mut.num_mutations <=
              options_.max_mutations_per_batch;
 }
 
+std::size_t MutationBatcher::MaxBatches() const {
+  if (!options_.adaptive_flow_control) return options_.max_batches;
+  return (std::min)(options_.max_batches,
+                    static_cast<std::size_t>(batch_window_));
+}
+
+std::size_t MutationBatcher::MaxSizePerBatch() const {
+  if (!options_.adaptive_flow_control) return options_.max_size_per_batch;
+  return batch_size_limit_;
+}
+
+bool MutationBatcher::IsReadyToSend() const {
+  if (options_.linger.count() == 0 || cur_batch_->linger_expired) return true;
+  // A pending mutation did not fit, the batch will not grow any further.
+  if (!pending_mutations_.empty()) return true;
+  return cur_batch_->requests_size >= MaxSizePerBatch() ||
+         cur_batch_->num_mutations >= options_.max_mutations_per_batch;
+}
+
 bool MutationBatcher::FlushIfPossible(CompletionQueue cq) {
-  if (cur_batch_->num_mutations > 0 &&
-      num_outstanding_batches_ < options_.max_batches) {
+  if (cur_batch_->num_mutations == 0) return false;
+  if (num_outstanding_batches_ < MaxBatches() && IsReadyToSend()) {
     ++num_outstanding_batches_;
 
-    auto batch = std::make_shared<Batch>();
+    auto batch = std::make_shared<Batch>(next_batch_id_++);
     cur_batch_.swap(batch);
+    batch->sent_at = std::chrono::steady_clock::now();
     table_.AsyncBulkApply(std::move(batch->requests), cq)
         .then([this, cq,
                batch](future<std::vector<FailedMutation>> failed) mutable {
@@ -149,9 +183,39 @@ bool MutationBatcher::FlushIfPossible(CompletionQueue cq) {
         });
     return true;
   }
+  if (options_.linger.count() != 0 && !cur_batch_->linger_timer_started) {
+    StartLingerTimer(cq);
+  }
   return false;
 }
 
+void MutationBatcher::StartLingerTimer(CompletionQueue& cq) {
+  cur_batch_->linger_timer_started = true;
+  ++num_linger_timers_;
+  auto const batch_id = cur_batch_->id;
+  cq.MakeRelativeTimer(options_.linger)
+      .then([this, cq, batch_id](
+                future<StatusOr<std::chrono::system_clock::time_point>>
+                    result) mutable {
+        OnLingerExpired(std::move(cq), batch_id, result.get().ok());
+      });
+}
+
+void MutationBatcher::OnLingerExpired(CompletionQueue cq,
+                                      std::uint64_t batch_id, bool expired) {
+  std::unique_lock<std::mutex> lk(mu_);
+  --num_linger_timers_;
+  // Timers are cancelled when the completion queue shuts down, do not start
+  // new requests in that case.
+  if (!expired) {
+    SatisfyPromises({}, lk);  // unlocks the lock
+    return;
+  }
+  // The batch may have been sent already, because it filled up.
+  if (cur_batch_->id == batch_id) cur_batch_->linger_expired = true;
+  SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
+}
+
 void MutationBatcher::OnBulkApplyDone(
     CompletionQueue cq, MutationBatcher::Batch batch,
     std::vector<FailedMutation> const& failed) {
@@ -181,14 +245,56 @@ void MutationBatcher::OnBulkApplyDone(
   }
   auto const num_mutations = batch.mutation_data.size();
   batch.mutation_data.clear();
+  bool const throttled =
+      std::any_of(failed.begin(), failed.end(), [](FailedMutation const& f) {
+        return f.status().code() == StatusCode::kResourceExhausted;
+      });
 
   std::unique_lock<std::mutex> lk(mu_);
   outstanding_size_ -= batch.requests_size;
   num_requests_pending_ -= num_mutations;
   num_outstanding_batches_--;
+  if (options_.adaptive_flow_control) {
+    UpdateFlowControl(batch.sent_at, throttled);
+  }
   SatisfyPromises(TryAdmit(cq), lk);  // unlocks the lock
 }
 
+void MutationBatcher::UpdateFlowControl(
+    std::chrono::steady_clock::time_point sent_at, bool throttled) {
+  auto const now = std::chrono::steady_clock::now();
+  if (throttled || now - sent_at > options_.target_batch_latency) {
+    // Batches sent before the last back off likely saw the same overload, back
+    // off at most once for all of them.
+    if (sent_at < last_backoff_) return;
+    last_backoff_ = now;
+    slow_start_ = false;
+    if (batch_window_ >= 2.0) {
+      batch_window_ /= 2.0;
+      return;
+    }
+    batch_window_ = 1.0;
+    auto const min_size = (std::max)(
+        std::size_t{1}, options_.max_size_per_batch / kMinBatchSizeDivisor);
+    batch_size_limit_ = (std::max)(min_size, batch_size_limit_ / 2);
+    return;
+  }
+  // Recover the batch size before sending more batches in parallel.
+  if (batch_size_limit_ < options_.max_size_per_batch) {
+    auto const step =
+        (std::max)(std::size_t{1},
+                   options_.max_size_per_batch / kBatchSizeIncreaseDivisor);
+    batch_size_limit_ =
+        (std::min)(options_.max_size_per_batch, batch_size_limit_ + step);
+    return;
+  }
+  // Like TCP, grow exponentially until the first back off, and by about one
+  // batch for each round of outstanding batches after that.
+  batch_window_ += slow_start_ ? 1.0 : 1.0 / batch_window_;
+  batch_window_ =
+      (std::min)(batch_window_, static_cast<double>(options_.max_batches));
+}
+
 std::vector<MutationBatcher::AdmissionPromise> MutationBatcher::TryAdmit(
     CompletionQueue& cq) {
   // Defer satisfying promises until we release the lock.
@@ -218,12 +324,14 @@ void MutationBatcher::SatisfyPromises(
     std::vector<AdmissionPromise> admission_promises,
     std::unique_lock<std::mutex>& lk) {
   std::vector<NoMorePendingPromise> no_more_pending_promises;
-  if (num_requests_pending_ == 0 && num_outstanding_batches_ == 0) {
+  if (num_requests_pending_ == 0 && num_outstanding_batches_ == 0 &&
+      num_linger_timers_ == 0) {
     // We should wait not only on num_requests_pending_ being zero but also on
     // num_outstanding_batches_ because we want to allow the user to kill the
     // completion queue after this promise is fulfilled. Otherwise, the user can
     // destroy the completion queue while the last batch is still being
-    // processed - we've had this bug (#2140).
+    // processed - we've had this bug (#2140). Linger timers also use the
+    // completion queue.
     no_more_pending_promises_.swap(no_more_pending_promises);
   }
   lk.unlock();
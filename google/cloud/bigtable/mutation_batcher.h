@@ -23,6 +23,8 @@
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/status.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
+#include <chrono>
+#include <cstdint>
 #include <deque>
 #include <functional>
 #include <memory>
@@ -45,6 +47,10 @@ inline namespace BIGTABLE_CLIENT_NS {
  * This class also offers an easy-to-use flow control mechanism to avoid
  * unbounded growth in its internal buffers.
  *
+ * Optionally, objects of this class adapt the number of batches in flight,
+ * and their size, to the load the service accepts, see
+ * `Options::SetAdaptiveFlowControl()`.
+ *
  * Applications must provide a `CompletionQueue` to (asynchronously) execute
  * these operations. The application is responsible of executing the
  * `CompletionQueue` event loop in one or more threads.
@@ -79,10 +85,53 @@ class MutationBatcher {
       return *this;
     }
 
+    /**
+     * Adapt the number of outstanding batches and their size to the service.
+     *
+     * The batcher starts with a single outstanding batch and, while batches
+     * complete within `target_batch_latency`, it sends more of them in
+     * parallel, up to `max_batches`. A batch with a `RESOURCE_EXHAUSTED`
+     * failure, or slower than `target_batch_latency`, halves the number of
+     * outstanding batches. Once that number is down to one, it halves the
+     * size of the batches instead. This is an additive-increase,
+     * multiplicative-decrease (AIMD) scheme, like TCP congestion control.
+     *
+     * With this option `max_batches` and `max_size_per_batch` are upper bounds,
+     * applications typically set `max_batches` higher than the default.
+     */
+    Options& SetAdaptiveFlowControl(bool adaptive_flow_control_arg) {
+      adaptive_flow_control = adaptive_flow_control_arg;
+      return *this;
+    }
+
+    /// The latency above which a batch signals overload, when adaptive.
+    Options& SetTargetBatchLatency(
+        std::chrono::milliseconds target_batch_latency_arg) {
+      target_batch_latency = target_batch_latency_arg;
+      return *this;
+    }
+
+    /**
+     * How long a partially filled batch waits for more mutations.
+     *
+     * By default a batch is sent as soon as the number of outstanding batches
+     * allows it. With a non-zero linger a batch is sent once it is full, or
+     * once it waited this long, which sends fewer, larger batches.
+     * `AsyncWaitForNoPendingRequests()` also waits for the linger timers,
+     * which use the completion queue.
+     */
+    Options& SetLinger(std::chrono::milliseconds linger_arg) {
+      linger = linger_arg;
+      return *this;
+    }
+
     std::size_t max_mutations_per_batch;
     std::size_t max_size_per_batch;
     std::size_t max_batches;
     std::size_t max_outstanding_size;
+    bool adaptive_flow_control;
+    std::chrono::milliseconds target_batch_latency;
+    std::chrono::milliseconds linger;
   };
 
   explicit MutationBatcher(Table table, Options options = Options())
@@ -91,7 +140,12 @@ class MutationBatcher {
         num_outstanding_batches_(),
         outstanding_size_(),
         num_requests_pending_(),
-        cur_batch_(std::make_shared<Batch>()) {}
+        num_linger_timers_(),
+        next_batch_id_(1),
+        cur_batch_(std::make_shared<Batch>(0)),
+        batch_window_(1.0),
+        batch_size_limit_(options_.max_size_per_batch),
+        slow_start_(true) {}
 
   /**
    * Asynchronously apply mutation.
@@ -209,12 +263,21 @@ class MutationBatcher {
    * another attempt before invoking callbacks for the previous one.
    */
   struct Batch {
-    Batch() : num_mutations(), requests_size() {}
-
+    explicit Batch(std::uint64_t id_arg)
+        : id(id_arg),
+          num_mutations(),
+          requests_size(),
+          linger_timer_started(),
+          linger_expired() {}
+
+    std::uint64_t id;
     size_t num_mutations;
     size_t requests_size;
     BulkMutation requests;
     std::vector<MutationData> mutation_data;
+    bool linger_timer_started;
+    bool linger_expired;
+    std::chrono::steady_clock::time_point sent_at;
   };
 
   /// Check if a mutation doesn't exceed allowed limits.
@@ -238,16 +301,39 @@ class MutationBatcher {
     return pending_mutations_.empty() && HasSpaceFor(mut);
   }
 
+  /// The current limit on outstanding batches.
+  std::size_t MaxBatches() const;
+
+  /// The current limit on the size of a batch.
+  std::size_t MaxSizePerBatch() const;
+
+  /**
+   * Check if the currently constructed batch should be sent, rather than wait
+   * for more mutations.
+   */
+  bool IsReadyToSend() const;
+
   /**
    * Send the currently constructed batch if there are not too many outstanding
    * already. If there are no mutations in the batch, it's a noop.
    */
   bool FlushIfPossible(CompletionQueue cq);
 
+  /// Send the currently constructed batch once the linger expires.
+  void StartLingerTimer(CompletionQueue& cq);
+
+  /// Handle an expired linger timer for the batch with id @p batch_id.
+  void OnLingerExpired(CompletionQueue cq, std::uint64_t batch_id,
+                       bool expired);
+
   /// Handle a completed batch.
   void OnBulkApplyDone(CompletionQueue cq, MutationBatcher::Batch batch,
                        std::vector<FailedMutation> const& failed);
 
+  /// Adapt the limits to the latency and result of a completed batch.
+  void UpdateFlowControl(std::chrono::steady_clock::time_point sent_at,
+                         bool throttled);
+
   /**
    * Try to move mutations waiting in `pending_mutations_` to the currently
    * constructed batch.
@@ -278,10 +364,22 @@ class MutationBatcher {
   size_t outstanding_size_;
   // Number of uncompleted SingleRowMutations (including not admitted).
   size_t num_requests_pending_;
+  /// Num linger timers started but not expired.
+  size_t num_linger_timers_;
+  /// The id for the next batch, used to match linger timers to batches.
+  std::uint64_t next_batch_id_;
 
   /// Currently contructed batch of mutations.
   std::shared_ptr<Batch> cur_batch_;
 
+  //@{
+  /// @name Adaptive flow control state, see `Options::adaptive_flow_control`.
+  double batch_window_;
+  std::size_t batch_size_limit_;
+  bool slow_start_;
+  std::chrono::steady_clock::time_point last_backoff_;
+  //@}
+
   /**
    * These are the mutations which have not been admitted yet. If the user is
    * properly reacting to `admission_promise`s, there should be very few of
@@ -22,6 +22,7 @@
 #include "google/cloud/testing_util/mock_completion_queue.h"
 #include <google/protobuf/util/message_differencer.h>
 #include <gmock/gmock.h>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -45,14 +46,17 @@ std::size_t MutationSize(SingleRowMutation mut) {
 struct ResultPiece {
   ResultPiece(std::vector<int> succeeded_mutations,
               std::vector<int> transiently_failed_mutations,
-              std::vector<int> permanently_failed_mutations)
+              std::vector<int> permanently_failed_mutations,
+              std::vector<int> throttled_mutations = {})
       : succeeded(std::move(succeeded_mutations)),
         transiently_failed(std::move(transiently_failed_mutations)),
-        permanently_failed(std::move(permanently_failed_mutations)) {}
+        permanently_failed(std::move(permanently_failed_mutations)),
+        throttled(std::move(throttled_mutations)) {}
 
   std::vector<int> succeeded;
   std::vector<int> transiently_failed;
   std::vector<int> permanently_failed;
+  std::vector<int> throttled;
 };
 
 struct Exchange {
@@ -122,6 +126,11 @@ auto generate_response_generator = [](ResultPiece const& result_piece) {
       e.set_index(idx);
       e.mutable_status()->set_code(grpc::StatusCode::PERMISSION_DENIED);
     }
+    for (int idx : result_piece.throttled) {
+      auto& e = *r->add_entries();
+      e.set_index(idx);
+      e.mutable_status()->set_code(grpc::StatusCode::RESOURCE_EXHAUSTED);
+    }
   };
 };
 
@@ -255,6 +264,20 @@ TEST(OptionsTest, Trivial) {
   ASSERT_EQ(4, opt.max_outstanding_size);
 }
 
+TEST(OptionsTest, FlowControl) {
+  MutationBatcher::Options defaults;
+  EXPECT_FALSE(defaults.adaptive_flow_control);
+  EXPECT_EQ(0, defaults.linger.count());
+
+  MutationBatcher::Options opt = MutationBatcher::Options()
+                                     .SetAdaptiveFlowControl(true)
+                                     .SetTargetBatchLatency(5_ms)
+                                     .SetLinger(6_ms);
+  EXPECT_TRUE(opt.adaptive_flow_control);
+  EXPECT_EQ(5_ms, opt.target_batch_latency);
+  EXPECT_EQ(6_ms, opt.linger);
+}
+
 TEST_F(MutationBatcherTest, TrivialTest) {
   std::vector<SingleRowMutation> mutations(
       {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")})});
@@ -659,6 +682,179 @@ TEST_F(MutationBatcherTest, WaitForNoPendingEdgeCases) {
   EXPECT_EQ(no_more_pending2.wait_for(1_ms), std::future_status::ready);
 }
 
+// Test that with a linger partially filled batches wait for more mutations.
+TEST_F(MutationBatcherTest, LingerWaitsForFullBatches) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("baz", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+
+  batcher_.reset(new MutationBatcher(
+      table_,
+      MutationBatcher::Options().SetMaxMutationsPerBatch(2).SetLinger(10_ms)));
+
+  ExpectInteraction(
+      {{{mutations[0]}, {ResultPiece({0}, {}, {})}},
+       {{mutations[1], mutations[2]}, {ResultPiece({0, 1}, {}, {})}}});
+
+  // The batch waits for the linger timer.
+  auto state0 = Apply(mutations[0]);
+  EXPECT_TRUE(state0->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishTimer();
+  EXPECT_EQ(1, NumOperationsOutstanding());
+  FinishSingleItemStream();
+  EXPECT_TRUE(state0->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+
+  // A full batch does not wait for the timer.
+  auto state1 = Apply(mutations[1]);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+  auto state2 = Apply(mutations[2]);
+  EXPECT_EQ(2, NumOperationsOutstanding());
+
+  auto no_more_pending = batcher_->AsyncWaitForNoPendingRequests();
+  // This also expires the timer, which finds no batch to send.
+  FinishSingleItemStream();
+  EXPECT_TRUE(state1->completed);
+  EXPECT_TRUE(state2->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+  EXPECT_EQ(no_more_pending.wait_for(1_ms), std::future_status::ready);
+}
+
+// Test that adaptive flow control sends more batches while they succeed.
+TEST_F(MutationBatcherTest, AdaptiveFlowControlGrows) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("baz", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+
+  batcher_.reset(new MutationBatcher(table_, MutationBatcher::Options()
+                                                 .SetAdaptiveFlowControl(true)
+                                                 .SetMaxBatches(4)
+                                                 .SetMaxMutationsPerBatch(1)));
+
+  ExpectInteraction({Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+                     Exchange({mutations[1]}, {ResultPiece({0}, {}, {})}),
+                     Exchange({mutations[2]}, {ResultPiece({0}, {}, {})})});
+
+  // It starts with a single outstanding batch.
+  auto state0 = Apply(mutations[0]);
+  auto state1 = Apply(mutations[1]);
+  EXPECT_TRUE(state1->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state0->completed);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  // After a successful batch it allows two.
+  auto state2 = Apply(mutations[2]);
+  EXPECT_EQ(2, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state1->completed);
+  EXPECT_TRUE(state2->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+// Test that adaptive flow control sends fewer batches when throttled.
+TEST_F(MutationBatcherTest, AdaptiveFlowControlBacksOffWhenThrottled) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("bar", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("baz", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("qux", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+
+  batcher_.reset(new MutationBatcher(table_, MutationBatcher::Options()
+                                                 .SetAdaptiveFlowControl(true)
+                                                 .SetMaxBatches(4)
+                                                 .SetMaxMutationsPerBatch(1)));
+
+  ExpectInteraction({Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+                     Exchange({mutations[1]}, {ResultPiece({}, {}, {}, {0})}),
+                     Exchange({mutations[2]}, {ResultPiece({0}, {}, {})}),
+                     Exchange({mutations[3]}, {ResultPiece({0}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  FinishSingleItemStream();
+  EXPECT_TRUE(state0->completed);
+
+  // Two batches are allowed, but this one is throttled.
+  auto state1 = Apply(mutations[1]);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+  FinishSingleItemStream();
+  EXPECT_TRUE(state1->completed);
+  EXPECT_EQ(google::cloud::StatusCode::kResourceExhausted,
+            state1->completion_status.code());
+
+  // Back to a single outstanding batch.
+  auto state2 = Apply(mutations[2]);
+  auto state3 = Apply(mutations[3]);
+  EXPECT_TRUE(state3->admitted);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state2->completed);
+  EXPECT_EQ(1, NumOperationsOutstanding());
+  FinishSingleItemStream();
+  EXPECT_TRUE(state3->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
+// Test that adaptive flow control sends smaller batches when they are slow.
+TEST_F(MutationBatcherTest, AdaptiveFlowControlShrinksSlowBatches) {
+  std::vector<SingleRowMutation> mutations(
+      {SingleRowMutation("foo0", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo1", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo2", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo3", {bt::SetCell("fam", "col", 0_ms, "baz")}),
+       SingleRowMutation("foo4", {bt::SetCell("fam", "col", 0_ms, "baz")})});
+
+  auto const mutation_size = MutationSize(mutations[0]);
+  batcher_.reset(new MutationBatcher(
+      table_, MutationBatcher::Options()
+                  .SetAdaptiveFlowControl(true)
+                  .SetTargetBatchLatency(1_ms)
+                  .SetMaxBatches(1)
+                  .SetMaxSizePerBatch(2 * mutation_size)));
+
+  ExpectInteraction(
+      {Exchange({mutations[0]}, {ResultPiece({0}, {}, {})}),
+       Exchange({mutations[1], mutations[2]}, {ResultPiece({0, 1}, {}, {})}),
+       Exchange({mutations[3]}, {ResultPiece({0}, {}, {})}),
+       Exchange({mutations[4]}, {ResultPiece({0}, {}, {})})});
+
+  auto state0 = Apply(mutations[0]);
+  auto state1 = Apply(mutations[1]);
+  auto state2 = Apply(mutations[2]);
+  EXPECT_TRUE(state2->admitted);
+
+  // A slow batch halves the batch size.
+  std::this_thread::sleep_for(5_ms);
+  FinishSingleItemStream();
+  EXPECT_TRUE(state0->completed);
+
+  // Only one of these fits in the next batch.
+  auto state3 = Apply(mutations[3]);
+  auto state4 = Apply(mutations[4]);
+  EXPECT_TRUE(state3->admitted);
+  EXPECT_FALSE(state4->admitted);
+
+  std::this_thread::sleep_for(5_ms);
+  FinishSingleItemStream();
+  EXPECT_TRUE(state1->completed);
+  EXPECT_TRUE(state2->completed);
+  EXPECT_TRUE(state4->admitted);
+
+  FinishSingleItemStream();
+  EXPECT_TRUE(state3->completed);
+  FinishSingleItemStream();
+  EXPECT_TRUE(state4->completed);
+  EXPECT_EQ(0, NumOperationsOutstanding());
+}
+
 }  // namespace
 }  // namespace BIGTABLE_CLIENT_NS
 }  // namespace bigtable
@@ -0,0 +1,78 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_READ_ROWS_OPTIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_READ_ROWS_OPTIONS_H
+
+#include "google/cloud/bigtable/version.h"
+#include <cstddef>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * Configuration for `Table::ParallelReadRows()`.
+ *
+ * The row set is partitioned into shards using the split points returned by
+ * `Table::SampleRows()`, each shard is read with its own `ReadRows` stream.
+ */
+struct ParallelReadRowsOptions {
+  ParallelReadRowsOptions()
+      : max_streams(8),
+        shard_count(0),
+        ordered(false),
+        max_buffered_rows(1024) {}
+
+  /// There will be no more `ReadRows` streams open than this.
+  ParallelReadRowsOptions& SetMaxStreams(std::size_t max_streams_arg) {
+    max_streams = max_streams_arg;
+    return *this;
+  }
+
+  /**
+   * Partition the row set into (at most) this many shards.
+   *
+   * The default (zero) creates four shards per stream, so streams that finish
+   * early can pick up more work.
+   */
+  ParallelReadRowsOptions& SetShardCount(std::size_t shard_count_arg) {
+    shard_count = shard_count_arg;
+    return *this;
+  }
+
+  /// Deliver the rows in row key order, only supported by the sync API.
+  ParallelReadRowsOptions& SetOrdered(bool ordered_arg) {
+    ordered = ordered_arg;
+    return *this;
+  }
+
+  /// A stream pauses when this many of its rows are waiting for the callback.
+  ParallelReadRowsOptions& SetMaxBufferedRows(
+      std::size_t max_buffered_rows_arg) {
+    max_buffered_rows = max_buffered_rows_arg;
+    return *this;
+  }
+
+  std::size_t max_streams;
+  std::size_t shard_count;
+  bool ordered;
+  std::size_t max_buffered_rows;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_PARALLEL_READ_ROWS_OPTIONS_H
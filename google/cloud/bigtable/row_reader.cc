@@ -91,6 +91,7 @@ RowReader::RowReader(
       parser_factory_(std::move(parser_factory)),
       stream_is_open_(false),
       operation_cancelled_(false),
+      build_views_(false),
       processed_chunks_count_(0),
       rows_count_(0) {}
 
@@ -129,6 +130,7 @@ void RowReader::MakeRequest() {
   stream_is_open_ = true;
 
   parser_ = parser_factory_->Create();
+  if (build_views_) parser_->BuildViews();
 }
 
 bool RowReader::NextChunk() {
@@ -145,23 +147,56 @@ bool RowReader::NextChunk() {
 }
 
 StatusOr<internal::OptionalRow> RowReader::Advance() {
+  auto has_row = AdvanceParser();
+  if (!has_row) return std::move(has_row).status();
+  if (!*has_row) return internal::OptionalRow();
+
+  grpc::Status status;
+  Row parsed_row = parser_->Next(status);
+  if (!status.ok()) {
+    return MakeStatusFromRpcError(status);
+  }
+  ++rows_count_;
+  last_read_row_key_ = std::string(parsed_row.row_key());
+  return internal::OptionalRow(std::move(parsed_row));
+}
+
+StatusOr<optional<RowView>> RowReader::NextView() {
+  if (!build_views_) {
+    build_views_ = true;
+    if (parser_) parser_->BuildViews();
+  }
+  auto has_row = AdvanceParser();
+  if (!has_row) return std::move(has_row).status();
+  if (!*has_row) return optional<RowView>();
+
+  grpc::Status status;
+  RowView parsed_row = parser_->NextView(status);
+  if (!status.ok()) {
+    return MakeStatusFromRpcError(status);
+  }
+  ++rows_count_;
+  auto const key = parsed_row.row_key();
+  last_read_row_key_ = RowKeyType(key.data(), key.size());
+  return optional<RowView>(std::move(parsed_row));
+}
+
+StatusOr<bool> RowReader::AdvanceParser() {
   if (operation_cancelled_) {
     return Status(StatusCode::kCancelled, "Operation cancelled.");
   }
   while (true) {
-    internal::OptionalRow row;
-    grpc::Status status = AdvanceOrFail(row);
+    grpc::Status status = AdvanceParserOrFail();
     if (status.ok()) {
-      return row;
+      return parser_->HasNext();
     }
-    row.reset();
 
     // In the unlikely case when we have already reached the requested
     // number of rows and still receive an error (the parser can throw
     // an error at end of stream for example), there is no need to
     // retry and we have no good value for rows_limit anyway.
     if (rows_limit_ != NO_ROWS_LIMIT && rows_limit_ <= rows_count_) {
-      return row;
+      return false;
     }
 
     if (!last_read_row_key_.empty()) {
@@ -172,7 +207,7 @@ StatusOr<internal::OptionalRow> RowReader::Advance() {
 
     // If we receive an error, but the retriable set is empty, stop.
     if (row_set_.IsEmpty()) {
-      return row;
+      return false;
     }
 
     if (!retry_policy_->OnFailure(status)) {
@@ -187,8 +222,7 @@ StatusOr<internal::OptionalRow> RowReader::Advance() {
   }
 }
 
-grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
-  row.reset();
+grpc::Status RowReader::AdvanceParserOrFail() {
   grpc::Status status;
   if (!stream_) {
     MakeRequest();
@@ -217,14 +251,6 @@ grpc::Status RowReader::AdvanceOrFail(internal::OptionalRow& row) {
   }
 
   // We have a complete row in the parser.
-  Row parsed_row = parser_->Next(status);
-  if (!status.ok()) {
-    return status;
-  }
-  row.emplace(std::move(parsed_row));
-  ++rows_count_;
-  last_read_row_key_ = std::string(row.value().row_key());
-
   return status;
 }
 
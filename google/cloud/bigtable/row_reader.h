@@ -22,9 +22,11 @@
 #include "google/cloud/bigtable/metadata_update_policy.h"
 #include "google/cloud/bigtable/row.h"
 #include "google/cloud/bigtable/row_set.h"
+#include "google/cloud/bigtable/row_view.h"
 #include "google/cloud/bigtable/rpc_backoff_policy.h"
 #include "google/cloud/bigtable/rpc_retry_policy.h"
 #include "google/cloud/bigtable/version.h"
+#include "google/cloud/optional.h"
 #include <google/bigtable/v2/bigtable.grpc.pb.h>
 #include <grpcpp/grpcpp.h>
 #include <cinttypes>
@@ -90,6 +92,21 @@ class RowReader {
   /// End iterator over the rows in the response.
   iterator end();
 
+  /**
+   * Read the next row as a `RowView`.
+   *
+   * A `RowView` stores all the data of the row in a single buffer, which
+   * avoids several memory allocations per cell when scanning many rows. Use
+   * this function or the iterators, but do not mix both on the same
+   * `RowReader`.
+   *
+   * Retry and backoff policies are honored.
+   *
+   * @return the next row, an empty optional if there are no more rows, or the
+   *     error if the read failed after retries.
+   */
+  StatusOr<optional<RowView>> NextView();
+
   /**
    * Gracefully terminate a streaming read.
    *
@@ -108,8 +125,15 @@ class RowReader {
    */
   StatusOr<internal::OptionalRow> Advance();
 
-  /// Called by Advance(), does not handle retries.
-  grpc::Status AdvanceOrFail(internal::OptionalRow& row);
+  /**
+   * Parse the response until the parser has a full row, retrying on failures.
+   *
+   * Returns false if there are no more rows.
+   */
+  StatusOr<bool> AdvanceParser();
+
+  /// Called by AdvanceParser(), does not handle retries.
+  grpc::Status AdvanceParserOrFail();
 
   /**
    * Move the `processed_chunks_count_` index to the next chunk,
@@ -117,7 +141,7 @@ class RowReader {
    *
    * Returns false if no more chunks are available.
    *
-   * This call is used internally by AdvanceOrFail to prepare data for
+   * This call is used internally by AdvanceParserOrFail to prepare data for
    * parsing. When it returns true, the value of
    * `response_.chunks(processed_chunks_count_)` is valid and holds
    * the next chunk to parse.
@@ -146,6 +170,8 @@ class RowReader {
       stream_;
   bool stream_is_open_;
   bool operation_cancelled_;
+  /// If true the parsers build `RowView`s, see `NextView()`.
+  bool build_views_;
 
   /// The last received response, chunks are being parsed one by one from it.
   google::bigtable::v2::ReadRowsResponse response_;
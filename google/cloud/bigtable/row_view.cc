@@ -0,0 +1,52 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_view.h"
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+std::string ToString(grpc::string_ref s) {
+  return std::string(s.data(), s.size());
+}
+}  // namespace
+
+Cell CellView::ToCell() const {
+  std::vector<std::string> labels;
+  labels.reserve(labels_.size());
+  for (auto const& l : labels_) {
+    labels.push_back(ToString(l));
+  }
+  return Cell(ToString(row_key_), ToString(family_name_),
+              ColumnQualifierType(column_qualifier_.data(),
+                                  column_qualifier_.size()),
+              timestamp_, CellValueType(value_.data(), value_.size()),
+              std::move(labels));
+}
+
+Row RowView::ToRow() const {
+  std::vector<Cell> cells;
+  cells.reserve(cells_.size());
+  for (auto const& c : cells_) {
+    cells.push_back(c.ToCell());
+  }
+  return Row(ToString(row_key_), std::move(cells));
+}
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
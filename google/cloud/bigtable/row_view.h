@@ -0,0 +1,145 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_VIEW_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_VIEW_H
+
+#include "google/cloud/bigtable/cell.h"
+#include "google/cloud/bigtable/row.h"
+#include "google/cloud/bigtable/version.h"
+#include "google/cloud/internal/big_endian.h"
+#include "google/cloud/status_or.h"
+#include <grpcpp/support/string_ref.h>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+/**
+ * A non-owning view of a Bigtable cell.
+ *
+ * A `CellView` references data owned by the `RowView` it belongs to, the
+ * returned values are not valid after all the copies of that `RowView` are
+ * deleted.
+ *
+ * @see RowView for the motivation to use this class instead of `Cell`.
+ */
+class CellView {
+ public:
+  CellView(grpc::string_ref row_key, grpc::string_ref family_name,
+           grpc::string_ref column_qualifier, std::int64_t timestamp,
+           grpc::string_ref value, std::vector<grpc::string_ref> labels)
+      : row_key_(row_key),
+        family_name_(family_name),
+        column_qualifier_(column_qualifier),
+        timestamp_(timestamp),
+        value_(value),
+        labels_(std::move(labels)) {}
+
+  /// Return the row key this cell belongs to.
+  grpc::string_ref row_key() const { return row_key_; }
+
+  /// Return the family this cell belongs to.
+  grpc::string_ref family_name() const { return family_name_; }
+
+  /// Return the column this cell belongs to.
+  grpc::string_ref column_qualifier() const { return column_qualifier_; }
+
+  /// Return the timestamp of this cell.
+  std::chrono::microseconds timestamp() const {
+    return std::chrono::microseconds(timestamp_);
+  }
+
+  /// Return the contents of this cell.
+  grpc::string_ref value() const { return value_; }
+
+  /// Interpret the value as a big-endian encoded `T` and return it.
+  template <typename T>
+  StatusOr<T> decode_big_endian_integer() const {
+    return google::cloud::internal::DecodeBigEndian<T>(
+        std::string(value_.data(), value_.size()));
+  }
+
+  /// Return the labels applied to this cell by label transformer read filters.
+  std::vector<grpc::string_ref> const& labels() const { return labels_; }
+
+  /// Return a copy of this cell that owns its data.
+  Cell ToCell() const;
+
+ private:
+  grpc::string_ref row_key_;
+  grpc::string_ref family_name_;
+  grpc::string_ref column_qualifier_;
+  std::int64_t timestamp_;
+  grpc::string_ref value_;
+  std::vector<grpc::string_ref> labels_;
+};
+
+/**
+ * A read-only representation of a Bigtable row with a single allocation for
+ * all its data.
+ *
+ * `Row` and `Cell` own each of their fields, so every cell costs several heap
+ * allocations (for the row key, family name, column qualifier, value, and
+ * labels). Applications scanning many small cells can spend more time in the
+ * memory allocator than processing data. A `RowView` stores the row key, and
+ * the family names, column qualifiers, values, and labels for all the cells in
+ * a single buffer. The row key is stored once, and the family names and column
+ * qualifiers are stored once for all the cells that share them.
+ *
+ * Copies of a `RowView` share the buffer, the `CellView`s remain valid as long
+ * as any copy of the `RowView` is alive.
+ *
+ * @see RowReader::NextView() to read rows using this representation.
+ */
+class RowView {
+ public:
+  /**
+   * Create a row from a buffer and a list of cells.
+   *
+   * The @p row_key and all the fields in @p cells should reference data owned
+   * by @p buffer.
+   */
+  RowView(std::shared_ptr<std::string const> buffer, grpc::string_ref row_key,
+          std::vector<CellView> cells)
+      : buffer_(std::move(buffer)),
+        row_key_(row_key),
+        cells_(std::move(cells)) {}
+
+  /// Return the row key.
+  grpc::string_ref row_key() const { return row_key_; }
+
+  /// Return all cells.
+  std::vector<CellView> const& cells() const { return cells_; }
+
+  /// Return a copy of this row that owns its data.
+  Row ToRow() const;
+
+ private:
+  std::shared_ptr<std::string const> buffer_;
+  grpc::string_ref row_key_;
+  std::vector<CellView> cells_;
+};
+
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_BIGTABLE_ROW_VIEW_H
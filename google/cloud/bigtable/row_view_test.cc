@@ -0,0 +1,101 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/bigtable/row_view.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gtest/gtest.h>
+
+namespace google {
+namespace cloud {
+namespace bigtable {
+inline namespace BIGTABLE_CLIENT_NS {
+namespace {
+
+/// Create a `RowView` with two cells, the second with a label.
+RowView MakeRowView() {
+  auto buffer = std::make_shared<std::string const>(
+      std::string("row-keyfamcol1v1col2") +
+      std::string("\0\0\0\0\0\0\0\x2A", 8) + "label");
+  char const* base = buffer->data();
+  grpc::string_ref row_key(base, 7);
+  grpc::string_ref family(base + 7, 3);
+  std::vector<CellView> cells;
+  cells.emplace_back(row_key, family, grpc::string_ref(base + 10, 4), 1000,
+                     grpc::string_ref(base + 14, 2),
+                     std::vector<grpc::string_ref>{});
+  cells.emplace_back(
+      row_key, family, grpc::string_ref(base + 16, 4), 2000,
+      grpc::string_ref(base + 20, 8),
+      std::vector<grpc::string_ref>{grpc::string_ref(base + 28, 5)});
+  return RowView(std::move(buffer), row_key, std::move(cells));
+}
+
+/// @test Verify RowView and CellView accessors.
+TEST(RowViewTest, Accessors) {
+  auto row = MakeRowView();
+  EXPECT_EQ("row-key", row.row_key());
+  ASSERT_EQ(2, row.cells().size());
+
+  auto const& c0 = row.cells()[0];
+  EXPECT_EQ("row-key", c0.row_key());
+  EXPECT_EQ("fam", c0.family_name());
+  EXPECT_EQ("col1", c0.column_qualifier());
+  EXPECT_EQ(std::chrono::microseconds(1000), c0.timestamp());
+  EXPECT_EQ("v1", c0.value());
+  EXPECT_TRUE(c0.labels().empty());
+
+  auto const& c1 = row.cells()[1];
+  EXPECT_EQ("col2", c1.column_qualifier());
+  auto decoded = c1.decode_big_endian_integer<std::int64_t>();
+  ASSERT_STATUS_OK(decoded);
+  EXPECT_EQ(42, *decoded);
+  ASSERT_EQ(1, c1.labels().size());
+  EXPECT_EQ("label", c1.labels()[0]);
+}
+
+/// @test Verify copies of a RowView keep the data alive.
+TEST(RowViewTest, CopiesShareData) {
+  std::unique_ptr<RowView> original(new RowView(MakeRowView()));
+  RowView copy = *original;
+  original.reset();
+  EXPECT_EQ("row-key", copy.row_key());
+  ASSERT_EQ(2, copy.cells().size());
+  EXPECT_EQ("v1", copy.cells()[0].value());
+}
+
+/// @test Verify RowView can be converted to a Row.
+TEST(RowViewTest, ToRow) {
+  auto row = MakeRowView().ToRow();
+  EXPECT_EQ("row-key", row.row_key());
+  ASSERT_EQ(2, row.cells().size());
+
+  auto const& c0 = row.cells()[0];
+  EXPECT_EQ("row-key", c0.row_key());
+  EXPECT_EQ("fam", c0.family_name());
+  EXPECT_EQ("col1", c0.column_qualifier());
+  EXPECT_EQ(std::chrono::microseconds(1000), c0.timestamp());
+  EXPECT_EQ("v1", c0.value());
+  EXPECT_TRUE(c0.labels().empty());
+
+  auto const& c1 = row.cells()[1];
+  EXPECT_EQ("col2", c1.column_qualifier());
+  EXPECT_EQ(std::string("\0\0\0\0\0\0\0\x2A", 8), c1.value());
+  EXPECT_EQ(std::vector<std::string>{"label"}, c1.labels());
+}
+
+}  // namespace
+}  // namespace BIGTABLE_CLIENT_NS
+}  // namespace bigtable
+}  // namespace cloud
+}  // namespace google
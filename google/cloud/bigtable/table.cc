@@ -15,9 +15,13 @@
 #include "google/cloud/bigtable/table.h"
 #include "google/cloud/bigtable/internal/async_bulk_apply.h"
 #include "google/cloud/bigtable/internal/bulk_mutator.h"
+#include "google/cloud/bigtable/internal/parallel_row_scanner.h"
 #include "google/cloud/bigtable/internal/unary_client_utils.h"
 #include "google/cloud/grpc_error_delegate.h"
 #include "google/cloud/internal/async_retry_unary_rpc.h"
+#include <algorithm>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <type_traits>
 
@@ -58,6 +62,13 @@ Row TransformReadModifyWriteRowResponse(Response& response) {
   return Row(std::move(*row.mutable_key()), std::move(cells));
 }
 
+std::size_t ParallelShardCount(ParallelReadRowsOptions const& options) {
+  // Create more shards than streams, streams finishing early pick up more.
+  auto constexpr kShardsPerStream = 4;
+  if (options.shard_count != 0) return options.shard_count;
+  return kShardsPerStream * (std::max)(options.max_streams, std::size_t(1));
+}
+
 }  // namespace
 
 using ClientUtils = bigtable::internal::UnaryClientUtils<DataClient>;
@@ -196,6 +207,90 @@ RowReader Table::ReadRows(RowSet row_set, std::int64_t rows_limit,
                        bigtable::internal::ReadRowsParserFactory>());
 }
 
+Status Table::ParallelReadRows(RowSet row_set, Filter filter,
+                               std::function<bool(Row)> const& on_row,
+                               ParallelReadRowsOptions const& options) {
+  auto samples = SampleRows();
+  if (!samples) return std::move(samples).status();
+  internal::ParallelRowScanner scanner(
+      internal::ParallelScanShards(std::move(row_set), *samples,
+                                   ParallelShardCount(options)),
+      options, [this, &filter](RowSet shard) {
+        return ReadRows(std::move(shard), filter);
+      });
+  return scanner.Run(on_row);
+}
+
+future<Status> Table::AsyncParallelReadRows(
+    CompletionQueue& cq, std::function<future<bool>(Row)> on_row,
+    RowSet row_set, Filter filter, ParallelReadRowsOptions const& options) {
+  if (options.ordered) {
+    return make_ready_future(
+        Status(StatusCode::kInvalidArgument,
+               "ordered delivery is not supported by AsyncParallelReadRows()"));
+  }
+  using Scanner = internal::AsyncParallelRowScanner;
+  auto done = std::make_shared<promise<Status>>();
+  auto result = done->get_future();
+  auto const self = *this;
+  // Capturing a RowSet by value would pick its variadic constructor when the
+  // callback is moved.
+  auto const rows = std::make_shared<RowSet const>(std::move(row_set));
+  auto const shard_count = ParallelShardCount(options);
+  auto const max_streams = options.max_streams;
+  auto start = [self, done, on_row, rows, filter, shard_count, max_streams](
+                   CompletionQueue& cq,
+                   StatusOr<std::vector<RowKeySample>> const& samples) {
+    if (!samples) {
+      done->set_value(samples.status());
+      return;
+    }
+    auto table = self;
+    auto factory = [table, cq, filter](
+                       RowSet shard, Scanner::RowFunctor shard_on_row,
+                       Scanner::FinishFunctor on_finish) mutable {
+      table.AsyncReadRows(cq, std::move(shard_on_row), std::move(on_finish),
+                          std::move(shard), filter);
+    };
+    Scanner::Start(
+        internal::ParallelScanShards(*rows, *samples, shard_count),
+        max_streams, std::move(factory), on_row)
+        .then([done](future<Status> f) { done->set_value(f.get()); });
+  };
+  // There is no asynchronous SampleRows(), sample the row keys in a separate
+  // thread so the threads running `cq` are not blocked. The scan starts from
+  // `cq`, after joining the sampling thread.
+  struct Sampler {
+    explicit Sampler(CompletionQueue q) : cq(std::move(q)) {}
+    // RunAsync() uses the `CompletionQueue` object after it returns, keep it
+    // alive until the functor runs.
+    CompletionQueue cq;
+    std::mutex mu;
+    std::thread thread;  // GUARDED_BY(mu)
+  };
+  auto sampler = std::make_shared<Sampler>(cq);
+  std::lock_guard<std::mutex> lk(sampler->mu);
+  sampler->thread = std::thread([self, start, sampler] {
+    auto table = self;
+    auto samples = table.SampleRows();
+    sampler->cq.RunAsync([start, samples, sampler](CompletionQueue& cq) {
+      std::thread t;
+      {
+        std::lock_guard<std::mutex> lk(sampler->mu);
+        t = std::move(sampler->thread);
+      }
+      // RunAsync() may call this functor from the sampling thread.
+      if (t.get_id() == std::this_thread::get_id()) {
+        t.detach();
+      } else {
+        t.join();
+      }
+      start(cq, samples);
+    });
+  });
+  return result;
+}
+
 StatusOr<std::pair<bool, Row>> Table::ReadRow(std::string row_key,
                                               Filter filter) {
   RowSet row_set(std::move(row_key));
@@ -21,6 +21,7 @@
 #include "google/cloud/bigtable/filters.h"
 #include "google/cloud/bigtable/idempotent_mutation_policy.h"
 #include "google/cloud/bigtable/mutations.h"
+#include "google/cloud/bigtable/parallel_read_rows_options.h"
 #include "google/cloud/bigtable/read_modify_write_rule.h"
 #include "google/cloud/bigtable/row_key_sample.h"
 #include "google/cloud/bigtable/row_reader.h"
@@ -33,6 +34,7 @@
 #include "google/cloud/internal/disjunction.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
+#include <functional>
 
 namespace google {
 namespace cloud {
@@ -475,6 +477,33 @@ class Table {
    */
   RowReader ReadRows(RowSet row_set, std::int64_t rows_limit, Filter filter);
 
+  /**
+   * Reads a set of rows from the table using several streams in parallel.
+   *
+   * The row set is partitioned into shards using the split points returned by
+   * `SampleRows()`, and up to `options.max_streams` shards are read at the
+   * same time. Once all the shards are assigned, streams that run out of work
+   * take over the second half of the busiest shard, so a slow shard does not
+   * hold up the whole scan.
+   *
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param on_row the callback invoked for each row, it should return `false`
+   *     to stop the scan. It is always called from the calling thread, and
+   *     never concurrently.
+   * @param options the number of streams and shards, and whether the rows are
+   *     delivered in row key order. By default rows from different shards are
+   *     interleaved.
+   * @returns the status of `SampleRows()` if it fails, otherwise the first
+   *     error from any of the streams. The scan stops on the first error.
+   *
+   * @par Idempotency
+   * This is a read-only operation and therefore it is always idempotent.
+   */
+  Status ParallelReadRows(
+      RowSet row_set, Filter filter, std::function<bool(Row)> const& on_row,
+      ParallelReadRowsOptions const& options = ParallelReadRowsOptions());
+
   /**
    * Read and return a single row from the table.
    *
@@ -734,6 +763,38 @@ class Table {
             bigtable::internal::ReadRowsParserFactory>());
   }
 
+  /**
+   * Asynchronously reads a set of rows from the table using several streams.
+   *
+   * @warning This is an early version of the asynchronous APIs for Cloud
+   *     Bigtable. These APIs might be changed in backward-incompatible ways. It
+   *     is not subject to any SLA or deprecation policy.
+   *
+   * This is the asynchronous version of `ParallelReadRows()`, the shards are
+   * read using `AsyncReadRows()`. There is no asynchronous version of
+   * `SampleRows()`, the row keys are sampled from a separate thread, created
+   * by this function, which does not block the threads running @p cq.
+   *
+   * @param cq the completion queue that will execute the asynchronous calls,
+   *     the application must ensure that one or more threads are blocked on
+   *     `cq.Run()`.
+   * @param on_row the callback to be invoked on each successfully read row; the
+   *     returned `future<bool>` should be satisfied with `true` when the user
+   *     is ready to receive the next row of that shard and with `false` to
+   *     stop the scan. Rows from different shards may be delivered
+   *     concurrently.
+   * @param row_set the rows to read from.
+   * @param filter is applied on the server-side to data in the rows.
+   * @param options the number of streams and shards. Ordered delivery is not
+   *     supported, the scan fails with `kInvalidArgument` if requested.
+   * @returns a future satisfied when all the streams finish, with the first
+   *     error from any of the streams, if any.
+   */
+  future<Status> AsyncParallelReadRows(
+      CompletionQueue& cq, std::function<future<bool>(Row)> on_row,
+      RowSet row_set, Filter filter,
+      ParallelReadRowsOptions const& options = ParallelReadRowsOptions());
+
   /**
    * Asynchronously read and return a single row from the table.
    *
@@ -0,0 +1,297 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/bigtable/table.h"
+#include "google/cloud/bigtable/testing/mock_read_rows_reader.h"
+#include "google/cloud/bigtable/testing/mock_sample_row_keys_reader.h"
+#include "google/cloud/bigtable/testing/table_test_fixture.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace bigtable = google::cloud::bigtable;
+namespace btproto = google::bigtable::v2;
+using testing::_;
+using testing::Invoke;
+using testing::Return;
+
+/// Define helper types and functions for this test.
+namespace {
+using bigtable::testing::MockReadRowsReader;
+using bigtable::testing::MockSampleRowKeysReader;
+
+/**
+ * Serve `ReadRows` and `SampleRowKeys` from a fixed list of rows.
+ *
+ * Each `ReadRows` stream returns one row per `Read()` call, with a short pause
+ * so streams run long enough for idle streams to split their shards.
+ */
+class TableParallelReadRowsTest : public bigtable::testing::TableTestFixture {
+ protected:
+  void SetUpTable(std::vector<std::string> rows,
+                  std::vector<std::string> const& split_points) {
+    rows_ = std::move(rows);
+    std::sort(rows_.begin(), rows_.end());
+
+    using Samples = std::vector<btproto::SampleRowKeysResponse>;
+    auto samples = std::make_shared<Samples>();
+    std::int64_t offset = 0;
+    for (auto const& key : split_points) {
+      btproto::SampleRowKeysResponse r;
+      r.set_row_key(key);
+      r.set_offset_bytes(offset += 100);
+      samples->push_back(std::move(r));
+    }
+    auto reader = new MockSampleRowKeysReader(
+        "google.bigtable.v2.Bigtable.SampleRowKeys");
+    EXPECT_CALL(*client_, SampleRowKeys(_, _))
+        .WillOnce(Invoke(reader->MakeMockReturner()));
+    auto index = std::make_shared<std::size_t>(0);
+    EXPECT_CALL(*reader, Read(_))
+        .WillRepeatedly(
+            Invoke([samples, index](btproto::SampleRowKeysResponse* r) {
+              if (*index == samples->size()) return false;
+              *r = (*samples)[(*index)++];
+              return true;
+            }));
+    EXPECT_CALL(*reader, Finish()).WillOnce(Return(grpc::Status::OK));
+
+    EXPECT_CALL(*client_, ReadRows(_, _))
+        .WillRepeatedly(Invoke(
+            [this](grpc::ClientContext*, btproto::ReadRowsRequest const& r) {
+              ++read_rows_calls_;
+              return MakeStream(r);
+            }));
+  }
+
+  MockReadRowsReader::UniquePtr MakeStream(
+      btproto::ReadRowsRequest const& request) {
+    auto responses = std::make_shared<std::vector<btproto::ReadRowsResponse>>();
+    for (auto const& key : rows_) {
+      if (!Contains(request.rows(), key)) continue;
+      btproto::ReadRowsResponse r;
+      auto& chunk = *r.add_chunks();
+      chunk.set_row_key(key);
+      chunk.mutable_family_name()->set_value("fam");
+      chunk.mutable_qualifier()->set_value("col");
+      chunk.set_timestamp_micros(1000);
+      chunk.set_value("value");
+      chunk.set_commit_row(true);
+      responses->push_back(std::move(r));
+    }
+    auto stream =
+        new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+    auto index = std::make_shared<std::size_t>(0);
+    EXPECT_CALL(*stream, Read(_))
+        .WillRepeatedly(
+            Invoke([responses, index](btproto::ReadRowsResponse* r) {
+              if (*index == responses->size()) return false;
+              std::this_thread::sleep_for(std::chrono::milliseconds(1));
+              *r = (*responses)[(*index)++];
+              return true;
+            }));
+    EXPECT_CALL(*stream, Finish()).WillRepeatedly(Return(stream_status_));
+    return stream->AsUniqueMocked();
+  }
+
+  static bool Contains(btproto::RowSet const& rows, std::string const& key) {
+    if (rows.row_keys().empty() && rows.row_ranges().empty()) return true;
+    for (auto const& k : rows.row_keys()) {
+      if (k == key) return true;
+    }
+    for (auto const& r : rows.row_ranges()) {
+      if (bigtable::RowRange(r).Contains(key)) return true;
+    }
+    return false;
+  }
+
+  std::vector<std::string> rows_;
+  grpc::Status stream_status_ = grpc::Status::OK;
+  std::atomic<int> read_rows_calls_{0};
+};
+
+std::vector<std::string> Keys(std::string const& prefixes, int count) {
+  std::vector<std::string> keys;
+  for (auto p : prefixes) {
+    for (int i = 0; i != count; ++i) {
+      keys.push_back(std::string(1, p) + std::to_string(i));
+    }
+  }
+  return keys;
+}
+}  // anonymous namespace
+
+TEST_F(TableParallelReadRowsTest, ReadsAllShards) {
+  SetUpTable(Keys("akmnz", 3), {"k", "n", ""});
+
+  std::mutex mu;
+  std::vector<std::string> actual;
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      [&](bigtable::Row row) {
+        std::lock_guard<std::mutex> lk(mu);
+        actual.push_back(row.row_key());
+        return true;
+      },
+      bigtable::ParallelReadRowsOptions().SetMaxStreams(2));
+  ASSERT_STATUS_OK(status);
+  std::sort(actual.begin(), actual.end());
+  EXPECT_EQ(rows_, actual);
+  EXPECT_EQ(3, read_rows_calls_.load());
+}
+
+TEST_F(TableParallelReadRowsTest, OrderedDelivery) {
+  SetUpTable(Keys("akmnz", 3), {"k", "n", ""});
+
+  std::vector<std::string> actual;
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      [&](bigtable::Row row) {
+        actual.push_back(row.row_key());
+        return true;
+      },
+      bigtable::ParallelReadRowsOptions()
+          .SetMaxStreams(3)
+          .SetOrdered(true)
+          .SetMaxBufferedRows(1));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(rows_, actual);
+}
+
+TEST_F(TableParallelReadRowsTest, SplitSlowShards) {
+  // A single shard, the idle streams must split it to make progress.
+  SetUpTable(Keys("abcdefgh", 4), {"b", "c", "d", "e", "f", "g", "h", ""});
+
+  std::vector<std::string> actual;
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      [&](bigtable::Row row) {
+        actual.push_back(row.row_key());
+        return true;
+      },
+      bigtable::ParallelReadRowsOptions()
+          .SetMaxStreams(4)
+          .SetShardCount(1)
+          .SetOrdered(true));
+  ASSERT_STATUS_OK(status);
+  // Each row is delivered exactly once, and in order.
+  EXPECT_EQ(rows_, actual);
+  EXPECT_LT(1, read_rows_calls_.load());
+}
+
+TEST_F(TableParallelReadRowsTest, RowSetIsRespected) {
+  SetUpTable(Keys("akmnz", 3), {"k", "n", ""});
+
+  std::vector<std::string> actual;
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(bigtable::RowRange::Range("k1", "n1"), "z0"),
+      bigtable::Filter::PassAllFilter(),
+      [&](bigtable::Row row) {
+        actual.push_back(row.row_key());
+        return true;
+      },
+      bigtable::ParallelReadRowsOptions().SetOrdered(true));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(
+      (std::vector<std::string>{"k1", "k2", "m0", "m1", "m2", "n0", "z0"}),
+      actual);
+}
+
+TEST_F(TableParallelReadRowsTest, StopsWhenCallbackReturnsFalse) {
+  SetUpTable(Keys("akmnz", 3), {"k", "n", ""});
+
+  int count = 0;
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      [&](bigtable::Row) { return ++count < 2; });
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(2, count);
+}
+
+TEST_F(TableParallelReadRowsTest, ReportsStreamErrors) {
+  stream_status_ = grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh");
+  SetUpTable(Keys("akmnz", 3), {"k", "n", ""});
+
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      [](bigtable::Row) { return true; });
+  EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied, status.code());
+}
+
+TEST_F(TableParallelReadRowsTest, ReportsSampleRowsErrors) {
+  auto reader =
+      new MockSampleRowKeysReader("google.bigtable.v2.Bigtable.SampleRowKeys");
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(Invoke(reader->MakeMockReturner()));
+  EXPECT_CALL(*reader, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh")));
+  EXPECT_CALL(*client_, ReadRows(_, _)).Times(0);
+
+  auto status = table_.ParallelReadRows(
+      bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+      [](bigtable::Row) { return true; });
+  EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied, status.code());
+}
+
+TEST_F(TableParallelReadRowsTest, AsyncRejectsOrdered) {
+  bigtable::CompletionQueue cq;
+  auto status =
+      table_
+          .AsyncParallelReadRows(
+              cq,
+              [](bigtable::Row) {
+                return google::cloud::make_ready_future(true);
+              },
+              bigtable::RowSet(), bigtable::Filter::PassAllFilter(),
+              bigtable::ParallelReadRowsOptions().SetOrdered(true))
+          .get();
+  EXPECT_EQ(google::cloud::StatusCode::kInvalidArgument, status.code());
+}
+
+TEST_F(TableParallelReadRowsTest, AsyncReportsSampleRowsErrors) {
+  bigtable::CompletionQueue cq;
+  std::thread t([&cq] { cq.Run(); });
+
+  auto reader =
+      new MockSampleRowKeysReader("google.bigtable.v2.Bigtable.SampleRowKeys");
+  auto returner = reader->MakeMockReturner();
+  auto const cq_thread = t.get_id();
+  EXPECT_CALL(*client_, SampleRowKeys(_, _))
+      .WillOnce(Invoke([returner, cq_thread](
+                           grpc::ClientContext* context,
+                           btproto::SampleRowKeysRequest const& request) {
+        // The blocking SampleRows() must not run in the threads of `cq`.
+        EXPECT_NE(cq_thread, std::this_thread::get_id());
+        return returner(context, request);
+      }));
+  EXPECT_CALL(*reader, Read(_)).WillOnce(Return(false));
+  EXPECT_CALL(*reader, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::PERMISSION_DENIED, "uh-oh")));
+
+  auto status = table_
+                    .AsyncParallelReadRows(
+                        cq,
+                        [](bigtable::Row) {
+                          return google::cloud::make_ready_future(true);
+                        },
+                        bigtable::RowSet(), bigtable::Filter::PassAllFilter())
+                    .get();
+  EXPECT_EQ(google::cloud::StatusCode::kPermissionDenied, status.code());
+  cq.Shutdown();
+  t.join();
+}
@@ -147,3 +147,101 @@ TEST_F(TableReadRowsTest, ReadRowsThrowsWhenTooManyErrors) {
   ++it;
   ASSERT_EQ(reader.end(), it);
 }
+
+TEST_F(TableReadRowsTest, ReadRowViewsWithRetries) {
+  auto response = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r1"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "v1"
+      }
+      chunks {
+        timestamp_micros: 41000
+        value: "v2"
+        commit_row: true
+      }
+      )");
+
+  auto response_retry = bigtable::testing::ReadRowsResponseFromString(R"(
+      chunks {
+        row_key: "r2"
+        family_name { value: "fam" }
+        qualifier { value: "qual" }
+        timestamp_micros: 42000
+        value: "v3"
+        commit_row: true
+      }
+      )");
+
+  // must be a new pointer, it is wrapped in unique_ptr by ReadRows
+  auto stream = new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+  auto stream_retry =
+      new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillOnce(Invoke(stream->MakeMockReturner()))
+      .WillOnce(Invoke(stream_retry->MakeMockReturner()));
+
+  EXPECT_CALL(*stream, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response), Return(true)))
+      .WillOnce(Return(false));
+
+  EXPECT_CALL(*stream, Finish())
+      .WillOnce(
+          Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "try-again")));
+
+  EXPECT_CALL(*stream_retry, Read(_))
+      .WillOnce(DoAll(SetArgPointee<0>(response_retry), Return(true)))
+      .WillOnce(Return(false));
+
+  EXPECT_CALL(*stream_retry, Finish()).WillOnce(Return(grpc::Status::OK));
+
+  auto reader =
+      table_.ReadRows(bigtable::RowSet(), bigtable::Filter::PassAllFilter());
+
+  auto r1 = reader.NextView();
+  ASSERT_STATUS_OK(r1);
+  ASSERT_TRUE(r1->has_value());
+  EXPECT_EQ("r1", (*r1)->row_key());
+  auto const& cells = (*r1)->cells();
+  ASSERT_EQ(2U, cells.size());
+  EXPECT_EQ("fam", cells[1].family_name());
+  EXPECT_EQ("qual", cells[1].column_qualifier());
+  EXPECT_EQ(41000, cells[1].timestamp().count());
+  EXPECT_EQ("v2", cells[1].value());
+
+  auto r2 = reader.NextView();
+  ASSERT_STATUS_OK(r2);
+  ASSERT_TRUE(r2->has_value());
+  EXPECT_EQ("r2", (*r2)->row_key());
+
+  auto end = reader.NextView();
+  ASSERT_STATUS_OK(end);
+  EXPECT_FALSE(end->has_value());
+}
+
+TEST_F(TableReadRowsTest, ReadRowViewsFailsWhenTooManyErrors) {
+  EXPECT_CALL(*client_, ReadRows(_, _))
+      .WillRepeatedly(testing::WithoutArgs(testing::Invoke([] {
+        auto stream =
+            new MockReadRowsReader("google.bigtable.v2.Bigtable.ReadRows");
+        EXPECT_CALL(*stream, Read(_)).WillOnce(Return(false));
+        EXPECT_CALL(*stream, Finish())
+            .WillOnce(
+                Return(grpc::Status(grpc::StatusCode::UNAVAILABLE, "broken")));
+        return stream->AsUniqueMocked();
+      })));
+
+  auto table = bigtable::Table(
+      client_, "table_id", bigtable::LimitedErrorCountRetryPolicy(3),
+      bigtable::ExponentialBackoffPolicy(std::chrono::seconds(0),
+                                         std::chrono::seconds(0)),
+      bigtable::SafeIdempotentMutationPolicy());
+  auto reader =
+      table.ReadRows(bigtable::RowSet(), bigtable::Filter::PassAllFilter());
+
+  auto row = reader.NextView();
+  EXPECT_EQ(google::cloud::StatusCode::kUnavailable, row.status().code());
+}
@@ -0,0 +1,1071 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/embedded_server.h"
+#include "google/cloud/storage/hashing_options.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/internal/setenv.h"
+#include "google/cloud/optional.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+#ifndef _WIN32
+namespace {
+namespace gcs = ::google::cloud::storage;
+namespace nl = ::google::cloud::storage::internal::nl;
+
+std::string ToLower(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(),
+                 [](char c) { return static_cast<char>(std::tolower(c)); });
+  return s;
+}
+
+std::string Trim(std::string const& s) {
+  auto const begin = s.find_first_not_of(" \t");
+  if (begin == std::string::npos) {
+    return {};
+  }
+  auto const end = s.find_last_not_of(" \t\r\n");
+  return s.substr(begin, end - begin + 1);
+}
+
+/**
+ * Parses an unsigned integer, returning an empty value if @p s is malformed.
+ *
+ * The values come from the requests, `std::stoull()` and friends would throw
+ * and terminate the server. Unlike `std::strtoull()` this rejects signs,
+ * whitespace, and trailing characters.
+ */
+optional<std::uint64_t> ParseUnsigned(std::string const& s, int base = 10) {
+  if (s.empty() || !std::isxdigit(static_cast<unsigned char>(s.front()))) {
+    return {};
+  }
+  char* end = nullptr;
+  errno = 0;
+  auto const value = std::strtoull(s.c_str(), &end, base);
+  if (errno != 0 || end != s.c_str() + s.size()) {
+    return {};
+  }
+  return static_cast<std::uint64_t>(value);
+}
+
+bool UrlDecode(std::string const& s, std::string& result) {
+  result.clear();
+  result.reserve(s.size());
+  for (std::size_t i = 0; i < s.size(); ++i) {
+    if (s[i] == '%' && i + 2 < s.size()) {
+      auto const c = ParseUnsigned(s.substr(i + 1, 2), 16);
+      if (!c.has_value()) {
+        return false;
+      }
+      result.push_back(static_cast<char>(*c));
+      i += 2;
+      continue;
+    }
+    result.push_back(s[i]);
+  }
+  return true;
+}
+
+
+struct HttpRequest {
+  std::string method;
+  // The URL-decoded path segments.
+  std::vector<std::string> path;
+  std::map<std::string, std::string> query;
+  // The header names are converted to lowercase, repeated headers are joined
+  // with commas.
+  std::map<std::string, std::string> headers;
+  std::string body;
+  // Describes the problem with a malformed request, these are rejected and the
+  // connection is closed.
+  std::string error;
+
+  std::string Header(std::string const& name) const {
+    auto l = headers.find(name);
+    return l == headers.end() ? std::string{} : l->second;
+  }
+  std::string Query(std::string const& name) const {
+    auto l = query.find(name);
+    return l == query.end() ? std::string{} : l->second;
+  }
+};
+
+/// Parses the `generation` query parameter, returns false if it is malformed.
+bool ParseGeneration(HttpRequest const& request,
+                     optional<std::uint64_t>& generation) {
+  auto const value = request.Query("generation");
+  generation = value.empty() ? optional<std::uint64_t>{} : ParseUnsigned(value);
+  return value.empty() || generation.has_value();
+}
+
+/// Returns true if @p generation is not set or matches @p actual.
+bool GenerationMatches(optional<std::uint64_t> const& generation,
+                       std::int64_t actual) {
+  return !generation.has_value() ||
+         *generation == static_cast<std::uint64_t>(actual);
+}
+
+struct HttpReply {
+  int status_code = 200;
+  std::vector<std::pair<std::string, std::string>> headers;
+  std::string body;
+  // Downloads send the object contents directly, without copying them.
+  std::shared_ptr<std::string const> media;
+  std::size_t media_offset = 0;
+  std::size_t media_length = 0;
+};
+
+char const* ReasonPhrase(int status_code) {
+  switch (status_code) {
+    case 100:
+      return "Continue";
+    case 200:
+      return "OK";
+    case 204:
+      return "No Content";
+    case 206:
+      return "Partial Content";
+    case 308:
+      return "Resume Incomplete";
+    case 400:
+      return "Bad Request";
+    case 404:
+      return "Not Found";
+    case 409:
+      return "Conflict";
+    case 412:
+      return "Precondition Failed";
+    case 416:
+      return "Requested Range Not Satisfiable";
+    case 499:
+      return "Client Closed Request";
+    default:
+      break;
+  }
+  return "Unknown";
+}
+
+HttpReply JsonReply(nl::json const& payload) {
+  HttpReply reply;
+  reply.headers.emplace_back("Content-Type", "application/json");
+  reply.body = payload.dump();
+  return reply;
+}
+
+HttpReply ErrorReply(int status_code, std::string const& message) {
+  auto reply = JsonReply(
+      nl::json{{"error", {{"code", status_code}, {"message", message}}}});
+  reply.status_code = status_code;
+  return reply;
+}
+
+HttpReply EmptyReply(int status_code) {
+  HttpReply reply;
+  reply.status_code = status_code;
+  return reply;
+}
+
+/// Reads HTTP/1.1 requests from, and writes replies to, a socket.
+class Connection {
+ public:
+  explicit Connection(int fd) : fd_(fd) {}
+
+  bool ReadRequest(HttpRequest& request);
+  bool SendReply(HttpReply const& reply);
+
+ private:
+  bool Fill();
+  bool ReadLine(std::string& line);
+  bool ReadBody(std::size_t n, std::string& out);
+  bool SendAll(std::vector<iovec> iov);
+
+  int fd_;
+  std::string buffer_;
+  std::size_t offset_ = 0;
+};
+
+bool Connection::Fill() {
+  if (offset_ != 0) {
+    buffer_.erase(0, offset_);
+    offset_ = 0;
+  }
+  auto constexpr kReadSize = 64 * 1024;
+  auto const size = buffer_.size();
+  buffer_.resize(size + kReadSize);
+  auto n = ::recv(fd_, &buffer_[size], kReadSize, 0);
+  if (n <= 0) {
+    buffer_.resize(size);
+    return false;
+  }
+  buffer_.resize(size + static_cast<std::size_t>(n));
+  return true;
+}
+
+bool Connection::ReadLine(std::string& line) {
+  for (auto pos = buffer_.find("\r\n", offset_); pos == std::string::npos;
+       pos = buffer_.find("\r\n", offset_)) {
+    if (!Fill()) {
+      return false;
+    }
+  }
+  auto const pos = buffer_.find("\r\n", offset_);
+  line = buffer_.substr(offset_, pos - offset_);
+  offset_ = pos + 2;
+  return true;
+}
+
+bool Connection::ReadBody(std::size_t n, std::string& out) {
+  auto const available = (std::min)(n, buffer_.size() - offset_);
+  auto pos = out.size();
+  out.resize(pos + n);
+  std::copy(buffer_.begin() + offset_, buffer_.begin() + offset_ + available,
+            out.begin() + pos);
+  offset_ += available;
+  pos += available;
+  // Read any remaining data directly into the destination, large uploads
+  // would otherwise be copied twice.
+  while (pos != out.size()) {
+    auto r = ::recv(fd_, &out[pos], out.size() - pos, 0);
+    if (r <= 0) {
+      return false;
+    }
+    pos += static_cast<std::size_t>(r);
+  }
+  return true;
+}
+
+bool Connection::ReadRequest(HttpRequest& request) {
+  std::string line;
+  do {
+    if (!ReadLine(line)) {
+      return false;
+    }
+  } while (line.empty());
+
+  std::istringstream request_line(line);
+  std::string target;
+  request_line >> request.method >> target;
+
+  auto const qpos = target.find('?');
+  std::istringstream path(target.substr(0, qpos));
+  for (std::string segment; std::getline(path, segment, '/');) {
+    if (segment.empty()) {
+      continue;
+    }
+    std::string decoded;
+    if (!UrlDecode(segment, decoded)) {
+      request.error = "invalid escape in request path";
+      return false;
+    }
+    request.path.push_back(std::move(decoded));
+  }
+  if (qpos != std::string::npos) {
+    std::istringstream query(target.substr(qpos + 1));
+    for (std::string kv; std::getline(query, kv, '&');) {
+      auto const eq = kv.find('=');
+      auto value = eq == std::string::npos ? std::string{} : kv.substr(eq + 1);
+      std::string key;
+      std::string decoded;
+      if (!UrlDecode(kv.substr(0, eq), key) || !UrlDecode(value, decoded)) {
+        request.error = "invalid escape in request query";
+        return false;
+      }
+      request.query[std::move(key)] = std::move(decoded);
+    }
+  }
+
+  while (ReadLine(line) && !line.empty()) {
+    auto const colon = line.find(':');
+    if (colon == std::string::npos) {
+      continue;
+    }
+    auto name = ToLower(line.substr(0, colon));
+    auto value = Trim(line.substr(colon + 1));
+    auto& h = request.headers[name];
+    h = h.empty() ? value : h + "," + value;
+  }
+
+  if (ToLower(request.Header("expect")) == "100-continue") {
+    std::string const reply = "HTTP/1.1 100 Continue\r\n\r\n";
+    if (!SendAll({iovec{const_cast<char*>(reply.data()), reply.size()}})) {
+      return false;
+    }
+  }
+
+  if (ToLower(request.Header("transfer-encoding")) == "chunked") {
+    for (;;) {
+      if (!ReadLine(line)) {
+        return false;
+      }
+      // Ignore any chunk extensions.
+      auto const size = ParseUnsigned(Trim(line.substr(0, line.find(';'))), 16);
+      if (!size.has_value() ||
+          *size > request.body.max_size() - request.body.size()) {
+        request.error = "invalid chunk size";
+        return false;
+      }
+      if (*size == 0) {
+        break;
+      }
+      if (!ReadBody(static_cast<std::size_t>(*size), request.body) ||
+          !ReadLine(line)) {
+        return false;
+      }
+    }
+    // Discard any trailers.
+    while (ReadLine(line) && !line.empty()) {
+    }
+    return true;
+  }
+  auto const length = request.Header("content-length");
+  if (length.empty()) {
+    return true;
+  }
+  auto const size = ParseUnsigned(length);
+  if (!size.has_value() || *size > request.body.max_size()) {
+    request.error = "invalid Content-Length header";
+    return false;
+  }
+  return ReadBody(static_cast<std::size_t>(*size), request.body);
+}
+
+bool Connection::SendReply(HttpReply const& reply) {
+  auto const content_length =
+      reply.media ? reply.media_length : reply.body.size();
+  std::ostringstream os;
+  os << "HTTP/1.1 " << reply.status_code << " "
+     << ReasonPhrase(reply.status_code) << "\r\n";
+  for (auto const& h : reply.headers) {
+    os << h.first << ": " << h.second << "\r\n";
+  }
+  os << "Content-Length: " << content_length << "\r\n\r\n";
+  auto const head = std::move(os).str();
+
+  std::vector<iovec> iov{iovec{const_cast<char*>(head.data()), head.size()}};
+  if (reply.media) {
+    iov.push_back(iovec{const_cast<char*>(reply.media->data()) +
+                            reply.media_offset,
+                        reply.media_length});
+  } else if (!reply.body.empty()) {
+    iov.push_back(
+        iovec{const_cast<char*>(reply.body.data()), reply.body.size()});
+  }
+  return SendAll(std::move(iov));
+}
+
+bool Connection::SendAll(std::vector<iovec> iov) {
+  std::size_t index = 0;
+  while (index != iov.size()) {
+    msghdr msg{};
+    msg.msg_iov = iov.data() + index;
+    msg.msg_iovlen = iov.size() - index;
+    auto n = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    auto sent = static_cast<std::size_t>(n);
+    while (index != iov.size() && sent >= iov[index].iov_len) {
+      sent -= iov[index].iov_len;
+      ++index;
+    }
+    if (index != iov.size()) {
+      iov[index].iov_base = static_cast<char*>(iov[index].iov_base) + sent;
+      iov[index].iov_len -= sent;
+    }
+  }
+  return true;
+}
+
+struct Object {
+  std::int64_t generation;
+  std::string content_type;
+  std::string crc32c;
+  std::shared_ptr<std::string const> contents;
+};
+
+struct Bucket {
+  nl::json metadata;
+  std::map<std::string, Object> objects;
+};
+
+struct UploadSession {
+  std::string bucket;
+  std::string name;
+  std::string content_type;
+  std::string data;
+};
+
+nl::json ObjectJson(std::string const& bucket, std::string const& name,
+                    Object const& object) {
+  auto const generation = std::to_string(object.generation);
+  return nl::json{
+      {"kind", "storage#object"},
+      {"id", bucket + "/" + name + "/" + generation},
+      {"bucket", bucket},
+      {"name", name},
+      {"generation", generation},
+      {"metageneration", "1"},
+      {"size", std::to_string(object.contents->size())},
+      {"contentType", object.content_type},
+      {"crc32c", object.crc32c},
+      {"storageClass", "STANDARD"},
+  };
+}
+
+class EmbeddedServerImpl : public EmbeddedServer {
+ public:
+  EmbeddedServerImpl(int fd, int port) : listen_fd_(fd), port_(port) {}
+  ~EmbeddedServerImpl() override { ::close(listen_fd_); }
+
+  std::string address() const override {
+    return "http://127.0.0.1:" + std::to_string(port_);
+  }
+  void Shutdown() override;
+  void Wait() override;
+
+  std::int64_t upload_count() const override { return upload_count_.load(); }
+  std::int64_t download_count() const override {
+    return download_count_.load();
+  }
+  std::int64_t bytes_uploaded() const override {
+    return bytes_uploaded_.load();
+  }
+  std::int64_t bytes_downloaded() const override {
+    return bytes_downloaded_.load();
+  }
+
+ private:
+  void HandleConnection(int fd);
+  HttpReply Dispatch(HttpRequest const& request);
+
+  HttpReply CreateBucket(HttpRequest const& request);
+  HttpReply GetBucket(std::string const& bucket);
+  HttpReply DeleteBucket(std::string const& bucket);
+  HttpReply ListObjects(HttpRequest const& request, std::string const& bucket);
+  HttpReply GetObject(HttpRequest const& request, std::string const& bucket,
+                      std::string const& name);
+  HttpReply DeleteObject(HttpRequest const& request, std::string const& bucket,
+                         std::string const& name);
+  HttpReply Download(HttpRequest const& request, std::string const& bucket,
+                     std::string const& name);
+  HttpReply Upload(HttpRequest const& request, std::string const& bucket);
+  HttpReply UploadChunk(HttpRequest const& request);
+  HttpReply XmlUpload(HttpRequest const& request, std::string const& bucket,
+                      std::string const& name);
+
+  StatusOr<nl::json> InsertObject(std::string const& bucket,
+                                  std::string const& name,
+                                  std::string content_type, std::string data);
+
+  int listen_fd_;
+  int port_;
+  std::atomic<std::int64_t> upload_count_{0};
+  std::atomic<std::int64_t> download_count_{0};
+  std::atomic<std::int64_t> bytes_uploaded_{0};
+  std::atomic<std::int64_t> bytes_downloaded_{0};
+
+  std::mutex mu_;
+  bool shutdown_ = false;                  // GUARDED_BY(mu_)
+  std::set<int> connections_;              // GUARDED_BY(mu_)
+  // The worker threads that have finished and can be joined.
+  std::vector<std::thread::id> finished_;  // GUARDED_BY(mu_)
+  std::map<std::string, Bucket> buckets_;  // GUARDED_BY(mu_)
+  std::int64_t generation_ = 1000;         // GUARDED_BY(mu_)
+  std::int64_t upload_id_ = 0;             // GUARDED_BY(mu_)
+  // The resumable upload sessions, each session is used by one thread at a
+  // time.
+  std::map<std::string, std::shared_ptr<UploadSession>>
+      uploads_;  // GUARDED_BY(mu_)
+};
+
+void EmbeddedServerImpl::Shutdown() {
+  std::lock_guard<std::mutex> lk(mu_);
+  shutdown_ = true;
+  // Shutting down the sockets unblocks any threads waiting on them.
+  ::shutdown(listen_fd_, SHUT_RDWR);
+  for (auto fd : connections_) {
+    ::shutdown(fd, SHUT_RDWR);
+  }
+}
+
+void EmbeddedServerImpl::Wait() {
+  auto const initial_backoff = std::chrono::milliseconds(1);
+  auto const maximum_backoff = std::chrono::milliseconds(500);
+  auto backoff = initial_backoff;
+  std::map<std::thread::id, std::thread> workers;
+  for (;;) {
+    auto fd = ::accept(listen_fd_, nullptr, nullptr);
+    auto const accept_errno = errno;
+    std::unique_lock<std::mutex> lk(mu_);
+    // Join the workers for closed connections, otherwise a long running
+    // server accumulates one finished thread per connection. The workers only
+    // exit after releasing `mu_`, so this does not block for long.
+    for (auto const& id : finished_) {
+      auto w = workers.find(id);
+      w->second.join();
+      workers.erase(w);
+    }
+    finished_.clear();
+    if (shutdown_) {
+      if (fd >= 0) {
+        ::close(fd);
+      }
+      break;
+    }
+    if (fd < 0) {
+      if (accept_errno == EINTR || accept_errno == ECONNABORTED) {
+        continue;
+      }
+      if (accept_errno != EMFILE && accept_errno != ENFILE &&
+          accept_errno != ENOBUFS && accept_errno != ENOMEM) {
+        std::cerr << "accept() failed, stopping the embedded server: "
+                  << std::strerror(accept_errno) << "\n";
+        break;
+      }
+      // Out of resources, wait for some connections to close before trying
+      // again.
+      lk.unlock();
+      std::this_thread::sleep_for(backoff);
+      backoff = (std::min)(2 * backoff, maximum_backoff);
+      continue;
+    }
+    backoff = initial_backoff;
+    int one = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    connections_.insert(fd);
+    std::thread t([this, fd] { HandleConnection(fd); });
+    auto const id = t.get_id();
+    workers.emplace(id, std::move(t));
+  }
+  for (auto& kv : workers) {
+    kv.second.join();
+  }
+}
+
+void EmbeddedServerImpl::HandleConnection(int fd) {
+  Connection connection(fd);
+  for (;;) {
+    HttpRequest request;
+    if (!connection.ReadRequest(request)) {
+      if (!request.error.empty()) {
+        auto reply = ErrorReply(400, request.error);
+        reply.headers.emplace_back("Connection", "close");
+        connection.SendReply(reply);
+      }
+      break;
+    }
+    if (!connection.SendReply(Dispatch(request))) {
+      break;
+    }
+    if (ToLower(request.Header("connection")) == "close") {
+      break;
+    }
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  connections_.erase(fd);
+  ::close(fd);
+  finished_.push_back(std::this_thread::get_id());
+}
+
+HttpReply EmbeddedServerImpl::Dispatch(HttpRequest const& request) {
+  auto const& p = request.path;
+  auto const& m = request.method;
+  if (p.size() == 3 && p[0] == "xmlapi") {
+    if (m == "GET") {
+      return Download(request, p[1], p[2]);
+    }
+    if (m == "PUT") {
+      return XmlUpload(request, p[1], p[2]);
+    }
+  }
+  if (p.size() == 6 && p[0] == "upload" && p[1] == "storage" &&
+      p[3] == "b" && p[5] == "o") {
+    if (m == "PUT" || !request.Query("upload_id").empty()) {
+      return UploadChunk(request);
+    }
+    return Upload(request, p[4]);
+  }
+  if (p.size() >= 3 && p[0] == "storage" && p[2] == "b") {
+    if (p.size() == 3 && m == "POST") {
+      return CreateBucket(request);
+    }
+    if (p.size() == 4 && m == "GET") {
+      return GetBucket(p[3]);
+    }
+    if (p.size() == 4 && m == "DELETE") {
+      return DeleteBucket(p[3]);
+    }
+    if (p.size() == 5 && p[4] == "o" && m == "GET") {
+      return ListObjects(request, p[3]);
+    }
+    if (p.size() == 6 && p[4] == "o" && m == "GET") {
+      if (request.Query("alt") == "media") {
+        return Download(request, p[3], p[5]);
+      }
+      return GetObject(request, p[3], p[5]);
+    }
+    if (p.size() == 6 && p[4] == "o" && m == "DELETE") {
+      return DeleteObject(request, p[3], p[5]);
+    }
+  }
+  return ErrorReply(404, "unsupported request " + m);
+}
+
+HttpReply EmbeddedServerImpl::CreateBucket(HttpRequest const& request) {
+  auto resource = nl::json::parse(request.body, nullptr, false);
+  if (!resource.is_object()) {
+    return ErrorReply(400, "invalid bucket resource");
+  }
+  auto const name = resource.value("name", std::string{});
+  if (name.empty()) {
+    return ErrorReply(400, "missing bucket name");
+  }
+  nl::json metadata{
+      {"kind", "storage#bucket"},
+      {"id", name},
+      {"name", name},
+      {"metageneration", "1"},
+      {"location", resource.value("location", std::string{"US"})},
+      {"storageClass", resource.value("storageClass", std::string{"STANDARD"})},
+  };
+  std::lock_guard<std::mutex> lk(mu_);
+  if (buckets_.count(name) != 0) {
+    return ErrorReply(409, "bucket already exists");
+  }
+  buckets_[name].metadata = metadata;
+  return JsonReply(metadata);
+}
+
+HttpReply EmbeddedServerImpl::GetBucket(std::string const& bucket) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto b = buckets_.find(bucket);
+  if (b == buckets_.end()) {
+    return ErrorReply(404, "bucket not found");
+  }
+  return JsonReply(b->second.metadata);
+}
+
+HttpReply EmbeddedServerImpl::DeleteBucket(std::string const& bucket) {
+  std::lock_guard<std::mutex> lk(mu_);
+  auto b = buckets_.find(bucket);
+  if (b == buckets_.end()) {
+    return ErrorReply(404, "bucket not found");
+  }
+  if (!b->second.objects.empty()) {
+    return ErrorReply(409, "bucket is not empty");
+  }
+  buckets_.erase(b);
+  return EmptyReply(204);
+}
+
+HttpReply EmbeddedServerImpl::ListObjects(HttpRequest const& request,
+                                          std::string const& bucket) {
+  auto const prefix = request.Query("prefix");
+  auto items = nl::json::array();
+  std::lock_guard<std::mutex> lk(mu_);
+  auto b = buckets_.find(bucket);
+  if (b == buckets_.end()) {
+    return ErrorReply(404, "bucket not found");
+  }
+  for (auto const& kv : b->second.objects) {
+    if (kv.first.compare(0, prefix.size(), prefix) == 0) {
+      items.push_back(ObjectJson(bucket, kv.first, kv.second));
+    }
+  }
+  return JsonReply(nl::json{{"kind", "storage#objects"}, {"items", items}});
+}
+
+HttpReply EmbeddedServerImpl::GetObject(HttpRequest const& request,
+                                        std::string const& bucket,
+                                        std::string const& name) {
+  optional<std::uint64_t> generation;
+  if (!ParseGeneration(request, generation)) {
+    return ErrorReply(400, "invalid generation");
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  auto b = buckets_.find(bucket);
+  if (b == buckets_.end()) {
+    return ErrorReply(404, "bucket not found");
+  }
+  auto o = b->second.objects.find(name);
+  if (o == b->second.objects.end() ||
+      !GenerationMatches(generation, o->second.generation)) {
+    return ErrorReply(404, "object not found");
+  }
+  return JsonReply(ObjectJson(bucket, name, o->second));
+}
+
+HttpReply EmbeddedServerImpl::DeleteObject(HttpRequest const& request,
+                                           std::string const& bucket,
+                                           std::string const& name) {
+  optional<std::uint64_t> generation;
+  if (!ParseGeneration(request, generation)) {
+    return ErrorReply(400, "invalid generation");
+  }
+  std::lock_guard<std::mutex> lk(mu_);
+  auto b = buckets_.find(bucket);
+  if (b == buckets_.end()) {
+    return ErrorReply(404, "bucket not found");
+  }
+  auto o = b->second.objects.find(name);
+  if (o == b->second.objects.end() ||
+      !GenerationMatches(generation, o->second.generation)) {
+    return ErrorReply(404, "object not found");
+  }
+  b->second.objects.erase(o);
+  return EmptyReply(204);
+}
+
+HttpReply EmbeddedServerImpl::Download(HttpRequest const& request,
+                                       std::string const& bucket,
+                                       std::string const& name) {
+  optional<std::uint64_t> generation;
+  if (!ParseGeneration(request, generation)) {
+    return ErrorReply(400, "invalid generation");
+  }
+  Object object;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto b = buckets_.find(bucket);
+    if (b == buckets_.end()) {
+      return ErrorReply(404, "bucket not found");
+    }
+    auto o = b->second.objects.find(name);
+    if (o == b->second.objects.end()) {
+      return ErrorReply(404, "object not found");
+    }
+    object = o->second;
+  }
+  if (!GenerationMatches(generation, object.generation)) {
+    return ErrorReply(404, "object not found");
+  }
+
+  auto const size = object.contents->size();
+  HttpReply reply;
+  reply.headers.emplace_back("Content-Type", object.content_type);
+  reply.headers.emplace_back("x-goog-generation",
+                             std::to_string(object.generation));
+  reply.headers.emplace_back("x-goog-metageneration", "1");
+  reply.headers.emplace_back("x-goog-stored-content-length",
+                             std::to_string(size));
+  reply.headers.emplace_back("x-goog-hash", "crc32c=" + object.crc32c);
+  reply.media = object.contents;
+  reply.media_offset = 0;
+  reply.media_length = size;
+
+  // Only the `bytes=begin-end`, `bytes=begin-`, and `bytes=-last` forms are
+  // used by the client library.
+  auto const range = request.Header("range");
+  char const prefix[] = "bytes=";
+  if (range.rfind(prefix, 0) == 0) {
+    auto const spec = range.substr(sizeof(prefix) - 1);
+    auto const dash = spec.find('-');
+    std::uint64_t begin = 0;
+    std::uint64_t end = size;
+    if (dash == 0) {
+      auto const last = ParseUnsigned(spec.substr(1));
+      if (!last.has_value()) {
+        return ErrorReply(400, "invalid Range header");
+      }
+      begin = size - (std::min<std::uint64_t>)(size, *last);
+    } else {
+      auto const first = ParseUnsigned(spec.substr(0, dash));
+      if (!first.has_value()) {
+        return ErrorReply(400, "invalid Range header");
+      }
+      begin = *first;
+      if (dash + 1 < spec.size()) {
+        auto const last = ParseUnsigned(spec.substr(dash + 1));
+        if (!last.has_value()) {
+          return ErrorReply(400, "invalid Range header");
+        }
+        // Avoid overflow computing `*last + 1`.
+        end = *last < size ? *last + 1 : size;
+      }
+    }
+    if (begin >= size && size != 0) {
+      return ErrorReply(416, "requested range not satisfiable");
+    }
+    begin = (std::min)(begin, end);
+    reply.status_code = 206;
+    reply.media_offset = static_cast<std::size_t>(begin);
+    reply.media_length = static_cast<std::size_t>(end - begin);
+    reply.headers.emplace_back("Content-Range",
+                               "bytes " + std::to_string(begin) + "-" +
+                                   std::to_string(end - 1) + "/" +
+                                   std::to_string(size));
+  }
+  ++download_count_;
+  bytes_downloaded_ += static_cast<std::int64_t>(reply.media_length);
+  return reply;
+}
+
+StatusOr<nl::json> EmbeddedServerImpl::InsertObject(std::string const& bucket,
+                                                    std::string const& name,
+                                                    std::string content_type,
+                                                    std::string data) {
+  Object object;
+  object.content_type = content_type.empty() ? "application/octet-stream"
+                                             : std::move(content_type);
+  object.crc32c = gcs::ComputeCrc32cChecksum(data);
+  object.contents = std::make_shared<std::string const>(std::move(data));
+
+  std::lock_guard<std::mutex> lk(mu_);
+  auto b = buckets_.find(bucket);
+  if (b == buckets_.end()) {
+    return Status(StatusCode::kNotFound, "bucket not found");
+  }
+  object.generation = ++generation_;
+  ++upload_count_;
+  bytes_uploaded_ += static_cast<std::int64_t>(object.contents->size());
+  auto& o = b->second.objects[name];
+  o = std::move(object);
+  return ObjectJson(bucket, name, o);
+}
+
+HttpReply EmbeddedServerImpl::Upload(HttpRequest const& request,
+                                     std::string const& bucket) {
+  auto const upload_type = request.Query("uploadType");
+  auto name = request.Query("name");
+  auto content_type = request.Header("content-type");
+
+  if (upload_type == "resumable") {
+    if (!request.body.empty()) {
+      auto resource = nl::json::parse(request.body, nullptr, false);
+      if (resource.is_object()) {
+        name = resource.value("name", name);
+        content_type = resource.value("contentType", std::string{});
+      }
+    } else {
+      content_type.clear();
+    }
+    auto upload = std::make_shared<UploadSession>();
+    upload->bucket = bucket;
+    upload->name = name;
+    upload->content_type = content_type;
+    std::string upload_id;
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      upload_id = std::to_string(++upload_id_);
+      uploads_[upload_id] = std::move(upload);
+    }
+    auto reply = EmptyReply(200);
+    reply.headers.emplace_back("Location",
+                               address() + "/upload/storage/v1/b/" + bucket +
+                                   "/o?uploadType=resumable&upload_id=" +
+                                   upload_id);
+    return reply;
+  }
+
+  std::string data;
+  if (upload_type == "multipart") {
+    // The payload is a `multipart/related` message, with the object metadata
+    // in the first part and the object contents in the second part.
+    auto const bpos = content_type.find("boundary=");
+    if (bpos == std::string::npos) {
+      return ErrorReply(400, "missing multipart boundary");
+    }
+    auto boundary = content_type.substr(bpos + 9);
+    if (!boundary.empty() && boundary.front() == '"') {
+      boundary = boundary.substr(1, boundary.find('"', 1) - 1);
+    }
+    auto const marker = "--" + boundary;
+    auto const p1 = request.body.find(marker);
+    auto const p2 = request.body.find(marker, p1 + marker.size());
+    auto const p3 = request.body.find("\r\n" + marker + "--", p2);
+    if (p1 == std::string::npos || p2 == std::string::npos ||
+        p3 == std::string::npos) {
+      return ErrorReply(400, "invalid multipart payload");
+    }
+    auto const m1 = request.body.find("\r\n\r\n", p1);
+    auto const m2 = request.body.find("\r\n\r\n", p2);
+    if (m1 == std::string::npos || m2 == std::string::npos || m2 > p3) {
+      return ErrorReply(400, "invalid multipart payload");
+    }
+    auto resource = nl::json::parse(
+        request.body.substr(m1 + 4, p2 - m1 - 4), nullptr, false);
+    content_type.clear();
+    if (resource.is_object()) {
+      name = resource.value("name", name);
+      content_type = resource.value("contentType", std::string{});
+    }
+    data = request.body.substr(m2 + 4, p3 - m2 - 4);
+  } else {
+    data = request.body;
+  }
+  if (name.empty()) {
+    return ErrorReply(400, "missing object name");
+  }
+  auto metadata =
+      InsertObject(bucket, name, std::move(content_type), std::move(data));
+  if (!metadata) {
+    return ErrorReply(404, metadata.status().message());
+  }
+  return JsonReply(*metadata);
+}
+
+HttpReply EmbeddedServerImpl::UploadChunk(HttpRequest const& request) {
+  std::shared_ptr<UploadSession> upload;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    auto u = uploads_.find(request.Query("upload_id"));
+    if (u == uploads_.end()) {
+      return ErrorReply(404, "upload session not found");
+    }
+    upload = u->second;
+  }
+  if (request.method == "DELETE") {
+    std::lock_guard<std::mutex> lk(mu_);
+    uploads_.erase(request.Query("upload_id"));
+    return EmptyReply(499);
+  }
+
+  // The Content-Range header has one of these forms: `bytes */*`,
+  // `bytes */total`, `bytes begin-end/*`, or `bytes begin-end/total`.
+  auto const range = request.Header("content-range");
+  char const prefix[] = "bytes ";
+  if (range.rfind(prefix, 0) != 0) {
+    return ErrorReply(400, "invalid Content-Range header");
+  }
+  auto const spec = range.substr(sizeof(prefix) - 1);
+  auto const slash = spec.find('/');
+  if (slash == std::string::npos) {
+    return ErrorReply(400, "invalid Content-Range header");
+  }
+  auto const sent = spec.substr(0, slash);
+  auto const total = spec.substr(slash + 1);
+  // The application may send the same data more than once (e.g. after a
+  // timeout), only append the new bytes.
+  auto const total_size =
+      total == "*" ? optional<std::uint64_t>{} : ParseUnsigned(total);
+  if (total != "*" && !total_size.has_value()) {
+    return ErrorReply(400, "invalid Content-Range header");
+  }
+  if (sent != "*") {
+    auto const begin = ParseUnsigned(sent.substr(0, sent.find('-')));
+    if (!begin.has_value()) {
+      return ErrorReply(400, "invalid Content-Range header");
+    }
+    auto const size = upload->data.size();
+    if (*begin <= size && request.body.size() > size - *begin) {
+      upload->data.append(request.body, size - *begin, std::string::npos);
+    }
+  }
+  if (total_size.has_value() && *total_size == upload->data.size()) {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      uploads_.erase(request.Query("upload_id"));
+    }
+    auto metadata =
+        InsertObject(upload->bucket, upload->name,
+                     std::move(upload->content_type), std::move(upload->data));
+    if (!metadata) {
+      return ErrorReply(404, metadata.status().message());
+    }
+    return JsonReply(*metadata);
+  }
+  auto reply = EmptyReply(308);
+  if (!upload->data.empty()) {
+    reply.headers.emplace_back(
+        "Range", "bytes=0-" + std::to_string(upload->data.size() - 1));
+  }
+  return reply;
+}
+
+HttpReply EmbeddedServerImpl::XmlUpload(HttpRequest const& request,
+                                        std::string const& bucket,
+                                        std::string const& name) {
+  auto metadata = InsertObject(bucket, name, request.Header("content-type"),
+                               request.body);
+  if (!metadata) {
+    return ErrorReply(404, metadata.status().message());
+  }
+  auto reply = EmptyReply(200);
+  reply.headers.emplace_back("x-goog-generation",
+                             metadata->value("generation", ""));
+  return reply;
+}
+
+}  // namespace
+
+StatusOr<std::unique_ptr<EmbeddedServer>> CreateEmbeddedServer() {
+  auto error = [](char const* where) {
+    return Status(StatusCode::kUnavailable,
+                  std::string("CreateEmbeddedServer() - ") + where +
+                      " failed: " + std::strerror(errno));
+  };
+  auto fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return error("socket()");
+  }
+  int one = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0;
+  socklen_t length = sizeof(address);
+  if (::bind(fd, reinterpret_cast<sockaddr*>(&address), length) != 0 ||
+      ::listen(fd, 128) != 0 ||
+      ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+    auto status = error("bind()/listen()");
+    ::close(fd);
+    return status;
+  }
+  return std::unique_ptr<EmbeddedServer>(
+      new EmbeddedServerImpl(fd, ntohs(address.sin_port)));
+}
+#else
+StatusOr<std::unique_ptr<EmbeddedServer>> CreateEmbeddedServer() {
+  return Status(StatusCode::kUnimplemented,
+                "the embedded server is not supported on this platform");
+}
+#endif  // _WIN32
+
+void UseEmbeddedServer(EmbeddedServer const& server) {
+  google::cloud::internal::SetEnv("CLOUD_STORAGE_TESTBENCH_ENDPOINT",
+                                  server.address().c_str());
+}
+
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
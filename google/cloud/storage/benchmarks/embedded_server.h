@@ -0,0 +1,102 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_EMBEDDED_SERVER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_EMBEDDED_SERVER_H
+
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+/**
+ * An abstract class to run and stop the embedded GCS server.
+ *
+ * Sometimes it is interesting to run performance benchmarks against an
+ * embedded server, as this eliminates the network (and the service) as sources
+ * of variation when measuring small changes to the library. This class is used
+ * to run (using Wait()) and stop (using Shutdown()) such a server, without
+ * exposing the implementation details to the application.
+ *
+ * The server is a minimal HTTP/1.1 server listening on the loopback interface.
+ * It keeps all the data in memory, and implements only the subset of the JSON
+ * and XML APIs used by the storage benchmarks:
+ *
+ * - Create, get, and delete buckets.
+ * - Simple, multipart, and resumable uploads, and XML uploads.
+ * - Get and delete objects, and list the objects in a bucket.
+ * - Downloads (JSON and XML), including ranged downloads.
+ *
+ * Objects report their CRC32C checksum but not their MD5 hash, computing the
+ * latter would dominate the server CPU usage.
+ */
+class EmbeddedServer {
+ public:
+  virtual ~EmbeddedServer() = default;
+
+  /// The endpoint for the server, for example `http://127.0.0.1:12345`.
+  virtual std::string address() const = 0;
+  virtual void Shutdown() = 0;
+  virtual void Wait() = 0;
+
+  virtual std::int64_t upload_count() const = 0;
+  virtual std::int64_t download_count() const = 0;
+  virtual std::int64_t bytes_uploaded() const = 0;
+  virtual std::int64_t bytes_downloaded() const = 0;
+};
+
+/// Create an embedded server listening on an ephemeral port.
+StatusOr<std::unique_ptr<EmbeddedServer>> CreateEmbeddedServer();
+
+/**
+ * Configure the client library to use @p server.
+ *
+ * The client library uses the production endpoints for some XML API requests
+ * unless the `CLOUD_STORAGE_TESTBENCH_ENDPOINT` environment variable is set,
+ * this function sets the variable. Any `storage::ClientOptions` created after
+ * this call use the embedded server and anonymous credentials.
+ */
+void UseEmbeddedServer(EmbeddedServer const& server);
+
+/**
+ * Runs an embedded server in a background thread.
+ *
+ * The server is shutdown, and the background thread joined, when this object
+ * is destroyed.
+ */
+class ScopedEmbeddedServer {
+ public:
+  explicit ScopedEmbeddedServer(std::unique_ptr<EmbeddedServer> server)
+      : server_(std::move(server)), thread_([this] { server_->Wait(); }) {}
+  ~ScopedEmbeddedServer() {
+    server_->Shutdown();
+    thread_.join();
+  }
+
+  EmbeddedServer& server() { return *server_; }
+
+ private:
+  std::unique_ptr<EmbeddedServer> server_;
+  std::thread thread_;
+};
+
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BENCHMARKS_EMBEDDED_SERVER_H
@@ -0,0 +1,290 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/benchmarks/embedded_server.h"
+#include "google/cloud/storage/benchmarks/benchmark_utils.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/internal/random.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include "google/cloud/testing_util/scoped_environment.h"
+#include <gmock/gmock.h>
+#include <thread>
+#include <vector>
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage_benchmarks {
+namespace {
+
+namespace gcs = ::google::cloud::storage;
+using ::testing::ElementsAre;
+using ::testing::StartsWith;
+
+class EmbeddedServerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto server = CreateEmbeddedServer();
+    ASSERT_STATUS_OK(server);
+    server_.reset(new ScopedEmbeddedServer(*std::move(server)));
+    endpoint_.reset(new testing_util::ScopedEnvironment(
+        "CLOUD_STORAGE_TESTBENCH_ENDPOINT", server_->server().address()));
+    auto options = gcs::ClientOptions::CreateDefaultClientOptions();
+    ASSERT_STATUS_OK(options);
+    options->set_project_id("test-project");
+    client_.reset(new gcs::Client(*std::move(options)));
+    ASSERT_STATUS_OK(
+        client_->CreateBucket(kBucketName, gcs::BucketMetadata()));
+  }
+
+  void TearDown() override {
+    client_.reset();
+    endpoint_.reset();
+    server_.reset();
+  }
+
+  std::string ReadAll(gcs::ObjectReadStream stream) {
+    std::string contents{std::istreambuf_iterator<char>{stream}, {}};
+    EXPECT_STATUS_OK(stream.status());
+    return contents;
+  }
+
+  std::string const kBucketName = "test-bucket";
+  google::cloud::internal::DefaultPRNG generator_ =
+      google::cloud::internal::MakeDefaultPRNG();
+  std::unique_ptr<ScopedEmbeddedServer> server_;
+  std::unique_ptr<testing_util::ScopedEnvironment> endpoint_;
+  std::unique_ptr<gcs::Client> client_;
+};
+
+TEST_F(EmbeddedServerTest, Buckets) {
+  auto metadata = client_->GetBucketMetadata(kBucketName);
+  ASSERT_STATUS_OK(metadata);
+  EXPECT_EQ(kBucketName, metadata->name());
+
+  // Creating the same bucket twice fails.
+  EXPECT_FALSE(client_->CreateBucket(kBucketName, gcs::BucketMetadata()).ok());
+
+  EXPECT_STATUS_OK(client_->DeleteBucket(kBucketName));
+  EXPECT_FALSE(client_->GetBucketMetadata(kBucketName).ok());
+}
+
+TEST_F(EmbeddedServerTest, InsertAndRead) {
+  auto const contents = MakeRandomData(generator_, 64 * kKiB);
+
+  // Use the multipart, simple, and XML uploads.
+  auto multipart = client_->InsertObject(kBucketName, "multipart", contents);
+  ASSERT_STATUS_OK(multipart);
+  EXPECT_EQ(contents.size(), multipart->size());
+  EXPECT_EQ(gcs::ComputeCrc32cChecksum(contents), multipart->crc32c());
+
+  auto simple = client_->InsertObject(kBucketName, "simple", contents,
+                                      gcs::DisableMD5Hash(true),
+                                      gcs::DisableCrc32cChecksum(true));
+  ASSERT_STATUS_OK(simple);
+  EXPECT_EQ(contents.size(), simple->size());
+
+  auto xml = client_->InsertObject(kBucketName, "xml", contents,
+                                   gcs::Fields(""));
+  ASSERT_STATUS_OK(xml);
+
+  for (auto const* name : {"multipart", "simple", "xml"}) {
+    SCOPED_TRACE(name);
+    auto metadata = client_->GetObjectMetadata(kBucketName, name);
+    ASSERT_STATUS_OK(metadata);
+    EXPECT_EQ(contents.size(), metadata->size());
+    // The default download uses the XML API, `QuotaUser` requires the JSON
+    // API.
+    EXPECT_EQ(contents, ReadAll(client_->ReadObject(kBucketName, name)));
+    EXPECT_EQ(contents, ReadAll(client_->ReadObject(kBucketName, name,
+                                                    gcs::QuotaUser("test"))));
+  }
+  EXPECT_EQ(3, server_->server().upload_count());
+  EXPECT_EQ(6, server_->server().download_count());
+}
+
+TEST_F(EmbeddedServerTest, RangedRead) {
+  auto const contents = MakeRandomData(generator_, 1000);
+  ASSERT_STATUS_OK(client_->InsertObject(kBucketName, "test-object", contents));
+
+  EXPECT_EQ(contents.substr(100, 200),
+            ReadAll(client_->ReadObject(kBucketName, "test-object",
+                                        gcs::ReadRange(100, 300))));
+  EXPECT_EQ(contents.substr(900),
+            ReadAll(client_->ReadObject(kBucketName, "test-object",
+                                        gcs::ReadFromOffset(900))));
+  EXPECT_EQ(contents.substr(950),
+            ReadAll(client_->ReadObject(kBucketName, "test-object",
+                                        gcs::ReadLast(50))));
+}
+
+TEST_F(EmbeddedServerTest, ResumableUpload) {
+  auto const contents = MakeRandomData(generator_, 3 * kMiB + 1234);
+  auto writer = client_->WriteObject(kBucketName, "test-object");
+  for (std::size_t offset = 0; offset < contents.size(); offset += 100000) {
+    writer.write(contents.data() + offset,
+                 (std::min<std::size_t>)(100000, contents.size() - offset));
+  }
+  writer.Close();
+  auto metadata = writer.metadata();
+  ASSERT_STATUS_OK(metadata);
+  EXPECT_EQ(contents.size(), metadata->size());
+  EXPECT_EQ(contents, ReadAll(client_->ReadObject(
+                          kBucketName, "test-object",
+                          gcs::Generation(metadata->generation()))));
+}
+
+TEST_F(EmbeddedServerTest, ListAndDelete) {
+  for (auto const* name : {"a", "b", "c"}) {
+    ASSERT_STATUS_OK(client_->InsertObject(kBucketName, name, "data"));
+  }
+  std::vector<std::string> names;
+  for (auto& o : client_->ListObjects(kBucketName)) {
+    ASSERT_STATUS_OK(o);
+    names.push_back(o->name());
+  }
+  EXPECT_THAT(names, ElementsAre("a", "b", "c"));
+
+  DeleteAllObjects(*client_, kBucketName, 2);
+  auto reader = client_->ListObjects(kBucketName);
+  EXPECT_EQ(0, std::distance(reader.begin(), reader.end()));
+  EXPECT_STATUS_OK(client_->DeleteBucket(kBucketName));
+}
+
+TEST_F(EmbeddedServerTest, RequestMetrics) {
+  auto metrics = std::make_shared<gcs::HistogramRequestMetrics>();
+  auto options = gcs::ClientOptions::CreateDefaultClientOptions();
+  ASSERT_STATUS_OK(options);
+  options->set_project_id("test-project").set_request_metrics(metrics);
+  gcs::Client client(*std::move(options));
+
+  auto const contents = MakeRandomData(generator_, 64 * kKiB);
+  ASSERT_STATUS_OK(client.InsertObject(kBucketName, "test-object", contents));
+  EXPECT_EQ(contents, ReadAll(client.ReadObject(kBucketName, "test-object")));
+  EXPECT_FALSE(client.GetObjectMetadata(kBucketName, "not-found").ok());
+
+  EXPECT_EQ(3, metrics->requests());
+  EXPECT_EQ(1, metrics->errors());
+  EXPECT_EQ(0, metrics->retries());
+  EXPECT_LE(contents.size(), metrics->bytes_sent());
+  EXPECT_LE(contents.size(), metrics->bytes_received());
+  EXPECT_EQ(3, metrics->total().count());
+  EXPECT_EQ(3, metrics->time_to_first_byte().count());
+  EXPECT_LT(0, metrics->total().sum().count());
+}
+
+TEST_F(EmbeddedServerTest, Http2Option) {
+  // The embedded server only speaks HTTP/1.1 (and without TLS libcurl would
+  // not negotiate HTTP/2 anyway), this verifies the requests still work when
+  // they run in the client's event loop.
+  auto options = gcs::ClientOptions::CreateDefaultClientOptions();
+  ASSERT_STATUS_OK(options);
+  options->set_project_id("test-project");
+  options->channel_options().set_enable_http2(true);
+  gcs::Client client(*std::move(options));
+
+  auto const contents = MakeRandomData(generator_, 4 * kKiB);
+  std::vector<std::thread> threads;
+  std::vector<Status> results(8);
+  for (std::size_t i = 0; i != results.size(); ++i) {
+    threads.emplace_back([&client, &contents, &results, i, this] {
+      auto const name = "test-object-" + std::to_string(i);
+      auto insert = client.InsertObject(kBucketName, name, contents);
+      if (!insert) {
+        results[i] = std::move(insert).status();
+        return;
+      }
+      auto metadata = client.GetObjectMetadata(kBucketName, name);
+      if (!metadata) {
+        results[i] = std::move(metadata).status();
+        return;
+      }
+      results[i] = client.DeleteObject(kBucketName, name);
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  for (auto const& status : results) {
+    EXPECT_STATUS_OK(status);
+  }
+}
+
+#ifndef _WIN32
+/// Sends @p request over a new connection and returns the full reply.
+std::string RawRequest(std::string const& address, std::string const& request) {
+  auto const port = std::stoi(address.substr(address.rfind(':') + 1));
+  auto fd = ::socket(AF_INET, SOCK_STREAM, 0);
+  EXPECT_LE(0, fd);
+  sockaddr_in server{};
+  server.sin_family = AF_INET;
+  server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  server.sin_port = htons(static_cast<std::uint16_t>(port));
+  EXPECT_EQ(0, ::connect(fd, reinterpret_cast<sockaddr*>(&server),
+                         sizeof(server)));
+  EXPECT_EQ(static_cast<ssize_t>(request.size()),
+            ::send(fd, request.data(), request.size(), 0));
+  // The server closes the connection after rejecting a malformed request, or
+  // when the request includes `Connection: close`.
+  std::string reply;
+  char buffer[4096];
+  for (ssize_t n; (n = ::recv(fd, buffer, sizeof(buffer), 0)) > 0;) {
+    reply.append(buffer, static_cast<std::size_t>(n));
+  }
+  ::close(fd);
+  return reply;
+}
+
+TEST_F(EmbeddedServerTest, MalformedRequests) {
+  auto const address = server_->server().address();
+  std::string const requests[] = {
+      "GET /storage/v1/b/test-bucket/o/%zz HTTP/1.1\r\n\r\n",
+      "GET /storage/v1/b/test-bucket/o/obj?generation=abc HTTP/1.1\r\n"
+      "Connection: close\r\n\r\n",
+      "GET /storage/v1/b/test-bucket/o/obj?generation=-1 HTTP/1.1\r\n"
+      "Connection: close\r\n\r\n",
+      "PUT /xmlapi/test-bucket/obj HTTP/1.1\r\nContent-Length: x\r\n\r\n",
+      "PUT /xmlapi/test-bucket/obj HTTP/1.1\r\n"
+      "Content-Length: 99999999999999999999999\r\n\r\n",
+      "PUT /xmlapi/test-bucket/obj HTTP/1.1\r\n"
+      "Transfer-Encoding: chunked\r\n\r\nzz\r\n",
+  };
+  for (auto const& r : requests) {
+    EXPECT_THAT(RawRequest(address, r), StartsWith("HTTP/1.1 400"))
+        << "request=" << r;
+  }
+
+  ASSERT_STATUS_OK(client_->InsertObject(kBucketName, "test-object", "data"));
+  std::string const ranges[] = {"bytes=x-", "bytes=-x", "bytes=1-x"};
+  for (auto const& range : ranges) {
+    auto const r = "GET /xmlapi/" + kBucketName + "/test-object HTTP/1.1\r\n" +
+                   "Range: " + range + "\r\nConnection: close\r\n\r\n";
+    EXPECT_THAT(RawRequest(address, r), StartsWith("HTTP/1.1 400"))
+        << "range=" << range;
+  }
+
+  // The server is still usable.
+  EXPECT_STATUS_OK(client_->GetBucketMetadata(kBucketName));
+}
+#endif  // _WIN32
+
+}  // namespace
+}  // namespace storage_benchmarks
+}  // namespace cloud
+}  // namespace google
@@ -21,6 +21,7 @@ storage_benchmark_programs = [
     "storage_latency_benchmark.cc",
     "storage_parallel_uploads_benchmark.cc",
     "storage_shard_throughput_benchmark.cc",
+    "storage_signed_url_benchmark.cc",
     "storage_throughput_benchmark.cc",
     "storage_throughput_vs_cpu_benchmark.cc",
 ]
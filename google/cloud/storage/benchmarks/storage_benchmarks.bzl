@@ -19,8 +19,10 @@
 storage_benchmarks_hdrs = [
     "benchmark_utils.h",
     "bounded_queue.h",
+    "embedded_server.h",
 ]
 
 storage_benchmarks_srcs = [
     "benchmark_utils.cc",
+    "embedded_server.cc",
 ]
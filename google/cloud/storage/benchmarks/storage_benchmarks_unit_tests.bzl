@@ -21,4 +21,5 @@ storage_benchmarks_unit_tests = [
     "benchmark_make_random_test.cc",
     "benchmark_parse_args_test.cc",
     "benchmark_utils_test.cc",
+    "embedded_server_test.cc",
 ]
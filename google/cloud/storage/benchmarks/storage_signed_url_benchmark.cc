@@ -0,0 +1,255 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/benchmarks/benchmark_utils.h"
+#include "google/cloud/storage/bulk_operations.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/internal/build_info.h"
+#include "google/cloud/internal/format_time_point.h"
+#include "google/cloud/internal/getenv.h"
+#include "google/cloud/internal/random.h"
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+
+namespace {
+namespace gcs = google::cloud::storage;
+namespace gcs_bm = google::cloud::storage_benchmarks;
+
+char const kDescription[] = R"""(
+A benchmark for the creation of V4 signed URLs.
+
+This program measures how many V4 signed URLs per second the Google Cloud
+Storage C++ client library can create. Creating signed URLs with a service
+account key file does not require any RPCs, the benchmark measures the CPU cost
+of computing the canonical request, its hash, and the RSA signature.
+
+The program loads the service account key file configured in the command line,
+generates a number of random object names, and then signs a URL for each
+object using `BulkCreateV4SignedUrls()` with the configured number of threads.
+The program repeats this "iteration" a number of times, and reports the number
+of URLs, the elapsed time (in microseconds), the CPU time (in microseconds) and
+the URLs per second for each iteration.
+
+The buckets and objects do not need to exist.
+)""";
+
+struct Options {
+  std::string key_file;
+  std::string bucket_name = "fake-bucket";
+  int thread_count = 1;
+  long url_count = 10000;
+  long iteration_count = 10;
+};
+
+google::cloud::StatusOr<Options> ParseArgs(int argc, char* argv[]);
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::cloud::StatusOr<Options> options = ParseArgs(argc, argv);
+  if (!options) {
+    std::cerr << options.status() << "\n";
+    return 1;
+  }
+
+  auto credentials = gcs::oauth2::CreateServiceAccountCredentialsFromFilePath(
+      options->key_file);
+  if (!credentials) {
+    std::cerr << "Could not load the service account key file, status="
+              << credentials.status() << "\n";
+    return 1;
+  }
+  gcs::Client client(gcs::ClientOptions(*std::move(credentials)));
+
+  google::cloud::internal::DefaultPRNG generator =
+      google::cloud::internal::MakeDefaultPRNG();
+  std::vector<std::string> object_names(options->url_count);
+  std::generate(object_names.begin(), object_names.end(), [&generator] {
+    return gcs_bm::MakeRandomObjectName(generator);
+  });
+
+  std::string notes = google::cloud::storage::version_string() + ";" +
+                      google::cloud::internal::compiler() + ";" +
+                      google::cloud::internal::compiler_flags();
+  std::transform(notes.begin(), notes.end(), notes.begin(),
+                 [](char c) { return c == '\n' ? ';' : c; });
+  std::cout << "# Start time: "
+            << google::cloud::internal::FormatRfc3339(
+                   std::chrono::system_clock::now())
+            << "\n# Thread Count: " << options->thread_count
+            << "\n# URL Count: " << options->url_count
+            << "\n# Iteration Count: " << options->iteration_count
+            << "\n# Build info: " << notes << std::endl;
+
+  std::cout << "Iteration,UrlCount,ErrorCount,ElapsedTimeUs,CpuTimeUs,"
+               "UrlsPerSecond\n";
+  double urls_per_second_sum = 0.0;
+  for (long i = 0; i != options->iteration_count; ++i) {
+    gcs_bm::SimpleTimer timer;
+    timer.Start();
+    auto urls = gcs::BulkCreateV4SignedUrls(
+        client, "GET", options->bucket_name, object_names,
+        gcs::MaxStreams(options->thread_count),
+        gcs::SignedUrlTimestamp(std::chrono::system_clock::now()));
+    timer.Stop();
+
+    auto const error_count =
+        std::count_if(urls.begin(), urls.end(),
+                      [](google::cloud::StatusOr<std::string> const& url) {
+                        return !url.ok();
+                      });
+    auto const elapsed = (std::max)(timer.elapsed_time().count(),
+                                    std::chrono::microseconds::rep(1));
+    auto const urls_per_second = static_cast<double>(urls.size()) *
+                                 std::chrono::microseconds::period::den /
+                                 static_cast<double>(elapsed);
+    urls_per_second_sum += urls_per_second;
+    std::cout << i << ',' << urls.size() << ',' << error_count << ','
+              << timer.elapsed_time().count() << ','
+              << timer.cpu_time().count() << ',' << urls_per_second
+              << std::endl;
+    if (error_count != 0) {
+      auto const& first_error =
+          *std::find_if(urls.begin(), urls.end(),
+                        [](google::cloud::StatusOr<std::string> const& url) {
+                          return !url.ok();
+                        });
+      std::cerr << "# Error creating signed URLs, status="
+                << first_error.status() << "\n";
+      return 1;
+    }
+  }
+
+  if (options->iteration_count > 0) {
+    std::cout << "# Average URLs per second: "
+              << urls_per_second_sum / options->iteration_count << "\n";
+  }
+  return 0;
+}
+
+namespace {
+
+google::cloud::StatusOr<Options> ParseArgsDefault(
+    std::vector<std::string> argv) {
+  Options options;
+  bool wants_help = false;
+  bool wants_description = false;
+  std::vector<gcs_bm::OptionDescriptor> desc{
+      {"--help", "print usage information",
+       [&wants_help](std::string const&) { wants_help = true; }},
+      {"--description", "print benchmark description",
+       [&wants_description](std::string const&) { wants_description = true; }},
+      {"--key-file", "the service account key file used to sign the URLs",
+       [&options](std::string const& val) { options.key_file = val; }},
+      {"--bucket-name", "the bucket name used in the signed URLs",
+       [&options](std::string const& val) { options.bucket_name = val; }},
+      {"--thread-count", "set the number of threads in the benchmark",
+       [&options](std::string const& val) {
+         options.thread_count = std::stoi(val);
+       }},
+      {"--url-count", "set the number of URLs created in each iteration",
+       [&options](std::string const& val) {
+         options.url_count = std::stol(val);
+       }},
+      {"--iteration-count",
+       "set the number of samples captured by the benchmark",
+       [&options](std::string const& val) {
+         options.iteration_count = std::stol(val);
+       }},
+  };
+  auto usage = gcs_bm::BuildUsage(desc, argv[0]);
+
+  auto unparsed = gcs_bm::OptionsParse(desc, argv);
+  if (wants_help) {
+    std::cout << usage << "\n";
+  }
+
+  if (wants_description) {
+    std::cout << kDescription << "\n";
+  }
+
+  if (unparsed.size() > 2) {
+    std::ostringstream os;
+    os << "Unknown arguments or options\n" << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  if (unparsed.size() == 2) {
+    options.key_file = unparsed[1];
+  }
+  if (options.key_file.empty()) {
+    std::ostringstream os;
+    os << "Missing value for --key-file option" << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+  if (options.thread_count <= 0) {
+    std::ostringstream os;
+    os << "Invalid value for --thread-count option" << usage << "\n";
+    return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
+                                 std::move(os).str()};
+  }
+
+  return options;
+}
+
+google::cloud::StatusOr<Options> SelfTest() {
+  using google::cloud::internal::GetEnv;
+
+  google::cloud::Status const self_test_error(
+      google::cloud::StatusCode::kUnknown, "self-test failure");
+
+  {
+    auto options = ParseArgsDefault(
+        {"self-test", "--help", "--description", "fake-key-file.json"});
+    if (!options) return options;
+  }
+  {
+    // Missing the key file should be an error
+    auto options = ParseArgsDefault({"self-test"});
+    if (options) return self_test_error;
+  }
+  {
+    // Too many positional arguments should be an error
+    auto options = ParseArgsDefault({"self-test", "unused-1", "unused-2"});
+    if (options) return self_test_error;
+  }
+
+  auto const key_file =
+      GetEnv("GOOGLE_CLOUD_CPP_STORAGE_TEST_KEY_FILE_JSON").value_or("");
+  if (key_file.empty()) {
+    return google::cloud::Status(
+        google::cloud::StatusCode::kUnknown,
+        "The environment variable GOOGLE_CLOUD_CPP_STORAGE_TEST_KEY_FILE_JSON"
+        " is not set or empty");
+  }
+  return ParseArgsDefault({
+      "self-test",
+      "--key-file=" + key_file,
+      "--thread-count=2",
+      "--url-count=100",
+      "--iteration-count=2",
+  });
+}
+
+google::cloud::StatusOr<Options> ParseArgs(int argc, char* argv[]) {
+  bool auto_run =
+      google::cloud::internal::GetEnv("GOOGLE_CLOUD_CPP_AUTO_RUN_EXAMPLES")
+          .value_or("") == "yes";
+  if (auto_run) return SelfTest();
+
+  return ParseArgsDefault({argv, argv + argc});
+}
+
+}  // namespace
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/benchmarks/benchmark_utils.h"
+#include "google/cloud/storage/benchmarks/embedded_server.h"
 #include "google/cloud/storage/client.h"
 #include "google/cloud/internal/build_info.h"
 #include "google/cloud/internal/format_time_point.h"
@@ -83,6 +84,7 @@ struct Options {
   bool create_objects = true;
   bool upload_objects = true;
   bool download_objects = true;
+  bool embedded_server = false;
 
   bool exit_success = false;
 };
@@ -125,6 +127,20 @@ int main(int argc, char* argv[]) {
     return 0;
   }
 
+  std::unique_ptr<gcs_bm::ScopedEmbeddedServer> embedded_server;
+  if (options->embedded_server) {
+    auto server = gcs_bm::CreateEmbeddedServer();
+    if (!server) {
+      std::cerr << "Could not create embedded server, status="
+                << server.status() << "\n";
+      return 1;
+    }
+    embedded_server.reset(new gcs_bm::ScopedEmbeddedServer(*std::move(server)));
+    gcs_bm::UseEmbeddedServer(embedded_server->server());
+    std::cout << "# Running embedded GCS server at "
+              << embedded_server->server().address() << "\n";
+  }
+
   google::cloud::StatusOr<gcs::ClientOptions> client_options =
       gcs::ClientOptions::CreateDefaultClientOptions();
   if (!client_options) {
@@ -194,6 +210,7 @@ int main(int argc, char* argv[]) {
             << "\n# Create Objects: " << options->create_objects
             << "\n# Upload Objects: " << options->upload_objects
             << "\n# Download Objects: " << options->download_objects
+            << "\n# Embedded Server: " << options->embedded_server
             << "\n# Build info: " << notes
             << "\n# OpType,ApiName,Bytes,ElapsedTime(us)" << std::endl;
 
@@ -545,6 +562,11 @@ google::cloud::StatusOr<Options> ParseArgsDefault(
        [&options](std::string const& val) {
          options.download_objects = gcs_bm::ParseBoolean(val).value_or(true);
        }},
+      {"--embedded-server",
+       "run the benchmark against an in-process server, without network access",
+       [&options](std::string const& val) {
+         options.embedded_server = gcs_bm::ParseBoolean(val).value_or(true);
+       }},
       {"--minimum-sample-count",
        "continue the test until at least this number of samples are obtained",
        [&options](std::string const& val) {
@@ -581,7 +603,8 @@ google::cloud::StatusOr<Options> ParseArgsDefault(
     return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
                                  std::move(os).str()};
   }
-  if (options.region.empty() && options.bucket_name.empty()) {
+  if (options.region.empty() && options.bucket_name.empty() &&
+      !options.embedded_server) {
     std::ostringstream os;
     os << "Both --region and --bucket-name options were missing, you must set"
        << " at least one of them:\n"
@@ -640,19 +663,24 @@ google::cloud::StatusOr<Options> SelfTest() {
     if (options) return self_test_error;
   }
 
-  for (auto const& var :
-       {"GOOGLE_CLOUD_PROJECT", "GOOGLE_CLOUD_CPP_STORAGE_TEST_REGION_ID"}) {
-    auto const value = GetEnv(var).value_or("");
-    if (!value.empty()) continue;
-    std::ostringstream os;
-    os << "The environment variable " << var << " is not set or empty";
-    return google::cloud::Status(google::cloud::StatusCode::kUnknown,
-                                 std::move(os).str());
+  {
+    // The embedded server does not require a region or bucket
+    auto options = ParseArgsDefault({"self-test", "--embedded-server=true"});
+    if (!options || !options->embedded_server) return self_test_error;
   }
+
+  // Without a project and region run the test against the embedded server,
+  // this allows running the self-test without network access.
+  auto const project_id = GetEnv("GOOGLE_CLOUD_PROJECT").value_or("");
+  auto const region =
+      GetEnv("GOOGLE_CLOUD_CPP_STORAGE_TEST_REGION_ID").value_or("");
+  auto const use_embedded_server = project_id.empty() || region.empty();
   return ParseArgsDefault({
       "self-test",
-      "--project-id=" + GetEnv("GOOGLE_CLOUD_PROJECT").value(),
-      "--region=" + GetEnv("GOOGLE_CLOUD_CPP_STORAGE_TEST_REGION_ID").value(),
+      "--project-id=" + project_id,
+      "--region=" + region,
+      std::string("--embedded-server=") +
+          (use_embedded_server ? "true" : "false"),
       "--duration=1s",
       "--object-count=4",
       "--object-size=16KiB",
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/benchmarks/benchmark_utils.h"
+#include "google/cloud/storage/benchmarks/embedded_server.h"
 #include "google/cloud/storage/client.h"
 #include "google/cloud/internal/build_info.h"
 #include "google/cloud/internal/format_time_point.h"
@@ -78,6 +79,11 @@ performance data. The bucket is deleted after the program terminates.
 
 A helper script in this directory can generate pretty graphs from the output of
 this program.
+
+With the `--embedded-server` option the program runs an in-process HTTP server
+and uses it instead of Google Cloud Storage. The server keeps all the data in
+memory, and runs in separate threads, so the CPU usage captured by the program
+is (mostly) the cost of the client library.
 )""";
 
 struct Options {
@@ -92,6 +98,7 @@ struct Options {
   std::int64_t maximum_chunk_size = 4096 * gcs_bm::kKiB;
   long minimum_sample_count = 0;
   long maximum_sample_count = std::numeric_limits<long>::max();
+  bool embedded_server = false;
 };
 
 enum OpType { OP_UPLOAD, OP_DOWNLOAD };
@@ -123,6 +130,20 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 
+  std::unique_ptr<gcs_bm::ScopedEmbeddedServer> embedded_server;
+  if (options->embedded_server) {
+    auto server = gcs_bm::CreateEmbeddedServer();
+    if (!server) {
+      std::cerr << "Could not create embedded server, status="
+                << server.status() << "\n";
+      return 1;
+    }
+    embedded_server.reset(new gcs_bm::ScopedEmbeddedServer(*std::move(server)));
+    gcs_bm::UseEmbeddedServer(embedded_server->server());
+    std::cout << "# Running embedded GCS server at "
+              << embedded_server->server().address() << "\n";
+  }
+
   google::cloud::StatusOr<gcs::ClientOptions> client_options =
       gcs::ClientOptions::CreateDefaultClientOptions();
   if (!client_options) {
@@ -175,6 +196,7 @@ int main(int argc, char* argv[]) {
             << options->minimum_chunk_size / gcs_bm::kKiB
             << "\n# Max Chunk Size (KiB): "
             << options->maximum_chunk_size / gcs_bm::kKiB << std::boolalpha
+            << "\n# Embedded Server: " << options->embedded_server
             << "\n# Build info: " << notes << "\n";
   // Make this immediately visible in the console, helps with debugging.
   std::cout << std::flush;
@@ -396,6 +418,11 @@ google::cloud::StatusOr<Options> ParseArgsDefault(
        [&options](std::string const& val) {
          options.maximum_sample_count = std::stol(val);
        }},
+      {"--embedded-server",
+       "run the benchmark against an in-process server, without network access",
+       [&options](std::string const& val) {
+         options.embedded_server = gcs_bm::ParseBoolean(val).value_or(true);
+       }},
   };
   auto usage = gcs_bm::BuildUsage(desc, argv[0]);
 
@@ -417,7 +444,7 @@ google::cloud::StatusOr<Options> ParseArgsDefault(
   if (unparsed.size() == 2) {
     options.region = unparsed[1];
   }
-  if (options.region.empty()) {
+  if (options.region.empty() && !options.embedded_server) {
     std::ostringstream os;
     os << "Missing value for --region option" << usage << "\n";
     return google::cloud::Status{google::cloud::StatusCode::kInvalidArgument,
@@ -511,22 +538,27 @@ google::cloud::StatusOr<Options> SelfTest() {
     if (options) return self_test_error;
   }
 
-  for (auto const& var :
-       {"GOOGLE_CLOUD_PROJECT", "GOOGLE_CLOUD_CPP_STORAGE_TEST_REGION_ID"}) {
-    auto const value = GetEnv(var).value_or("");
-    if (!value.empty()) continue;
-    std::ostringstream os;
-    os << "The environment variable " << var << " is not set or empty";
-    return google::cloud::Status(google::cloud::StatusCode::kUnknown,
-                                 std::move(os).str());
+  {
+    // The embedded server does not require a region
+    auto options = ParseArgsDefault({"self-test", "--embedded-server=true"});
+    if (!options || !options->embedded_server) return self_test_error;
   }
+
+  // Without a project and region run the test against the embedded server,
+  // this allows running the self-test without network access.
+  auto const project_id = GetEnv("GOOGLE_CLOUD_PROJECT").value_or("");
+  auto const region =
+      GetEnv("GOOGLE_CLOUD_CPP_STORAGE_TEST_REGION_ID").value_or("");
+  auto const use_embedded_server = project_id.empty() || region.empty();
   auto const thread_count_arg = gcs_bm::SimpleTimer::SupportPerThreadUsage()
                                     ? "--thread-count=2"
                                     : "--thread-count=1";
   return ParseArgsDefault({
       "self-test",
-      "--project-id=" + GetEnv("GOOGLE_CLOUD_PROJECT").value(),
-      "--region=" + GetEnv("GOOGLE_CLOUD_CPP_STORAGE_TEST_REGION_ID").value(),
+      "--project-id=" + project_id,
+      "--region=" + region,
+      std::string("--embedded-server=") +
+          (use_embedded_server ? "true" : "false"),
       thread_count_arg,
       "--minimum-object-size=16KiB",
       "--maximum-object-size=32KiB",
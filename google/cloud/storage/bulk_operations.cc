@@ -0,0 +1,71 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/bulk_operations.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+void BulkApply(std::size_t count, std::size_t max_streams,
+               std::function<void(std::size_t)> const& op) {
+  std::atomic<std::size_t> next(0);
+  std::mutex mu;
+  std::exception_ptr exception;
+  auto worker = [&] {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      for (auto i = next++; i < count; i = next++) {
+        op(i);
+      }
+    } catch (...) {
+      // Stop handing out work, the first exception is rethrown once all the
+      // threads are joined.
+      next = count;
+      std::lock_guard<std::mutex> lk(mu);
+      if (!exception) exception = std::current_exception();
+    }
+#else
+    for (auto i = next++; i < count; i = next++) {
+      op(i);
+    }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  };
+
+  auto const thread_count =
+      (std::max<std::size_t>)(1, (std::min)(max_streams, count));
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1);
+  for (std::size_t i = 1; i != thread_count; ++i) {
+    threads.emplace_back(worker);
+  }
+  // The calling thread also runs operations.
+  worker();
+  for (auto& t : threads) {
+    t.join();
+  }
+  if (exception) std::rethrow_exception(exception);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,437 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BULK_OPERATIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BULK_OPERATIONS_H
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/tuple_filter.h"
+#include "google/cloud/storage/parallel_list_objects.h"
+#include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/optional.h"
+#include "google/cloud/status_or.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/// An object (and optionally, a specific generation) for a bulk operation.
+struct BulkObject {
+  std::string object_name;
+  google::cloud::optional<std::int64_t> generation;
+};
+
+/// An object and the changes applied by `BulkPatchObjects()`.
+struct BulkPatchOperation {
+  std::string object_name;
+  ObjectMetadataPatchBuilder builder;
+};
+
+/// The source and destination of a `BulkCopyObjects()` operation.
+struct BulkCopyOperation {
+  std::string source_bucket_name;
+  std::string source_object_name;
+  std::string destination_bucket_name;
+  std::string destination_object_name;
+};
+
+namespace internal {
+
+/**
+ * Call @p op for each index in `[0, count)` using up to @p max_streams threads.
+ *
+ * The calling thread is one of the workers, with `max_streams <= 1` all the
+ * operations run sequentially in the calling thread. If @p op throws, no new
+ * operations are started, and the first exception is rethrown in the calling
+ * thread after all the workers finish.
+ */
+void BulkApply(std::size_t count, std::size_t max_streams,
+               std::function<void(std::size_t)> const& op);
+
+template <typename... Options>
+std::size_t BulkMaxStreams(std::tuple<Options...> const& options) {
+  MaxStreams const kDefaultMaxStreams(64);
+  return ExtractFirstOccurenceOfType<MaxStreams>(options)
+      .value_or(kDefaultMaxStreams)
+      .value();
+}
+
+// Just a wrapper to allow for use in `google::cloud::internal::apply`.
+struct PatchObjectApplyHelper {
+  template <typename... Options>
+  StatusOr<ObjectMetadata> operator()(Options... options) const {
+    return client.PatchObject(bucket_name, object_name, builder,
+                              std::move(options)...);
+  }
+
+  Client& client;
+  std::string const& bucket_name;
+  std::string const& object_name;
+  ObjectMetadataPatchBuilder const& builder;
+};
+
+// Just a wrapper to allow for use in `google::cloud::internal::apply`.
+struct CopyObjectApplyHelper {
+  template <typename... Options>
+  StatusOr<ObjectMetadata> operator()(Options... options) const {
+    return client.CopyObject(
+        operation.source_bucket_name, operation.source_object_name,
+        operation.destination_bucket_name, operation.destination_object_name,
+        std::move(options)...);
+  }
+
+  Client& client;
+  BulkCopyOperation const& operation;
+};
+
+// Just a wrapper to allow for use in `google::cloud::internal::apply`.
+struct CreateV4SignedUrlApplyHelper {
+  template <typename... Options>
+  StatusOr<std::string> operator()(Options... options) const {
+    return client.CreateV4SignedUrl(verb, bucket_name, object_name,
+                                    std::move(options)...);
+  }
+
+  Client& client;
+  std::string const& verb;
+  std::string const& bucket_name;
+  std::string const& object_name;
+};
+
+}  // namespace internal
+
+/**
+ * Execute a list of operations using a bounded number of threads.
+ *
+ * This is the building block for the other bulk functions, it can be used to
+ * run any mix of operations concurrently. The results are returned in the same
+ * order as @p operations.
+ *
+ * @param operations the operations to execute, they are called from multiple
+ *     threads and must be thread-safe.
+ * @param max_streams the maximum number of operations in progress at a time.
+ */
+template <typename T>
+std::vector<T> BulkExecute(std::vector<std::function<T()>> const& operations,
+                           std::size_t max_streams) {
+  std::vector<T> results(operations.size());
+  internal::BulkApply(operations.size(), max_streams,
+                      [&](std::size_t i) { results[i] = operations[i](); });
+  return results;
+}
+
+/**
+ * Delete multiple objects concurrently.
+ *
+ * Each object is deleted with a separate `Client::DeleteObject()` request,
+ * including its retry loop, with up to `MaxStreams` (64 by default) requests
+ * in progress at a time.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket that contains the objects.
+ * @param objects the objects to delete, if the generation is set only that
+ *     generation of the object is deleted.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `IfMetagenerationMatch`,
+ *     `IfMetagenerationNotMatch`, `MaxStreams`, `QuotaUser`, `UserIp`, and
+ *     `UserProject`.
+ *
+ * @return the result of each deletion, in the same order as @p objects.
+ *
+ * @par Idempotency
+ * The individual operations are idempotent only if the generation is set.
+ */
+template <typename... Options>
+std::vector<Status> BulkDeleteObjects(Client client,
+                                      std::string const& bucket_name,
+                                      std::vector<BulkObject> const& objects,
+                                      Options&&... options) {
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+  auto const max_streams = internal::BulkMaxStreams(std::tie(options...));
+  auto delete_options =
+      StaticTupleFilter<NotAmong<MaxStreams>::TPred>(std::tie(options...));
+
+  std::vector<Status> results(objects.size());
+  internal::BulkApply(objects.size(), max_streams, [&](std::size_t i) {
+    auto const& o = objects[i];
+    results[i] = google::cloud::internal::apply(
+        internal::DeleteApplyHelper{client, bucket_name, o.object_name},
+        std::tuple_cat(std::make_tuple(o.generation ? Generation(*o.generation)
+                                                    : Generation()),
+                       delete_options));
+  });
+  return results;
+}
+
+/**
+ * Fetch the metadata for multiple objects concurrently.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket that contains the objects.
+ * @param objects the objects to query, if the generation is not set the
+ *     metadata for the latest generation is returned.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `IfMetagenerationMatch`,
+ *     `IfMetagenerationNotMatch`, `MaxStreams`, `Projection`, and
+ *     `UserProject`.
+ *
+ * @return the result of each request, in the same order as @p objects.
+ *
+ * @par Idempotency
+ * This is a read-only operation and is always idempotent.
+ */
+template <typename... Options>
+std::vector<StatusOr<ObjectMetadata>> BulkGetObjectMetadata(
+    Client client, std::string const& bucket_name,
+    std::vector<BulkObject> const& objects, Options&&... options) {
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+  auto const max_streams = internal::BulkMaxStreams(std::tie(options...));
+  auto get_options =
+      StaticTupleFilter<NotAmong<MaxStreams>::TPred>(std::tie(options...));
+
+  std::vector<StatusOr<ObjectMetadata>> results(objects.size());
+  internal::BulkApply(objects.size(), max_streams, [&](std::size_t i) {
+    auto const& o = objects[i];
+    results[i] = google::cloud::internal::apply(
+        internal::GetObjectMetadataApplyHelper{client, bucket_name,
+                                               o.object_name},
+        std::tuple_cat(std::make_tuple(o.generation ? Generation(*o.generation)
+                                                    : Generation()),
+                       get_options));
+  });
+  return results;
+}
+
+/**
+ * Patch the metadata of multiple objects concurrently.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket that contains the objects.
+ * @param operations the objects to patch and the changes for each one.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `IfMetagenerationMatch`,
+ *     `IfMetagenerationNotMatch`, `MaxStreams`, `PredefinedAcl`,
+ *     `Projection`, and `UserProject`.
+ *
+ * @return the result of each request, in the same order as @p operations.
+ *
+ * @par Idempotency
+ * The individual operations are idempotent only if a metageneration
+ * precondition is set, see `Client::PatchObject()`.
+ */
+template <typename... Options>
+std::vector<StatusOr<ObjectMetadata>> BulkPatchObjects(
+    Client client, std::string const& bucket_name,
+    std::vector<BulkPatchOperation> const& operations, Options&&... options) {
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+  auto const max_streams = internal::BulkMaxStreams(std::tie(options...));
+  auto patch_options =
+      StaticTupleFilter<NotAmong<MaxStreams>::TPred>(std::tie(options...));
+
+  std::vector<StatusOr<ObjectMetadata>> results(operations.size());
+  internal::BulkApply(operations.size(), max_streams, [&](std::size_t i) {
+    auto const& op = operations[i];
+    results[i] = google::cloud::internal::apply(
+        internal::PatchObjectApplyHelper{client, bucket_name, op.object_name,
+                                         op.builder},
+        patch_options);
+  });
+  return results;
+}
+
+/**
+ * Copy multiple objects concurrently.
+ *
+ * Each copy uses a separate `Client::CopyObject()` request, which is only
+ * suitable for objects in the same location and storage class. Use
+ * `Client::RewriteObject()` for other objects.
+ *
+ * @param client the client on which to perform the operation.
+ * @param operations the source and destination of each copy.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `DestinationPredefinedAcl`,
+ *     `EncryptionKey`, `MaxStreams`, `Projection`, `SourceGeneration`,
+ *     `UserProject`, and `WithObjectMetadata`.
+ *
+ * @return the result of each copy, in the same order as @p operations.
+ *
+ * @par Idempotency
+ * The individual operations are idempotent only if a generation precondition
+ * is set, see `Client::CopyObject()`.
+ */
+template <typename... Options>
+std::vector<StatusOr<ObjectMetadata>> BulkCopyObjects(
+    Client client, std::vector<BulkCopyOperation> const& operations,
+    Options&&... options) {
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+  auto const max_streams = internal::BulkMaxStreams(std::tie(options...));
+  auto copy_options =
+      StaticTupleFilter<NotAmong<MaxStreams>::TPred>(std::tie(options...));
+
+  std::vector<StatusOr<ObjectMetadata>> results(operations.size());
+  internal::BulkApply(operations.size(), max_streams, [&](std::size_t i) {
+    results[i] = google::cloud::internal::apply(
+        internal::CopyObjectApplyHelper{client, operations[i]}, copy_options);
+  });
+  return results;
+}
+
+/**
+ * Create V4 signed URLs for multiple objects concurrently.
+ *
+ * Each URL is created with `Client::CreateV4SignedUrl()`, using up to
+ * `MaxStreams` (64 by default) threads. When the client credentials can sign
+ * locally (e.g. service account keys) the work is CPU-bound and the threads
+ * share the parsed private key. Otherwise each URL requires a `signBlob` call
+ * to the IAM Credentials API, there is no batch version of that API, and the
+ * threads keep up to `MaxStreams` of these calls in flight.
+ *
+ * @param client the client used to sign the URLs.
+ * @param verb the HTTP verb (e.g. "GET") of the signed URLs.
+ * @param bucket_name the name of the bucket that contains the objects.
+ * @param object_names the objects to create signed URLs for.
+ * @param options a list of optional parameters for the signed URLs, in
+ *     addition to `MaxStreams` this accepts the same options as
+ *     `Client::CreateV4SignedUrl()`. The options are applied to all URLs,
+ *     set `SignedUrlTimestamp` to use the same timestamp in all of them.
+ *
+ * @return the signed URLs, in the same order as @p object_names.
+ */
+template <typename... Options>
+std::vector<StatusOr<std::string>> BulkCreateV4SignedUrls(
+    Client client, std::string const& verb, std::string const& bucket_name,
+    std::vector<std::string> const& object_names, Options&&... options) {
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+  auto const max_streams = internal::BulkMaxStreams(std::tie(options...));
+  auto sign_options =
+      StaticTupleFilter<NotAmong<MaxStreams>::TPred>(std::tie(options...));
+
+  std::vector<StatusOr<std::string>> results(object_names.size());
+  internal::BulkApply(object_names.size(), max_streams, [&](std::size_t i) {
+    results[i] = google::cloud::internal::apply(
+        internal::CreateV4SignedUrlApplyHelper{client, verb, bucket_name,
+                                               object_names[i]},
+        sign_options);
+  });
+  return results;
+}
+
+/**
+ * Delete objects whose names match a given prefix, using concurrent requests.
+ *
+ * This is a faster version of `DeleteByPrefix()` for prefixes with many
+ * objects. Each page of the listing is deleted with up to `MaxStreams` (64 by
+ * default) concurrent requests, while the next page is fetched in the
+ * background. As with `DeleteByPrefix()`, each object is deleted only if its
+ * generation has not changed since it was listed.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket that contains the objects.
+ * @param prefix the prefix of the objects to be deleted.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `MaxStreams`, `QuotaUser`,
+ *     `UserIp`, `UserProject` and `Versions`.
+ *
+ * @return the first error, if any. On error, the deletions already in
+ *     progress complete, but no new deletions are started.
+ */
+template <typename... Options>
+Status BulkDeleteByPrefix(Client client, std::string const& bucket_name,
+                          std::string const& prefix, Options&&... options) {
+  using internal::Among;
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+
+  auto all_options = std::tie(options...);
+  static_assert(
+      std::tuple_size<decltype(
+              StaticTupleFilter<NotAmong<MaxStreams, QuotaUser, UserIp,
+                                         UserProject, Versions>::TPred>(
+                  all_options))>::value == 0,
+      "This functions accepts only options of type MaxStreams, QuotaUser, "
+      "UserIp, UserProject or Versions.");
+  auto const max_streams = internal::BulkMaxStreams(all_options);
+  auto delete_options =
+      StaticTupleFilter<Among<QuotaUser, UserIp, UserProject>::TPred>(
+          all_options);
+
+  std::vector<ObjectMetadata> batch;
+  auto flush = [&]() -> Status {
+    std::atomic<bool> failed(false);
+    std::vector<Status> results(batch.size());
+    internal::BulkApply(batch.size(), max_streams, [&](std::size_t i) {
+      if (failed) {
+        return;
+      }
+      auto const& o = batch[i];
+      results[i] = google::cloud::internal::apply(
+          internal::DeleteApplyHelper{client, bucket_name, o.name()},
+          std::tuple_cat(std::make_tuple(IfGenerationMatch(o.generation())),
+                         delete_options));
+      if (!results[i].ok()) {
+        failed = true;
+      }
+    });
+    batch.clear();
+    for (auto& s : results) {
+      if (!s.ok()) {
+        return std::move(s);
+      }
+    }
+    return Status();
+  };
+
+  // Delete the objects one page at a time, while the next page is fetched in
+  // the background.
+  std::size_t const kBatchSize = 1000;
+  for (auto& object : google::cloud::internal::apply(
+           internal::ListObjectsApplyHelper{client, bucket_name},
+           std::tuple_cat(std::make_tuple(Projection::NoAcl(), Prefix(prefix),
+                                          PrefetchNextPage(true)),
+                          StaticTupleFilter<NotAmong<MaxStreams>::TPred>(
+                              all_options)))) {
+    if (!object) {
+      return std::move(object).status();
+    }
+    batch.push_back(*std::move(object));
+    if (batch.size() < kBatchSize) {
+      continue;
+    }
+    auto status = flush();
+    if (!status.ok()) {
+      return status;
+    }
+  }
+  return flush();
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_BULK_OPERATIONS_H
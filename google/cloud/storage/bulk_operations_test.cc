@@ -0,0 +1,348 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/bulk_operations.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Invoke;
+using ::testing::HasSubstr;
+using ::testing::ReturnRef;
+using ::testing::UnorderedElementsAre;
+
+std::string const kBucketName = "test-bucket";
+
+ObjectMetadata CreateObject(std::string const& name,
+                            std::int64_t generation) {
+  return ObjectMetadataParser::FromJson(nl::json{
+                                            {"bucket", kBucketName},
+                                            {"name", name},
+                                            {"generation", generation},
+                                        })
+      .value();
+}
+
+class BulkOperationsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock_ = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*mock_, client_options())
+        .WillRepeatedly(ReturnRef(client_options_));
+    client_.reset(new Client{
+        std::shared_ptr<internal::RawClient>(mock_),
+        LimitedErrorCountRetryPolicy(2),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+
+  std::shared_ptr<testing::MockClient> mock_;
+  std::unique_ptr<Client> client_;
+  ClientOptions client_options_ =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+TEST(BulkApplyTest, CallsEachIndexOnce) {
+  std::mutex mu;
+  std::multiset<std::size_t> called;
+  std::set<std::thread::id> threads;
+  BulkApply(100, 4, [&](std::size_t i) {
+    std::lock_guard<std::mutex> lk(mu);
+    called.insert(i);
+    threads.insert(std::this_thread::get_id());
+  });
+  ASSERT_EQ(100, called.size());
+  for (std::size_t i = 0; i != 100; ++i) {
+    EXPECT_EQ(1, called.count(i)) << "i=" << i;
+  }
+  EXPECT_LE(threads.size(), 4);
+}
+
+TEST(BulkApplyTest, SequentialInCallingThread) {
+  std::vector<std::size_t> called;
+  auto const id = std::this_thread::get_id();
+  BulkApply(5, 1, [&](std::size_t i) {
+    EXPECT_EQ(id, std::this_thread::get_id());
+    called.push_back(i);
+  });
+  EXPECT_THAT(called, ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(BulkApplyTest, Empty) {
+  BulkApply(0, 8, [](std::size_t) { FAIL() << "unexpected call"; });
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(BulkApplyTest, ExceptionIsRethrown) {
+  std::atomic<int> running(0);
+  std::atomic<int> max_running(0);
+  EXPECT_THROW(
+      try {
+        BulkApply(100, 4, [&](std::size_t i) {
+          auto const r = ++running;
+          for (auto m = max_running.load(); m < r;) {
+            max_running.compare_exchange_weak(m, r);
+          }
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          --running;
+          if (i == 10) throw std::runtime_error("uh-oh");
+        });
+      } catch (std::runtime_error const& ex) {
+        EXPECT_THAT(ex.what(), HasSubstr("uh-oh"));
+        // All the workers are joined before the exception is rethrown.
+        EXPECT_EQ(0, running.load());
+        throw;
+      },
+      std::runtime_error);
+  EXPECT_LE(max_running.load(), 4);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+TEST(BulkExecuteTest, ResultsInOrder) {
+  std::vector<std::function<StatusOr<int>()>> operations;
+  for (int i = 0; i != 10; ++i) {
+    operations.emplace_back([i]() -> StatusOr<int> {
+      if (i == 3) {
+        return PermanentError();
+      }
+      return i * i;
+    });
+  }
+  auto actual = BulkExecute(operations, 3);
+  ASSERT_EQ(10, actual.size());
+  for (int i = 0; i != 10; ++i) {
+    if (i == 3) {
+      EXPECT_EQ(PermanentError().code(), actual[i].status().code());
+      continue;
+    }
+    ASSERT_STATUS_OK(actual[i]);
+    EXPECT_EQ(i * i, *actual[i]);
+  }
+}
+
+TEST_F(BulkOperationsTest, DeleteObjects) {
+  std::mutex mu;
+  std::vector<std::string> deleted;
+  EXPECT_CALL(*mock_, DeleteObject(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&](DeleteObjectRequest const& r) {
+        EXPECT_EQ(kBucketName, r.bucket_name());
+        EXPECT_EQ("my-project", r.GetOption<UserProject>().value());
+        auto const generation = r.GetOption<Generation>();
+        {
+          std::lock_guard<std::mutex> lk(mu);
+          deleted.push_back(
+              r.object_name() + "#" +
+              (generation.has_value() ? std::to_string(generation.value())
+                                      : std::string("latest")));
+        }
+        if (r.object_name() == "o2") {
+          return StatusOr<EmptyResponse>(PermanentError());
+        }
+        return make_status_or(EmptyResponse{});
+      }));
+
+  auto actual = BulkDeleteObjects(*client_, kBucketName,
+                                  {{"o1", 7}, {"o2", {}}, {"o3", 42}},
+                                  UserProject("my-project"), MaxStreams(2));
+  ASSERT_EQ(3, actual.size());
+  EXPECT_STATUS_OK(actual[0]);
+  EXPECT_EQ(PermanentError().code(), actual[1].code());
+  EXPECT_STATUS_OK(actual[2]);
+  EXPECT_THAT(deleted, UnorderedElementsAre("o1#7", "o2#latest", "o3#42"));
+}
+
+TEST_F(BulkOperationsTest, GetObjectMetadata) {
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([](GetObjectMetadataRequest const& r) {
+        if (r.object_name() == "missing") {
+          return StatusOr<ObjectMetadata>(
+              Status(StatusCode::kNotFound, "not found"));
+        }
+        return make_status_or(CreateObject(r.object_name(), 1));
+      }));
+
+  auto actual = BulkGetObjectMetadata(
+      *client_, kBucketName, {{"o1", {}}, {"missing", {}}, {"o3", {}}});
+  ASSERT_EQ(3, actual.size());
+  ASSERT_STATUS_OK(actual[0]);
+  EXPECT_EQ("o1", actual[0]->name());
+  EXPECT_EQ(StatusCode::kNotFound, actual[1].status().code());
+  ASSERT_STATUS_OK(actual[2]);
+  EXPECT_EQ("o3", actual[2]->name());
+}
+
+TEST_F(BulkOperationsTest, PatchObjects) {
+  EXPECT_CALL(*mock_, PatchObject(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([](PatchObjectRequest const& r) {
+        EXPECT_EQ(kBucketName, r.bucket_name());
+        EXPECT_EQ(1, r.GetOption<IfMetagenerationMatch>().value());
+        auto patch = nl::json::parse(r.payload());
+        auto metadata = CreateObject(r.object_name(), 1);
+        metadata.set_content_type(patch.value("contentType", ""));
+        return make_status_or(metadata);
+      }));
+
+  std::vector<BulkPatchOperation> operations;
+  operations.push_back(
+      {"o1", ObjectMetadataPatchBuilder().SetContentType("text/plain")});
+  operations.push_back(
+      {"o2", ObjectMetadataPatchBuilder().SetContentType("text/html")});
+  auto actual = BulkPatchObjects(*client_, kBucketName, operations,
+                                 IfMetagenerationMatch(1));
+  ASSERT_EQ(2, actual.size());
+  ASSERT_STATUS_OK(actual[0]);
+  EXPECT_EQ("o1", actual[0]->name());
+  EXPECT_EQ("text/plain", actual[0]->content_type());
+  ASSERT_STATUS_OK(actual[1]);
+  EXPECT_EQ("o2", actual[1]->name());
+  EXPECT_EQ("text/html", actual[1]->content_type());
+}
+
+TEST_F(BulkOperationsTest, CopyObjects) {
+  EXPECT_CALL(*mock_, CopyObject(_))
+      .Times(2)
+      .WillRepeatedly(Invoke([](CopyObjectRequest const& r) {
+        EXPECT_EQ("src-bucket", r.source_bucket());
+        EXPECT_EQ(kBucketName, r.destination_bucket());
+        EXPECT_EQ(0, r.GetOption<IfGenerationMatch>().value());
+        return make_status_or(CreateObject(r.destination_object(), 1));
+      }));
+
+  auto actual = BulkCopyObjects(
+      *client_,
+      {{"src-bucket", "s1", kBucketName, "d1"},
+       {"src-bucket", "s2", kBucketName, "d2"}},
+      IfGenerationMatch(0));
+  ASSERT_EQ(2, actual.size());
+  ASSERT_STATUS_OK(actual[0]);
+  EXPECT_EQ("d1", actual[0]->name());
+  ASSERT_STATUS_OK(actual[1]);
+  EXPECT_EQ("d2", actual[1]->name());
+}
+
+TEST_F(BulkOperationsTest, DeleteByPrefix) {
+  EXPECT_CALL(*mock_, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const& r) {
+        EXPECT_EQ("tmp/", r.GetOption<Prefix>().value());
+        ListObjectsResponse response;
+        response.next_page_token = "page-1";
+        response.items.push_back(CreateObject("tmp/1", 10));
+        response.items.push_back(CreateObject("tmp/2", 20));
+        return make_status_or(std::move(response));
+      }))
+      .WillOnce(Invoke([](ListObjectsRequest const& r) {
+        EXPECT_EQ("page-1", r.page_token());
+        ListObjectsResponse response;
+        response.items.push_back(CreateObject("tmp/3", 30));
+        return make_status_or(std::move(response));
+      }));
+
+  std::mutex mu;
+  std::vector<std::string> deleted;
+  EXPECT_CALL(*mock_, DeleteObject(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&](DeleteObjectRequest const& r) {
+        auto const generation = r.GetOption<IfGenerationMatch>().value();
+        std::lock_guard<std::mutex> lk(mu);
+        deleted.push_back(r.object_name() + "#" + std::to_string(generation));
+        return make_status_or(EmptyResponse{});
+      }));
+
+  auto status =
+      BulkDeleteByPrefix(*client_, kBucketName, "tmp/", MaxStreams(4));
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(deleted,
+              UnorderedElementsAre("tmp/1#10", "tmp/2#20", "tmp/3#30"));
+}
+
+TEST_F(BulkOperationsTest, DeleteByPrefixFailure) {
+  EXPECT_CALL(*mock_, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const&) {
+        ListObjectsResponse response;
+        response.items.push_back(CreateObject("tmp/1", 10));
+        response.items.push_back(CreateObject("tmp/2", 20));
+        response.items.push_back(CreateObject("tmp/3", 30));
+        return make_status_or(std::move(response));
+      }));
+  // With a single stream the deletions stop after the first error.
+  EXPECT_CALL(*mock_, DeleteObject(_))
+      .WillOnce(Invoke([](DeleteObjectRequest const& r) {
+        EXPECT_EQ("tmp/1", r.object_name());
+        return make_status_or(EmptyResponse{});
+      }))
+      .WillOnce(Invoke([](DeleteObjectRequest const& r) {
+        EXPECT_EQ("tmp/2", r.object_name());
+        return StatusOr<EmptyResponse>(PermanentError());
+      }));
+
+  auto status =
+      BulkDeleteByPrefix(*client_, kBucketName, "tmp/", MaxStreams(1));
+  EXPECT_EQ(PermanentError().code(), status.code());
+}
+
+TEST_F(BulkOperationsTest, CreateV4SignedUrls) {
+  // The anonymous credentials cannot sign blobs, so each URL is signed using
+  // the SignBlob API. Use `echo -n test-signed-blob | openssl base64 -e` to
+  // create the magic string.
+  EXPECT_CALL(*mock_, SignBlob(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([](internal::SignBlobRequest const& r) {
+        EXPECT_EQ("test-account@example.com", r.service_account());
+        return make_status_or(internal::SignBlobResponse{
+            "test-key-id", "dGVzdC1zaWduZWQtYmxvYg=="});
+      }));
+
+  auto actual = BulkCreateV4SignedUrls(
+      *client_, "GET", kBucketName, {"o1", "o2", "o 3"}, MaxStreams(2),
+      SigningAccount("test-account@example.com"));
+  ASSERT_EQ(3, actual.size());
+  ASSERT_STATUS_OK(actual[0]);
+  EXPECT_THAT(*actual[0], HasSubstr("/o1?"));
+  ASSERT_STATUS_OK(actual[1]);
+  EXPECT_THAT(*actual[1], HasSubstr("/o2?"));
+  ASSERT_STATUS_OK(actual[2]);
+  EXPECT_THAT(*actual[2], HasSubstr("/o%203?"));
+  for (auto const& url : actual) {
+    // The hex encoding of "test-signed-blob".
+    EXPECT_THAT(*url, HasSubstr("X-Goog-Signature="
+                                "746573742d7369676e65642d626c6f62"));
+  }
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
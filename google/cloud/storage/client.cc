@@ -13,14 +13,17 @@
 // limitations under the License.
 
 #include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/adaptive_chunk_size.h"
 #include "google/cloud/storage/internal/curl_client.h"
-#include "google/cloud/storage/internal/curl_handle.h"
+#include "google/cloud/storage/internal/mapped_file.h"
 #include "google/cloud/storage/internal/openssl_util.h"
+#include "google/cloud/storage/internal/pipelined_resumable_upload_session.h"
 #include "google/cloud/storage/oauth2/service_account_credentials.h"
 #include "google/cloud/internal/filesystem.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/log.h"
 #include <openssl/md5.h>
+#include <chrono>
 #include <fstream>
 #include <thread>
 
@@ -48,7 +51,10 @@ StatusOr<Client> Client::CreateDefaultClient() {
 
 ObjectReadStream Client::ReadObjectImpl(
     internal::ReadObjectRangeRequest const& request) {
-  auto source = raw_client_->ReadObject(request);
+  auto source = request.HasOption<HedgeRequests>()
+                    ? internal::HedgedReadObject(*hedged_call_threads_,
+                                                 raw_client_, request)
+                    : raw_client_->ReadObject(request);
   if (!source) {
     ObjectReadStream error_stream(
         google::cloud::internal::make_unique<internal::ObjectReadStreambuf>(
@@ -85,13 +91,77 @@ ObjectWriteStream Client::WriteObjectImpl(
     error_stream.Close();
     return error_stream;
   }
+  std::unique_ptr<internal::ResumableUploadSession> upload_session =
+      *std::move(session);
+  auto const& options = raw_client_->client_options();
+  auto chunk_size =
+      internal::AdaptiveChunkSize::FromOptions(options, learned_chunk_size_);
+  auto const pipeline_depth = request.GetOption<UploadPipelineDepth>();
+  if (pipeline_depth.has_value() && pipeline_depth.value() != 0) {
+    upload_session = google::cloud::internal::make_unique<
+        internal::PipelinedResumableUploadSession>(std::move(upload_session),
+                                                   pipeline_depth.value());
+    // The pipelined session returns before the chunk is uploaded, so the
+    // latency of each chunk cannot be measured.
+    chunk_size = internal::AdaptiveChunkSize(options.upload_buffer_size(), 0,
+                                             options.upload_chunk_stats());
+  }
   return ObjectWriteStream(
       google::cloud::internal::make_unique<internal::ObjectWriteStreambuf>(
-          *std::move(session),
-          raw_client_->client_options().upload_buffer_size(),
+          std::move(upload_session), std::move(chunk_size),
           internal::CreateHashValidator(request)));
 }
 
+namespace {
+StatusOr<ObjectMetadata> UploadMappedFile(
+    internal::ResumableUploadSession& session, internal::MappedFile const& file,
+    internal::AdaptiveChunkSize chunk_size) {
+  auto const size = file.size();
+  StatusOr<internal::ResumableUploadResponse> upload_response =
+      session.last_response();
+  // A restored session may have completed already.
+  while (!session.done()) {
+    auto const offset = session.next_expected_byte();
+    if (offset > size) {
+      std::ostringstream os;
+      os << __func__ << ": the upload session expects byte " << offset
+         << " but the file only has " << size << " bytes";
+      return Status(StatusCode::kFailedPrecondition, std::move(os).str());
+    }
+    // Each chunk is sent directly from the mapped memory, without copies.
+    auto const chunk = file.Range(offset, chunk_size.chunk_size());
+    bool const final_chunk = offset + chunk.size() == size;
+    auto const start = std::chrono::steady_clock::now();
+    if (final_chunk) {
+      upload_response = session.UploadFinalChunkFromBuffer(chunk, size);
+    } else {
+      upload_response = session.UploadChunkFromBuffer(chunk);
+    }
+    if (!upload_response) {
+      return std::move(upload_response).status();
+    }
+    if (!final_chunk) {
+      chunk_size.OnChunkUploaded(
+          chunk.size(), std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - start));
+    }
+    if (!session.done() && session.next_expected_byte() <= offset) {
+      std::ostringstream os;
+      os << __func__ << ": no progress uploading chunk at offset=" << offset;
+      return Status(StatusCode::kAborted, std::move(os).str());
+    }
+  }
+  if (!upload_response) {
+    return std::move(upload_response).status();
+  }
+  if (!upload_response->payload.has_value()) {
+    return Status(StatusCode::kInternal,
+                  "upload completed without returning the object metadata");
+  }
+  return *std::move(upload_response->payload);
+}
+}  // namespace
+
 bool Client::UseSimpleUpload(std::string const& file_name) const {
   auto status = google::cloud::internal::status(file_name);
   if (!is_regular(status)) {
@@ -111,7 +181,17 @@ StatusOr<ObjectMetadata> Client::UploadFileSimple(
     return Status(StatusCode::kNotFound, std::move(os).str());
   }
 
-  std::string payload(std::istreambuf_iterator<char>{is}, {});
+  // Read the file with a single sized read, instead of growing the string one
+  // character at a time.
+  std::string payload;
+  is.seekg(0, std::ios::end);
+  auto const size = is.tellg();
+  is.seekg(0, std::ios::beg);
+  if (size > 0) {
+    payload.resize(static_cast<std::size_t>(size));
+    is.read(&payload[0], size);
+    payload.resize(static_cast<std::size_t>(is.gcount()));
+  }
   request.set_contents(std::move(payload));
 
   return raw_client_->InsertObjectMedia(request);
@@ -136,6 +216,24 @@ integrity checks using the DisableMD5Hash() and DisableCrc32cChecksum() options.
 )""";
   }
 
+  auto const use_mapping = request.GetOption<UseMemoryMappedFile>();
+  if (use_mapping.has_value() && use_mapping.value()) {
+    auto mapped = internal::MappedFile::Open(file_name);
+    if (mapped) {
+      auto session = raw_client()->CreateResumableSession(request);
+      if (!session) {
+        return std::move(session).status();
+      }
+      return UploadMappedFile(**session, **mapped,
+                              internal::AdaptiveChunkSize::FromOptions(
+                                  raw_client()->client_options(),
+                                  learned_chunk_size_));
+    }
+    GCP_LOG(INFO) << "Cannot map " << file_name
+                  << " into memory, reading it as a stream. status="
+                  << mapped.status();
+  }
+
   std::ifstream source(file_name, std::ios::binary);
   if (!source.is_open()) {
     std::ostringstream os;
@@ -156,18 +254,21 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
 
   auto session = std::move(*session_status);
 
-  // GCS requires chunks to be a multiple of 256KiB.
-  auto chunk_size = internal::UploadChunkRequest::RoundUpToQuantum(
-      raw_client()->client_options().upload_buffer_size());
+  // GCS requires chunks to be a multiple of 256KiB, `chunk_size` takes care of
+  // that.
+  auto chunk_size = internal::AdaptiveChunkSize::FromOptions(
+      raw_client()->client_options(), learned_chunk_size_);
 
   StatusOr<internal::ResumableUploadResponse> upload_response(
       internal::ResumableUploadResponse{});
+  // Reuse the same buffer for all the chunks.
+  std::string buffer;
   // We iterate while `source` is good and the retry policy has not been
   // exhausted.
   while (!source.eof() && upload_response &&
          !upload_response->payload.has_value()) {
     // Read a chunk of data from the source file.
-    std::string buffer(chunk_size, '\0');
+    buffer.resize(chunk_size.chunk_size());
     source.read(&buffer[0], buffer.size());
     auto gcount = static_cast<std::size_t>(source.gcount());
     bool final_chunk = (gcount < buffer.size());
@@ -175,6 +276,7 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
     buffer.resize(gcount);
 
     auto expected = session->next_expected_byte() + gcount - 1;
+    auto const start = std::chrono::steady_clock::now();
     if (final_chunk) {
       upload_response = session->UploadFinalChunk(buffer, source_size);
     } else {
@@ -183,6 +285,11 @@ StatusOr<ObjectMetadata> Client::UploadStreamResumable(
     if (!upload_response) {
       return std::move(upload_response).status();
     }
+    if (!final_chunk) {
+      chunk_size.OnChunkUploaded(
+          gcount, std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - start));
+    }
     if (session->next_expected_byte() != expected) {
       GCP_LOG(WARNING) << "unexpected last committed byte "
                        << " expected=" << expected
@@ -279,14 +386,13 @@ StatusOr<std::string> Client::SignUrlV2(
     return signed_blob.status();
   }
 
-  internal::CurlHandle curl;
   auto encoded = internal::Base64Encode(signed_blob->signed_blob);
-  std::string signature = curl.MakeEscapedString(encoded).get();
+  std::string signature = internal::UrlEscapeString(encoded);
 
   std::ostringstream os;
   os << "https://storage.googleapis.com/" << request.bucket_name();
   if (!request.object_name().empty()) {
-    os << '/' << curl.MakeEscapedString(request.object_name()).get();
+    os << '/' << internal::UrlEscapeString(request.object_name());
   }
   os << "?GoogleAccessId=" << SigningEmail(signing_account)
      << "&Expires=" << request.expiration_time_as_seconds().count()
@@ -311,11 +417,10 @@ StatusOr<std::string> Client::SignUrlV4(internal::V4SignUrlRequest request) {
   }
 
   std::string signature = internal::HexEncode(signed_blob->signed_blob);
-  internal::CurlHandle curl;
   std::ostringstream os;
   os << request.HostnameWithBucket();
   for (auto& part : request.ObjectNameParts()) {
-    os << '/' << curl.MakeEscapedString(part).get();
+    os << '/' << internal::UrlEscapeString(part);
   }
   os << "?" << request.CanonicalQueryString(signing_email)
      << "&X-Goog-Signature=" << signature;
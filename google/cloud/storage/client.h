@@ -16,6 +16,8 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_H
 
 #include "google/cloud/storage/hmac_key_metadata.h"
+#include "google/cloud/storage/internal/adaptive_chunk_size.h"
+#include "google/cloud/storage/internal/hedged_request.h"
 #include "google/cloud/storage/internal/logging_client.h"
 #include "google/cloud/storage/internal/parameter_pack_validation.h"
 #include "google/cloud/storage/internal/policy_document_request.h"
@@ -958,7 +960,7 @@ class Client {
    * @param bucket_name the bucket containing the object.
    * @param object_name the object name.
    * @param options a list of optional query parameters and/or request headers.
-   *     Valid types for this operation include `Generation`,
+   *     Valid types for this operation include `Generation`, `HedgeRequests`,
    *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
    *     `IfMetagenerationNotMatch`, `Projection`, and `UserProject`.
    *
@@ -974,6 +976,10 @@ class Client {
                                              Options&&... options) {
     internal::GetObjectMetadataRequest request(bucket_name, object_name);
     request.set_multiple_options(std::forward<Options>(options)...);
+    if (request.HasOption<HedgeRequests>()) {
+      return internal::HedgedGetObjectMetadata(*hedged_call_threads_,
+                                               raw_client_, request);
+    }
     return raw_client_->GetObjectMetadata(request);
   }
 
@@ -984,11 +990,22 @@ class Client {
    * @param options a list of optional query parameters and/or request headers.
    *     Valid types for this operation include
    *     `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `UserProject`,
-   *     `Projection`, `Prefix`, `Delimiter`, and `Versions`.
+   *     `Projection`, `Prefix`, `Delimiter`, `StartOffset`, `EndOffset`,
+   *     `PrefetchNextPage`, `Fields`, and `Versions`.
+   *
+   * @par Partial Responses
+   * Use `Fields` to request only some attributes of each object, e.g.
+   * `Fields("items(name,size)")`, this reduces the size of each page and the
+   * cost of parsing it. The attributes not requested are left with their
+   * default values in the returned `ObjectMetadata`. The library adds
+   * `nextPageToken` to the fields if needed.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
    *
+   * @see `ParallelListObjects()` to list very large buckets using multiple
+   *     concurrent streams.
+   *
    * @par Example
    * @snippet storage_object_samples.cc list objects
    */
@@ -998,10 +1015,50 @@ class Client {
     internal::ListObjectsRequest request(bucket_name);
     request.set_multiple_options(std::forward<Options>(options)...);
     auto client = raw_client_;
+    auto const prefetch = request.GetOption<PrefetchNextPage>();
     return ListObjectsReader(request,
                              [client](internal::ListObjectsRequest const& r) {
                                return client->ListObjects(r);
-                             });
+                             },
+                             prefetch.has_value() && prefetch.value());
+  }
+
+  /**
+   * Lists the objects in a bucket, returning only their name, generation, size
+   * and CRC32C checksum.
+   *
+   * This is useful to keep the results of very large listings in memory, e.g.
+   * to compare the contents of two buckets, `ObjectSummary` requires a
+   * fraction of the memory used by `ObjectMetadata`. Unless the application
+   * provides a `Fields` option, the request asks the service to return only
+   * these attributes, which also reduces the size of each page.
+   *
+   * @param bucket_name the name of the bucket to list.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include
+   *     `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `UserProject`,
+   *     `Prefix`, `Delimiter`, `StartOffset`, `EndOffset`,
+   *     `PrefetchNextPage`, `Fields`, and `Versions`.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   */
+  template <typename... Options>
+  ListObjectSummariesReader ListObjectSummaries(std::string const& bucket_name,
+                                                Options&&... options) {
+    internal::ListObjectsRequest request(bucket_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    if (!request.HasOption<Fields>()) {
+      request.set_option(Fields(internal::kObjectSummaryFields));
+    }
+    auto client = raw_client_;
+    auto const prefetch = request.GetOption<PrefetchNextPage>();
+    return ListObjectSummariesReader(
+        request,
+        [client](internal::ListObjectsRequest const& r) {
+          return internal::ListObjectSummaries(*client, r);
+        },
+        prefetch.has_value() && prefetch.value());
   }
 
   /**
@@ -1020,9 +1077,9 @@ class Client {
    * @param options a list of optional query parameters and/or request headers.
    *     Valid types for this operation include `DisableCrc32cChecksum`,
    *     `DisableMD5Hash`, `IfGenerationMatch`, `EncryptionKey`, `Generation`,
-   *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
-   *     `IfMetagenerationNotMatch`, `ReadFromOffset`, `ReadRange`, `ReadLast`
-   *     and `UserProject`.
+   *     `HedgeRequests`, `IfGenerationMatch`, `IfGenerationNotMatch`,
+   *     `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `ReadFromOffset`,
+   *     `ReadRange`, `ReadLast`, `UseHashingThread` and `UserProject`.
    *
    * @par Idempotency
    * This is a read-only operation and is always idempotent.
@@ -1061,6 +1118,69 @@ class Client {
     return ReadObjectImpl(request);
   }
 
+  /**
+   * Reads the contents of an object into memory, asynchronously.
+   *
+   * Unlike `ReadObject()` this function does not block the calling thread. All
+   * the asynchronous downloads created by this client (and its copies) share a
+   * single background thread and a single pool of connections, which makes
+   * it possible to read thousands of objects concurrently without creating a
+   * thread for each download.
+   *
+   * The returned future is satisfied by the background thread, any
+   * continuations attached to it (via `.then()`) may run in that thread and
+   * should not block. Other requests made from a continuation, even with
+   * `ChannelOptions::set_enable_http2()`, run synchronously in the background
+   * thread and delay all the pending downloads until they complete. The
+   * application must keep this client (or a copy of it) alive until the
+   * future is satisfied, pending downloads are cancelled when the last copy is
+   * destroyed.
+   *
+   * @param bucket_name the name of the bucket that contains the object.
+   * @param object_name the name of the object to be read.
+   * @param options a list of optional query parameters and/or request headers.
+   *     Valid types for this operation include `DisableCrc32cChecksum`,
+   *     `DisableMD5Hash`, `EncryptionKey`, `Generation`, `IfGenerationMatch`,
+   *     `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+   *     `IfMetagenerationNotMatch`, `ReadFromOffset`, `ReadRange`, `ReadLast`
+   *     and `UserProject`.
+   *
+   * @return a future satisfied with the contents of the object (or the
+   *     requested range), or the error status. The download is not retried,
+   *     applications can retry the operation if the status indicates a
+   *     transient failure.
+   *
+   * @par Idempotency
+   * This is a read-only operation and is always idempotent.
+   *
+   * @par Example
+   * @snippet storage_object_samples.cc async read object
+   */
+  template <typename... Options>
+  future<StatusOr<std::string>> AsyncReadObject(std::string const& bucket_name,
+                                                std::string const& object_name,
+                                                Options&&... options) {
+    struct HasReadRange : public google::cloud::internal::disjunction<
+                              std::is_same<ReadRange, Options>...> {};
+    struct HasReadFromOffset : public google::cloud::internal::disjunction<
+                                   std::is_same<ReadFromOffset, Options>...> {};
+    struct HasReadLast : public google::cloud::internal::disjunction<
+                             std::is_same<ReadLast, Options>...> {};
+
+    struct HasIncompatibleRangeOptions
+        : public std::integral_constant<bool, HasReadLast::value &&
+                                                  (HasReadFromOffset::value ||
+                                                   HasReadRange::value)> {};
+
+    static_assert(!HasIncompatibleRangeOptions::value,
+                  "Cannot set ReadLast option with either ReadFromOffset or "
+                  "ReadRange.");
+
+    internal::ReadObjectRangeRequest request(bucket_name, object_name);
+    request.set_multiple_options(std::forward<Options>(options)...);
+    return raw_client_->AsyncReadObject(request);
+  }
+
   /**
    * Writes contents into an object.
    *
@@ -1099,8 +1219,9 @@ class Client {
    *   `Crc32cChecksumValue`, `DisableCrc32cChecksum`, `DisableMD5Hash`,
    *   `EncryptionKey`, `IfGenerationMatch`, `IfGenerationNotMatch`,
    *   `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `KmsKeyName`,
-   *   `MD5HashValue`, `PredefinedAcl`, `Projection`,
-   *   `UseResumableUploadSession`, `UserProject`, and `WithObjectMetadata`.
+   *   `MD5HashValue`, `PredefinedAcl`, `Projection`, `UploadPipelineDepth`,
+   *   `UseHashingThread`, `UseResumableUploadSession`, `UserProject`, and
+   *   `WithObjectMetadata`.
    *
    * @par Idempotency
    * This operation is only idempotent if restricted by pre-conditions, in this
@@ -1144,8 +1265,8 @@ class Client {
    *   `Crc32cChecksumValue`, `DisableCrc32cChecksum`, `DisableMD5Hash`,
    *   `EncryptionKey`, `IfGenerationMatch`, `IfGenerationNotMatch`,
    *   `IfMetagenerationMatch`, `IfMetagenerationNotMatch`, `KmsKeyName`,
-   *   `MD5HashValue`, `PredefinedAcl`, `Projection`, `UserProject`, and
-   *   `WithObjectMetadata`.
+   *   `MD5HashValue`, `PredefinedAcl`, `Projection`, `UseMemoryMappedFile`,
+   *   `UserProject`, and `WithObjectMetadata`.
    *
    * @par Idempotency
    * This operation is only idempotent if restricted by pre-conditions, in this
@@ -3093,6 +3214,12 @@ class Client {
       internal::PolicyDocumentV4Request request);
 
   std::shared_ptr<internal::RawClient> raw_client_;
+  // The chunk size chosen by previous uploads, shared by copies of the client.
+  std::shared_ptr<internal::LearnedChunkSize> learned_chunk_size_ =
+      std::make_shared<internal::LearnedChunkSize>();
+  // Runs the attempts of hedged requests, shared by copies of the client.
+  std::shared_ptr<internal::HedgedCallThreads> hedged_call_threads_ =
+      std::make_shared<internal::HedgedCallThreads>();
 
   friend class internal::NonResumableParallelUploadState;
   friend class internal::ResumableParallelUploadState;
@@ -3183,6 +3310,9 @@ StatusOr<ObjectMetadata> LockPrefix(Client& client,
  * @param options a list of optional query parameters and/or request headers.
  *     Valid types for this operation include `QuotaUser`, `UserIp`,
  *     `UserProject` and `Versions`.
+ *
+ * @see `BulkDeleteByPrefix()` to delete many objects using concurrent
+ *     requests.
  */
 template <typename... Options>
 Status DeleteByPrefix(Client& client, std::string const& bucket_name,
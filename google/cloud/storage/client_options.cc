@@ -84,9 +84,11 @@ ClientOptions::ClientOptions(std::shared_ptr<oauth2::Credentials> credentials,
       enable_http_tracing_(false),
       enable_raw_client_tracing_(false),
       connection_pool_size_(DefaultConnectionPoolSize()),
+      connection_pool_stats_(std::make_shared<ConnectionPoolStats>()),
       download_buffer_size_(
           GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_DOWNLOAD_BUFFER_SIZE),
       upload_buffer_size_(GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_UPLOAD_BUFFER_SIZE),
+      upload_chunk_stats_(std::make_shared<UploadChunkStats>()),
       maximum_simple_upload_size_(
           GOOGLE_CLOUD_CPP_STORAGE_DEFAULT_MAXIMUM_SIMPLE_UPLOAD_SIZE),
       download_stall_timeout_(
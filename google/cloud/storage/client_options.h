@@ -16,13 +16,115 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_CLIENT_OPTIONS_H
 
 #include "google/cloud/storage/oauth2/credentials.h"
+#include "google/cloud/storage/request_metrics.h"
 #include "google/cloud/storage/version.h"
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
 namespace google {
 namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+class AdaptiveChunkSize;
+class PooledCurlHandleFactory;
+}  // namespace internal
+
+/**
+ * Counters describing how well the connection pool is working.
+ *
+ * The library reuses libcurl handles, and (by default) shares the DNS cache,
+ * TLS sessions, and open connections between them. Applications can use these
+ * counters to verify that connections are reused, for example, to explain the
+ * latency of small requests, which is often dominated by TLS handshakes.
+ *
+ * The counters are only updated when `ClientOptions::connection_pool_size()`
+ * is not zero. All the counters are monotonic and safe to read from any thread.
+ */
+class ConnectionPoolStats {
+ public:
+  ConnectionPoolStats() = default;
+
+  /// The number of requests that reused a handle from the pool.
+  std::uint64_t hits() const { return hits_.load(); }
+
+  /// The number of requests that had to create a new handle.
+  std::uint64_t misses() const { return misses_.load(); }
+
+  /// The number of handles released because the pool was full.
+  std::uint64_t evictions() const { return evictions_.load(); }
+
+  /// The number of requests that reused an existing connection.
+  std::uint64_t connections_reused() const {
+    return connections_reused_.load();
+  }
+
+  /// The number of requests that opened at least one new connection.
+  std::uint64_t connections_created() const {
+    return connections_created_.load();
+  }
+
+ private:
+  friend class internal::PooledCurlHandleFactory;
+
+  std::atomic<std::uint64_t> hits_{0};
+  std::atomic<std::uint64_t> misses_{0};
+  std::atomic<std::uint64_t> evictions_{0};
+  std::atomic<std::uint64_t> connections_reused_{0};
+  std::atomic<std::uint64_t> connections_created_{0};
+};
+
+/**
+ * Counters describing the chunk sizes used by resumable uploads.
+ *
+ * `Client::WriteObject()` and `Client::UploadFile()` upload data in chunks.
+ * Applications can use these counters to examine the chunk sizes chosen when
+ * `ClientOptions::maximum_upload_buffer_size()` enables adaptive chunk sizes.
+ * The last chunk in each upload is not included, as its size depends on the
+ * amount of data. All the values are safe to read from any thread.
+ */
+class UploadChunkStats {
+ public:
+  UploadChunkStats() = default;
+
+  /// The number of chunks uploaded.
+  std::uint64_t chunks() const { return chunks_.load(); }
+
+  /// The number of bytes uploaded in these chunks.
+  std::uint64_t bytes() const { return bytes_.load(); }
+
+  /// The smallest chunk uploaded, 0 if no chunks have been uploaded.
+  std::uint64_t smallest_chunk_size() const {
+    return smallest_chunk_size_.load();
+  }
+
+  /// The largest chunk uploaded.
+  std::uint64_t largest_chunk_size() const {
+    return largest_chunk_size_.load();
+  }
+
+  /// The chunk size chosen after the most recent chunk.
+  std::uint64_t last_chunk_size() const { return last_chunk_size_.load(); }
+
+  /// The number of times the chunk size was increased.
+  std::uint64_t increases() const { return increases_.load(); }
+
+  /// The number of times the chunk size was decreased.
+  std::uint64_t decreases() const { return decreases_.load(); }
+
+ private:
+  friend class internal::AdaptiveChunkSize;
+
+  std::atomic<std::uint64_t> chunks_{0};
+  std::atomic<std::uint64_t> bytes_{0};
+  std::atomic<std::uint64_t> smallest_chunk_size_{0};
+  std::atomic<std::uint64_t> largest_chunk_size_{0};
+  std::atomic<std::uint64_t> last_chunk_size_{0};
+  std::atomic<std::uint64_t> increases_{0};
+  std::atomic<std::uint64_t> decreases_{0};
+};
+
 /**
  * Describes the configuration for low-level connection features.
  *
@@ -43,8 +145,36 @@ class ChannelOptions {
     return *this;
   }
 
+  /**
+   * Use HTTP/2 for the connections to GCS.
+   *
+   * With HTTP/2 many concurrent requests are multiplexed over a few
+   * connections, instead of opening (and performing a TLS handshake on) one
+   * connection for each concurrent request. This can significantly reduce the
+   * number of connections, and the latency, for applications that make many
+   * small requests from many threads, e.g., to read object metadata or small
+   * objects.
+   *
+   * When enabled, the client runs most requests from a single background
+   * thread, which drives all the transfers over the shared connections. The
+   * streaming downloads created by `Client::ReadObject()` use HTTP/2, but
+   * keep their own connections. Requests made from that background thread,
+   * e.g., from a continuation attached to the future returned by
+   * `Client::AsyncReadObject()`, block it and do not use the shared
+   * connections. HTTP/2 is only negotiated over TLS, and it requires a libcurl
+   * built with HTTP/2 support, otherwise the requests use HTTP/1.1. The
+   * default is `false`.
+   */
+  bool enable_http2() const { return enable_http2_; }
+
+  ChannelOptions& set_enable_http2(bool enable) {
+    enable_http2_ = enable;
+    return *this;
+  }
+
  private:
   std::string ssl_root_path_;
+  bool enable_http2_ = false;
 };
 
 /**
@@ -133,12 +263,99 @@ class ClientOptions {
     return *this;
   }
 
+  /**
+   * Share the DNS cache and TLS sessions between pooled handles.
+   *
+   * Enabled by default. Only used if `connection_pool_size()` is not zero.
+   * Each pooled handle keeps its own connections, as they are used from many
+   * threads at the same time.
+   */
+  bool enable_connection_sharing() const { return enable_connection_sharing_; }
+  ClientOptions& set_enable_connection_sharing(bool v) {
+    enable_connection_sharing_ = v;
+    return *this;
+  }
+
+  /**
+   * The counters updated by the connection pool.
+   *
+   * Copies of a `ClientOptions` share the same counters, and so do any clients
+   * created from them. Set to `nullptr` to disable the counters.
+   */
+  std::shared_ptr<ConnectionPoolStats> connection_pool_stats() const {
+    return connection_pool_stats_;
+  }
+  ClientOptions& set_connection_pool_stats(
+      std::shared_ptr<ConnectionPoolStats> v) {
+    connection_pool_stats_ = std::move(v);
+    return *this;
+  }
+
+  /**
+   * The recorder for per-request latency and size metrics.
+   *
+   * When set, the library reports the timing of each phase of every HTTP
+   * request (name resolution, connection setup, TLS handshake, time to first
+   * byte, and transfer), the number of bytes transferred, and any retries.
+   * Use `HistogramRequestMetrics` to aggregate these metrics in histograms.
+   *
+   * Copies of a `ClientOptions` share the same recorder, and so do any clients
+   * created from them. The default is `nullptr`, which disables the metrics.
+   */
+  std::shared_ptr<RequestMetricsRecorder> request_metrics() const {
+    return request_metrics_;
+  }
+  ClientOptions& set_request_metrics(
+      std::shared_ptr<RequestMetricsRecorder> v) {
+    request_metrics_ = std::move(v);
+    return *this;
+  }
+
   std::size_t download_buffer_size() const { return download_buffer_size_; }
   ClientOptions& SetDownloadBufferSize(std::size_t size);
 
   std::size_t upload_buffer_size() const { return upload_buffer_size_; }
   ClientOptions& SetUploadBufferSize(std::size_t size);
 
+  /**
+   * Enable adaptive chunk sizes for resumable uploads.
+   *
+   * If this value is larger than `upload_buffer_size()` the library adapts the
+   * size of each chunk to the throughput observed for previous chunks, aiming
+   * for chunks that take about one second to upload. Fast links use larger
+   * chunks, which amortize the per-request overhead, while slow links use
+   * smaller chunks, which reduce the amount of data resent after an error.
+   *
+   * The first upload in a `Client` (or its copies) starts with chunks of
+   * `upload_buffer_size()`, later uploads start with the chunk size chosen by
+   * the previous ones. The chunk size is always a multiple of 256KiB, between
+   * 256KiB and this value. The default is `0`, which disables this feature.
+   *
+   * Adaptive chunk sizes are not used with the `UploadPipelineDepth` option.
+   */
+  std::size_t maximum_upload_buffer_size() const {
+    return maximum_upload_buffer_size_;
+  }
+  ClientOptions& SetMaximumUploadBufferSize(std::size_t size) {
+    maximum_upload_buffer_size_ = size;
+    return *this;
+  }
+
+  /**
+   * The counters describing the chunk sizes used by resumable uploads.
+   *
+   * Copies of a `ClientOptions` share the same counters, and so do any clients
+   * created from them. Set to `nullptr` to disable the counters, this does not
+   * change the chunk sizes.
+   */
+  std::shared_ptr<UploadChunkStats> upload_chunk_stats() const {
+    return upload_chunk_stats_;
+  }
+  ClientOptions& set_upload_chunk_stats(std::shared_ptr<UploadChunkStats> v) {
+    upload_chunk_stats_ = std::move(v);
+    return *this;
+  }
+
   std::string const& user_agent_prefix() const { return user_agent_prefix_; }
   ClientOptions& add_user_agent_prefx(std::string const& v) {
     std::string prefix = v;
@@ -226,8 +443,13 @@ class ClientOptions {
   bool enable_raw_client_tracing_;
   std::string project_id_;
   std::size_t connection_pool_size_;
+  bool enable_connection_sharing_ = true;
+  std::shared_ptr<ConnectionPoolStats> connection_pool_stats_;
+  std::shared_ptr<RequestMetricsRecorder> request_metrics_;
   std::size_t download_buffer_size_;
   std::size_t upload_buffer_size_;
+  std::size_t maximum_upload_buffer_size_ = 0;
+  std::shared_ptr<UploadChunkStats> upload_chunk_stats_;
   std::string user_agent_prefix_;
   std::size_t maximum_simple_upload_size_;
   bool enable_ssl_locking_callbacks_ = true;
@@ -180,6 +180,88 @@ TEST_F(ClientOptionsTest, SetMaximumSocketSendSize) {
   EXPECT_EQ(16 * 1024, client_options.maximum_socket_send_size());
 }
 
+TEST_F(ClientOptionsTest, SetEnableConnectionSharing) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_TRUE(client_options.enable_connection_sharing());
+  client_options.set_enable_connection_sharing(false);
+  EXPECT_FALSE(client_options.enable_connection_sharing());
+}
+
+TEST_F(ClientOptionsTest, ConnectionPoolStats) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  auto stats = client_options.connection_pool_stats();
+  ASSERT_NE(nullptr, stats);
+  EXPECT_EQ(0, stats->hits());
+  EXPECT_EQ(0, stats->misses());
+  EXPECT_EQ(0, stats->evictions());
+  EXPECT_EQ(0, stats->connections_reused());
+  EXPECT_EQ(0, stats->connections_created());
+
+  // Copies share the counters.
+  ClientOptions copy = client_options;
+  EXPECT_EQ(stats, copy.connection_pool_stats());
+
+  auto other = std::make_shared<ConnectionPoolStats>();
+  client_options.set_connection_pool_stats(other);
+  EXPECT_EQ(other, client_options.connection_pool_stats());
+  client_options.set_connection_pool_stats(nullptr);
+  EXPECT_EQ(nullptr, client_options.connection_pool_stats());
+}
+
+TEST_F(ClientOptionsTest, SetMaximumUploadBufferSize) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(0, client_options.maximum_upload_buffer_size());
+  client_options.SetMaximumUploadBufferSize(64 * 1024 * 1024);
+  EXPECT_EQ(64 * 1024 * 1024, client_options.maximum_upload_buffer_size());
+}
+
+TEST_F(ClientOptionsTest, UploadChunkStats) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  auto stats = client_options.upload_chunk_stats();
+  ASSERT_NE(nullptr, stats);
+  EXPECT_EQ(0, stats->chunks());
+  EXPECT_EQ(0, stats->bytes());
+  EXPECT_EQ(0, stats->smallest_chunk_size());
+  EXPECT_EQ(0, stats->largest_chunk_size());
+  EXPECT_EQ(0, stats->last_chunk_size());
+  EXPECT_EQ(0, stats->increases());
+  EXPECT_EQ(0, stats->decreases());
+
+  // Copies share the counters.
+  ClientOptions copy = client_options;
+  EXPECT_EQ(stats, copy.upload_chunk_stats());
+
+  auto other = std::make_shared<UploadChunkStats>();
+  client_options.set_upload_chunk_stats(other);
+  EXPECT_EQ(other, client_options.upload_chunk_stats());
+  client_options.set_upload_chunk_stats(nullptr);
+  EXPECT_EQ(nullptr, client_options.upload_chunk_stats());
+}
+
+TEST_F(ClientOptionsTest, RequestMetrics) {
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials());
+  EXPECT_EQ(nullptr, client_options.request_metrics());
+
+  auto metrics = std::make_shared<HistogramRequestMetrics>();
+  client_options.set_request_metrics(metrics);
+  EXPECT_EQ(metrics, client_options.request_metrics());
+
+  // Copies share the recorder.
+  ClientOptions copy = client_options;
+  EXPECT_EQ(metrics, copy.request_metrics());
+}
+
+TEST_F(ClientOptionsTest, ChannelOptionsHttp2) {
+  ChannelOptions channel_options;
+  EXPECT_FALSE(channel_options.enable_http2());
+  channel_options.set_enable_http2(true);
+  EXPECT_TRUE(channel_options.enable_http2());
+
+  ClientOptions client_options(oauth2::CreateAnonymousCredentials(),
+                               channel_options);
+  EXPECT_TRUE(client_options.channel_options().enable_http2());
+}
+
 TEST_F(ClientOptionsTest, SetMaximumDownloadStall) {
   ClientOptions client_options(oauth2::CreateAnonymousCredentials());
   auto default_value = client_options.download_stall_timeout();
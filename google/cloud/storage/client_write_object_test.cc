@@ -17,6 +17,7 @@
 #include "google/cloud/storage/retry_policy.h"
 #include "google/cloud/storage/testing/canonical_errors.h"
 #include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/temp_file.h"
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include <gmock/gmock.h>
@@ -61,6 +62,8 @@ class WriteObjectTest : public ::testing::Test {
   std::unique_ptr<Client> client;
   ClientOptions client_options =
       ClientOptions(oauth2::CreateAnonymousCredentials());
+  StatusOr<internal::ResumableUploadResponse> fake_last_response =
+      internal::ResumableUploadResponse{};
 };
 
 TEST_F(WriteObjectTest, WriteObject) {
@@ -103,6 +106,125 @@ TEST_F(WriteObjectTest, WriteObject) {
   EXPECT_EQ(expected, actual);
 }
 
+TEST_F(WriteObjectTest, WriteObjectPipelined) {
+  std::string text = R"""({
+      "name": "test-bucket-name/test-object-name/1"
+})""";
+  auto expected = internal::ObjectMetadataParser::FromString(text).value();
+
+  auto const quantum = internal::UploadChunkRequest::kChunkSizeQuantum;
+  client_options.SetUploadBufferSize(quantum);
+  std::vector<std::size_t> uploads;
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([&](internal::ResumableUploadRequest const& request) {
+        EXPECT_EQ(2, request.GetOption<UploadPipelineDepth>().value());
+
+        auto mock = make_unique<testing::MockResumableUploadSession>();
+        using internal::ResumableUploadResponse;
+        auto next_expected = std::make_shared<std::uint64_t>(0);
+        EXPECT_CALL(*mock, done()).WillRepeatedly(Return(false));
+        EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Invoke([=] {
+          return *next_expected;
+        }));
+        EXPECT_CALL(*mock, last_response())
+            .WillRepeatedly(ReturnRef(fake_last_response));
+        EXPECT_CALL(*mock, UploadChunk(_))
+            .WillRepeatedly(Invoke([=, &uploads](std::string const& p) {
+              uploads.push_back(p.size());
+              *next_expected += p.size();
+              return make_status_or(ResumableUploadResponse{
+                  "fake-url", *next_expected - 1, {},
+                  ResumableUploadResponse::kInProgress, {}});
+            }));
+        EXPECT_CALL(*mock, UploadFinalChunk(_, _))
+            .WillOnce(Invoke([=, &uploads](std::string const& p,
+                                           std::uint64_t upload_size) {
+              uploads.push_back(p.size());
+              EXPECT_EQ(3 * quantum + 5, upload_size);
+              return make_status_or(ResumableUploadResponse{
+                  "fake-url", 0, expected, ResumableUploadResponse::kDone,
+                  {}});
+            }));
+
+        return make_status_or(
+            std::unique_ptr<internal ::ResumableUploadSession>(
+                std::move(mock)));
+      }));
+
+  auto stream = client->WriteObject("test-bucket-name", "test-object-name",
+                                    UploadPipelineDepth(2));
+  stream << std::string(3 * quantum, 'A') << "Hello";
+  stream.Close();
+  ASSERT_STATUS_OK(stream.metadata());
+  EXPECT_EQ(expected, stream.metadata().value());
+  EXPECT_THAT(uploads, ::testing::ElementsAre(quantum, quantum, quantum, 5));
+}
+
+TEST_F(WriteObjectTest, UploadFileMemoryMapped) {
+  std::string text = R"""({
+      "name": "test-bucket-name/test-object-name/1"
+})""";
+  auto expected = internal::ObjectMetadataParser::FromString(text).value();
+
+  auto const quantum = internal::UploadChunkRequest::kChunkSizeQuantum;
+  client_options.SetUploadBufferSize(quantum);
+  std::string const contents =
+      std::string(quantum, 'A') + std::string(quantum, 'B') + "Hello";
+  testing::TempFile temp_file(contents);
+
+  std::vector<std::string> uploads;
+  EXPECT_CALL(*mock, CreateResumableSession(_))
+      .WillOnce(Invoke([&](internal::ResumableUploadRequest const& request) {
+        EXPECT_TRUE(request.GetOption<UseMemoryMappedFile>().value());
+
+        auto mock = make_unique<testing::MockResumableUploadSession>();
+        using internal::ResumableUploadResponse;
+        // Simulate a restored session, where the first chunk was uploaded
+        // already.
+        auto next_expected = std::make_shared<std::uint64_t>(quantum);
+        auto done = std::make_shared<bool>(false);
+        EXPECT_CALL(*mock, done()).WillRepeatedly(Invoke([=] {
+          return *done;
+        }));
+        EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Invoke([=] {
+          return *next_expected;
+        }));
+        EXPECT_CALL(*mock, last_response())
+            .WillRepeatedly(ReturnRef(fake_last_response));
+        EXPECT_CALL(*mock, UploadChunk(_))
+            .WillOnce(Invoke([=, &uploads](std::string const& p) {
+              uploads.push_back(p);
+              *next_expected += p.size();
+              return make_status_or(ResumableUploadResponse{
+                  "fake-url", *next_expected - 1, {},
+                  ResumableUploadResponse::kInProgress, {}});
+            }));
+        EXPECT_CALL(*mock, UploadFinalChunk(_, _))
+            .WillOnce(Invoke([=, &uploads](std::string const& p,
+                                           std::uint64_t upload_size) {
+              uploads.push_back(p);
+              EXPECT_EQ(2 * quantum + 5, upload_size);
+              *next_expected += p.size();
+              *done = true;
+              return make_status_or(ResumableUploadResponse{
+                  "fake-url", 0, expected, ResumableUploadResponse::kDone,
+                  {}});
+            }));
+
+        return make_status_or(
+            std::unique_ptr<internal ::ResumableUploadSession>(
+                std::move(mock)));
+      }));
+
+  auto actual = client->UploadFile(
+      temp_file.name(), "test-bucket-name", "test-object-name",
+      RestoreResumableUploadSession("fake-url"), UseMemoryMappedFile(true));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(expected, *actual);
+  EXPECT_THAT(uploads, ::testing::ElementsAre(std::string(quantum, 'B'),
+                                              std::string("Hello")));
+}
+
 TEST_F(WriteObjectTest, WriteObjectTooManyFailures) {
   Client client{std::shared_ptr<internal::RawClient>(mock),
                 LimitedErrorCountRetryPolicy(2),
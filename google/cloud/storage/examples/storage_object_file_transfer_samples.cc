@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/client.h"
 #include "google/cloud/storage/examples/storage_examples_common.h"
+#include "google/cloud/storage/parallel_download.h"
 #include "google/cloud/storage/parallel_upload.h"
 #include "google/cloud/internal/getenv.h"
 #include <cstdlib>
@@ -104,6 +105,25 @@ void DownloadFile(google::cloud::storage::Client client,
   (std::move(client), argv.at(0), argv.at(1), argv.at(2));
 }
 
+void ParallelDownloadFile(google::cloud::storage::Client client,
+                          std::vector<std::string> const& argv) {
+  //! [parallel download file]
+  namespace gcs = google::cloud::storage;
+  [](gcs::Client client, std::string bucket_name, std::string object_name,
+     std::string file_name) {
+    // Keep track of the progress in a separate file, if the download is
+    // interrupted running this function again resumes the download.
+    google::cloud::Status status = gcs::ParallelDownloadFile(
+        client, bucket_name, object_name, file_name,
+        gcs::ParallelDownloadStateFile(file_name + ".download-state"));
+    if (!status.ok()) throw std::runtime_error(status.message());
+
+    std::cout << "Downloaded " << object_name << " to " << file_name << "\n";
+  }
+  //! [parallel download file]
+  (std::move(client), argv.at(0), argv.at(1), argv.at(2));
+}
+
 std::string MakeRandomFilename(
     google::cloud::internal::DefaultPRNG& generator) {
   auto constexpr kMaxBasenameLength = 28;
@@ -161,6 +181,9 @@ culpa qui officia deserunt mollit anim id est laborum.
   std::cout << "\nRunning the ParallelUploadFile() example" << std::endl;
   ParallelUploadFile(client, {filename_1, bucket_name, object_name});
 
+  std::cout << "\nRunning the ParallelDownloadFile() example" << std::endl;
+  ParallelDownloadFile(client, {bucket_name, object_name, filename_1});
+
   std::cout << "\nDeleting uploaded object" << std::endl;
   (void)client.DeleteObject(bucket_name, object_name);
 
@@ -195,6 +218,10 @@ int main(int argc, char* argv[]) {
       examples::CreateCommandEntry(
           "download-file", {"<bucket-name>", "<object-name>", "<filename>"},
           DownloadFile),
+      examples::CreateCommandEntry(
+          "parallel-download-file",
+          {"<bucket-name>", "<object-name>", "<filename>"},
+          ParallelDownloadFile),
       {"auto", RunAll},
   });
   return example.Run(argc, argv);
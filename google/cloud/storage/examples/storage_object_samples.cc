@@ -260,6 +260,29 @@ void ReadObject(google::cloud::storage::Client client,
   (std::move(client), argv.at(0), argv.at(1));
 }
 
+void AsyncReadObject(google::cloud::storage::Client client,
+                     std::vector<std::string> const& argv) {
+  //! [async read object]
+  namespace gcs = google::cloud::storage;
+  using ::google::cloud::future;
+  using ::google::cloud::StatusOr;
+  [](gcs::Client client, std::string bucket_name, std::string object_name) {
+    // Start several downloads, none of them block this thread.
+    std::vector<future<StatusOr<std::string>>> pending;
+    for (int i = 0; i != 4; ++i) {
+      pending.push_back(client.AsyncReadObject(bucket_name, object_name));
+    }
+
+    for (auto& f : pending) {
+      StatusOr<std::string> contents = f.get();
+      if (!contents) throw std::runtime_error(contents.status().message());
+      std::cout << "The object has " << contents->size() << " bytes\n";
+    }
+  }
+  //! [async read object]
+  (std::move(client), argv.at(0), argv.at(1));
+}
+
 void ReadObjectRange(google::cloud::storage::Client client,
                      std::vector<std::string> const& argv) {
   //! [read object range] [START storage_download_byte_range]
@@ -553,6 +576,9 @@ void RunAll(std::vector<std::string> const& argv) {
   std::cout << "\nRunning WriteObject() example" << std::endl;
   WriteObject(client, {bucket_name, object_name, "100000"});
 
+  std::cout << "\nRunning AsyncReadObject() example" << std::endl;
+  AsyncReadObject(client, {bucket_name, object_name});
+
   std::cout << "\nRunning ReadObjectRange() example" << std::endl;
   ReadObjectRange(client, {bucket_name, object_name, "1000", "2000"});
 
@@ -650,6 +676,7 @@ int main(int argc, char* argv[]) {
           CopyObject),
       make_entry("get-object-metadata", {"<object-name>"}, GetObjectMetadata),
       make_entry("read-object", {"<object-name>"}, ReadObject),
+      make_entry("async-read-object", {"<object-name>"}, AsyncReadObject),
       make_entry("read-object-range", {"<object-name>", "<start>", "<end>"},
                  ReadObjectRange),
       make_entry("delete-object", {"<object-name>"}, DeleteObject),
@@ -106,6 +106,26 @@ struct DisableCrc32cChecksum
   static char const* name() { return "disable-crc32c-checksum"; }
 };
 
+/**
+ * Compute the hashes and checksums in a separate thread.
+ *
+ * By default the client library computes the MD5 hash and CRC32C checksum of
+ * uploaded and downloaded data in the thread making the request, in between
+ * the network operations. With this option set to `true` the data is copied
+ * to a bounded queue and hashed by a separate thread, overlapping the
+ * computation with the network transfer. This improves the throughput of
+ * large uploads and downloads, but it requires an additional thread for each
+ * one, and is not recommended for small objects.
+ */
+struct UseHashingThread
+    : public internal::ComplexOption<UseHashingThread, bool> {
+  using ComplexOption<UseHashingThread, bool>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  UseHashingThread() = default;
+  static char const* name() { return "use-hashing-thread"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
@@ -0,0 +1,112 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/hedging_options.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+// Keep enough samples to estimate the high percentiles without making
+// `hedge_delay()` expensive.
+std::size_t constexpr kMaxSamples = 256;
+// Use the initial delay until this many samples are available.
+std::size_t constexpr kMinSamples = 16;
+}  // namespace
+
+struct HedgingPolicy::Impl {
+  double percentile;
+  std::chrono::microseconds initial_delay;
+  std::chrono::microseconds minimum_delay;
+
+  std::mutex mu;
+  std::vector<std::chrono::microseconds> samples;  // GUARDED_BY(mu)
+  std::size_t next = 0;                            // GUARDED_BY(mu)
+};
+
+HedgingPolicy HedgingPolicy::FixedDelay(std::chrono::microseconds delay) {
+  auto impl = std::make_shared<Impl>();
+  impl->percentile = 0.0;
+  impl->initial_delay = delay;
+  impl->minimum_delay = delay;
+  return HedgingPolicy(std::move(impl));
+}
+
+HedgingPolicy HedgingPolicy::Percentile(
+    double percentile, std::chrono::microseconds initial_delay,
+    std::chrono::microseconds minimum_delay) {
+  auto impl = std::make_shared<Impl>();
+  impl->percentile = (std::min)(100.0, (std::max)(0.0, percentile));
+  impl->initial_delay = initial_delay;
+  impl->minimum_delay = minimum_delay;
+  return HedgingPolicy(std::move(impl));
+}
+
+HedgingPolicy::HedgingPolicy(std::shared_ptr<Impl> impl)
+    : impl_(std::move(impl)) {}
+
+std::chrono::microseconds HedgingPolicy::hedge_delay() const {
+  if (impl_->percentile <= 0.0) {
+    return impl_->initial_delay;
+  }
+  std::vector<std::chrono::microseconds> samples;
+  {
+    std::lock_guard<std::mutex> lk(impl_->mu);
+    if (impl_->samples.size() < kMinSamples) {
+      return impl_->initial_delay;
+    }
+    samples = impl_->samples;
+  }
+  auto const rank = static_cast<std::size_t>(std::ceil(
+      impl_->percentile / 100.0 * static_cast<double>(samples.size())));
+  auto const index = rank == 0 ? 0 : (std::min)(rank, samples.size()) - 1;
+  auto nth = samples.begin() + static_cast<std::ptrdiff_t>(index);
+  std::nth_element(samples.begin(), nth, samples.end());
+  return (std::max)(*nth, impl_->minimum_delay);
+}
+
+void HedgingPolicy::RecordLatency(std::chrono::microseconds latency) const {
+  if (impl_->percentile <= 0.0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lk(impl_->mu);
+  if (impl_->samples.size() < kMaxSamples) {
+    impl_->samples.push_back(latency);
+    return;
+  }
+  impl_->samples[impl_->next] = latency;
+  impl_->next = (impl_->next + 1) % kMaxSamples;
+}
+
+double HedgingPolicy::percentile() const { return impl_->percentile; }
+
+std::ostream& operator<<(std::ostream& os, HedgingPolicy const& rhs) {
+  os << "HedgingPolicy={";
+  if (rhs.percentile() <= 0.0) {
+    return os << "delay=" << rhs.hedge_delay().count() << "us}";
+  }
+  return os << "percentile=" << rhs.percentile()
+            << ", delay=" << rhs.hedge_delay().count() << "us}";
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
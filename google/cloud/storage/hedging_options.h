@@ -0,0 +1,118 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_HEDGING_OPTIONS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_HEDGING_OPTIONS_H
+
+#include "google/cloud/storage/internal/complex_option.h"
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <iosfwd>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * Controls when a hedged request is sent.
+ *
+ * A hedged request is a second copy of a request, sent when the first one is
+ * taking longer than usual. The client library uses whichever copy completes
+ * first, and discards the other. Hedging trades a small increase in the number
+ * of requests for lower tail latency, it is only recommended for small,
+ * latency-sensitive reads.
+ *
+ * The delay before sending the second request is either fixed, or a percentile
+ * of the recent (successful) request latencies. Copies of a `HedgingPolicy`
+ * share the latency history, applications should reuse the same policy for
+ * requests with similar latency profiles.
+ *
+ * @par Example
+ * @code
+ * auto policy = gcs::HedgingPolicy::Percentile(
+ *     95.0, std::chrono::milliseconds(50), std::chrono::milliseconds(5));
+ * auto metadata = client.GetObjectMetadata(
+ *     "my-bucket", "my-object", gcs::HedgeRequests(policy));
+ * @endcode
+ */
+class HedgingPolicy {
+ public:
+  /// Send the second request after a fixed @p delay.
+  static HedgingPolicy FixedDelay(std::chrono::microseconds delay);
+
+  /**
+   * Send the second request when the first takes longer than @p percentile of
+   * the recent requests.
+   *
+   * @param percentile the latency percentile, in the `(0, 100]` range.
+   * @param initial_delay the delay used until enough latency samples are
+   *     collected.
+   * @param minimum_delay a lower bound for the delay, prevents hedging every
+   *     request when the latencies are very uniform.
+   */
+  static HedgingPolicy Percentile(double percentile,
+                                  std::chrono::microseconds initial_delay,
+                                  std::chrono::microseconds minimum_delay);
+
+  /// The delay before sending the second request.
+  std::chrono::microseconds hedge_delay() const;
+
+  /// Record the latency of a successful request.
+  void RecordLatency(std::chrono::microseconds latency) const;
+
+  /// The configured percentile, 0 for fixed delay policies.
+  double percentile() const;
+
+ private:
+  struct Impl;
+  explicit HedgingPolicy(std::shared_ptr<Impl> impl);
+
+  std::shared_ptr<Impl> impl_;
+};
+
+std::ostream& operator<<(std::ostream& os, HedgingPolicy const& rhs);
+
+/**
+ * Send a hedged request if the first request is slow.
+ *
+ * This option is supported by `Client::ReadObject()` and
+ * `Client::GetObjectMetadata()`. If the request (including any retries) does
+ * not complete before the delay configured in the `HedgingPolicy` a second
+ * request is sent, and the result of the first one to succeed is returned.
+ * For downloads the race includes the first block of data, which is where
+ * most of the latency of small downloads is.
+ *
+ * The losing request runs to completion (or until the first block of data is
+ * received) in a background thread and is then discarded. These threads are
+ * owned by the `Client`, destroying the last copy of a `Client` waits for any
+ * losing requests still running. Each hedged request uses additional threads,
+ * this option is not recommended for large downloads, or for applications
+ * with a large number of concurrent requests.
+ */
+struct HedgeRequests
+    : public internal::ComplexOption<HedgeRequests, HedgingPolicy> {
+  using ComplexOption<HedgeRequests, HedgingPolicy>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  HedgeRequests() = default;
+  static char const* name() { return "hedge-requests"; }
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_HEDGING_OPTIONS_H
@@ -0,0 +1,101 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/hedging_options.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::testing::HasSubstr;
+using us = std::chrono::microseconds;
+
+TEST(HedgingPolicyTest, FixedDelay) {
+  auto policy = HedgingPolicy::FixedDelay(us(1000));
+  EXPECT_EQ(us(1000), policy.hedge_delay());
+  EXPECT_EQ(0.0, policy.percentile());
+  for (int i = 0; i != 100; ++i) {
+    policy.RecordLatency(us(10));
+  }
+  EXPECT_EQ(us(1000), policy.hedge_delay());
+}
+
+TEST(HedgingPolicyTest, PercentileUsesInitialDelay) {
+  auto policy = HedgingPolicy::Percentile(95.0, us(5000), us(10));
+  EXPECT_EQ(us(5000), policy.hedge_delay());
+  for (int i = 0; i != 4; ++i) {
+    policy.RecordLatency(us(100));
+  }
+  EXPECT_EQ(us(5000), policy.hedge_delay());
+}
+
+TEST(HedgingPolicyTest, Percentile) {
+  auto policy = HedgingPolicy::Percentile(95.0, us(5000), us(10));
+  for (int i = 100; i != 0; --i) {
+    policy.RecordLatency(us(i * 100));
+  }
+  EXPECT_EQ(us(9500), policy.hedge_delay());
+
+  auto p50 = HedgingPolicy::Percentile(50.0, us(5000), us(10));
+  for (int i = 1; i <= 100; ++i) {
+    p50.RecordLatency(us(i * 100));
+  }
+  EXPECT_EQ(us(5000), p50.hedge_delay());
+}
+
+TEST(HedgingPolicyTest, PercentileMinimumDelay) {
+  auto policy = HedgingPolicy::Percentile(99.0, us(5000), us(2000));
+  for (int i = 0; i != 100; ++i) {
+    policy.RecordLatency(us(100));
+  }
+  EXPECT_EQ(us(2000), policy.hedge_delay());
+}
+
+TEST(HedgingPolicyTest, PercentileUsesRecentSamples) {
+  auto policy = HedgingPolicy::Percentile(50.0, us(5000), us(10));
+  for (int i = 0; i != 1000; ++i) {
+    policy.RecordLatency(us(100));
+  }
+  for (int i = 0; i != 1000; ++i) {
+    policy.RecordLatency(us(300));
+  }
+  EXPECT_EQ(us(300), policy.hedge_delay());
+}
+
+TEST(HedgingPolicyTest, CopiesShareHistory) {
+  auto policy = HedgingPolicy::Percentile(90.0, us(5000), us(10));
+  auto copy = policy;
+  for (int i = 0; i != 100; ++i) {
+    copy.RecordLatency(us(200));
+  }
+  EXPECT_EQ(us(200), policy.hedge_delay());
+}
+
+TEST(HedgingPolicyTest, Streaming) {
+  std::ostringstream os;
+  os << HedgeRequests(HedgingPolicy::Percentile(95.0, us(5000), us(10)));
+  EXPECT_THAT(os.str(), HasSubstr("hedge-requests="));
+  EXPECT_THAT(os.str(), HasSubstr("percentile=95"));
+  EXPECT_THAT(os.str(), HasSubstr("delay=5000us"));
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,127 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/adaptive_chunk_size.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include <algorithm>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// The weight of the last measurement in the average throughput.
+auto constexpr kThroughputWeight = 0.5;
+
+std::size_t RoundDownToQuantum(std::size_t size) {
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  return (std::max)(quantum, size / quantum * quantum);
+}
+
+void UpdateMinimum(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+  auto current = counter.load();
+  while ((current == 0 || value < current) &&
+         !counter.compare_exchange_weak(current, value)) {
+  }
+}
+
+void UpdateMaximum(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+  auto current = counter.load();
+  while (value > current && !counter.compare_exchange_weak(current, value)) {
+  }
+}
+}  // namespace
+
+AdaptiveChunkSize::AdaptiveChunkSize(std::size_t initial_size,
+                                     std::size_t maximum_size,
+                                     std::shared_ptr<UploadChunkStats> stats,
+                                     std::shared_ptr<LearnedChunkSize> learned,
+                                     std::chrono::microseconds target_latency)
+    : minimum_size_(UploadChunkRequest::RoundUpToQuantum(initial_size)),
+      maximum_size_(minimum_size_),
+      chunk_size_(minimum_size_),
+      target_latency_(target_latency),
+      stats_(std::move(stats)),
+      learned_(std::move(learned)) {
+  if (maximum_size <= chunk_size_) {
+    return;
+  }
+  minimum_size_ = UploadChunkRequest::kChunkSizeQuantum;
+  maximum_size_ = RoundDownToQuantum(maximum_size);
+  if (learned_ && learned_->get() != 0) {
+    // Start with the size chosen by previous uploads.
+    chunk_size_ =
+        RoundDownToQuantum((std::min)(learned_->get(), maximum_size_));
+  }
+}
+
+AdaptiveChunkSize AdaptiveChunkSize::FromOptions(
+    ClientOptions const& options, std::shared_ptr<LearnedChunkSize> learned) {
+  return AdaptiveChunkSize(
+      options.upload_buffer_size(), options.maximum_upload_buffer_size(),
+      options.upload_chunk_stats(), std::move(learned));
+}
+
+void AdaptiveChunkSize::OnChunkUploaded(std::size_t bytes,
+                                        std::chrono::microseconds elapsed) {
+  RecordChunk(bytes);
+  if (!adaptive() || bytes == 0) {
+    return;
+  }
+  using seconds = std::chrono::duration<double>;
+  auto const elapsed_seconds =
+      (std::max)(seconds(elapsed), seconds(std::chrono::microseconds(1)));
+  auto const throughput = static_cast<double>(bytes) / elapsed_seconds.count();
+  throughput_ = throughput_ == 0 ? throughput
+                                 : kThroughputWeight * throughput +
+                                       (1 - kThroughputWeight) * throughput_;
+
+  auto const desired = throughput_ * seconds(target_latency_).count();
+  // Change the size gradually, a single slow (or fast) chunk is not a trend.
+  auto const lower = static_cast<double>(chunk_size_ / 2);
+  auto const upper = static_cast<double>(chunk_size_) * 2;
+  auto const bounded = (std::min)((std::max)(desired, lower), upper);
+  auto const next = (std::min)(
+      (std::max)(RoundDownToQuantum(static_cast<std::size_t>(bounded)),
+                 minimum_size_),
+      maximum_size_);
+
+  if (stats_) {
+    if (next > chunk_size_) {
+      ++stats_->increases_;
+    } else if (next < chunk_size_) {
+      ++stats_->decreases_;
+    }
+    stats_->last_chunk_size_.store(next);
+  }
+  if (learned_) learned_->set(next);
+  chunk_size_ = next;
+}
+
+void AdaptiveChunkSize::RecordChunk(std::size_t bytes) {
+  if (!stats_) {
+    return;
+  }
+  ++stats_->chunks_;
+  stats_->bytes_ += bytes;
+  UpdateMinimum(stats_->smallest_chunk_size_, bytes);
+  UpdateMaximum(stats_->largest_chunk_size_, bytes);
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,107 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_ADAPTIVE_CHUNK_SIZE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_ADAPTIVE_CHUNK_SIZE_H
+
+#include "google/cloud/storage/client_options.h"
+#include "google/cloud/storage/version.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * The chunk size chosen by previous uploads.
+ *
+ * Each `Client` (and its copies) shares one of these, so new uploads start
+ * with the chunk size learned by previous uploads. This is independent of
+ * `UploadChunkStats`, which only observes the uploads. It is safe to use from
+ * multiple threads.
+ */
+class LearnedChunkSize {
+ public:
+  /// The chunk size chosen by the most recent upload, 0 if none.
+  std::size_t get() const { return value_.load(); }
+  void set(std::size_t value) { value_.store(value); }
+
+ private:
+  std::atomic<std::size_t> value_{0};
+};
+
+/**
+ * Chooses the chunk size for resumable uploads.
+ *
+ * The chunk size is adapted to the throughput observed for the previous
+ * chunks: the next chunk should take about @p target_latency to upload. To
+ * smooth out noisy measurements the throughput is a moving average, and the
+ * chunk size changes by at most a factor of 2 after each chunk. Chunk sizes
+ * are always a multiple of the 256KiB quantum required by GCS.
+ *
+ * If @p maximum_size is not larger than @p initial_size the chunk size is
+ * fixed, but the chunks are still recorded in @p stats (if not null).
+ * Otherwise the first chunk size is taken from @p learned (if not null and
+ * set), and the chunk sizes chosen by this upload are saved there.
+ *
+ * This class is not thread-safe, each upload uses its own instance.
+ */
+class AdaptiveChunkSize {
+ public:
+  AdaptiveChunkSize(
+      std::size_t initial_size, std::size_t maximum_size,
+      std::shared_ptr<UploadChunkStats> stats,
+      std::shared_ptr<LearnedChunkSize> learned = {},
+      std::chrono::microseconds target_latency = std::chrono::seconds(1));
+
+  /// Creates an object configured from @p options.
+  static AdaptiveChunkSize FromOptions(
+      ClientOptions const& options,
+      std::shared_ptr<LearnedChunkSize> learned = {});
+
+  bool adaptive() const { return maximum_size_ > minimum_size_; }
+  std::size_t chunk_size() const { return chunk_size_; }
+
+  /**
+   * Updates the chunk size after uploading @p bytes in @p elapsed time.
+   *
+   * Only call this function for chunks that succeed. The last chunk in an
+   * upload is typically shorter, and its latency is not representative.
+   */
+  void OnChunkUploaded(std::size_t bytes, std::chrono::microseconds elapsed);
+
+ private:
+  void RecordChunk(std::size_t bytes);
+
+  std::size_t minimum_size_;
+  std::size_t maximum_size_;
+  std::size_t chunk_size_;
+  std::chrono::microseconds target_latency_;
+  std::shared_ptr<UploadChunkStats> stats_;
+  std::shared_ptr<LearnedChunkSize> learned_;
+  // The average throughput, in bytes per second, 0 until the first chunk.
+  double throughput_ = 0;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_ADAPTIVE_CHUNK_SIZE_H
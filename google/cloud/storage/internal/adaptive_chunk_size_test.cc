@@ -0,0 +1,161 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/adaptive_chunk_size.h"
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using std::chrono::milliseconds;
+auto constexpr kQuantum = UploadChunkRequest::kChunkSizeQuantum;
+
+TEST(AdaptiveChunkSizeTest, Fixed) {
+  auto stats = std::make_shared<UploadChunkStats>();
+  AdaptiveChunkSize tested(3 * kQuantum - 1, 0, stats);
+  EXPECT_FALSE(tested.adaptive());
+  EXPECT_EQ(3 * kQuantum, tested.chunk_size());
+
+  tested.OnChunkUploaded(3 * kQuantum, milliseconds(10));
+  tested.OnChunkUploaded(3 * kQuantum, milliseconds(10000));
+  EXPECT_EQ(3 * kQuantum, tested.chunk_size());
+
+  EXPECT_EQ(2, stats->chunks());
+  EXPECT_EQ(6 * kQuantum, stats->bytes());
+  EXPECT_EQ(3 * kQuantum, stats->smallest_chunk_size());
+  EXPECT_EQ(3 * kQuantum, stats->largest_chunk_size());
+  EXPECT_EQ(0, stats->last_chunk_size());
+  EXPECT_EQ(0, stats->increases());
+  EXPECT_EQ(0, stats->decreases());
+}
+
+TEST(AdaptiveChunkSizeTest, GrowsOnFastLinks) {
+  auto stats = std::make_shared<UploadChunkStats>();
+  AdaptiveChunkSize tested(4 * kQuantum, 64 * kQuantum, stats, {},
+                           milliseconds(1000));
+  EXPECT_TRUE(tested.adaptive());
+  EXPECT_EQ(4 * kQuantum, tested.chunk_size());
+
+  // Each chunk takes 100ms, the chunk size can grow by at most 2x each time.
+  tested.OnChunkUploaded(4 * kQuantum, milliseconds(100));
+  EXPECT_EQ(8 * kQuantum, tested.chunk_size());
+  tested.OnChunkUploaded(8 * kQuantum, milliseconds(100));
+  EXPECT_EQ(16 * kQuantum, tested.chunk_size());
+  tested.OnChunkUploaded(16 * kQuantum, milliseconds(100));
+  EXPECT_EQ(32 * kQuantum, tested.chunk_size());
+  tested.OnChunkUploaded(32 * kQuantum, milliseconds(100));
+  EXPECT_EQ(64 * kQuantum, tested.chunk_size());
+  // Never exceed the maximum.
+  tested.OnChunkUploaded(64 * kQuantum, milliseconds(100));
+  EXPECT_EQ(64 * kQuantum, tested.chunk_size());
+
+  EXPECT_EQ(5, stats->chunks());
+  EXPECT_EQ(4 * kQuantum, stats->smallest_chunk_size());
+  EXPECT_EQ(64 * kQuantum, stats->largest_chunk_size());
+  EXPECT_EQ(64 * kQuantum, stats->last_chunk_size());
+  EXPECT_EQ(4, stats->increases());
+  EXPECT_EQ(0, stats->decreases());
+}
+
+TEST(AdaptiveChunkSizeTest, ShrinksOnSlowLinks) {
+  auto stats = std::make_shared<UploadChunkStats>();
+  AdaptiveChunkSize tested(16 * kQuantum, 64 * kQuantum, stats, {},
+                           milliseconds(1000));
+
+  // Each chunk takes 10s, the chunk size can shrink by at most 2x each time.
+  tested.OnChunkUploaded(16 * kQuantum, milliseconds(10000));
+  EXPECT_EQ(8 * kQuantum, tested.chunk_size());
+  tested.OnChunkUploaded(8 * kQuantum, milliseconds(10000));
+  EXPECT_EQ(4 * kQuantum, tested.chunk_size());
+  tested.OnChunkUploaded(4 * kQuantum, milliseconds(10000));
+  EXPECT_EQ(2 * kQuantum, tested.chunk_size());
+  tested.OnChunkUploaded(2 * kQuantum, milliseconds(10000));
+  EXPECT_EQ(kQuantum, tested.chunk_size());
+  // Never go below the quantum.
+  tested.OnChunkUploaded(kQuantum, milliseconds(10000));
+  EXPECT_EQ(kQuantum, tested.chunk_size());
+
+  EXPECT_EQ(0, stats->increases());
+  EXPECT_EQ(4, stats->decreases());
+  EXPECT_EQ(kQuantum, stats->last_chunk_size());
+}
+
+TEST(AdaptiveChunkSizeTest, Stable) {
+  AdaptiveChunkSize tested(8 * kQuantum, 64 * kQuantum, {}, {},
+                           milliseconds(1000));
+  // The chunk takes exactly the target latency.
+  for (int i = 0; i != 5; ++i) {
+    tested.OnChunkUploaded(8 * kQuantum, milliseconds(1000));
+    EXPECT_EQ(8 * kQuantum, tested.chunk_size());
+  }
+}
+
+TEST(AdaptiveChunkSizeTest, StartsWithPreviousSize) {
+  auto learned = std::make_shared<LearnedChunkSize>();
+  {
+    AdaptiveChunkSize tested(4 * kQuantum, 64 * kQuantum, {}, learned,
+                             milliseconds(1000));
+    tested.OnChunkUploaded(4 * kQuantum, milliseconds(100));
+    EXPECT_EQ(8 * kQuantum, tested.chunk_size());
+  }
+  EXPECT_EQ(8 * kQuantum, learned->get());
+  AdaptiveChunkSize tested(4 * kQuantum, 64 * kQuantum, {}, learned,
+                           milliseconds(1000));
+  EXPECT_EQ(8 * kQuantum, tested.chunk_size());
+
+  // Unless adaptive chunk sizes are disabled.
+  AdaptiveChunkSize fixed(4 * kQuantum, 0, {}, learned);
+  EXPECT_EQ(4 * kQuantum, fixed.chunk_size());
+}
+
+TEST(AdaptiveChunkSizeTest, StatsDoNotChangeChunkSize) {
+  auto stats = std::make_shared<UploadChunkStats>();
+  {
+    AdaptiveChunkSize tested(4 * kQuantum, 64 * kQuantum, stats, {},
+                             milliseconds(1000));
+    tested.OnChunkUploaded(4 * kQuantum, milliseconds(100));
+  }
+  EXPECT_EQ(8 * kQuantum, stats->last_chunk_size());
+  // The counters only observe the uploads, new uploads do not use them.
+  AdaptiveChunkSize with_stats(4 * kQuantum, 64 * kQuantum, stats);
+  EXPECT_EQ(4 * kQuantum, with_stats.chunk_size());
+  AdaptiveChunkSize without_stats(4 * kQuantum, 64 * kQuantum, {});
+  EXPECT_EQ(4 * kQuantum, without_stats.chunk_size());
+}
+
+TEST(AdaptiveChunkSizeTest, FromOptions) {
+  ClientOptions options(oauth2::CreateAnonymousCredentials());
+  options.SetUploadBufferSize(2 * kQuantum);
+  auto fixed = AdaptiveChunkSize::FromOptions(options);
+  EXPECT_FALSE(fixed.adaptive());
+  EXPECT_EQ(2 * kQuantum, fixed.chunk_size());
+
+  options.SetMaximumUploadBufferSize(8 * kQuantum);
+  auto adaptive = AdaptiveChunkSize::FromOptions(options);
+  EXPECT_TRUE(adaptive.adaptive());
+  EXPECT_EQ(2 * kQuantum, adaptive.chunk_size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
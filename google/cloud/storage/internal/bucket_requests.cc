@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/bucket_requests.h"
 #include "google/cloud/storage/internal/bucket_acl_requests.h"
+#include "google/cloud/storage/internal/list_response_parser.h"
 #include "google/cloud/storage/internal/nljson.h"
 #include "google/cloud/storage/internal/object_acl_requests.h"
 #include "google/cloud/internal/format_time_point.h"
@@ -432,21 +433,19 @@ std::ostream& operator<<(std::ostream& os, ListBucketsRequest const& r) {
 
 StatusOr<ListBucketsResponse> ListBucketsResponse::FromHttpResponse(
     std::string const& payload) {
-  auto json = storage::internal::nl::json::parse(payload, nullptr, false);
-  if (!json.is_object()) {
-    return Status(StatusCode::kInvalidArgument, __func__);
-  }
-
   ListBucketsResponse result;
-  result.next_page_token = json.value("nextPageToken", "");
-
-  for (auto const& kv : json["items"].items()) {
-    auto parsed = internal::BucketMetadataParser::FromJson(kv.value());
+  auto json = ParseListResponse(payload, [&result](nl::json item) -> Status {
+    auto parsed = internal::BucketMetadataParser::FromJson(item);
     if (!parsed) {
       return std::move(parsed).status();
     }
     result.items.emplace_back(std::move(*parsed));
+    return Status();
+  });
+  if (!json) {
+    return std::move(json).status();
   }
+  result.next_page_token = json->value("nextPageToken", "");
 
   return result;
 }
@@ -0,0 +1,64 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CONST_BUFFER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CONST_BUFFER_H
+
+#include "google/cloud/storage/version.h"
+#include <cstddef>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A non-owning reference to a contiguous block of memory.
+ *
+ * Used to upload data without first copying it to a `std::string`, e.g., from
+ * a memory mapped file. The memory must remain valid while the buffer (or any
+ * request created from it) is in use.
+ */
+class ConstBuffer {
+ public:
+  ConstBuffer() = default;
+  ConstBuffer(char const* data, std::size_t size) : data_(data), size_(size) {}
+
+  char const* data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  /// Returns the buffer without its first @p pos bytes.
+  ConstBuffer substr(std::size_t pos) const {
+    if (pos >= size_) {
+      return ConstBuffer(data_ + size_, 0);
+    }
+    return ConstBuffer(data_ + pos, size_ - pos);
+  }
+
+  std::string ToString() const { return std::string(data_, size_); }
+
+ private:
+  char const* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CONST_BUFFER_H
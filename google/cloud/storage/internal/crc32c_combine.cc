@@ -0,0 +1,89 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c_combine.h"
+#include "google/cloud/storage/internal/openssl_util.h"
+#include "google/cloud/internal/big_endian.h"
+#include <array>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+// The CRC32C (Castagnoli) polynomial, in reversed bit order.
+auto constexpr kCrc32cPolynomial = 0x82F63B78U;
+
+// A 32x32 matrix over GF(2), each element is a column.
+using Gf2Matrix = std::array<std::uint32_t, 32>;
+
+std::uint32_t Gf2MatrixTimes(Gf2Matrix const& mat, std::uint32_t vec) {
+  std::uint32_t sum = 0;
+  for (std::size_t i = 0; vec != 0; vec >>= 1U, ++i) {
+    if ((vec & 1U) != 0) sum ^= mat[i];
+  }
+  return sum;
+}
+
+void Gf2MatrixSquare(Gf2Matrix& square, Gf2Matrix const& mat) {
+  for (std::size_t i = 0; i != mat.size(); ++i) {
+    square[i] = Gf2MatrixTimes(mat, mat[i]);
+  }
+}
+}  // namespace
+
+std::uint32_t Crc32cCombine(std::uint32_t crc1, std::uint32_t crc2,
+                            std::uint64_t len2) {
+  // This is the algorithm used by zlib's `crc32_combine()`: appending `len2`
+  // zero bytes to the first block is a linear operation on its CRC, which we
+  // compute by repeated squaring of the "append one zero bit" operator.
+  if (len2 == 0) return crc1;
+
+  Gf2Matrix odd;
+  odd[0] = kCrc32cPolynomial;
+  std::uint32_t row = 1;
+  for (std::size_t i = 1; i != odd.size(); ++i) {
+    odd[i] = row;
+    row <<= 1U;
+  }
+  Gf2Matrix even;
+  // Operators for two and four zero bits.
+  Gf2MatrixSquare(even, odd);
+  Gf2MatrixSquare(odd, even);
+
+  // Apply `len2` zero bytes to `crc1`, the first squaring puts the operator
+  // for one zero byte in `even`.
+  do {
+    Gf2MatrixSquare(even, odd);
+    if ((len2 & 1U) != 0) crc1 = Gf2MatrixTimes(even, crc1);
+    len2 >>= 1U;
+    if (len2 == 0) break;
+    Gf2MatrixSquare(odd, even);
+    if ((len2 & 1U) != 0) crc1 = Gf2MatrixTimes(odd, crc1);
+    len2 >>= 1U;
+  } while (len2 != 0);
+
+  return crc1 ^ crc2;
+}
+
+std::string Crc32cToBase64(std::uint32_t crc) {
+  return Base64Encode(google::cloud::internal::EncodeBigEndian(crc));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,49 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_COMBINE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_COMBINE_H
+
+#include "google/cloud/storage/version.h"
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Combine the CRC32C checksums of two adjacent blocks of data.
+ *
+ * Given `crc1 = CRC32C(A)` and `crc2 = CRC32C(B)`, where `B` is @p len2 bytes
+ * long, this function returns `CRC32C(A + B)` without access to the original
+ * data. This is useful to validate downloads (or uploads) performed in
+ * several independent slices, as the checksum of each slice can be computed
+ * as the data arrives and then merged in `O(log(len2))` time.
+ */
+std::uint32_t Crc32cCombine(std::uint32_t crc1, std::uint32_t crc2,
+                            std::uint64_t len2);
+
+/// Return the base64 encoded CRC32C, in the format used by GCS metadata.
+std::string Crc32cToBase64(std::uint32_t crc);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CRC32C_COMBINE_H
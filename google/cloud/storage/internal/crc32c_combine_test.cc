@@ -0,0 +1,73 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/crc32c_combine.h"
+#include <crc32c/crc32c.h>
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+std::string const kQuickFox = "The quick brown fox jumps over the lazy dog";
+
+TEST(Crc32cCombine, Base64) {
+  EXPECT_EQ("ImIEBA==", Crc32cToBase64(crc32c::Crc32c(kQuickFox)));
+  EXPECT_EQ("AAAAAA==", Crc32cToBase64(0));
+}
+
+TEST(Crc32cCombine, EmptySuffix) {
+  auto const crc = crc32c::Crc32c(kQuickFox);
+  EXPECT_EQ(crc, Crc32cCombine(crc, crc32c::Crc32c(std::string{}), 0));
+}
+
+TEST(Crc32cCombine, EmptyPrefix) {
+  auto const crc = crc32c::Crc32c(kQuickFox);
+  EXPECT_EQ(crc, Crc32cCombine(0, crc, kQuickFox.size()));
+}
+
+TEST(Crc32cCombine, AllSplits) {
+  auto const expected = crc32c::Crc32c(kQuickFox);
+  for (std::size_t split = 0; split <= kQuickFox.size(); ++split) {
+    auto const a = kQuickFox.substr(0, split);
+    auto const b = kQuickFox.substr(split);
+    auto const actual =
+        Crc32cCombine(crc32c::Crc32c(a), crc32c::Crc32c(b), b.size());
+    EXPECT_EQ(expected, actual) << "split=" << split;
+  }
+}
+
+TEST(Crc32cCombine, ManyBlocks) {
+  std::string data;
+  for (int i = 0; i != 1000; ++i) data += kQuickFox;
+  auto const expected = crc32c::Crc32c(data);
+
+  std::uint32_t actual = 0;
+  std::size_t const block_size = 4093;
+  for (std::size_t offset = 0; offset < data.size(); offset += block_size) {
+    auto const block = data.substr(offset, block_size);
+    actual = Crc32cCombine(actual, crc32c::Crc32c(block), block.size());
+  }
+  EXPECT_EQ(expected, actual);
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
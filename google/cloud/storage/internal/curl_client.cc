@@ -13,9 +13,11 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_client.h"
+#include "google/cloud/storage/internal/curl_event_loop.h"
 #include "google/cloud/storage/internal/curl_request_builder.h"
 #include "google/cloud/storage/internal/curl_resumable_upload_session.h"
 #include "google/cloud/storage/internal/generate_message_boundary.h"
+#include "google/cloud/storage/internal/list_response_parser.h"
 #include "google/cloud/storage/internal/object_streambuf.h"
 #include "google/cloud/storage/object_stream.h"
 #include "google/cloud/storage/version.h"
@@ -38,7 +40,8 @@ std::shared_ptr<CurlHandleFactory> CreateHandleFactory(
         options.channel_options());
   }
   return std::make_shared<PooledCurlHandleFactory>(
-      options.connection_pool_size(), options.channel_options());
+      options.connection_pool_size(), options.channel_options(),
+      options.enable_connection_sharing(), options.connection_pool_stats());
 }
 
 std::string UrlEscapeString(std::string const& value) {
@@ -102,6 +105,11 @@ Status CurlClient::SetupBuilderCommon(CurlRequestBuilder& builder,
       .ApplyClientOptions(options_)
       .AddHeader(auth_header.value())
       .AddHeader("x-goog-api-client: " + x_goog_api_client());
+  if (options_.channel_options().enable_http2()) {
+    // Concurrent requests can only share a HTTP/2 connection if they are
+    // driven by the same multi handle.
+    builder.SetEventLoop(event_loop());
+  }
   return Status();
 }
 
@@ -252,6 +260,13 @@ CurlClient::CurlClient(ClientOptions options)
   CurlInitializeOnce(options);
 }
 
+CurlClient::~CurlClient() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (event_loop_) {
+    event_loop_->Shutdown();
+  }
+}
+
 StatusOr<ResumableUploadResponse> CurlClient::UploadChunk(
     UploadChunkRequest const& request) {
   CurlRequestBuilder builder(request.upload_session_url(), upload_factory_);
@@ -298,7 +313,10 @@ StatusOr<ResumableUploadResponse> CurlClient::QueryResumableUpload(
 StatusOr<ListBucketsResponse> CurlClient::ListBuckets(
     ListBucketsRequest const& request) {
   CurlRequestBuilder builder(storage_endpoint_ + "/b", storage_factory_);
-  auto status = SetupBuilder(builder, request, "GET");
+  // A `fields` projection must include the token for the next page.
+  auto r = request;
+  r.set_option(FieldsWithNextPageToken(request.GetOption<Fields>()));
+  auto status = SetupBuilder(builder, r, "GET");
   if (!status.ok()) {
     return status;
   }
@@ -555,10 +573,55 @@ StatusOr<ObjectMetadata> CurlClient::GetObjectMetadata(
 
 StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObject(
     ReadObjectRangeRequest const& request) {
+  auto builder = CreateReadObjectBuilder(request);
+  if (!builder) {
+    return std::move(builder).status();
+  }
+  return std::unique_ptr<ObjectReadSource>(
+      new CurlDownloadRequest(builder->BuildDownloadRequest(std::string{})));
+}
+
+future<StatusOr<std::string>> CurlClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  auto builder = CreateReadObjectBuilder(request);
+  if (!builder) {
+    return make_ready_future(
+        StatusOr<std::string>(std::move(builder).status()));
+  }
+  std::shared_ptr<HashValidator> hash_validator = CreateHashValidator(request);
+  return event_loop()
+      ->MakeRequest(builder->BuildRequest(), std::string{})
+      .then([hash_validator](future<StatusOr<HttpResponse>> f)
+                -> StatusOr<std::string> {
+        auto response = f.get();
+        if (!response) {
+          return std::move(response).status();
+        }
+        if (response->status_code >= HttpStatusCode::kMinNotSuccess) {
+          return AsStatus(*response);
+        }
+        hash_validator->Update(response->payload.data(),
+                               response->payload.size());
+        for (auto const& kv : response->headers) {
+          hash_validator->ProcessHeader(kv.first, kv.second);
+        }
+        auto result = std::move(*hash_validator).Finish();
+        if (result.is_mismatch) {
+          return Status(StatusCode::kDataLoss,
+                        "AsyncReadObject(): mismatched hashes in download"
+                        ", expected=" +
+                            result.computed + ", received=" + result.received);
+        }
+        return std::move(response->payload);
+      });
+}
+
+StatusOr<CurlRequestBuilder> CurlClient::CreateReadObjectBuilder(
+    ReadObjectRangeRequest const& request) {
   if (!request.HasOption<IfMetagenerationNotMatch>() &&
       !request.HasOption<IfGenerationNotMatch>() &&
       !request.HasOption<QuotaUser>() && !request.HasOption<UserIp>()) {
-    return ReadObjectXml(request);
+    return CreateReadObjectXmlBuilder(request);
   }
   // Assume the bucket name is validated by the caller.
   CurlRequestBuilder builder(storage_endpoint_ + "/b/" + request.bucket_name() +
@@ -575,9 +638,7 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObject(
   if (request.RequiresNoCache()) {
     builder.AddHeader("Cache-Control: no-transform");
   }
-
-  return std::unique_ptr<ObjectReadSource>(
-      new CurlDownloadRequest(builder.BuildDownloadRequest(std::string{})));
+  return StatusOr<CurlRequestBuilder>(std::move(builder));
 }
 
 StatusOr<ListObjectsResponse> CurlClient::ListObjects(
@@ -586,7 +647,10 @@ StatusOr<ListObjectsResponse> CurlClient::ListObjects(
   CurlRequestBuilder builder(
       storage_endpoint_ + "/b/" + request.bucket_name() + "/o",
       storage_factory_);
-  auto status = SetupBuilder(builder, request, "GET");
+  // A `fields` projection must include the token for the next page.
+  auto r = request;
+  r.set_option(FieldsWithNextPageToken(request.GetOption<Fields>()));
+  auto status = SetupBuilder(builder, r, "GET");
   if (!status.ok()) {
     return status;
   }
@@ -1232,7 +1296,7 @@ StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaXml(
   });
 }
 
-StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObjectXml(
+StatusOr<CurlRequestBuilder> CurlClient::CreateReadObjectXmlBuilder(
     ReadObjectRangeRequest const& request) {
   CurlRequestBuilder builder(xml_download_endpoint_ + "/" +
                                  request.bucket_name() + "/" +
@@ -1280,9 +1344,15 @@ StatusOr<std::unique_ptr<ObjectReadSource>> CurlClient::ReadObjectXml(
   if (request.RequiresNoCache()) {
     builder.AddHeader("Cache-Control: no-transform");
   }
+  return StatusOr<CurlRequestBuilder>(std::move(builder));
+}
 
-  return std::unique_ptr<ObjectReadSource>(
-      new CurlDownloadRequest(builder.BuildDownloadRequest(std::string{})));
+std::shared_ptr<CurlEventLoop> CurlClient::event_loop() {
+  std::lock_guard<std::mutex> lk(mu_);
+  if (!event_loop_) {
+    event_loop_ = CurlEventLoop::Create();
+  }
+  return event_loop_;
 }
 
 StatusOr<ObjectMetadata> CurlClient::InsertObjectMediaMultipart(
@@ -28,6 +28,7 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+class CurlEventLoop;
 class CurlRequestBuilder;
 
 /**
@@ -45,6 +46,8 @@ class CurlClient : public RawClient,
     return Create(ClientOptions(std::move(credentials)));
   }
 
+  ~CurlClient() override;
+
   CurlClient(CurlClient const& rhs) = delete;
   CurlClient(CurlClient&& rhs) = delete;
   CurlClient& operator=(CurlClient const& rhs) = delete;
@@ -99,6 +102,8 @@ class CurlClient : public RawClient,
       GetObjectMetadataRequest const& request) override;
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
       ReadObjectRangeRequest const&) override;
+  future<StatusOr<std::string>> AsyncReadObject(
+      ReadObjectRangeRequest const&) override;
   StatusOr<ListObjectsResponse> ListObjects(
       ListObjectsRequest const& request) override;
   StatusOr<EmptyResponse> DeleteObject(
@@ -196,9 +201,15 @@ class CurlClient : public RawClient,
 
   StatusOr<ObjectMetadata> InsertObjectMediaXml(
       InsertObjectMediaRequest const& request);
-  StatusOr<std::unique_ptr<ObjectReadSource>> ReadObjectXml(
+  /// Prepare a builder to download an object, using the XML API if possible.
+  StatusOr<CurlRequestBuilder> CreateReadObjectBuilder(
+      ReadObjectRangeRequest const& request);
+  StatusOr<CurlRequestBuilder> CreateReadObjectXmlBuilder(
       ReadObjectRangeRequest const& request);
 
+  /// Return the event loop for asynchronous operations, creating it if needed.
+  std::shared_ptr<CurlEventLoop> event_loop();
+
   /// Insert an object using uploadType=multipart.
   StatusOr<ObjectMetadata> InsertObjectMediaMultipart(
       InsertObjectMediaRequest const& request);
@@ -226,6 +237,9 @@ class CurlClient : public RawClient,
   std::shared_ptr<CurlHandleFactory> upload_factory_;
   std::shared_ptr<CurlHandleFactory> xml_upload_factory_;
   std::shared_ptr<CurlHandleFactory> xml_download_factory_;
+
+  // Only created if the application uses asynchronous operations.
+  std::shared_ptr<CurlEventLoop> event_loop_;  // GUARDED_BY(mu_);
 };
 
 }  // namespace internal
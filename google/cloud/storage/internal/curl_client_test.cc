@@ -255,6 +255,21 @@ TEST_P(CurlClientTest, ReadObjectJson) {
   CheckStatus(actual);
 }
 
+TEST_P(CurlClientTest, AsyncReadObjectXml) {
+  auto actual =
+      client_->AsyncReadObject(ReadObjectRangeRequest("bkt", "obj")).get();
+  CheckStatus(actual.status());
+}
+
+TEST_P(CurlClientTest, AsyncReadObjectJson) {
+  auto actual =
+      client_
+          ->AsyncReadObject(ReadObjectRangeRequest("bkt", "obj")
+                                .set_multiple_options(IfGenerationNotMatch(0)))
+          .get();
+  CheckStatus(actual.status());
+}
+
 TEST_P(CurlClientTest, ListObjects) {
   auto actual = client_->ListObjects(ListObjectsRequest("bkt")).status();
   CheckStatus(actual);
@@ -57,8 +57,7 @@ extern "C" std::size_t CurlDownloadRequestHeader(char* contents,
 CurlDownloadRequest::CurlDownloadRequest()
     : headers_(nullptr, &curl_slist_free_all),
       download_stall_timeout_(0),
-      multi_(nullptr, &curl_multi_cleanup),
-      spill_(CURL_MAX_WRITE_SIZE) {}
+      multi_(nullptr, &curl_multi_cleanup) {}
 
 template <typename Predicate>
 Status CurlDownloadRequest::Wait(Predicate predicate) {
@@ -155,12 +154,15 @@ StatusOr<ReadSourceResult> CurlDownloadRequest::Read(char* buf, std::size_t n) {
 #else
   if (!curl_closed_) {
 #endif  // libcurl >= 7.69.0
+    // Clear the flag before unpausing: libcurl may deliver any data it kept
+    // while paused from inside `EasyPause()`, and the write callback may pause
+    // the handle again if that data does not fit in the application buffer.
+    paused_ = false;
     auto status = handle_.EasyPause(CURLPAUSE_RECV_CONT);
     if (!status.ok()) {
       TRACE_STATE() << ", status=" << status;
       return status;
     }
-    paused_ = false;
     TRACE_STATE();
   }
 
@@ -245,10 +247,13 @@ void CurlDownloadRequest::SetOptions() {
 void CurlDownloadRequest::DrainSpillBuffer() {
   std::size_t free = buffer_size_ - buffer_offset_;
   auto copy_count = (std::min)(free, spill_offset_);
+  if (copy_count == 0) {
+    return;
+  }
   std::memcpy(buffer_ + buffer_offset_, spill_.data(), copy_count);
   buffer_offset_ += copy_count;
   std::memmove(spill_.data(), spill_.data() + copy_count,
-               spill_.size() - copy_count);
+               spill_offset_ - copy_count);
   spill_offset_ -= copy_count;
 }
 
@@ -267,7 +272,7 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
   if (buffer_offset_ >= buffer_size_) {
     TRACE_STATE() << " *** PAUSING HANDLE ***";
     paused_ = true;
-    return CURL_READFUNC_PAUSE;
+    return CURL_WRITEFUNC_PAUSE;
   }
 
   // Use the spill buffer first, if there is any...
@@ -276,22 +281,38 @@ std::size_t CurlDownloadRequest::WriteCallback(void* ptr, std::size_t size,
   if (free == 0) {
     TRACE_STATE() << " *** PAUSING HANDLE ***";
     paused_ = true;
-    return CURL_READFUNC_PAUSE;
+    return CURL_WRITEFUNC_PAUSE;
   }
   TRACE_STATE() << ", n=" << size * nmemb << ", free=" << free;
 
   // Copy the full contents of `ptr` into the application buffer.
-  if (size * nmemb < free) {
+  if (size * nmemb <= free) {
     std::memcpy(buffer_ + buffer_offset_, ptr, size * nmemb);
     buffer_offset_ += size * nmemb;
     TRACE_STATE() << ", n=" << size * nmemb;
     return size * nmemb;
   }
-  // Copy as much as possible from `ptr` into the application buffer.
+
+  // The block does not fit. If the application buffer already has some data
+  // return that data, libcurl keeps the block while the handle is paused and
+  // delivers it again on the next `Read()`, most likely directly into the
+  // next application buffer. That avoids copying the block twice.
+  if (buffer_offset_ != 0) {
+    TRACE_STATE() << " *** PAUSING HANDLE (partial block) ***";
+    paused_ = true;
+    return CURL_WRITEFUNC_PAUSE;
+  }
+
+  // The application buffer is smaller than the block, copy as much as possible
+  // from `ptr` into the application buffer.
   std::memcpy(buffer_ + buffer_offset_, ptr, free);
   buffer_offset_ += free;
   spill_offset_ = size * nmemb - free;
-  // The rest goes into the spill buffer.
+  // The rest goes into the spill buffer. It is only allocated when needed, as
+  // most applications never read in blocks smaller than what libcurl uses.
+  if (spill_.size() < spill_offset_) {
+    spill_.resize((std::max)(spill_offset_, std::size_t(CURL_MAX_WRITE_SIZE)));
+  }
   std::memcpy(spill_.data(), static_cast<char*>(ptr) + free, spill_offset_);
   TRACE_STATE() << ", n=" << size * nmemb << ", free=" << free;
   return size * nmemb;
@@ -347,6 +368,12 @@ StatusOr<int> CurlDownloadRequest::PerformWork() {
       // Whatever the status is, the transfer is done, we need to remove it
       // from the CURLM* interface.
       curl_closed_ = true;
+      if (metrics_) {
+        // Transfers terminated by Close() fail with a write error, that is not
+        // a problem with the request, so do not report it as such.
+        metrics_->OnRequest(
+            handle_.GetRequestMetrics(closing_ ? Status() : status));
+      }
       Status multi_remove_status;
       if (in_multi_) {
         // In the extremely unlikely case that removing the handle from CURLM*
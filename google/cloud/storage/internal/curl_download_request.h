@@ -63,8 +63,10 @@ class CurlDownloadRequest : public ObjectReadSource {
   /**
    * Waits for additional data or the end of the transfer.
    *
-   * This operation blocks until `initial_buffer_size` data has been received or
-   * the transfer is completed.
+   * This operation blocks until some data has been received or the transfer is
+   * completed. The data is copied from the libcurl buffers directly into
+   * @p buf. To avoid additional copies the function may return fewer than
+   * @p n bytes, even if the transfer is not completed.
    *
    * @param buffer the location to return the new data. Note that the contents
    *     of this parameter are completely replaced with the new data.
@@ -113,6 +115,7 @@ class CurlDownloadRequest : public ObjectReadSource {
   bool logging_enabled_ = false;
   CurlHandle::SocketOptions socket_options_;
   std::chrono::seconds download_stall_timeout_;
+  std::shared_ptr<RequestMetricsRecorder> metrics_;
   CurlHandle handle_;
   CurlMulti multi_;
   std::shared_ptr<CurlHandleFactory> factory_;
@@ -148,8 +151,10 @@ class CurlDownloadRequest : public ObjectReadSource {
   // libcurl(1) will never pass a block larger than CURL_MAX_WRITE_SIZE to the
   // WriteCallback. However, the callback *must* save all the bytes, returning
   // less bytes read aborts the download (we do that on a Close(), but in
-  // general we do not). The application may have requested less bytes in the
-  // call to `Read()`, so we need a place to store the additional bytes.
+  // general we do not). Most of the time the callback pauses the transfer when
+  // a block does not fit in the application buffer, and libcurl delivers the
+  // block again once the transfer resumes. But if the application buffer is
+  // smaller than a single block we need a place to store the additional bytes.
   std::vector<char> spill_;
   std::size_t spill_offset_ = 0;
 };
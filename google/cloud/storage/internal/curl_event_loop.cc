@@ -0,0 +1,257 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_event_loop.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/log.h"
+#include <curl/multi.h>
+#include <chrono>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+std::shared_ptr<CurlEventLoop> CurlEventLoop::Create() {
+  // Cannot use std::make_shared because the constructor is private.
+  auto loop = std::shared_ptr<CurlEventLoop>(new CurlEventLoop);
+  // The thread holds a reference to the loop, it is released once `Run()`
+  // returns, that is, after `Shutdown()`.
+  loop->io_thread_ = std::thread([loop] { loop->Run(); });
+  return loop;
+}
+
+CurlEventLoop::CurlEventLoop()
+    : multi_(curl_multi_init(), &curl_multi_cleanup) {
+#if CURL_AT_LEAST_VERSION(7, 43, 0)
+  // This is the default with libcurl >= 7.62.0, it only affects HTTP/2
+  // transfers.
+  (void)curl_multi_setopt(multi_.get(), CURLMOPT_PIPELINING,
+                          CURLPIPE_MULTIPLEX);
+#endif  // libcurl >= 7.43.0
+}
+
+CurlEventLoop::~CurlEventLoop() {
+  if (!io_thread_.joinable()) {
+    return;
+  }
+  // The last reference may be released by the I/O thread itself, as it exits.
+  if (io_thread_.get_id() == std::this_thread::get_id()) {
+    io_thread_.detach();
+    return;
+  }
+  io_thread_.join();
+}
+
+future<StatusOr<HttpResponse>> CurlEventLoop::MakeRequest(CurlRequest request,
+                                                          std::string payload) {
+  auto transfer = google::cloud::internal::make_unique<Transfer>(nullptr);
+  transfer->owned_request = std::move(request);
+  transfer->request = &transfer->owned_request;
+  transfer->payload = std::move(payload);
+  ConstBuffer buffer(transfer->payload.data(), transfer->payload.size());
+  return Submit(std::move(transfer), buffer);
+}
+
+future<StatusOr<HttpResponse>> CurlEventLoop::MakeRequest(CurlRequest& request,
+                                                          ConstBuffer payload) {
+  return Submit(google::cloud::internal::make_unique<Transfer>(&request),
+                payload);
+}
+
+future<StatusOr<HttpResponse>> CurlEventLoop::Submit(
+    std::unique_ptr<Transfer> transfer, ConstBuffer payload) {
+  // Once the transfer is in the heap its address is stable, and it is safe to
+  // configure the callbacks.
+  transfer->request->SetOptions(payload);
+  auto f = transfer->result.get_future();
+  std::unique_lock<std::mutex> lk(mu_);
+  if (shutdown_) {
+    lk.unlock();
+    transfer->result.set_value(
+        Status(StatusCode::kCancelled, "CurlEventLoop is shutdown"));
+    return f;
+  }
+  submitted_.push_back(std::move(transfer));
+  lk.unlock();
+  cv_.notify_one();
+  Wakeup();
+  return f;
+}
+
+void CurlEventLoop::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_one();
+  Wakeup();
+}
+
+void CurlEventLoop::Run() {
+  int repeats = 0;
+  for (;;) {
+    std::vector<std::unique_ptr<Transfer>> submitted;
+    {
+      std::unique_lock<std::mutex> lk(mu_);
+      // Without any transfers in progress there is nothing for libcurl to do,
+      // block until a new transfer is submitted.
+      cv_.wait(lk, [this] {
+        return shutdown_ || !submitted_.empty() || !running_.empty();
+      });
+      if (shutdown_) {
+        break;
+      }
+      submitted.swap(submitted_);
+    }
+    for (auto& t : submitted) {
+      StartTransfer(std::move(t));
+    }
+    auto status = PerformWork();
+    if (status.ok()) {
+      status = WaitForHandles(repeats);
+    }
+    if (!status.ok()) {
+      // Errors in the curl_multi_* functions indicate a bug or memory
+      // corruption, there is no way to tell which transfers are affected.
+      GCP_LOG(ERROR) << "CurlEventLoop: unexpected error, status=" << status;
+      CancelAll(status);
+    }
+  }
+  CancelAll(Status(StatusCode::kCancelled, "CurlEventLoop is shutdown"));
+}
+
+void CurlEventLoop::StartTransfer(std::unique_ptr<Transfer> transfer) {
+  CURL* handle = transfer->request->handle_.handle_.get();
+  auto status =
+      AsStatus(curl_multi_add_handle(multi_.get(), handle), __func__);
+  if (!status.ok()) {
+    transfer->result.set_value(std::move(status));
+    return;
+  }
+  running_.emplace(handle, std::move(transfer));
+}
+
+Status CurlEventLoop::PerformWork() {
+  int running_handles = 0;
+  CURLMcode result;
+  do {
+    result = curl_multi_perform(multi_.get(), &running_handles);
+  } while (result == CURLM_CALL_MULTI_PERFORM);
+  auto status = AsStatus(result, __func__);
+  if (!status.ok()) {
+    return status;
+  }
+  int remaining;
+  while (auto* msg = curl_multi_info_read(multi_.get(), &remaining)) {
+    if (msg->msg != CURLMSG_DONE) {
+      continue;
+    }
+    // Removing the handle invalidates `msg`, capture its values first.
+    CURL* handle = msg->easy_handle;
+    CURLcode code = msg->data.result;
+    CompleteTransfer(handle, code);
+  }
+  return Status();
+}
+
+void CurlEventLoop::CompleteTransfer(CURL* handle, CURLcode code) {
+  auto i = running_.find(handle);
+  if (i == running_.end()) {
+    GCP_LOG(WARNING) << "CurlEventLoop: unknown handle completed";
+    return;
+  }
+  auto transfer = std::move(i->second);
+  running_.erase(i);
+  (void)curl_multi_remove_handle(multi_.get(), handle);
+  auto status = CurlHandle::AsStatus(code, __func__);
+  transfer->request->ReportMetrics(status);
+  if (!status.ok()) {
+    transfer->result.set_value(std::move(status));
+    return;
+  }
+  transfer->result.set_value(transfer->request->CompleteRequest());
+}
+
+Status CurlEventLoop::WaitForHandles(int& repeats) {
+  int const timeout_ms = 10;
+  int numfds = 0;
+#if CURL_AT_LEAST_VERSION(7, 68, 0)
+  // curl_multi_poll() waits even if there are no file descriptors, and
+  // returns early on curl_multi_wakeup(), e.g. when a new transfer starts.
+  CURLMcode result =
+      curl_multi_poll(multi_.get(), nullptr, 0, timeout_ms, &numfds);
+  (void)repeats;
+  return AsStatus(result, __func__);
+#else
+  CURLMcode result =
+      curl_multi_wait(multi_.get(), nullptr, 0, timeout_ms, &numfds);
+  Status status = AsStatus(result, __func__);
+  if (!status.ok()) {
+    return status;
+  }
+  // The documentation for curl_multi_wait() recommends sleeping if it returns
+  // numfds == 0 more than once in a row :shrug:
+  //    https://curl.haxx.se/libcurl/c/curl_multi_wait.html
+  if (numfds == 0) {
+    if (++repeats > 1) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  } else {
+    repeats = 0;
+  }
+  return status;
+#endif  // libcurl >= 7.68.0
+}
+
+void CurlEventLoop::CancelAll(Status const& status) {
+  std::vector<std::unique_ptr<Transfer>> submitted;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    submitted.swap(submitted_);
+  }
+  for (auto& t : submitted) {
+    t->result.set_value(status);
+  }
+  auto running = std::move(running_);
+  running_.clear();
+  for (auto& kv : running) {
+    (void)curl_multi_remove_handle(multi_.get(), kv.first);
+    kv.second->result.set_value(status);
+  }
+}
+
+void CurlEventLoop::Wakeup() {
+#if CURL_AT_LEAST_VERSION(7, 68, 0)
+  (void)curl_multi_wakeup(multi_.get());
+#endif  // libcurl >= 7.68.0
+}
+
+Status CurlEventLoop::AsStatus(CURLMcode result, char const* where) {
+  if (result == CURLM_OK) {
+    return Status();
+  }
+  std::ostringstream os;
+  os << where << "(): unexpected error code in curl_multi_*, [" << result
+     << "]=" << curl_multi_strerror(result);
+  return Status(StatusCode::kUnknown, std::move(os).str());
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,141 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_EVENT_LOOP_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_EVENT_LOOP_H
+
+#include "google/cloud/storage/internal/curl_request.h"
+#include "google/cloud/storage/internal/curl_wrappers.h"
+#include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/future.h"
+#include "google/cloud/status_or.h"
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Runs many libcurl transfers concurrently using a single multi handle.
+ *
+ * `CurlRequest::MakeRequest()` and `CurlDownloadRequest` block the calling
+ * thread while the transfer is in progress, and each download uses its own
+ * `CURLM*` handle. This class drives all its transfers from a single `CURLM*`
+ * handle and a dedicated I/O thread, and reports the result of each transfer
+ * via a `future<>`. Sharing the multi handle also shares its connection cache
+ * across all the transfers, and with HTTP/2 concurrent transfers to the same
+ * host are multiplexed over a single connection.
+ *
+ * The I/O thread satisfies the futures, therefore any continuations attached
+ * to them (via `.then()`) may run in the I/O thread and should not block.
+ *
+ * The I/O thread keeps the object alive until `Shutdown()` is called.
+ */
+class CurlEventLoop {
+ public:
+  static std::shared_ptr<CurlEventLoop> Create();
+
+  ~CurlEventLoop();
+
+  CurlEventLoop(CurlEventLoop const&) = delete;
+  CurlEventLoop& operator=(CurlEventLoop const&) = delete;
+  CurlEventLoop(CurlEventLoop&&) = delete;
+  CurlEventLoop& operator=(CurlEventLoop&&) = delete;
+
+  /**
+   * Starts @p request in the background.
+   *
+   * @return a future satisfied when the transfer completes, with the same
+   *     results as `CurlRequest::MakeRequest()`. If the event loop is shutdown
+   *     before the transfer completes the result is a `kCancelled` error.
+   */
+  future<StatusOr<HttpResponse>> MakeRequest(CurlRequest request,
+                                             std::string payload);
+
+  /**
+   * Starts @p request in the background, without taking ownership.
+   *
+   * The caller must keep @p request and @p payload alive until the future is
+   * satisfied. Blocking on the future from the I/O thread, e.g., from a
+   * continuation, deadlocks.
+   */
+  future<StatusOr<HttpResponse>> MakeRequest(CurlRequest& request,
+                                             ConstBuffer payload);
+
+  /// Returns true if called from the I/O thread.
+  bool InIoThread() const {
+    return io_thread_.get_id() == std::this_thread::get_id();
+  }
+
+  /**
+   * Stops the I/O thread, cancelling any pending transfers.
+   *
+   * This function does not block, the pending transfers are cancelled by the
+   * I/O thread.
+   */
+  void Shutdown();
+
+ private:
+  struct Transfer {
+    explicit Transfer(CurlRequest* r) : request(r) {}
+
+    CurlRequest* request;
+    // Only used when the loop owns the request and its payload.
+    CurlRequest owned_request;
+    std::string payload;
+    promise<StatusOr<HttpResponse>> result;
+  };
+
+  CurlEventLoop();
+
+  future<StatusOr<HttpResponse>> Submit(std::unique_ptr<Transfer> transfer,
+                                        ConstBuffer payload);
+
+  void Run();
+  void StartTransfer(std::unique_ptr<Transfer> transfer);
+  Status PerformWork();
+  void CompleteTransfer(CURL* handle, CURLcode code);
+  Status WaitForHandles(int& repeats);
+  void CancelAll(Status const& status);
+  void Wakeup();
+
+  /// Simplify handling of errors in the curl_multi_* API.
+  static Status AsStatus(CURLMcode result, char const* where);
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool shutdown_ = false;                             // GUARDED_BY(mu_)
+  std::vector<std::unique_ptr<Transfer>> submitted_;  // GUARDED_BY(mu_)
+
+  CurlMulti multi_;
+  // Only used by the I/O thread.
+  std::map<CURL*, std::unique_ptr<Transfer>> running_;
+  std::thread io_thread_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_EVENT_LOOP_H
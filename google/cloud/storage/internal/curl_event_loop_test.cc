@@ -0,0 +1,111 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/curl_event_loop.h"
+#include "google/cloud/storage/internal/curl_request_builder.h"
+#include <gmock/gmock.h>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::HasSubstr;
+
+CurlRequest MakeFailingRequest() {
+  // Nothing listens on port 1, the request fails once libcurl tries to
+  // connect.
+  CurlRequestBuilder builder("http://localhost:1/",
+                             GetDefaultCurlHandleFactory());
+  return builder.BuildRequest();
+}
+
+TEST(CurlEventLoopTest, FailedRequests) {
+  auto loop = CurlEventLoop::Create();
+  std::vector<future<StatusOr<HttpResponse>>> pending;
+  for (int i = 0; i != 16; ++i) {
+    pending.push_back(loop->MakeRequest(MakeFailingRequest(), std::string{}));
+  }
+  for (auto& f : pending) {
+    auto response = f.get();
+    ASSERT_FALSE(response.ok());
+    EXPECT_THAT(response.status().message(), HasSubstr("CURL error"));
+  }
+  loop->Shutdown();
+}
+
+TEST(CurlEventLoopTest, BlockingRequests) {
+  auto loop = CurlEventLoop::Create();
+  CurlRequestBuilder builder("http://localhost:1/",
+                             GetDefaultCurlHandleFactory());
+  auto request = builder.SetEventLoop(loop).BuildRequest();
+  // The request runs in the loop, it can be used more than once.
+  for (int i = 0; i != 2; ++i) {
+    auto response = request.MakeRequest(std::string{});
+    ASSERT_FALSE(response.ok());
+    EXPECT_THAT(response.status().message(), HasSubstr("CURL error"));
+  }
+  loop->Shutdown();
+  auto response = request.MakeRequest(std::string{});
+  EXPECT_EQ(StatusCode::kCancelled, response.status().code());
+}
+
+TEST(CurlEventLoopTest, BlockingRequestFromContinuation) {
+  auto loop = CurlEventLoop::Create();
+  auto f = loop->MakeRequest(MakeFailingRequest(), std::string{})
+               .then([loop](future<StatusOr<HttpResponse>>) {
+                 EXPECT_TRUE(loop->InIoThread());
+                 CurlRequestBuilder builder("http://localhost:1/",
+                                            GetDefaultCurlHandleFactory());
+                 auto request = builder.SetEventLoop(loop).BuildRequest();
+                 // Waiting for the loop from its own thread would deadlock,
+                 // the request runs in this thread instead.
+                 return request.MakeRequest(std::string{}).status();
+               });
+  auto status = f.get();
+  ASSERT_FALSE(status.ok());
+  EXPECT_THAT(status.message(), HasSubstr("CURL error"));
+  EXPECT_FALSE(loop->InIoThread());
+  loop->Shutdown();
+}
+
+TEST(CurlEventLoopTest, RequestAfterShutdown) {
+  auto loop = CurlEventLoop::Create();
+  loop->Shutdown();
+  auto response = loop->MakeRequest(MakeFailingRequest(), std::string{}).get();
+  EXPECT_EQ(StatusCode::kCancelled, response.status().code());
+}
+
+TEST(CurlEventLoopTest, ShutdownFromContinuation) {
+  auto loop = CurlEventLoop::Create();
+  auto f = loop->MakeRequest(MakeFailingRequest(), std::string{})
+               .then([loop](future<StatusOr<HttpResponse>> g) {
+                 loop->Shutdown();
+                 return g.get().status();
+               });
+  // Release the reference held by this thread, the loop is destroyed once the
+  // I/O thread (and the continuation) release theirs.
+  loop.reset();
+  EXPECT_FALSE(f.get().ok());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
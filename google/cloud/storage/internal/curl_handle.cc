@@ -114,6 +114,61 @@ extern "C" int CurlSetSocketOptions(void* userdata, curl_socket_t curlfd,
   return CURL_SOCKOPT_OK;
 }
 
+// Newer versions of libcurl report the timers in microseconds, and the sizes
+// as `curl_off_t`, the older `double` variants are deprecated.
+#if CURL_AT_LEAST_VERSION(7, 61, 0)
+#define GOOGLE_CLOUD_CPP_CURL_TIMER(name) CURLINFO_##name##_T
+#else
+#define GOOGLE_CLOUD_CPP_CURL_TIMER(name) CURLINFO_##name
+#endif  // libcurl >= 7.61.0
+#if CURL_AT_LEAST_VERSION(7, 55, 0)
+#define GOOGLE_CLOUD_CPP_CURL_SIZE(name) CURLINFO_##name##_T
+#else
+#define GOOGLE_CLOUD_CPP_CURL_SIZE(name) CURLINFO_##name
+#endif  // libcurl >= 7.55.0
+
+std::chrono::microseconds GetDuration(CURL* handle, CURLINFO info) {
+#if CURL_AT_LEAST_VERSION(7, 61, 0)
+  curl_off_t value = 0;
+  if (curl_easy_getinfo(handle, info, &value) != CURLE_OK) {
+    return std::chrono::microseconds(0);
+  }
+  return std::chrono::microseconds(value);
+#else
+  double value = 0;
+  if (curl_easy_getinfo(handle, info, &value) != CURLE_OK) {
+    return std::chrono::microseconds(0);
+  }
+  return std::chrono::microseconds(static_cast<std::int64_t>(value * 1.0E6));
+#endif  // libcurl >= 7.61.0
+}
+
+std::uint64_t GetSize(CURL* handle, CURLINFO info) {
+#if CURL_AT_LEAST_VERSION(7, 55, 0)
+  curl_off_t value = 0;
+  if (curl_easy_getinfo(handle, info, &value) != CURLE_OK || value < 0) {
+    return 0;
+  }
+  return static_cast<std::uint64_t>(value);
+#else
+  double value = 0;
+  if (curl_easy_getinfo(handle, info, &value) != CURLE_OK || value < 0) {
+    return 0;
+  }
+  return static_cast<std::uint64_t>(value);
+#endif  // libcurl >= 7.55.0
+}
+
+std::chrono::microseconds Elapsed(std::chrono::microseconds start,
+                                  std::chrono::microseconds end) {
+  // libcurl reports 0 for the phases that did not happen, e.g., the TLS
+  // handshake on a reused connection.
+  if (end < start) {
+    return std::chrono::microseconds(0);
+  }
+  return end - start;
+}
+
 }  // namespace
 
 CurlHandle::CurlHandle() : handle_(curl_easy_init(), &curl_easy_cleanup) {
@@ -135,6 +190,49 @@ void CurlHandle::ResetSocketCallback() {
   SetOption(CURLOPT_SOCKOPTFUNCTION, nullptr);
 }
 
+RequestMetrics CurlHandle::GetRequestMetrics(Status status) {
+  // The libcurl timers are cumulative, each one measures the time from the
+  // start of the request until the end of some phase, convert them to the
+  // duration of each phase.
+  auto* h = handle_.get();
+  auto const name_lookup =
+      GetDuration(h, GOOGLE_CLOUD_CPP_CURL_TIMER(NAMELOOKUP_TIME));
+  auto const connect =
+      GetDuration(h, GOOGLE_CLOUD_CPP_CURL_TIMER(CONNECT_TIME));
+  auto const app_connect =
+      GetDuration(h, GOOGLE_CLOUD_CPP_CURL_TIMER(APPCONNECT_TIME));
+  auto const pre_transfer =
+      GetDuration(h, GOOGLE_CLOUD_CPP_CURL_TIMER(PRETRANSFER_TIME));
+  auto const start_transfer =
+      GetDuration(h, GOOGLE_CLOUD_CPP_CURL_TIMER(STARTTRANSFER_TIME));
+  auto const total = GetDuration(h, GOOGLE_CLOUD_CPP_CURL_TIMER(TOTAL_TIME));
+
+  RequestMetrics metrics;
+  char* url = nullptr;
+  if (curl_easy_getinfo(h, CURLINFO_EFFECTIVE_URL, &url) == CURLE_OK &&
+      url != nullptr) {
+    metrics.url = url;
+  }
+  auto code = GetResponseCode();
+  metrics.status_code = code ? static_cast<std::int32_t>(*code) : 0;
+  metrics.status = std::move(status);
+  metrics.name_lookup = name_lookup;
+  metrics.connect = Elapsed(name_lookup, connect);
+  metrics.tls_handshake = Elapsed(connect, app_connect);
+  metrics.time_to_first_byte = Elapsed(pre_transfer, start_transfer);
+  metrics.transfer = Elapsed(start_transfer, total);
+  metrics.total = total;
+  metrics.bytes_sent = GetSize(h, GOOGLE_CLOUD_CPP_CURL_SIZE(SIZE_UPLOAD));
+  metrics.bytes_received =
+      GetSize(h, GOOGLE_CLOUD_CPP_CURL_SIZE(SIZE_DOWNLOAD));
+  // NOLINTNEXTLINE(google-runtime-int) - libcurl *requires* `long`
+  long connects = 0;
+  metrics.connection_reused =
+      curl_easy_getinfo(h, CURLINFO_NUM_CONNECTS, &connects) == CURLE_OK &&
+      connects == 0;
+  return metrics;
+}
+
 void CurlHandle::EnableLogging(bool enabled) {
   if (enabled) {
     SetOption(CURLOPT_DEBUGDATA, &debug_buffer_);
@@ -92,6 +92,13 @@ class CurlHandle {
     return AsStatus(e, __func__);
   }
 
+  /**
+   * Collects the timing and size of the last transfer.
+   *
+   * @param status the result of the transfer, included in the metrics.
+   */
+  RequestMetrics GetRequestMetrics(Status status);
+
   void EnableLogging(bool enabled);
 
   /// Flushes any debug data using GCP_LOG().
@@ -104,6 +111,7 @@ class CurlHandle {
   explicit CurlHandle(CurlPtr ptr) : handle_(std::move(ptr)) {}
 
   friend class CurlDownloadRequest;
+  friend class CurlEventLoop;
   friend class CurlRequestBuilder;
   friend class CurlHandleFactory;
 
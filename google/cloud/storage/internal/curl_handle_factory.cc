@@ -33,6 +33,19 @@ void CurlHandleFactory::SetCurlOptions(CURL* handle,
     SetCurlStringOption(handle, CURLOPT_CAINFO,
                         options.ssl_root_path().c_str());
   }
+  if (options.enable_http2()) {
+    // Errors are ignored, if libcurl does not support HTTP/2 the requests use
+    // HTTP/1.1.
+#if CURL_AT_LEAST_VERSION(7, 47, 0)
+    (void)curl_easy_setopt(handle, CURLOPT_HTTP_VERSION,
+                           CURL_HTTP_VERSION_2TLS);
+#endif  // libcurl >= 7.47.0
+#if CURL_AT_LEAST_VERSION(7, 43, 0)
+    // Prefer waiting for a connection that can multiplex this request over
+    // opening a new connection.
+    (void)curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+#endif  // libcurl >= 7.43.0
+  }
 }
 
 std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory() {
@@ -44,7 +57,7 @@ std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory() {
 
 std::shared_ptr<CurlHandleFactory> GetDefaultCurlHandleFactory(
     ChannelOptions const& options) {
-  if (!options.ssl_root_path().empty()) {
+  if (!options.ssl_root_path().empty() || options.enable_http2()) {
     return std::make_shared<DefaultCurlHandleFactory>(options);
   }
   return GetDefaultCurlHandleFactory();
@@ -72,14 +85,35 @@ CurlMulti DefaultCurlHandleFactory::CreateMultiHandle() {
 
 void DefaultCurlHandleFactory::CleanupMultiHandle(CurlMulti&& m) { m.reset(); }
 
-PooledCurlHandleFactory::PooledCurlHandleFactory(std::size_t maximum_size,
-                                                 ChannelOptions options)
-    : maximum_size_(maximum_size), options_(std::move(options)) {
+PooledCurlHandleFactory::PooledCurlHandleFactory(
+    std::size_t maximum_size, ChannelOptions options, bool enable_sharing,
+    std::shared_ptr<ConnectionPoolStats> stats)
+    : maximum_size_(maximum_size),
+      options_(std::move(options)),
+      stats_(std::move(stats)),
+      share_(nullptr, &curl_share_cleanup) {
   handles_.reserve(maximum_size);
   multi_handles_.reserve(maximum_size);
+  if (!enable_sharing) {
+    return;
+  }
+  share_.reset(curl_share_init());
+  if (!share_) {
+    return;
+  }
+  (void)curl_share_setopt(share_.get(), CURLSHOPT_LOCKFUNC, &ShareLock);
+  (void)curl_share_setopt(share_.get(), CURLSHOPT_UNLOCKFUNC, &ShareUnlock);
+  (void)curl_share_setopt(share_.get(), CURLSHOPT_USERDATA, this);
+  (void)curl_share_setopt(share_.get(), CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+  (void)curl_share_setopt(share_.get(), CURLSHOPT_SHARE,
+                          CURL_LOCK_DATA_SSL_SESSION);
+  // Do not share the connection cache (CURL_LOCK_DATA_CONNECT): the handles are
+  // used concurrently from many threads, and libcurl does not support sharing
+  // the connection cache between easy handles used in parallel.
 }
 
 PooledCurlHandleFactory::~PooledCurlHandleFactory() {
+  // The handles must be released before `share_`, they hold references to it.
   for (auto* h : handles_) {
     curl_easy_cleanup(h);
   }
@@ -95,16 +129,25 @@ CurlPtr PooledCurlHandleFactory::CreateHandle() {
     // Clear all the options in the handle so we do not leak its previous state.
     (void)curl_easy_reset(handle);
     handles_.pop_back();
+    lk.unlock();
+    if (stats_) {
+      ++stats_->hits_;
+    }
     CurlPtr curl(handle, &curl_easy_cleanup);
-    SetCurlOptions(curl.get(), options_);
+    SetPooledHandleOptions(curl.get());
     return curl;
   }
+  lk.unlock();
+  if (stats_) {
+    ++stats_->misses_;
+  }
   CurlPtr curl(curl_easy_init(), &curl_easy_cleanup);
-  SetCurlOptions(curl.get(), options_);
+  SetPooledHandleOptions(curl.get());
   return curl;
 }
 
 void PooledCurlHandleFactory::CleanupHandle(CurlHandle&& h) {
+  UpdateConnectionStats(GetHandle(h));
   std::unique_lock<std::mutex> lk(mu_);
   char* ip;
   auto res = curl_easy_getinfo(GetHandle(h), CURLINFO_LOCAL_IP, &ip);
@@ -115,12 +158,56 @@ void PooledCurlHandleFactory::CleanupHandle(CurlHandle&& h) {
     CURL* tmp = handles_.front();
     handles_.erase(handles_.begin());
     curl_easy_cleanup(tmp);
+    if (stats_) {
+      ++stats_->evictions_;
+    }
   }
   handles_.push_back(GetHandle(h));
   // The handles_ vector now has ownership, so release it.
   ReleaseHandle(h);
 }
 
+void PooledCurlHandleFactory::SetPooledHandleOptions(CURL* handle) {
+  SetCurlOptions(handle, options_);
+  if (share_) {
+    (void)curl_easy_setopt(handle, CURLOPT_SHARE, share_.get());
+  }
+}
+
+void PooledCurlHandleFactory::UpdateConnectionStats(CURL* handle) {
+  if (!stats_) {
+    return;
+  }
+  long response_code = 0;
+  auto res = curl_easy_getinfo(handle, CURLINFO_RESPONSE_CODE, &response_code);
+  // Handles that did not complete a transfer say nothing about reuse.
+  if (res != CURLE_OK || response_code == 0) {
+    return;
+  }
+  long connects = 0;
+  res = curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &connects);
+  if (res != CURLE_OK) {
+    return;
+  }
+  if (connects == 0) {
+    ++stats_->connections_reused_;
+  } else {
+    ++stats_->connections_created_;
+  }
+}
+
+void PooledCurlHandleFactory::ShareLock(CURL*, curl_lock_data data,
+                                        curl_lock_access, void* userptr) {
+  auto* self = static_cast<PooledCurlHandleFactory*>(userptr);
+  self->share_mu_[data].lock();
+}
+
+void PooledCurlHandleFactory::ShareUnlock(CURL*, curl_lock_data data,
+                                          void* userptr) {
+  auto* self = static_cast<PooledCurlHandleFactory*>(userptr);
+  self->share_mu_[data].unlock();
+}
+
 CurlMulti PooledCurlHandleFactory::CreateMultiHandle() {
   std::unique_lock<std::mutex> lk(mu_);
   if (!multi_handles_.empty()) {
@@ -15,9 +15,12 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_HANDLE_FACTORY_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_HANDLE_FACTORY_H
 
+#include "google/cloud/storage/client_options.h"
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/curl_wrappers.h"
 #include "google/cloud/storage/version.h"
+#include <array>
+#include <memory>
 #include <mutex>
 #include <vector>
 
@@ -91,10 +94,24 @@ class DefaultCurlHandleFactory : public CurlHandleFactory {
  *
  * This implementation keeps up to N handles in memory, they are only released
  * when the factory is destructed.
+ *
+ * Unless @p enable_sharing is false, all the handles created by this factory
+ * share a `CURLSH*` handle, which holds the DNS cache and the TLS sessions.
+ * Without it each handle keeps its own caches, and a handle that was recently
+ * returned to the pool cannot resume the TLS sessions created by other
+ * handles. The connection cache is not shared, libcurl does not support
+ * sharing it between handles used concurrently from different threads.
+ *
+ * If @p stats is not null, the factory updates its counters as handles are
+ * created and released.
  */
 class PooledCurlHandleFactory : public CurlHandleFactory {
  public:
-  PooledCurlHandleFactory(std::size_t maximum_size, ChannelOptions options);
+  PooledCurlHandleFactory(std::size_t maximum_size, ChannelOptions options,
+                          bool enable_sharing,
+                          std::shared_ptr<ConnectionPoolStats> stats);
+  PooledCurlHandleFactory(std::size_t maximum_size, ChannelOptions options)
+      : PooledCurlHandleFactory(maximum_size, std::move(options), true, {}) {}
   explicit PooledCurlHandleFactory(std::size_t maximum_size)
       : PooledCurlHandleFactory(maximum_size, {}) {}
   ~PooledCurlHandleFactory() override;
@@ -111,12 +128,24 @@ class PooledCurlHandleFactory : public CurlHandleFactory {
   }
 
  private:
+  void SetPooledHandleOptions(CURL* handle);
+  void UpdateConnectionStats(CURL* handle);
+
+  static void ShareLock(CURL* handle, curl_lock_data data,
+                        curl_lock_access access, void* userptr);
+  static void ShareUnlock(CURL* handle, curl_lock_data data, void* userptr);
+
   std::size_t maximum_size_;
   mutable std::mutex mu_;
   std::vector<CURL*> handles_;
   std::vector<CURLM*> multi_handles_;
   std::string last_client_ip_address_;
   ChannelOptions options_;
+  std::shared_ptr<ConnectionPoolStats> stats_;
+  // libcurl locks each type of shared data independently, and must be able to
+  // lock them until `share_` is released.
+  std::array<std::mutex, CURL_LOCK_DATA_LAST> share_mu_;
+  CurlShare share_;
 };
 
 }  // namespace internal
@@ -85,6 +85,19 @@ TEST(CurlHandleFactoryTest, DefaultFactoryChannelOptionsCallsSetOptions) {
   EXPECT_THAT(object_under_test.set_options_, testing::ElementsAre(expected));
 }
 
+TEST(CurlHandleFactoryTest, DefaultFactoryHttp2) {
+  auto const shared = GetDefaultCurlHandleFactory();
+  EXPECT_EQ(shared, GetDefaultCurlHandleFactory(ChannelOptions{}));
+
+  // The shared factory does not set any options, applications that enable
+  // HTTP/2 need a separate factory.
+  auto const http2 =
+      GetDefaultCurlHandleFactory(ChannelOptions{}.set_enable_http2(true));
+  EXPECT_NE(shared, http2);
+  auto handle = http2->CreateHandle();
+  EXPECT_NE(nullptr, handle.get());
+}
+
 TEST(CurlHandleFactoryTest, PooledFactoryNoChannelOptionsDoesntCallSetOptions) {
   OverriddenPooledCurlHandleFactory object_under_test(2);
 
@@ -111,6 +124,42 @@ TEST(CurlHandleFactoryTest, PooledFactoryChannelOptionsCallsSetOptions) {
   EXPECT_THAT(object_under_test.set_options_, testing::ElementsAre(expected));
 }
 
+TEST(CurlHandleFactoryTest, PooledFactoryStats) {
+  auto stats = std::make_shared<ConnectionPoolStats>();
+  PooledCurlHandleFactory object_under_test(2, {}, true, stats);
+
+  // The pool starts empty, so the first handles are all misses.
+  auto h1 = object_under_test.CreateHandle();
+  auto h2 = object_under_test.CreateHandle();
+  EXPECT_EQ(0, stats->hits());
+  EXPECT_EQ(2, stats->misses());
+
+  // Fill the pool, and then release one more handle than it can hold.
+  object_under_test.CleanupHandle(CurlHandle());
+  object_under_test.CleanupHandle(CurlHandle());
+  EXPECT_EQ(0, stats->evictions());
+  object_under_test.CleanupHandle(CurlHandle());
+  EXPECT_EQ(1, stats->evictions());
+
+  auto h3 = object_under_test.CreateHandle();
+  auto h4 = object_under_test.CreateHandle();
+  auto h5 = object_under_test.CreateHandle();
+  EXPECT_EQ(2, stats->hits());
+  EXPECT_EQ(3, stats->misses());
+
+  // None of these handles completed a transfer.
+  EXPECT_EQ(0, stats->connections_reused());
+  EXPECT_EQ(0, stats->connections_created());
+}
+
+TEST(CurlHandleFactoryTest, PooledFactoryWithoutStatsOrSharing) {
+  PooledCurlHandleFactory object_under_test(1, {}, false, nullptr);
+  object_under_test.CleanupHandle(CurlHandle());
+  object_under_test.CleanupHandle(CurlHandle());
+  auto h = object_under_test.CreateHandle();
+  EXPECT_NE(nullptr, h.get());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/curl_request.h"
+#include "google/cloud/storage/internal/curl_event_loop.h"
 #include <iostream>
 
 namespace google {
@@ -34,6 +35,27 @@ extern "C" size_t CurlRequestOnHeaderData(char* contents, size_t size,
 }
 
 StatusOr<HttpResponse> CurlRequest::MakeRequest(std::string const& payload) {
+  return MakeRequest(ConstBuffer(payload.data(), payload.size()));
+}
+
+StatusOr<HttpResponse> CurlRequest::MakeRequest(ConstBuffer payload) {
+  // Blocking on the event loop from its own I/O thread (e.g. from a
+  // continuation attached to `Client::AsyncReadObject()`) would deadlock, in
+  // that case the request runs in this thread, on its own connection.
+  if (event_loop_ && !event_loop_->InIoThread()) {
+    // The event loop sets the options, and reports the metrics.
+    return event_loop_->MakeRequest(*this, payload).get();
+  }
+  SetOptions(payload);
+  auto status = handle_.EasyPerform();
+  ReportMetrics(status);
+  if (!status.ok()) {
+    return status;
+  }
+  return CompleteRequest();
+}
+
+void CurlRequest::SetOptions(ConstBuffer payload) {
   // We get better performance using a slightly larger buffer (128KiB) than the
   // default buffer size set by libcurl (16KiB)
   auto constexpr kDefaultBufferSize = 128 * 1024L;
@@ -53,13 +75,12 @@ StatusOr<HttpResponse> CurlRequest::MakeRequest(std::string const& payload) {
   handle_.SetOption(CURLOPT_HEADERFUNCTION, &CurlRequestOnHeaderData);
   handle_.SetOption(CURLOPT_HEADERDATA, this);
   if (!payload.empty()) {
-    handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload.length());
-    handle_.SetOption(CURLOPT_POSTFIELDS, payload.c_str());
-  }
-  auto status = handle_.EasyPerform();
-  if (!status.ok()) {
-    return status;
+    handle_.SetOption(CURLOPT_POSTFIELDSIZE, payload.size());
+    handle_.SetOption(CURLOPT_POSTFIELDS, payload.data());
   }
+}
+
+StatusOr<HttpResponse> CurlRequest::CompleteRequest() {
   if (logging_enabled_) {
     handle_.FlushDebug(__func__);
   }
@@ -71,6 +92,13 @@ StatusOr<HttpResponse> CurlRequest::MakeRequest(std::string const& payload) {
                       std::move(received_headers_)};
 }
 
+void CurlRequest::ReportMetrics(Status const& status) {
+  if (!metrics_) {
+    return;
+  }
+  metrics_->OnRequest(handle_.GetRequestMetrics(status));
+}
+
 std::size_t CurlRequest::OnWriteData(char* contents, std::size_t size,
                                      std::size_t nmemb) {
   response_payload_.append(contents, size * nmemb);
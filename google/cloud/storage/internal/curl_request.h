@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_CURL_REQUEST_H
 
+#include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/curl_handle_factory.h"
 #include "google/cloud/storage/internal/http_response.h"
@@ -25,6 +26,8 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+class CurlEventLoop;
+
 extern "C" size_t CurlRequestOnWriteData(char* ptr, size_t size, size_t nmemb,
                                          void* userdata);
 extern "C" size_t CurlRequestOnHeaderData(char* contents, size_t size,
@@ -43,19 +46,35 @@ class CurlRequest {
   /**
    * Makes the prepared request.
    *
-   * This function can be called multiple times on the same request.
+   * This function can be called multiple times on the same request. If the
+   * request was created with an event loop, the transfer runs in the loop's
+   * I/O thread, and this function blocks until it completes.
    *
    * @return The response HTTP error code, the headers and an empty payload.
    */
   StatusOr<HttpResponse> MakeRequest(std::string const& payload);
 
+  /// Makes the prepared request, without copying the @p payload.
+  StatusOr<HttpResponse> MakeRequest(ConstBuffer payload);
+
  private:
   friend class CurlRequestBuilder;
+  friend class CurlEventLoop;
   friend size_t CurlRequestOnWriteData(char* ptr, size_t size, size_t nmemb,
                                        void* userdata);
   friend size_t CurlRequestOnHeaderData(char* contents, size_t size,
                                         size_t nitems, void* userdata);
 
+  /// Set the options on the handle, @p payload must remain valid until the
+  /// transfer completes.
+  void SetOptions(ConstBuffer payload);
+
+  /// Collect the results of a completed transfer.
+  StatusOr<HttpResponse> CompleteRequest();
+
+  /// Report the metrics for the last transfer, if enabled.
+  void ReportMetrics(Status const& status);
+
   std::size_t OnWriteData(char* contents, std::size_t size, std::size_t nmemb);
   std::size_t OnHeaderData(char* contents, std::size_t size,
                            std::size_t nitems);
@@ -67,6 +86,8 @@ class CurlRequest {
   CurlReceivedHeaders received_headers_;
   bool logging_enabled_ = false;
   CurlHandle::SocketOptions socket_options_;
+  std::shared_ptr<RequestMetricsRecorder> metrics_;
+  std::shared_ptr<CurlEventLoop> event_loop_;
   CurlHandle handle_;
   std::shared_ptr<CurlHandleFactory> factory_;
 };
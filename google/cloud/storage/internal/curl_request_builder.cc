@@ -46,6 +46,8 @@ CurlRequest CurlRequestBuilder::BuildRequest() {
   request.factory_ = std::move(factory_);
   request.logging_enabled_ = logging_enabled_;
   request.socket_options_ = socket_options_;
+  request.metrics_ = std::move(metrics_);
+  request.event_loop_ = std::move(event_loop_);
   return request;
 }
 
@@ -63,6 +65,7 @@ CurlDownloadRequest CurlRequestBuilder::BuildDownloadRequest(
   request.logging_enabled_ = logging_enabled_;
   request.socket_options_ = socket_options_;
   request.download_stall_timeout_ = download_stall_timeout_;
+  request.metrics_ = std::move(metrics_);
   request.SetOptions();
   return request;
 }
@@ -75,6 +78,7 @@ CurlRequestBuilder& CurlRequestBuilder::ApplyClientOptions(
   socket_options_.send_buffer_size_ = options.maximum_socket_send_size();
   user_agent_prefix_ = options.user_agent_prefix() + user_agent_prefix_;
   download_stall_timeout_ = options.download_stall_timeout();
+  metrics_ = options.request_metrics();
   return *this;
 }
 
@@ -104,6 +108,13 @@ CurlRequestBuilder& CurlRequestBuilder::SetMethod(std::string const& method) {
   return *this;
 }
 
+CurlRequestBuilder& CurlRequestBuilder::SetEventLoop(
+    std::shared_ptr<CurlEventLoop> loop) {
+  ValidateBuilderState(__func__);
+  event_loop_ = std::move(loop);
+  return *this;
+}
+
 CurlRequestBuilder& CurlRequestBuilder::SetCurlShare(CURLSH* share) {
   handle_.SetOption(CURLOPT_SHARE, share);
   return *this;
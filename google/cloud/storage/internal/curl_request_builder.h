@@ -147,6 +147,15 @@ class CurlRequestBuilder {
   /// Sets the CURLSH* handle to share resources.
   CurlRequestBuilder& SetCurlShare(CURLSH* share);
 
+  /**
+   * Run the requests created by `BuildRequest()` in @p loop.
+   *
+   * The requests still block the calling thread, but the transfers share the
+   * loop's multi handle, which allows libcurl to multiplex concurrent HTTP/2
+   * requests over the same connection.
+   */
+  CurlRequestBuilder& SetEventLoop(std::shared_ptr<CurlEventLoop> loop);
+
   /// Gets the user-agent suffix.
   std::string UserAgentSuffix() const;
 
@@ -175,6 +184,8 @@ class CurlRequestBuilder {
   bool logging_enabled_;
   CurlHandle::SocketOptions socket_options_;
   std::chrono::seconds download_stall_timeout_;
+  std::shared_ptr<RequestMetricsRecorder> metrics_;
+  std::shared_ptr<CurlEventLoop> event_loop_;
 };
 
 }  // namespace internal
@@ -22,14 +22,26 @@ namespace internal {
 
 StatusOr<ResumableUploadResponse> CurlResumableUploadSession::UploadChunk(
     std::string const& buffer) {
+  return UploadChunkFromBuffer(ConstBuffer(buffer.data(), buffer.size()));
+}
+
+StatusOr<ResumableUploadResponse> CurlResumableUploadSession::UploadFinalChunk(
+    std::string const& buffer, std::uint64_t upload_size) {
+  return UploadFinalChunkFromBuffer(ConstBuffer(buffer.data(), buffer.size()),
+                                    upload_size);
+}
+
+StatusOr<ResumableUploadResponse>
+CurlResumableUploadSession::UploadChunkFromBuffer(ConstBuffer buffer) {
   UploadChunkRequest request(session_id_, next_expected_, buffer);
   auto result = client_->UploadChunk(request);
   Update(result, buffer.size());
   return result;
 }
 
-StatusOr<ResumableUploadResponse> CurlResumableUploadSession::UploadFinalChunk(
-    std::string const& buffer, std::uint64_t upload_size) {
+StatusOr<ResumableUploadResponse>
+CurlResumableUploadSession::UploadFinalChunkFromBuffer(
+    ConstBuffer buffer, std::uint64_t upload_size) {
   UploadChunkRequest request(session_id_, next_expected_, buffer, upload_size);
   auto result = client_->UploadChunk(request);
   Update(result, buffer.size());
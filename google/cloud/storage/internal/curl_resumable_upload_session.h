@@ -39,6 +39,12 @@ class CurlResumableUploadSession : public ResumableUploadSession {
   StatusOr<ResumableUploadResponse> UploadFinalChunk(
       std::string const& buffer, std::uint64_t upload_size) override;
 
+  StatusOr<ResumableUploadResponse> UploadChunkFromBuffer(
+      ConstBuffer buffer) override;
+
+  StatusOr<ResumableUploadResponse> UploadFinalChunkFromBuffer(
+      ConstBuffer buffer, std::uint64_t upload_size) override;
+
   StatusOr<ResumableUploadResponse> ResetSession() override;
 
   std::uint64_t next_expected_byte() const override;
@@ -56,7 +56,7 @@ TEST(CurlResumableUploadSessionTest, Simple) {
   EXPECT_CALL(*mock, UploadChunk(_))
       .WillOnce(Invoke([&](UploadChunkRequest const& request) {
         EXPECT_EQ(test_url, request.upload_session_url());
-        EXPECT_EQ(payload, request.payload());
+        EXPECT_EQ(payload, request.payload().ToString());
         EXPECT_EQ(0, request.source_size());
         EXPECT_EQ(0, request.range_begin());
         return make_status_or(ResumableUploadResponse{
@@ -64,7 +64,7 @@ TEST(CurlResumableUploadSessionTest, Simple) {
       }))
       .WillOnce(Invoke([&](UploadChunkRequest const& request) {
         EXPECT_EQ(test_url, request.upload_session_url());
-        EXPECT_EQ(payload, request.payload());
+        EXPECT_EQ(payload, request.payload().ToString());
         EXPECT_EQ(2 * size, request.source_size());
         EXPECT_EQ(size, request.range_begin());
         return make_status_or(ResumableUploadResponse{
@@ -84,6 +84,44 @@ TEST(CurlResumableUploadSessionTest, Simple) {
   EXPECT_TRUE(session.done());
 }
 
+TEST(CurlResumableUploadSessionTest, UploadFromBuffer) {
+  auto mock = MockCurlClient::Create();
+  std::string test_url = "http://invalid.example.com/not-used-in-mock";
+  CurlResumableUploadSession session(mock, test_url);
+
+  std::string const data = "0123456789";
+  ConstBuffer const first(data.data(), 4);
+  ConstBuffer const last = ConstBuffer(data.data(), data.size()).substr(4);
+
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillOnce(Invoke([&](UploadChunkRequest const& request) {
+        // The request should reference the caller's buffer, not a copy.
+        EXPECT_EQ(first.data(), request.payload().data());
+        EXPECT_EQ(4, request.payload().size());
+        EXPECT_EQ(0, request.range_begin());
+        EXPECT_EQ(3, request.range_end());
+        return make_status_or(ResumableUploadResponse{
+            "", 3, {}, ResumableUploadResponse::kInProgress, {}});
+      }))
+      .WillOnce(Invoke([&](UploadChunkRequest const& request) {
+        EXPECT_EQ(last.data(), request.payload().data());
+        EXPECT_EQ("456789", request.payload().ToString());
+        EXPECT_EQ(data.size(), request.source_size());
+        EXPECT_EQ(4, request.range_begin());
+        return make_status_or(ResumableUploadResponse{
+            "", data.size() - 1, {}, ResumableUploadResponse::kDone, {}});
+      }));
+
+  auto upload = session.UploadChunkFromBuffer(first);
+  EXPECT_STATUS_OK(upload);
+  EXPECT_EQ(4, session.next_expected_byte());
+
+  upload = session.UploadFinalChunkFromBuffer(last, data.size());
+  EXPECT_STATUS_OK(upload);
+  EXPECT_EQ(data.size(), session.next_expected_byte());
+  EXPECT_TRUE(session.done());
+}
+
 TEST(CurlResumableUploadSessionTest, Reset) {
   auto mock = MockCurlClient::Create();
   std::string url1 = "http://invalid.example.com/not-used-in-mock-1";
@@ -52,6 +52,7 @@ HashValidator::Result CompositeValidator::Finish() && {
   return Result{std::move(received), std::move(computed), is_mismatch};
 }
 
+namespace {
 std::unique_ptr<HashValidator> CreateHashValidator(bool disable_md5,
                                                    bool disable_crc32c) {
   if (disable_md5 && disable_crc32c) {
@@ -68,6 +69,18 @@ std::unique_ptr<HashValidator> CreateHashValidator(bool disable_md5,
       google::cloud::internal::make_unique<MD5HashValidator>());
 }
 
+std::unique_ptr<HashValidator> CreateHashValidator(bool disable_md5,
+                                                   bool disable_crc32c,
+                                                   bool use_hashing_thread) {
+  auto validator = CreateHashValidator(disable_md5, disable_crc32c);
+  if (!use_hashing_thread || (disable_md5 && disable_crc32c)) {
+    return validator;
+  }
+  return google::cloud::internal::make_unique<ThreadedHashValidator>(
+      std::move(validator));
+}
+}  // namespace
+
 std::unique_ptr<HashValidator> CreateHashValidator(
     ReadObjectRangeRequest const& request) {
   if (request.RequiresRangeHeader()) {
@@ -77,7 +90,9 @@ std::unique_ptr<HashValidator> CreateHashValidator(
                      request.GetOption<DisableMD5Hash>().value();
   auto disable_crc32c = request.HasOption<DisableCrc32cChecksum>() &&
                         request.GetOption<DisableCrc32cChecksum>().value();
-  return CreateHashValidator(disable_md5, disable_crc32c);
+  auto use_hashing_thread = request.HasOption<UseHashingThread>() &&
+                            request.GetOption<UseHashingThread>().value();
+  return CreateHashValidator(disable_md5, disable_crc32c, use_hashing_thread);
 }
 
 std::unique_ptr<HashValidator> CreateHashValidator(
@@ -86,7 +101,9 @@ std::unique_ptr<HashValidator> CreateHashValidator(
                      request.GetOption<DisableMD5Hash>().value();
   auto disable_crc32c = request.HasOption<DisableCrc32cChecksum>() &&
                         request.GetOption<DisableCrc32cChecksum>().value();
-  return CreateHashValidator(disable_md5, disable_crc32c);
+  auto use_hashing_thread = request.HasOption<UseHashingThread>() &&
+                            request.GetOption<UseHashingThread>().value();
+  return CreateHashValidator(disable_md5, disable_crc32c, use_hashing_thread);
 }
 
 }  // namespace internal
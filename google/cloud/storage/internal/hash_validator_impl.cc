@@ -109,6 +109,98 @@ HashValidator::Result Crc32cHashValidator::Finish() && {
   return Result{std::move(received_hash_), std::move(computed), is_mismatch};
 }
 
+std::size_t constexpr ThreadedHashValidator::kDefaultMaxPendingBytes;
+
+ThreadedHashValidator::ThreadedHashValidator(
+    std::unique_ptr<HashValidator> child, std::size_t max_pending_bytes)
+    : child_(std::move(child)),
+      max_pending_bytes_(max_pending_bytes),
+      worker_([this] { Run(); }) {}
+
+ThreadedHashValidator::~ThreadedHashValidator() { Shutdown(); }
+
+void ThreadedHashValidator::Update(char const* buf, std::size_t n) {
+  if (n == 0) {
+    return;
+  }
+  std::string buffer;
+  {
+    std::unique_lock<std::mutex> lk(mu_);
+    // Always accept some data, even if the buffer is larger than the limit.
+    cv_.wait(lk, [this, n] {
+      return pending_bytes_ == 0 || pending_bytes_ + n <= max_pending_bytes_;
+    });
+    if (!free_.empty()) {
+      buffer = std::move(free_.back());
+      free_.pop_back();
+    }
+    pending_bytes_ += n;
+  }
+  buffer.assign(buf, n);
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    pending_.push_back(std::move(buffer));
+  }
+  cv_.notify_all();
+}
+
+void ThreadedHashValidator::ProcessMetadata(ObjectMetadata const& meta) {
+  // The worker thread is idle after `Drain()`, and only this thread can give
+  // it more work.
+  Drain();
+  child_->ProcessMetadata(meta);
+}
+
+void ThreadedHashValidator::ProcessHeader(std::string const& key,
+                                          std::string const& value) {
+  Drain();
+  child_->ProcessHeader(key, value);
+}
+
+HashValidator::Result ThreadedHashValidator::Finish() && {
+  Shutdown();
+  return std::move(*child_).Finish();
+}
+
+void ThreadedHashValidator::Drain() {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] { return pending_.empty() && !busy_; });
+}
+
+void ThreadedHashValidator::Shutdown() {
+  if (!worker_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  worker_.join();
+}
+
+void ThreadedHashValidator::Run() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !pending_.empty(); });
+    // Consume any pending data before shutting down, `Finish()` needs it.
+    if (pending_.empty()) {
+      return;
+    }
+    auto buffer = std::move(pending_.front());
+    pending_.pop_front();
+    busy_ = true;
+    lk.unlock();
+    child_->Update(buffer.data(), buffer.size());
+    lk.lock();
+    busy_ = false;
+    pending_bytes_ -= buffer.size();
+    buffer.clear();
+    free_.push_back(std::move(buffer));
+    cv_.notify_all();
+  }
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
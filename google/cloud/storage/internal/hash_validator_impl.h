@@ -18,6 +18,12 @@
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/version.h"
 #include <openssl/md5.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace google {
 namespace cloud {
@@ -67,6 +73,52 @@ class Crc32cHashValidator : public HashValidator {
   std::string received_hash_;
 };
 
+/**
+ * A validator that computes the hashes of a child validator in a separate
+ * thread.
+ *
+ * `Update()` copies the data to a queue and returns immediately, unless the
+ * queue already holds more than @p max_pending_bytes. The worker thread drains
+ * the queue, overlapping the (relatively expensive) hash computations with the
+ * network transfer performed by the calling thread.
+ *
+ * The buffers are recycled once they are consumed, so after the first few
+ * calls to `Update()` no further memory allocations are needed.
+ */
+class ThreadedHashValidator : public HashValidator {
+ public:
+  static std::size_t constexpr kDefaultMaxPendingBytes = 8 * 1024 * 1024L;
+
+  explicit ThreadedHashValidator(
+      std::unique_ptr<HashValidator> child,
+      std::size_t max_pending_bytes = kDefaultMaxPendingBytes);
+  ~ThreadedHashValidator() override;
+
+  std::string Name() const override { return child_->Name(); }
+  void Update(char const* buf, std::size_t n) override;
+  void ProcessMetadata(ObjectMetadata const& meta) override;
+  void ProcessHeader(std::string const& key, std::string const& value) override;
+  Result Finish() && override;
+
+ private:
+  /// Block until the worker thread has consumed all the pending data.
+  void Drain();
+  void Shutdown();
+  void Run();
+
+  std::unique_ptr<HashValidator> child_;
+  std::size_t const max_pending_bytes_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::string> pending_;  // GUARDED_BY(mu_)
+  std::vector<std::string> free_;    // GUARDED_BY(mu_)
+  std::size_t pending_bytes_ = 0;    // GUARDED_BY(mu_)
+  bool busy_ = false;                // GUARDED_BY(mu_)
+  bool shutdown_ = false;            // GUARDED_BY(mu_)
+  // Initialized last, as the thread uses all the other members.
+  std::thread worker_;
+};
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
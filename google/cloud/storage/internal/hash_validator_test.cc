@@ -19,6 +19,7 @@
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/status.h"
 #include <gmock/gmock.h>
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -223,6 +224,65 @@ TEST(CompositeHashValidator, Missing) {
   EXPECT_FALSE(result.is_mismatch);
 }
 
+TEST(ThreadedHashValidator, Simple) {
+  ThreadedHashValidator validator(
+      google::cloud::internal::make_unique<CompositeValidator>(
+          google::cloud::internal::make_unique<Crc32cHashValidator>(),
+          google::cloud::internal::make_unique<MD5HashValidator>()));
+  EXPECT_EQ("composite", validator.Name());
+  UpdateValidator(validator, "The quick");
+  validator.ProcessHeader("x-goog-hash", "crc32c=" + QUICK_FOX_CRC32C_CHECKSUM);
+  UpdateValidator(validator, " brown");
+  UpdateValidator(validator, " fox jumps over the lazy dog");
+  validator.ProcessHeader("x-goog-hash", "md5=" + QUICK_FOX_MD5_HASH);
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ(
+      "crc32c=" + QUICK_FOX_CRC32C_CHECKSUM + ",md5=" + QUICK_FOX_MD5_HASH,
+      result.computed);
+  EXPECT_EQ(result.received, result.computed);
+  EXPECT_FALSE(result.is_mismatch);
+}
+
+TEST(ThreadedHashValidator, ProcessMetadata) {
+  ThreadedHashValidator validator(
+      google::cloud::internal::make_unique<MD5HashValidator>());
+  UpdateValidator(validator, "The quick brown fox jumps over the lazy dog");
+  auto object_metadata = internal::ObjectMetadataParser::FromJson(
+                             internal::nl::json{{"md5Hash", "invalid"}})
+                             .value();
+  validator.ProcessMetadata(object_metadata);
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ(QUICK_FOX_MD5_HASH, result.computed);
+  EXPECT_EQ("invalid", result.received);
+  EXPECT_TRUE(result.is_mismatch);
+}
+
+TEST(ThreadedHashValidator, SmallQueue) {
+  std::string data;
+  for (int i = 0; i != 64 * 1024; ++i) {
+    data.push_back(static_cast<char>('a' + i % 26));
+  }
+  // Use a queue smaller than most of the buffers, so `Update()` must wait for
+  // the worker thread.
+  ThreadedHashValidator validator(
+      google::cloud::internal::make_unique<Crc32cHashValidator>(), 16);
+  Crc32cHashValidator expected;
+  std::size_t size = 1;
+  for (std::size_t offset = 0; offset < data.size(); offset += size) {
+    size = (std::min)(data.size() - offset, size * 2 % 4096 + 1);
+    validator.Update(data.data() + offset, size);
+    expected.Update(data.data() + offset, size);
+  }
+  auto result = std::move(validator).Finish();
+  EXPECT_EQ(std::move(expected).Finish().computed, result.computed);
+}
+
+TEST(ThreadedHashValidator, DestroyWithoutFinish) {
+  ThreadedHashValidator validator(
+      google::cloud::internal::make_unique<MD5HashValidator>());
+  UpdateValidator(validator, "The quick brown fox jumps over the lazy dog");
+}
+
 TEST(CreateHashValidator, Read_Null) {
   auto validator =
       CreateHashValidator(ReadObjectRangeRequest("test-bucket", "test-object")
@@ -300,6 +360,25 @@ TEST(CreateHashValidator, Read_DisableMD5_Default_Constructor) {
   EXPECT_THAT(result.computed, HasSubstr(QUICK_FOX_CRC32C_CHECKSUM));
 }
 
+TEST(CreateHashValidator, Read_UseHashingThread) {
+  auto validator =
+      CreateHashValidator(ReadObjectRangeRequest("test-bucket", "test-object")
+                              .set_multiple_options(UseHashingThread(true)));
+  EXPECT_NE(nullptr, dynamic_cast<ThreadedHashValidator*>(validator.get()));
+  UpdateValidator(*validator, "The quick brown fox jumps over the lazy dog");
+  auto result = std::move(*validator).Finish();
+  EXPECT_THAT(result.computed, HasSubstr(QUICK_FOX_MD5_HASH));
+  EXPECT_THAT(result.computed, HasSubstr(QUICK_FOX_CRC32C_CHECKSUM));
+}
+
+TEST(CreateHashValidator, Read_UseHashingThread_Null) {
+  auto validator = CreateHashValidator(
+      ReadObjectRangeRequest("test-bucket", "test-object")
+          .set_multiple_options(DisableCrc32cChecksum(true),
+                                DisableMD5Hash(true), UseHashingThread(true)));
+  EXPECT_EQ(nullptr, dynamic_cast<ThreadedHashValidator*>(validator.get()));
+}
+
 TEST(CreateHashValidator, Write_Null) {
   auto validator =
       CreateHashValidator(ResumableUploadRequest("test-bucket", "test-object")
@@ -397,6 +476,16 @@ TEST(CreateHashValidator, Write_DisableMD5_Default_Constructor) {
   EXPECT_THAT(result.computed, HasSubstr(QUICK_FOX_MD5_HASH));
   EXPECT_THAT(result.computed, HasSubstr(QUICK_FOX_CRC32C_CHECKSUM));
 }
+TEST(CreateHashValidator, Write_UseHashingThread) {
+  auto validator = CreateHashValidator(
+      ResumableUploadRequest("test-bucket", "test-object")
+          .set_multiple_options(DisableMD5Hash(true), UseHashingThread(true)));
+  EXPECT_NE(nullptr, dynamic_cast<ThreadedHashValidator*>(validator.get()));
+  UpdateValidator(*validator, "The quick brown fox jumps over the lazy dog");
+  auto result = std::move(*validator).Finish();
+  EXPECT_EQ(QUICK_FOX_CRC32C_CHECKSUM, result.computed);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -0,0 +1,150 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/hedged_request.h"
+#include "google/cloud/storage/internal/object_read_source.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/**
+ * Replays the first block of a download, then reads from the download.
+ *
+ * The headers of the first block are returned with the first call to
+ * `Read()`, its status code (which may indicate that the download is
+ * complete) with the last byte of the block.
+ */
+class HedgedObjectReadSource : public ObjectReadSource {
+ public:
+  HedgedObjectReadSource(std::unique_ptr<ObjectReadSource> source,
+                         std::string block, HttpResponse response)
+      : source_(std::move(source)),
+        block_(std::move(block)),
+        response_(std::move(response)) {}
+
+  bool IsOpen() const override {
+    return !replay_done_ || source_->IsOpen();
+  }
+
+  StatusOr<HttpResponse> Close() override { return source_->Close(); }
+
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override {
+    if (replay_done_) {
+      return source_->Read(buf, n);
+    }
+    auto const count = (std::min)(n, block_.size() - offset_);
+    if (count != 0) {
+      std::memcpy(buf, block_.data() + offset_, count);
+    }
+    offset_ += count;
+    ReadSourceResult result{count, HttpResponse{100, {}, {}}};
+    result.response.headers = std::move(response_.headers);
+    response_.headers.clear();
+    if (offset_ == block_.size()) {
+      replay_done_ = true;
+      result.response.status_code = response_.status_code;
+      result.response.payload = std::move(response_.payload);
+    }
+    return result;
+  }
+
+ private:
+  std::unique_ptr<ObjectReadSource> source_;
+  std::string block_;
+  HttpResponse response_;
+  std::size_t offset_ = 0;
+  bool replay_done_ = false;
+};
+
+}  // namespace
+
+HedgedCallThreads::~HedgedCallThreads() {
+  std::vector<std::thread> threads;
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    threads.swap(threads_);
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+void HedgedCallThreads::Launch(std::function<void()> function) {
+  std::vector<std::thread> finished;
+  std::unique_lock<std::mutex> lk(mu_);
+  auto const running = std::partition(
+      threads_.begin(), threads_.end(), [this](std::thread const& t) {
+        return std::find(finished_.begin(), finished_.end(), t.get_id()) ==
+               finished_.end();
+      });
+  std::move(running, threads_.end(), std::back_inserter(finished));
+  threads_.erase(running, threads_.end());
+  finished_.clear();
+  threads_.emplace_back([this, function] {
+    function();
+    std::lock_guard<std::mutex> lk(mu_);
+    finished_.push_back(std::this_thread::get_id());
+  });
+  lk.unlock();
+  // These threads have returned from `function`, joining them is fast.
+  for (auto& t : finished) {
+    t.join();
+  }
+}
+
+StatusOr<ObjectMetadata> HedgedGetObjectMetadata(
+    HedgedCallThreads& threads, std::shared_ptr<RawClient> const& client,
+    GetObjectMetadataRequest const& request) {
+  auto policy = request.GetOption<HedgeRequests>().value();
+  return HedgedCall<ObjectMetadata>(
+      threads, policy,
+      [client, request] { return client->GetObjectMetadata(request); },
+      [](ObjectMetadata) {});
+}
+
+StatusOr<std::unique_ptr<ObjectReadSource>> HedgedReadObject(
+    HedgedCallThreads& threads, std::shared_ptr<RawClient> const& client,
+    ReadObjectRangeRequest const& request) {
+  using SourcePtr = std::unique_ptr<ObjectReadSource>;
+  auto policy = request.GetOption<HedgeRequests>().value();
+  auto const block_size = client->client_options().download_buffer_size();
+  auto attempt = [client, request, block_size]() -> StatusOr<SourcePtr> {
+    auto source = client->ReadObject(request);
+    if (!source) {
+      return std::move(source).status();
+    }
+    std::string block(block_size, '\0');
+    auto read = (*source)->Read(&block[0], block.size());
+    if (!read) {
+      return std::move(read).status();
+    }
+    block.resize(read->bytes_received);
+    return SourcePtr(new HedgedObjectReadSource(
+        *std::move(source), std::move(block), std::move(read->response)));
+  };
+  return HedgedCall<SourcePtr>(threads, policy, std::move(attempt),
+                               [](SourcePtr source) { (void)source->Close(); });
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,189 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HEDGED_REQUEST_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HEDGED_REQUEST_H
+
+#include "google/cloud/storage/hedging_options.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/log.h"
+#include "google/cloud/optional.h"
+#include "google/cloud/status_or.h"
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Owns the threads running the attempts of hedged calls.
+ *
+ * The losing attempt of a hedged call keeps running after the call returns.
+ * Its thread is joined by a later `Launch()` once it completes, or by the
+ * destructor, which waits for any attempts still running. A `Client` and its
+ * copies share one of these objects.
+ */
+class HedgedCallThreads {
+ public:
+  HedgedCallThreads() = default;
+  ~HedgedCallThreads();
+
+  HedgedCallThreads(HedgedCallThreads const&) = delete;
+  HedgedCallThreads& operator=(HedgedCallThreads const&) = delete;
+
+  /// Run @p function in a new thread.
+  void Launch(std::function<void()> function);
+
+ private:
+  std::mutex mu_;
+  std::vector<std::thread> threads_;       // GUARDED_BY(mu_)
+  std::vector<std::thread::id> finished_;  // GUARDED_BY(mu_)
+};
+
+/// The state shared between a hedged call and its attempts.
+template <typename T>
+struct HedgedCallState {
+  std::mutex mu;
+  std::condition_variable cv;
+  int running = 0;                    // GUARDED_BY(mu)
+  bool decided = false;               // GUARDED_BY(mu)
+  google::cloud::optional<T> winner;  // GUARDED_BY(mu)
+  Status last_error;                  // GUARDED_BY(mu)
+  std::exception_ptr last_exception;  // GUARDED_BY(mu)
+
+  bool done() const { return winner.has_value() || running == 0; }
+};
+
+/**
+ * Run @p attempt, and a second copy of it if the first one is slow.
+ *
+ * The first attempt starts immediately, if it has not completed after
+ * `policy.hedge_delay()` a second attempt is started. The first successful
+ * result is returned. If the first attempt fails before the second one starts
+ * its error is returned, if both attempts fail the last error is returned. An
+ * exception raised by that attempt is rethrown in the caller's thread.
+ *
+ * The attempts run in threads owned by @p threads, this function returns as
+ * soon as the result is known. A successful result that loses the race is
+ * passed to @p discard, in the thread that produced it. Exceptions raised by
+ * the losing attempt or by @p discard are logged and ignored.
+ */
+template <typename T>
+StatusOr<T> HedgedCall(HedgedCallThreads& threads, HedgingPolicy const& policy,
+                       std::function<StatusOr<T>()> attempt,
+                       std::function<void(T)> discard) {
+  auto state = std::make_shared<HedgedCallState<T>>();
+  auto launch = [&] {
+    ++state->running;
+    threads.Launch([state, policy, attempt, discard] {
+      auto const start = std::chrono::steady_clock::now();
+      StatusOr<T> result;
+      std::exception_ptr exception;
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      try {
+        result = attempt();
+      } catch (...) {
+        exception = std::current_exception();
+      }
+#else
+      result = attempt();
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+      if (result) {
+        policy.RecordLatency(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start));
+      }
+      std::unique_lock<std::mutex> lk(state->mu);
+      --state->running;
+      if (exception) {
+        state->last_exception = std::move(exception);
+      } else if (!result) {
+        state->last_error = std::move(result).status();
+        state->last_exception = nullptr;
+      } else if (!state->decided && !state->winner.has_value()) {
+        state->winner.emplace(*std::move(result));
+      } else {
+        lk.unlock();
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+        try {
+          discard(*std::move(result));
+        } catch (std::exception const& ex) {
+          GCP_LOG(INFO) << "Ignored exception discarding a hedged result: "
+                        << ex.what();
+        } catch (...) {
+          GCP_LOG(INFO) << "Ignored unknown exception discarding a hedged"
+                        << " result";
+        }
+#else
+        discard(*std::move(result));
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+        return;
+      }
+      state->cv.notify_all();
+    });
+  };
+
+  std::unique_lock<std::mutex> lk(state->mu);
+  launch();
+  auto const delay = policy.hedge_delay();
+  if (!state->cv.wait_for(lk, delay, [&state] { return state->done(); })) {
+    launch();
+  }
+  state->cv.wait(lk, [&state] { return state->done(); });
+  state->decided = true;
+  if (!state->winner.has_value()) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    if (state->last_exception) {
+      std::rethrow_exception(state->last_exception);
+    }
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    return state->last_error;
+  }
+  T value = *std::move(state->winner);
+  state->winner.reset();
+  return value;
+}
+
+/// Run `client->GetObjectMetadata()` using the request's `HedgeRequests`.
+StatusOr<ObjectMetadata> HedgedGetObjectMetadata(
+    HedgedCallThreads& threads, std::shared_ptr<RawClient> const& client,
+    GetObjectMetadataRequest const& request);
+
+/**
+ * Run `client->ReadObject()` using the request's `HedgeRequests`.
+ *
+ * Each attempt opens the download and reads the first block of data, the
+ * returned source replays that block before reading the rest of the data from
+ * the winning download. The losing download is closed.
+ */
+StatusOr<std::unique_ptr<ObjectReadSource>> HedgedReadObject(
+    HedgedCallThreads& threads, std::shared_ptr<RawClient> const& client,
+    ReadObjectRangeRequest const& request);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_HEDGED_REQUEST_H
@@ -0,0 +1,277 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/hedged_request.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <stdexcept>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::MockClient;
+using ::google::cloud::storage::testing::MockObjectReadSource;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+using us = std::chrono::microseconds;
+
+TEST(HedgedCallTest, FastAttemptIsNotHedged) {
+  std::atomic<int> attempts(0);
+  HedgedCallThreads threads;
+  auto result = HedgedCall<int>(
+      threads, HedgingPolicy::FixedDelay(std::chrono::seconds(10)),
+      [&attempts]() -> StatusOr<int> { return ++attempts; }, [](int) {});
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(1, *result);
+  EXPECT_EQ(1, attempts.load());
+}
+
+TEST(HedgedCallTest, SlowAttemptIsHedged) {
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::promise<int> discarded;
+  std::atomic<int> attempts(0);
+  HedgedCallThreads threads;
+  auto result = HedgedCall<int>(
+      threads, HedgingPolicy::FixedDelay(us(1000)),
+      [&attempts, released]() -> StatusOr<int> {
+        auto const n = ++attempts;
+        if (n == 1) {
+          released.wait();
+        }
+        return n;
+      },
+      [&discarded](int n) { discarded.set_value(n); });
+  release.set_value();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(2, *result);
+  EXPECT_EQ(1, discarded.get_future().get());
+}
+
+TEST(HedgedCallTest, LosingAttemptIsJoined) {
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<int> attempts(0);
+  int discarded = 0;
+  {
+    HedgedCallThreads threads;
+    auto result = HedgedCall<int>(
+        threads, HedgingPolicy::FixedDelay(us(1000)),
+        [&attempts, released]() -> StatusOr<int> {
+          auto const n = ++attempts;
+          if (n == 1) {
+            released.wait();
+          }
+          return n;
+        },
+        [&discarded](int n) { discarded = n; });
+    release.set_value();
+    ASSERT_STATUS_OK(result);
+    EXPECT_EQ(2, *result);
+  }
+  // Destroying `threads` waits for the losing attempt.
+  EXPECT_EQ(1, discarded);
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(HedgedCallTest, ExceptionIsRethrown) {
+  HedgedCallThreads threads;
+  EXPECT_THROW(
+      HedgedCall<int>(
+          threads, HedgingPolicy::FixedDelay(std::chrono::seconds(10)),
+          []() -> StatusOr<int> { throw std::runtime_error("uh-oh"); },
+          [](int) {}),
+      std::runtime_error);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+TEST(HedgedCallTest, FirstErrorWaitsForHedge) {
+  auto hedged = std::make_shared<std::promise<void>>();
+  std::shared_future<void> started = hedged->get_future().share();
+  auto attempts = std::make_shared<std::atomic<int>>(0);
+  HedgedCallThreads threads;
+  auto result = HedgedCall<int>(
+      threads, HedgingPolicy::FixedDelay(us(1000)),
+      [attempts, hedged, started]() -> StatusOr<int> {
+        auto const n = ++*attempts;
+        if (n == 1) {
+          // Fail only after the hedged request starts.
+          started.wait();
+          return PermanentError();
+        }
+        hedged->set_value();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return n;
+      },
+      [](int) {});
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ(2, *result);
+}
+
+TEST(HedgedCallTest, FastErrorIsNotHedged) {
+  std::atomic<int> attempts(0);
+  HedgedCallThreads threads;
+  auto result = HedgedCall<int>(
+      threads, HedgingPolicy::FixedDelay(std::chrono::seconds(10)),
+      [&attempts]() -> StatusOr<int> {
+        ++attempts;
+        return PermanentError();
+      },
+      [](int) {});
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(PermanentError().code(), result.status().code());
+  EXPECT_EQ(1, attempts.load());
+}
+
+TEST(HedgedCallTest, RecordsLatency) {
+  auto policy = HedgingPolicy::Percentile(50.0, std::chrono::seconds(10),
+                                          std::chrono::seconds(1));
+  HedgedCallThreads threads;
+  for (int i = 0; i != 20; ++i) {
+    auto result = HedgedCall<int>(
+        threads, policy, []() -> StatusOr<int> { return 0; }, [](int) {});
+    ASSERT_STATUS_OK(result);
+  }
+  // With enough samples the delay is the (tiny) median, clamped to the
+  // minimum.
+  EXPECT_EQ(std::chrono::seconds(1), policy.hedge_delay());
+}
+
+TEST(HedgedRequestTest, GetObjectMetadata) {
+  auto mock = std::make_shared<MockClient>();
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  EXPECT_CALL(*mock, GetObjectMetadata(_))
+      .WillOnce(Invoke([released](GetObjectMetadataRequest const&) {
+        released.wait();
+        return make_status_or(ObjectMetadata{}.set_content_type("slow"));
+      }))
+      .WillOnce(Invoke([](GetObjectMetadataRequest const& r) {
+        EXPECT_TRUE(r.HasOption<HedgeRequests>());
+        return make_status_or(ObjectMetadata{}.set_content_type("fast"));
+      }));
+
+  GetObjectMetadataRequest request("test-bucket", "test-object");
+  request.set_option(HedgeRequests(HedgingPolicy::FixedDelay(us(1000))));
+  HedgedCallThreads threads;
+  auto result = HedgedGetObjectMetadata(threads, mock, request);
+  release.set_value();
+  ASSERT_STATUS_OK(result);
+  EXPECT_EQ("fast", result->content_type());
+}
+
+TEST(HedgedRequestTest, ReadObject) {
+  auto mock = std::make_shared<MockClient>();
+  ClientOptions options(oauth2::CreateAnonymousCredentials());
+  options.SetDownloadBufferSize(16);
+  EXPECT_CALL(*mock, client_options()).WillRepeatedly(ReturnRef(options));
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::promise<void> closed;
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(Invoke([released, &closed](ReadObjectRangeRequest const&) {
+        std::unique_ptr<MockObjectReadSource> source(new MockObjectReadSource);
+        EXPECT_CALL(*source, Read(_, 16))
+            .WillOnce(Invoke([released](char*, std::size_t) {
+              released.wait();
+              return ReadSourceResult{0, HttpResponse{100, {}, {}}};
+            }));
+        EXPECT_CALL(*source, Close()).WillOnce(Invoke([&closed] {
+          closed.set_value();
+          return HttpResponse{200, {}, {}};
+        }));
+        return make_status_or(
+            std::unique_ptr<ObjectReadSource>(std::move(source)));
+      }))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const&) {
+        std::unique_ptr<MockObjectReadSource> source(new MockObjectReadSource);
+        EXPECT_CALL(*source, Read(_, 16))
+            .WillOnce(Invoke([](char* buf, std::size_t) {
+              std::memcpy(buf, "0123456789", 10);
+              return ReadSourceResult{
+                  10, HttpResponse{200, {}, {{"x-goog-generation", "7"}}}};
+            }));
+        EXPECT_CALL(*source, IsOpen()).WillRepeatedly(Return(false));
+        return make_status_or(
+            std::unique_ptr<ObjectReadSource>(std::move(source)));
+      }));
+
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_option(HedgeRequests(HedgingPolicy::FixedDelay(us(1000))));
+  HedgedCallThreads threads;
+  auto source = HedgedReadObject(threads, mock, request);
+  release.set_value();
+  ASSERT_STATUS_OK(source);
+
+  // The first block is replayed in pieces, with the headers in the first
+  // piece and the final status code in the last one.
+  char buf[16];
+  EXPECT_TRUE((*source)->IsOpen());
+  auto read = (*source)->Read(buf, 4);
+  ASSERT_STATUS_OK(read);
+  EXPECT_EQ(4, read->bytes_received);
+  EXPECT_EQ("0123", std::string(buf, 4));
+  EXPECT_EQ(100, read->response.status_code);
+  EXPECT_EQ(1, read->response.headers.count("x-goog-generation"));
+
+  read = (*source)->Read(buf, sizeof(buf));
+  ASSERT_STATUS_OK(read);
+  EXPECT_EQ(6, read->bytes_received);
+  EXPECT_EQ("456789", std::string(buf, 6));
+  EXPECT_EQ(200, read->response.status_code);
+  EXPECT_TRUE(read->response.headers.empty());
+  EXPECT_FALSE((*source)->IsOpen());
+
+  // The losing download is closed once it completes.
+  closed.get_future().wait();
+}
+
+TEST(HedgedRequestTest, ReadObjectError) {
+  auto mock = std::make_shared<MockClient>();
+  ClientOptions options(oauth2::CreateAnonymousCredentials());
+  EXPECT_CALL(*mock, client_options()).WillRepeatedly(ReturnRef(options));
+  EXPECT_CALL(*mock, ReadObject(_))
+      .WillOnce(Invoke([](ReadObjectRangeRequest const&) {
+        return StatusOr<std::unique_ptr<ObjectReadSource>>(PermanentError());
+      }));
+
+  ReadObjectRangeRequest request("test-bucket", "test-object");
+  request.set_option(
+      HedgeRequests(HedgingPolicy::FixedDelay(std::chrono::seconds(10))));
+  HedgedCallThreads threads;
+  auto source = HedgedReadObject(threads, mock, request);
+  EXPECT_FALSE(source.ok());
+  EXPECT_EQ(PermanentError().code(), source.status().code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
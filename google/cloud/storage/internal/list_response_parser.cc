@@ -0,0 +1,178 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/list_response_parser.h"
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+/**
+ * Receives the events from `nl::json::sax_parse()` and builds the items.
+ *
+ * The handler keeps a stack with the JSON containers (objects or arrays) that
+ * are open. A `nullptr` in this stack represents the top-level `items` array,
+ * whose elements are passed to the callback instead of being stored.
+ */
+class ListResponseHandler {
+ public:
+  using number_integer_t = nl::json::number_integer_t;
+  using number_unsigned_t = nl::json::number_unsigned_t;
+  using number_float_t = nl::json::number_float_t;
+  using string_t = nl::json::string_t;
+
+  explicit ListResponseHandler(
+      std::function<Status(nl::json item)> const& on_item)
+      : on_item_(on_item) {}
+
+  bool null() { return AddValue(nullptr); }
+  bool boolean(bool val) { return AddValue(val); }
+  bool number_integer(number_integer_t val) { return AddValue(val); }
+  bool number_unsigned(number_unsigned_t val) { return AddValue(val); }
+  bool number_float(number_float_t val, string_t const&) {
+    return AddValue(val);
+  }
+  bool string(string_t& val) { return AddValue(std::move(val)); }
+  // Only needed for binary formats (e.g. CBOR), which are never used here.
+  template <typename BinaryType>
+  bool binary(BinaryType&) {
+    return false;
+  }
+
+  bool start_object(std::size_t) {
+    if (stack_.empty()) {
+      if (started_) {
+        return false;
+      }
+      started_ = true;
+      stack_.push_back(&top_);
+      return true;
+    }
+    stack_.push_back(Add(nl::json::object()));
+    return true;
+  }
+
+  bool key(string_t& val) {
+    key_ = std::move(val);
+    return true;
+  }
+
+  bool end_object() { return EndContainer(); }
+
+  bool start_array(std::size_t) {
+    if (stack_.empty()) {
+      return false;
+    }
+    if (stack_.size() == 1 && key_ == "items") {
+      stack_.push_back(nullptr);
+      return true;
+    }
+    stack_.push_back(Add(nl::json::array()));
+    return true;
+  }
+
+  bool end_array() { return EndContainer(); }
+
+  template <typename Exception>
+  bool parse_error(std::size_t, std::string const&, Exception const&) {
+    return false;
+  }
+
+  Status const& status() const { return status_; }
+  nl::json& top() { return top_; }
+
+ private:
+  nl::json* Add(nl::json value) {
+    auto& container = stack_.back();
+    if (container == nullptr) {
+      item_ = std::move(value);
+      return &item_;
+    }
+    if (container->is_object()) {
+      auto& ref = (*container)[key_];
+      ref = std::move(value);
+      return &ref;
+    }
+    container->push_back(std::move(value));
+    return &container->back();
+  }
+
+  bool AddValue(nl::json value) {
+    if (stack_.empty()) {
+      return false;
+    }
+    Add(std::move(value));
+    return MaybeEmitItem();
+  }
+
+  bool EndContainer() {
+    if (stack_.empty()) {
+      return false;
+    }
+    stack_.pop_back();
+    return MaybeEmitItem();
+  }
+
+  // If the last value completed an element of `items` pass it to the callback.
+  bool MaybeEmitItem() {
+    if (stack_.empty() || stack_.back() != nullptr) {
+      return true;
+    }
+    status_ = on_item_(std::move(item_));
+    item_ = nullptr;
+    return status_.ok();
+  }
+
+  std::function<Status(nl::json item)> const& on_item_;
+  bool started_ = false;
+  nl::json top_ = nl::json::object();
+  nl::json item_;
+  std::vector<nl::json*> stack_;
+  std::string key_;
+  Status status_;
+};
+}  // namespace
+
+StatusOr<nl::json> ParseListResponse(
+    std::string const& payload,
+    std::function<Status(nl::json item)> const& on_item) {
+  ListResponseHandler handler(on_item);
+  auto success = nl::json::sax_parse(payload, &handler);
+  if (!handler.status().ok()) {
+    return handler.status();
+  }
+  if (!success) {
+    return Status(StatusCode::kInvalidArgument,
+                  std::string(__func__) + ": invalid JSON object in payload");
+  }
+  return std::move(handler.top());
+}
+
+Fields FieldsWithNextPageToken(Fields const& fields) {
+  if (!fields.has_value() || fields.value().empty() ||
+      fields.value().find("nextPageToken") != std::string::npos) {
+    return fields;
+  }
+  return Fields(fields.value() + ",nextPageToken");
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
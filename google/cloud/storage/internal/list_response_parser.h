@@ -0,0 +1,64 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_LIST_RESPONSE_PARSER_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_LIST_RESPONSE_PARSER_H
+
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/storage/well_known_parameters.h"
+#include "google/cloud/status_or.h"
+#include <functional>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/**
+ * Parse the payload of a paginated list response (e.g. `objects.list`).
+ *
+ * Parsing the full page into a JSON object and then converting each item
+ * requires memory for the complete page twice, and this is significant with
+ * large pages (1,000 objects or more) with long metadata. This function uses
+ * the streaming (SAX) parser, only one element of the top-level `items` array
+ * is kept as a JSON object at a time, and it is passed to @p on_item as soon
+ * as it is parsed.
+ *
+ * @return the top-level fields other than `items` (e.g. `nextPageToken`), or
+ *     an error if the payload is not a valid JSON object. If @p on_item
+ *     returns an error the parsing stops and that error is returned.
+ */
+StatusOr<nl::json> ParseListResponse(
+    std::string const& payload,
+    std::function<Status(nl::json item)> const& on_item);
+
+/**
+ * Returns @p fields, including `nextPageToken` if needed.
+ *
+ * Applications use `Fields` to request only some attributes of each item, e.g.
+ * `Fields("items(name,size)")`. Without `nextPageToken` in the response the
+ * list operations would silently stop after the first page.
+ */
+Fields FieldsWithNextPageToken(Fields const& fields);
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_LIST_RESPONSE_PARSER_H
@@ -0,0 +1,125 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/internal/list_response_parser.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+TEST(ListResponseParserTest, Basic) {
+  std::string const text = R"""({
+      "kind": "storage#objects",
+      "nextPageToken": "some-token-42",
+      "items": [
+        {"name": "foo", "size": 42, "metadata": {"k": "v"}},
+        {"name": "bar", "items": [1, 2], "acl": [{"entity": "e"}]},
+        "not-an-object",
+        [1, 2]
+      ],
+      "prefixes": ["p1/", "p2/"]
+  })""";
+
+  std::vector<nl::json> items;
+  auto actual = ParseListResponse(text, [&items](nl::json item) {
+    items.push_back(std::move(item));
+    return Status();
+  });
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ((nl::json{{"kind", "storage#objects"},
+                      {"nextPageToken", "some-token-42"},
+                      {"prefixes", {"p1/", "p2/"}}}),
+            *actual);
+  EXPECT_THAT(
+      items,
+      ElementsAre(
+          nl::json{{"name", "foo"}, {"size", 42}, {"metadata", {{"k", "v"}}}},
+          nl::json{{"name", "bar"},
+                   {"items", {1, 2}},
+                   {"acl", nl::json::array({{{"entity", "e"}}})}},
+          nl::json("not-an-object"), nl::json({1, 2})));
+}
+
+TEST(ListResponseParserTest, MatchesDomParser) {
+  std::string const text = R"""({
+      "nextPageToken": "t",
+      "items": [
+        {"name": "a", "n": null, "b": true, "i": -7, "u": 7, "d": 1.5,
+         "nested": {"items": [{"x": "y"}], "empty": {}, "list": []}}
+      ]
+  })""";
+  auto expected = nl::json::parse(text);
+
+  auto actual = ParseListResponse(text, [&expected](nl::json item) {
+    EXPECT_EQ(expected["items"][0], item);
+    return Status();
+  });
+  ASSERT_STATUS_OK(actual);
+  expected.erase("items");
+  EXPECT_EQ(expected, *actual);
+}
+
+TEST(ListResponseParserTest, Empty) {
+  auto actual = ParseListResponse("{}", [](nl::json const&) {
+    ADD_FAILURE() << "unexpected item";
+    return Status();
+  });
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ(nl::json::object(), *actual);
+}
+
+TEST(ListResponseParserTest, InvalidJson) {
+  auto on_item = [](nl::json const&) { return Status(); };
+  for (std::string const text :
+       {"", "{123", "[]", "\"string\"", "42", R"""({"items": [{"a": )"""}) {
+    auto actual = ParseListResponse(text, on_item);
+    EXPECT_EQ(StatusCode::kInvalidArgument, actual.status().code())
+        << "text=" << text;
+  }
+}
+
+TEST(ListResponseParserTest, ItemErrorStopsParsing) {
+  std::string const text = R"""({"items": [{"name": "a"}, {"name": "b"}]})""";
+  int count = 0;
+  auto actual = ParseListResponse(text, [&count](nl::json const&) {
+    ++count;
+    return Status(StatusCode::kUnavailable, "try-again");
+  });
+  EXPECT_EQ(StatusCode::kUnavailable, actual.status().code());
+  EXPECT_THAT(actual.status().message(), HasSubstr("try-again"));
+  EXPECT_EQ(1, count);
+}
+
+TEST(ListResponseParserTest, FieldsWithNextPageToken) {
+  EXPECT_FALSE(FieldsWithNextPageToken(Fields()).has_value());
+  EXPECT_EQ("", FieldsWithNextPageToken(Fields("")).value());
+  EXPECT_EQ("items(name),nextPageToken",
+            FieldsWithNextPageToken(Fields("items(name)")).value());
+  auto const with_token = Fields("nextPageToken,items(name)");
+  EXPECT_EQ(with_token.value(), FieldsWithNextPageToken(with_token).value());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
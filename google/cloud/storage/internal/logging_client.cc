@@ -170,6 +170,23 @@ StatusOr<std::unique_ptr<ObjectReadSource>> LoggingClient::ReadObject(
                                    __func__);
 }
 
+future<StatusOr<std::string>> LoggingClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  GCP_LOG(INFO) << __func__ << "() << " << request;
+  char const* context = __func__;
+  return client_->AsyncReadObject(request).then(
+      [context](future<StatusOr<std::string>> f) {
+        auto response = f.get();
+        if (response.ok()) {
+          GCP_LOG(INFO) << context << "() >> payload.size=" << response->size();
+        } else {
+          GCP_LOG(INFO) << context << "() >> status={" << response.status()
+                        << "}";
+        }
+        return response;
+      });
+}
+
 StatusOr<ListObjectsResponse> LoggingClient::ListObjects(
     ListObjectsRequest const& request) {
   return MakeCall(*client_, &RawClient::ListObjects, request, __func__);
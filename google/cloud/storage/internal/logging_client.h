@@ -65,6 +65,8 @@ class LoggingClient : public RawClient {
       GetObjectMetadataRequest const& request) override;
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
       ReadObjectRangeRequest const&) override;
+  future<StatusOr<std::string>> AsyncReadObject(
+      ReadObjectRangeRequest const&) override;
   StatusOr<ListObjectsResponse> ListObjects(ListObjectsRequest const&) override;
   StatusOr<EmptyResponse> DeleteObject(DeleteObjectRequest const&) override;
   StatusOr<ObjectMetadata> UpdateObject(
@@ -48,6 +48,32 @@ LoggingResumableUploadSession::UploadFinalChunk(std::string const& buffer,
   return response;
 }
 
+StatusOr<ResumableUploadResponse>
+LoggingResumableUploadSession::UploadChunkFromBuffer(ConstBuffer buffer) {
+  GCP_LOG(INFO) << __func__ << "() << {buffer.size=" << buffer.size() << "}";
+  auto response = session_->UploadChunkFromBuffer(buffer);
+  if (response.ok()) {
+    GCP_LOG(INFO) << __func__ << "() >> payload={" << response.value() << "}";
+  } else {
+    GCP_LOG(INFO) << __func__ << "() >> status={" << response.status() << "}";
+  }
+  return response;
+}
+
+StatusOr<ResumableUploadResponse>
+LoggingResumableUploadSession::UploadFinalChunkFromBuffer(
+    ConstBuffer buffer, std::uint64_t upload_size) {
+  GCP_LOG(INFO) << __func__ << "() << upload_size=" << upload_size
+                << ", buffer.size=" << buffer.size();
+  auto response = session_->UploadFinalChunkFromBuffer(buffer, upload_size);
+  if (response.ok()) {
+    GCP_LOG(INFO) << __func__ << "() >> payload={" << response.value() << "}";
+  } else {
+    GCP_LOG(INFO) << __func__ << "() >> status={" << response.status() << "}";
+  }
+  return response;
+}
+
 StatusOr<ResumableUploadResponse>
 LoggingResumableUploadSession::ResetSession() {
   GCP_LOG(INFO) << __func__ << "() << {}";
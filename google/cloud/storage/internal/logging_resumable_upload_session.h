@@ -37,6 +37,10 @@ class LoggingResumableUploadSession : public ResumableUploadSession {
       std::string const& buffer) override;
   StatusOr<ResumableUploadResponse> UploadFinalChunk(
       std::string const& buffer, std::uint64_t upload_size) override;
+  StatusOr<ResumableUploadResponse> UploadChunkFromBuffer(
+      ConstBuffer buffer) override;
+  StatusOr<ResumableUploadResponse> UploadFinalChunkFromBuffer(
+      ConstBuffer buffer, std::uint64_t upload_size) override;
   StatusOr<ResumableUploadResponse> ResetSession() override;
   std::uint64_t next_expected_byte() const override;
   std::string const& session_id() const override;
@@ -0,0 +1,117 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/mapped_file.h"
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#if _WIN32
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // _WIN32
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+#if _WIN32
+StatusOr<std::unique_ptr<MappedFile>> MappedFile::Open(
+    std::string const& file_name) {
+  return Status(StatusCode::kUnimplemented,
+                "memory mapped files are not supported on this platform, "
+                "file_name=" +
+                    file_name);
+}
+
+MappedFile::~MappedFile() = default;
+#else
+namespace {
+Status ErrnoToStatus(char const* where, std::string const& file_name,
+                     int error) {
+  std::ostringstream os;
+  os << "MappedFile::Open(" << file_name << "): " << where
+     << "() failed: " << std::strerror(error);
+  switch (error) {
+    case ENOENT:
+      return Status(StatusCode::kNotFound, std::move(os).str());
+    case EACCES:
+    case EPERM:
+      return Status(StatusCode::kPermissionDenied, std::move(os).str());
+    default:
+      break;
+  }
+  return Status(StatusCode::kUnknown, std::move(os).str());
+}
+}  // namespace
+
+StatusOr<std::unique_ptr<MappedFile>> MappedFile::Open(
+    std::string const& file_name) {
+  int fd = open(file_name.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd == -1) {
+    return ErrnoToStatus("open", file_name, errno);
+  }
+  struct stat st {};
+  if (fstat(fd, &st) != 0) {
+    auto const error = errno;
+    (void)close(fd);
+    return ErrnoToStatus("fstat", file_name, error);
+  }
+  if (!S_ISREG(st.st_mode)) {
+    (void)close(fd);
+    return Status(StatusCode::kInvalidArgument,
+                  "MappedFile::Open(" + file_name + "): not a regular file");
+  }
+  auto const size = static_cast<std::size_t>(st.st_size);
+  if (size == 0) {
+    // mmap() rejects empty mappings, there is nothing to map anyway.
+    (void)close(fd);
+    return std::unique_ptr<MappedFile>(new MappedFile(nullptr, 0));
+  }
+  void* address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  auto const error = errno;
+  // The mapping keeps its own reference to the file.
+  (void)close(fd);
+  if (address == MAP_FAILED) {
+    return ErrnoToStatus("mmap", file_name, error);
+  }
+  // This is only a hint, ignore any errors.
+  (void)madvise(address, size, MADV_SEQUENTIAL);
+  return std::unique_ptr<MappedFile>(new MappedFile(address, size));
+}
+
+MappedFile::~MappedFile() {
+  if (address_ != nullptr) {
+    (void)munmap(address_, size_);
+  }
+}
+#endif  // _WIN32
+
+ConstBuffer MappedFile::Range(std::size_t offset, std::size_t count) const {
+  if (offset >= size_) {
+    return ConstBuffer(data() + size_, 0);
+  }
+  return ConstBuffer(data() + offset, (std::min)(count, size_ - offset));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
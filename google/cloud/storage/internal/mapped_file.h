@@ -0,0 +1,71 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_H
+
+#include "google/cloud/storage/internal/const_buffer.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * A read-only memory mapping of a regular file.
+ *
+ * The mapping is created with a hint that the data is read sequentially, so
+ * the kernel can read ahead aggressively. The file must not be truncated while
+ * it is mapped, on POSIX systems accessing the truncated pages raises
+ * `SIGBUS`.
+ *
+ * Memory mapped files are not supported on Windows, `Open()` returns a
+ * `kUnimplemented` error and the callers should fall back to streams.
+ */
+class MappedFile {
+ public:
+  static StatusOr<std::unique_ptr<MappedFile>> Open(
+      std::string const& file_name);
+
+  ~MappedFile();
+
+  MappedFile(MappedFile const&) = delete;
+  MappedFile& operator=(MappedFile const&) = delete;
+
+  char const* data() const { return static_cast<char const*>(address_); }
+  std::size_t size() const { return size_; }
+
+  /// Returns (at most) @p count bytes starting at @p offset.
+  ConstBuffer Range(std::size_t offset, std::size_t count) const;
+
+ private:
+  MappedFile(void* address, std::size_t size)
+      : address_(address), size_(size) {}
+
+  void* address_;
+  std::size_t size_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_MAPPED_FILE_H
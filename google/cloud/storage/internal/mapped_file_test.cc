@@ -0,0 +1,76 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/mapped_file.h"
+#include "google/cloud/storage/testing/temp_file.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+#if _WIN32
+TEST(MappedFileTest, Unimplemented) {
+  testing::TempFile temp_file("0123456789");
+  auto file = MappedFile::Open(temp_file.name());
+  ASSERT_FALSE(file);
+  EXPECT_EQ(StatusCode::kUnimplemented, file.status().code());
+}
+#else
+TEST(MappedFileTest, Simple) {
+  std::string const contents = "0123456789";
+  testing::TempFile temp_file(contents);
+  auto file = MappedFile::Open(temp_file.name());
+  ASSERT_STATUS_OK(file);
+  auto const& mapped = **file;
+  ASSERT_EQ(contents.size(), mapped.size());
+  EXPECT_EQ(contents, std::string(mapped.data(), mapped.size()));
+
+  EXPECT_EQ("234", mapped.Range(2, 3).ToString());
+  EXPECT_EQ("789", mapped.Range(7, 100).ToString());
+  EXPECT_TRUE(mapped.Range(10, 3).empty());
+  EXPECT_TRUE(mapped.Range(20, 3).empty());
+}
+
+TEST(MappedFileTest, Empty) {
+  testing::TempFile temp_file("");
+  auto file = MappedFile::Open(temp_file.name());
+  ASSERT_STATUS_OK(file);
+  EXPECT_EQ(0, (*file)->size());
+  EXPECT_TRUE((*file)->Range(0, 10).empty());
+}
+
+TEST(MappedFileTest, NotFound) {
+  auto file = MappedFile::Open("/not-there/not-a-file");
+  ASSERT_FALSE(file);
+  EXPECT_EQ(StatusCode::kNotFound, file.status().code());
+}
+
+TEST(MappedFileTest, NotRegular) {
+  auto file = MappedFile::Open("/dev/null");
+  ASSERT_FALSE(file);
+  EXPECT_EQ(StatusCode::kInvalidArgument, file.status().code());
+}
+#endif  // _WIN32
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -66,8 +66,13 @@ class ObjectReadSource {
   /// Actively close a download, even if not all the data has been read.
   virtual StatusOr<HttpResponse> Close() = 0;
 
-  /// Read more data from the download, returning any HTTP headers and error
-  /// codes.
+  /**
+   * Read more data from the download, returning any HTTP headers and error
+   * codes.
+   *
+   * Implementations may return fewer than @p n bytes before the download
+   * completes, callers should not treat short reads as the end of the data.
+   */
   virtual StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) = 0;
 };
 
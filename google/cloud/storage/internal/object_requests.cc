@@ -14,6 +14,7 @@
 
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/internal/binary_data_as_debug_string.h"
+#include "google/cloud/storage/internal/list_response_parser.h"
 #include "google/cloud/storage/internal/metadata_parser.h"
 #include "google/cloud/storage/internal/nljson.h"
 #include "google/cloud/storage/internal/object_acl_requests.h"
@@ -72,7 +73,7 @@ StatusOr<ObjectMetadata> ObjectMetadataParser::FromJson(
   result.content_type_ = json.value("contentType", "");
   result.crc32c_ = json.value("crc32c", "");
   if (json.count("customerEncryption") != 0) {
-    auto field = json["customerEncryption"];
+    auto const& field = json["customerEncryption"];
     CustomerEncryption e;
     e.encryption_algorithm = field.value("encryptionAlgorithm", "");
     e.key_sha256 = field.value("keySha256", "");
@@ -196,20 +197,22 @@ std::ostream& operator<<(std::ostream& os, ListObjectsRequest const& r) {
 
 StatusOr<ListObjectsResponse> ListObjectsResponse::FromHttpResponse(
     std::string const& payload) {
-  auto json = storage::internal::nl::json::parse(payload, nullptr, false);
-  if (!json.is_object()) {
-    return Status(StatusCode::kInvalidArgument, __func__);
-  }
-
   ListObjectsResponse result;
-  result.next_page_token = json.value("nextPageToken", "");
-
-  for (auto const& kv : json["items"].items()) {
-    auto parsed = internal::ObjectMetadataParser::FromJson(kv.value());
+  auto json = ParseListResponse(payload, [&result](nl::json item) -> Status {
+    auto parsed = internal::ObjectMetadataParser::FromJson(item);
     if (!parsed.ok()) {
       return std::move(parsed).status();
     }
     result.items.emplace_back(std::move(*parsed));
+    return Status();
+  });
+  if (!json) {
+    return std::move(json).status();
+  }
+
+  result.next_page_token = json->value("nextPageToken", "");
+  for (auto const& kv : (*json)["prefixes"].items()) {
+    result.prefixes.emplace_back(kv.value().get<std::string>());
   }
 
   return result;
@@ -220,6 +223,9 @@ std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r) {
      << ", items={";
   std::copy(r.items.begin(), r.items.end(),
             std::ostream_iterator<ObjectMetadata>(os, "\n  "));
+  os << "}, prefixes={";
+  std::copy(r.prefixes.begin(), r.prefixes.end(),
+            std::ostream_iterator<std::string>(os, "\n  "));
   return os << "}}";
 }
 
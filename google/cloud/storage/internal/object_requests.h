@@ -17,8 +17,11 @@
 
 #include "google/cloud/storage/download_options.h"
 #include "google/cloud/storage/hashing_options.h"
+#include "google/cloud/storage/hedging_options.h"
+#include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/generic_object_request.h"
 #include "google/cloud/storage/internal/http_response.h"
+#include "google/cloud/storage/list_objects_options.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/storage/upload_options.h"
 #include "google/cloud/storage/version.h"
@@ -55,7 +58,8 @@ internal::nl::json ObjectMetadataJsonForUpdate(ObjectMetadata const& meta);
  */
 class ListObjectsRequest
     : public GenericRequest<ListObjectsRequest, MaxResults, Prefix, Delimiter,
-                            Projection, UserProject, Versions> {
+                            EndOffset, PrefetchNextPage, Projection,
+                            StartOffset, UserProject, Versions> {
  public:
   ListObjectsRequest() = default;
   explicit ListObjectsRequest(std::string bucket_name)
@@ -81,6 +85,8 @@ struct ListObjectsResponse {
 
   std::string next_page_token;
   std::vector<ObjectMetadata> items;
+  /// The prefixes found when the request includes a `Delimiter`.
+  std::vector<std::string> prefixes;
 };
 
 std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r);
@@ -90,9 +96,9 @@ std::ostream& operator<<(std::ostream& os, ListObjectsResponse const& r);
  */
 class GetObjectMetadataRequest
     : public GenericObjectRequest<
-          GetObjectMetadataRequest, Generation, IfGenerationMatch,
-          IfGenerationNotMatch, IfMetagenerationMatch, IfMetagenerationNotMatch,
-          Projection, UserProject> {
+          GetObjectMetadataRequest, Generation, HedgeRequests,
+          IfGenerationMatch, IfGenerationNotMatch, IfMetagenerationMatch,
+          IfMetagenerationNotMatch, Projection, UserProject> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 };
@@ -113,8 +119,8 @@ class InsertObjectMediaRequest
           Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
           IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UserProject,
-          WithObjectMetadata> {
+          MD5HashValue, PredefinedAcl, Projection, UseMemoryMappedFile,
+          UserProject, WithObjectMetadata> {
  public:
   InsertObjectMediaRequest() : GenericObjectRequest(), contents_() {}
 
@@ -177,9 +183,9 @@ std::ostream& operator<<(std::ostream& os, CopyObjectRequest const& r);
 class ReadObjectRangeRequest
     : public GenericObjectRequest<
           ReadObjectRangeRequest, DisableCrc32cChecksum, DisableMD5Hash,
-          EncryptionKey, Generation, IfGenerationMatch, IfGenerationNotMatch,
-          IfMetagenerationMatch, IfMetagenerationNotMatch, ReadFromOffset,
-          ReadRange, ReadLast, UserProject> {
+          EncryptionKey, Generation, HedgeRequests, IfGenerationMatch,
+          IfGenerationNotMatch, IfMetagenerationMatch, IfMetagenerationNotMatch,
+          ReadFromOffset, ReadRange, ReadLast, UseHashingThread, UserProject> {
  public:
   using GenericObjectRequest::GenericObjectRequest;
 
@@ -360,7 +366,8 @@ class ResumableUploadRequest
           Crc32cChecksumValue, DisableCrc32cChecksum, DisableMD5Hash,
           EncryptionKey, IfGenerationMatch, IfGenerationNotMatch,
           IfMetagenerationMatch, IfMetagenerationNotMatch, KmsKeyName,
-          MD5HashValue, PredefinedAcl, Projection, UseResumableUploadSession,
+          MD5HashValue, PredefinedAcl, Projection, UploadPipelineDepth,
+          UseHashingThread, UseMemoryMappedFile, UseResumableUploadSession,
           UserProject, WithObjectMetadata> {
  public:
   ResumableUploadRequest() = default;
@@ -394,11 +401,45 @@ class UploadChunkRequest : public GenericRequest<UploadChunkRequest> {
         source_size_(source_size),
         last_chunk_(true) {}
 
+  //@{
+  /**
+   * Creates a request that references (instead of copying) the payload.
+   *
+   * The memory referenced by @p payload must remain valid while the request
+   * is in use.
+   */
+  UploadChunkRequest(std::string upload_session_url, std::uint64_t range_begin,
+                     ConstBuffer payload)
+      : GenericRequest(),
+        upload_session_url_(std::move(upload_session_url)),
+        range_begin_(range_begin),
+        external_payload_(payload),
+        has_external_payload_(true),
+        source_size_(0),
+        last_chunk_(false) {}
+  UploadChunkRequest(std::string upload_session_url, std::uint64_t range_begin,
+                     ConstBuffer payload, std::uint64_t source_size)
+      : GenericRequest(),
+        upload_session_url_(std::move(upload_session_url)),
+        range_begin_(range_begin),
+        external_payload_(payload),
+        has_external_payload_(true),
+        source_size_(source_size),
+        last_chunk_(true) {}
+  //@}
+
   std::string const& upload_session_url() const { return upload_session_url_; }
   std::uint64_t range_begin() const { return range_begin_; }
-  std::uint64_t range_end() const { return range_begin_ + payload_.size() - 1; }
+  std::uint64_t range_end() const {
+    return range_begin_ + payload().size() - 1;
+  }
   std::uint64_t source_size() const { return source_size_; }
-  std::string const& payload() const { return payload_; }
+  ConstBuffer payload() const {
+    if (has_external_payload_) {
+      return external_payload_;
+    }
+    return ConstBuffer(payload_.data(), payload_.size());
+  }
 
   std::string RangeHeader() const;
 
@@ -421,6 +462,8 @@ class UploadChunkRequest : public GenericRequest<UploadChunkRequest> {
   std::string upload_session_url_;
   std::uint64_t range_begin_ = 0;
   std::string payload_;
+  ConstBuffer external_payload_;
+  bool has_external_payload_ = false;
   std::uint64_t source_size_ = 0;
   bool last_chunk_ = false;
 };
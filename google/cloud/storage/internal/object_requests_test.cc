@@ -62,6 +62,18 @@ TEST(ObjectRequestsTest, List) {
   EXPECT_THAT(actual, HasSubstr("prefix=foo/"));
 }
 
+TEST(ObjectRequestsTest, ListWithOffsets) {
+  ListObjectsRequest request("my-bucket");
+  request.set_multiple_options(StartOffset("foo/a"), EndOffset("foo/b"));
+
+  std::ostringstream os;
+  os << request;
+  std::string actual = os.str();
+  EXPECT_THAT(actual, HasSubstr("my-bucket"));
+  EXPECT_THAT(actual, HasSubstr("startOffset=foo/a"));
+  EXPECT_THAT(actual, HasSubstr("endOffset=foo/b"));
+}
+
 TEST(ObjectRequestsTest, ParseListResponse) {
   std::string object1 = R"""({
       "bucket": "foo-bar",
@@ -116,6 +128,22 @@ TEST(ObjectRequestsTest, ParseListResponse) {
   EXPECT_THAT(actual.items, ::testing::ElementsAre(o1, o2));
 }
 
+TEST(ObjectRequestsTest, ParseListResponsePrefixes) {
+  std::string text = R"""({
+      "kind": "storage#objects",
+      "prefixes": ["a/", "b/"]
+})""";
+
+  auto actual = ListObjectsResponse::FromHttpResponse(text).value();
+  EXPECT_EQ("", actual.next_page_token);
+  EXPECT_TRUE(actual.items.empty());
+  EXPECT_THAT(actual.prefixes, ::testing::ElementsAre("a/", "b/"));
+
+  std::ostringstream os;
+  os << actual;
+  EXPECT_THAT(os.str(), HasSubstr("a/"));
+}
+
 TEST(ObjectRequestsTest, ParseListResponseFailure) {
   std::string text = R"""({123)""";
 
@@ -549,6 +577,26 @@ TEST(ObjectRequestsTest, UploadChunkContentRangeEmptyPayloadEmpty) {
   EXPECT_EQ("Content-Range: bytes */0", request.RangeHeader());
 }
 
+TEST(ObjectRequestsTest, UploadChunkFromBuffer) {
+  std::string const url = "https://unused.googleapis.com/test-only";
+  std::string const data = "abc123";
+  UploadChunkRequest request(url, 1024, ConstBuffer(data.data(), 4));
+  // The request references the buffer, it does not make a copy.
+  EXPECT_EQ(data.data(), request.payload().data());
+  EXPECT_EQ(4, request.payload().size());
+  EXPECT_EQ(1027, request.range_end());
+  EXPECT_EQ("Content-Range: bytes 1024-1027/*", request.RangeHeader());
+
+  UploadChunkRequest last(url, 2042, ConstBuffer(data.data(), data.size()),
+                          2048U);
+  EXPECT_EQ(data.data(), last.payload().data());
+  EXPECT_EQ("Content-Range: bytes 2042-2047/2048", last.RangeHeader());
+
+  std::ostringstream os;
+  os << last;
+  EXPECT_THAT(os.str(), HasSubstr("<Content-Range: bytes 2042-2047/2048>"));
+}
+
 TEST(ObjectRequestsTest, QueryResumableUpload) {
   std::string const url =
       "https://storage.googleapis.com/upload/storage/v1/b/"
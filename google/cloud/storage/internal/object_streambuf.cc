@@ -16,6 +16,8 @@
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/object_stream.h"
 #include "google/cloud/log.h"
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 
 namespace google {
@@ -118,6 +120,25 @@ ObjectReadStreambuf::int_type ObjectReadStreambuf::underflow() {
 }
 
 std::streamsize ObjectReadStreambuf::xsgetn(char* s, std::streamsize count) {
+  // The short reads flag only applies to a single call.
+  bool const short_reads = short_reads_;
+  short_reads_ = false;
+  // The data source may return fewer bytes than requested (for example, to
+  // avoid copying data into a spill buffer). Unless the caller can handle short
+  // reads keep reading until the request is satisfied, the download completes,
+  // or there is an error.
+  std::streamsize offset = 0;
+  do {
+    auto n = ReadOnce(s + offset, count - offset);
+    if (n == 0) {
+      break;
+    }
+    offset += n;
+  } while (!short_reads && offset < count && status_.ok() && IsOpen());
+  return offset;
+}
+
+std::streamsize ObjectReadStreambuf::ReadOnce(char* s, std::streamsize count) {
   GCP_LOG(INFO) << __func__ << "(): count=" << count
                 << ", in_avail=" << in_avail() << ", status=" << status_;
   // This function optimizes stream.read(), the data is copied directly from the
@@ -237,15 +258,20 @@ void ObjectReadStreambuf::SetEmptyRegion() {
 ObjectWriteStreambuf::ObjectWriteStreambuf(
     std::unique_ptr<ResumableUploadSession> upload_session,
     std::size_t max_buffer_size, std::unique_ptr<HashValidator> hash_validator)
+    : ObjectWriteStreambuf(std::move(upload_session),
+                           AdaptiveChunkSize(max_buffer_size, 0, {}),
+                           std::move(hash_validator)) {}
+
+ObjectWriteStreambuf::ObjectWriteStreambuf(
+    std::unique_ptr<ResumableUploadSession> upload_session,
+    AdaptiveChunkSize chunk_size, std::unique_ptr<HashValidator> hash_validator)
     : upload_session_(std::move(upload_session)),
-      max_buffer_size_(UploadChunkRequest::RoundUpToQuantum(max_buffer_size)),
+      chunk_size_(std::move(chunk_size)),
+      max_buffer_size_(chunk_size_.chunk_size()),
       hash_validator_(std::move(hash_validator)),
       last_response_(ResumableUploadResponse{
           {}, 0, {}, ResumableUploadResponse::kInProgress, {}}) {
-  current_ios_buffer_.resize(max_buffer_size_);
-  auto pbeg = current_ios_buffer_.data();
-  auto pend = pbeg + current_ios_buffer_.size();
-  setp(pbeg, pend);
+  ResetPutArea(0);
   // Sessions start in a closed state for uploads that have already been
   // finalized.
   if (upload_session_->done()) {
@@ -340,8 +366,8 @@ StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::FlushFinal() {
   std::size_t upload_size = upload_session_->next_expected_byte() + actual_size;
   hash_validator_->Update(pbase(), actual_size);
 
-  std::string to_upload(pbase(), actual_size);
-  last_response_ = upload_session_->UploadFinalChunk(to_upload, upload_size);
+  last_response_ = upload_session_->UploadFinalChunkFromBuffer(
+      ConstBuffer(pbase(), actual_size), upload_size);
   if (!last_response_) {
     // This was an unrecoverable error, time to store status and signal an
     // error.
@@ -375,12 +401,13 @@ StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::Flush() {
   auto expected_next_byte = upload_session_->next_expected_byte() + chunk_size;
 
   hash_validator_->Update(pbase(), chunk_size);
-  StatusOr<ResumableUploadResponse> result;
-  std::string to_send(pbase(), chunk_size);
-  last_response_ = upload_session_->UploadChunk(to_send);
+  auto const start = std::chrono::steady_clock::now();
+  last_response_ =
+      upload_session_->UploadChunkFromBuffer(ConstBuffer(pbase(), chunk_size));
   if (!last_response_) {
     return last_response_;
   }
+  auto const elapsed = std::chrono::steady_clock::now() - start;
   auto actual_next_byte = upload_session_->next_expected_byte();
   auto bytes_uploaded = static_cast<int64_t>(chunk_size);
   if (actual_next_byte < expected_next_byte) {
@@ -399,12 +426,27 @@ StatusOr<ResumableUploadResponse> ObjectWriteStreambuf::Flush() {
                   << ")";
     return Status(StatusCode::kAborted, error_message.str());
   }
-  std::copy(pbase() + bytes_uploaded, epptr(), pbase());
-  setp(pbase(), epptr());
-  pbump(static_cast<int>(actual_size - bytes_uploaded));
+  chunk_size_.OnChunkUploaded(
+      static_cast<std::size_t>(bytes_uploaded),
+      std::chrono::duration_cast<std::chrono::microseconds>(elapsed));
+  max_buffer_size_ = chunk_size_.chunk_size();
+  std::copy(pbase() + bytes_uploaded, pptr(), pbase());
+  ResetPutArea(actual_size - static_cast<std::size_t>(bytes_uploaded));
   return last_response_;
 }
 
+void ObjectWriteStreambuf::ResetPutArea(std::size_t pending) {
+  // The buffer may contain more than `max_buffer_size_` bytes after a short
+  // write, or when the chunk size decreases.
+  auto const size = (std::max)(max_buffer_size_, pending);
+  if (current_ios_buffer_.size() < size) {
+    current_ios_buffer_.resize(size);
+  }
+  auto pbeg = current_ios_buffer_.data();
+  setp(pbeg, pbeg + size);
+  pbump(static_cast<int>(pending));
+}
+
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_STREAMBUF_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_OBJECT_STREAMBUF_H
 
+#include "google/cloud/storage/internal/adaptive_chunk_size.h"
 #include "google/cloud/storage/internal/hash_validator.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/internal/object_read_source.h"
@@ -67,6 +68,15 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
     return headers_;
   }
 
+  /**
+   * Let the next `xsgetn()` call return as soon as some data is available.
+   *
+   * Normally `xsgetn()` blocks until all the requested bytes are received. With
+   * this flag set it returns after the first read from the data source, which
+   * copies the data directly into the caller's buffer.
+   */
+  void set_short_reads(bool value) { short_reads_ = value; }
+
  private:
   int_type ReportError(Status status);
   void SetEmptyRegion();
@@ -75,12 +85,16 @@ class ObjectReadStreambuf : public std::basic_streambuf<char> {
   int_type underflow() override;
   std::streamsize xsgetn(char* s, std::streamsize count) override;
 
+  /// Read from the internal get area and at most once from the data source.
+  std::streamsize ReadOnce(char* s, std::streamsize count);
+
   std::unique_ptr<ObjectReadSource> source_;
   std::vector<char> current_ios_buffer_;
   std::unique_ptr<HashValidator> hash_validator_;
   HashValidator::Result hash_validator_result_;
   Status status_;
   std::multimap<std::string, std::string> headers_;
+  bool short_reads_ = false;
 };
 
 /**
@@ -98,6 +112,11 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
                        std::size_t max_buffer_size,
                        std::unique_ptr<HashValidator> hash_validator);
 
+  /// Create a streambuf where @p chunk_size chooses the size of each chunk.
+  ObjectWriteStreambuf(std::unique_ptr<ResumableUploadSession> upload_session,
+                       AdaptiveChunkSize chunk_size,
+                       std::unique_ptr<HashValidator> hash_validator);
+
   ~ObjectWriteStreambuf() override = default;
 
   ObjectWriteStreambuf(ObjectWriteStreambuf&& rhs) noexcept = delete;
@@ -140,9 +159,13 @@ class ObjectWriteStreambuf : public std::basic_streambuf<char> {
   /// Flush any remaining data and commit the upload.
   StatusOr<ResumableUploadResponse> FlushFinal();
 
+  /// Reset the put area, keeping the first @p pending bytes in the buffer.
+  void ResetPutArea(std::size_t pending);
+
   std::unique_ptr<ResumableUploadSession> upload_session_;
 
   std::vector<char> current_ios_buffer_;
+  AdaptiveChunkSize chunk_size_;
   std::size_t max_buffer_size_;
 
   std::unique_ptr<HashValidator> hash_validator_;
@@ -19,6 +19,7 @@
 #include "google/cloud/internal/make_unique.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include <gmock/gmock.h>
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -339,6 +340,57 @@ TEST(ObjectWriteStreambufTest, SomeBytesNotAccepted) {
   EXPECT_STATUS_OK(response);
 }
 
+/// @test Verify that the chunk size adapts to the upload throughput.
+TEST(ObjectWriteStreambufTest, AdaptiveChunkSize) {
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockResumableUploadSession>();
+
+  auto const quantum = UploadChunkRequest::kChunkSizeQuantum;
+  std::string const payload = std::string(23 * quantum, '*') + "abcde";
+
+  std::vector<std::size_t> sizes;
+  std::uint64_t next_byte = 0;
+  EXPECT_CALL(*mock, UploadChunk(_))
+      .WillRepeatedly(Invoke([&](std::string const& p) {
+        sizes.push_back(p.size());
+        next_byte += p.size();
+        return make_status_or(ResumableUploadResponse{
+            "", next_byte - 1, {}, ResumableUploadResponse::kInProgress, {}});
+      }));
+  EXPECT_CALL(*mock, UploadFinalChunk(_, _))
+      .WillOnce(Invoke([&](std::string const& p, std::uint64_t s) {
+        sizes.push_back(p.size());
+        EXPECT_EQ(payload.size(), s);
+        return make_status_or(ResumableUploadResponse{
+            "", s - 1, {}, ResumableUploadResponse::kDone, {}});
+      }));
+  EXPECT_CALL(*mock, next_expected_byte()).WillRepeatedly(Invoke([&]() {
+    return next_byte;
+  }));
+  EXPECT_CALL(*mock, done).WillRepeatedly(Return(false));
+
+  auto stats = std::make_shared<UploadChunkStats>();
+  ObjectWriteStreambuf streambuf(
+      std::move(mock), AdaptiveChunkSize(quantum, 8 * quantum, stats),
+      google::cloud::internal::make_unique<NullHashValidator>());
+
+  std::ostream output(&streambuf);
+  output << payload;
+  auto response = streambuf.Close();
+  EXPECT_STATUS_OK(response);
+
+  // The mock uploads are (almost) instantaneous, the chunk size doubles after
+  // each chunk until it reaches the maximum.
+  EXPECT_THAT(sizes, ::testing::ElementsAre(quantum, 2 * quantum, 4 * quantum,
+                                            8 * quantum, 8 * quantum, 5));
+  EXPECT_EQ(5, stats->chunks());
+  EXPECT_EQ(23 * quantum, stats->bytes());
+  EXPECT_EQ(quantum, stats->smallest_chunk_size());
+  EXPECT_EQ(8 * quantum, stats->largest_chunk_size());
+  EXPECT_EQ(8 * quantum, stats->last_chunk_size());
+  EXPECT_EQ(3, stats->increases());
+}
+
 /// @test verify that the upload steam transitions to a bad state if the next
 /// expected byte jumps.
 TEST(ObjectWriteStreambufTest, NextExpectedByteJumpsAhead) {
@@ -540,6 +592,61 @@ TEST(ObjectWriteStreambufTest, ErrorInLargePayload) {
   EXPECT_EQ(StatusCode::kInvalidArgument, response.status().code())
       << ", status=" << response.status();
 }
+
+/// Create a data source returning at most 7 bytes on each call, similar to a
+/// source that pauses instead of copying data into a spill buffer.
+std::unique_ptr<ObjectReadSource> MockShortReadSource(
+    std::string const& payload) {
+  auto offset = std::make_shared<std::size_t>(0);
+  auto mock = google::cloud::internal::make_unique<
+      testing::MockObjectReadSource>();
+  EXPECT_CALL(*mock, IsOpen).WillRepeatedly(Invoke([offset, payload] {
+    return *offset < payload.size();
+  }));
+  EXPECT_CALL(*mock, Read)
+      .WillRepeatedly(Invoke([offset, payload](char* buf, std::size_t n) {
+        auto const count =
+            (std::min)({n, std::size_t(7), payload.size() - *offset});
+        std::copy(payload.begin() + *offset,
+                  payload.begin() + *offset + count, buf);
+        *offset += count;
+        auto const code = *offset < payload.size() ? HttpStatusCode::kContinue
+                                                   : HttpStatusCode::kOk;
+        return make_status_or(
+            ReadSourceResult{count, HttpResponse{code, {}, {}}});
+      }));
+  return std::unique_ptr<ObjectReadSource>(std::move(mock));
+}
+
+/// @test Verify that sgetn() hides short reads from the data source.
+TEST(ObjectReadStreambufTest, ShortReadsFromSource) {
+  std::string const payload = "0123456789abcdefghijklmnopqrstuvwxyz";
+  ObjectReadStreambuf streambuf(ReadObjectRangeRequest("test-bucket", "test"),
+                                MockShortReadSource(payload));
+  std::vector<char> buffer(20);
+  EXPECT_EQ(20, streambuf.sgetn(buffer.data(), buffer.size()));
+  EXPECT_EQ(payload.substr(0, 20), std::string(buffer.begin(), buffer.end()));
+  EXPECT_EQ(16, streambuf.sgetn(buffer.data(), buffer.size()));
+  EXPECT_EQ(payload.substr(20), std::string(buffer.data(), 16));
+  EXPECT_STATUS_OK(streambuf.status());
+  EXPECT_FALSE(streambuf.IsOpen());
+}
+
+/// @test Verify that sgetn() returns short reads when requested.
+TEST(ObjectReadStreambufTest, ShortReadsEnabled) {
+  std::string const payload = "0123456789abcdefghijklmnopqrstuvwxyz";
+  ObjectReadStreambuf streambuf(ReadObjectRangeRequest("test-bucket", "test"),
+                                MockShortReadSource(payload));
+  std::vector<char> buffer(20);
+  streambuf.set_short_reads(true);
+  EXPECT_EQ(7, streambuf.sgetn(buffer.data(), buffer.size()));
+  EXPECT_EQ(payload.substr(0, 7), std::string(buffer.data(), 7));
+  // The flag only applies to one call.
+  EXPECT_EQ(20, streambuf.sgetn(buffer.data(), buffer.size()));
+  EXPECT_EQ(payload.substr(7, 20), std::string(buffer.begin(), buffer.end()));
+  EXPECT_STATUS_OK(streambuf.status());
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
@@ -23,6 +23,7 @@
 #include <openssl/base64.h>
 #endif  // OPENSSL_IS_BORINGSSL
 #include <memory>
+#include <mutex>
 #include <sstream>
 
 namespace google {
@@ -46,6 +47,90 @@ inline std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)> GetDigestCtx() {
 };
 #endif
 
+// Return a digest context to its initial state, so it can be used again.
+inline void ResetDigestCtx(EVP_MD_CTX* ctx) {
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)  // Older than version 1.1.0.
+  EVP_MD_CTX_cleanup(ctx);
+#else
+  EVP_MD_CTX_reset(ctx);
+#endif
+}
+
+using PrivateKeyPtr = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>;
+
+/// Parse the private key in @p pem_contents, returns `nullptr` on errors.
+PrivateKeyPtr ParsePemPrivateKey(std::string const& pem_contents) {
+  auto pem_buffer = std::unique_ptr<BIO, decltype(&BIO_free)>(
+      BIO_new_mem_buf(pem_contents.data(),
+                      static_cast<int>(pem_contents.length())),
+      &BIO_free);
+  if (!pem_buffer) {
+    return PrivateKeyPtr(nullptr, &EVP_PKEY_free);
+  }
+  return PrivateKeyPtr(
+      PEM_read_bio_PrivateKey(
+          pem_buffer.get(),
+          nullptr,  // EVP_PKEY **x
+          nullptr,  // pem_password_cb *cb -- a custom callback.
+          // void *u -- this represents the password for the PEM (only
+          // applicable for formats such as PKCS12 (.p12 files) that use
+          // a password, which we don't currently support.
+          nullptr),
+      &EVP_PKEY_free);
+}
+
+EVP_MD const* DigestType(storage::oauth2::JwtSigningAlgorithms alg) {
+  using ::google::cloud::storage::oauth2::JwtSigningAlgorithms;
+  switch (alg) {
+    case JwtSigningAlgorithms::RS256:
+      return EVP_sha256();
+  }
+  return nullptr;
+}
+
+/**
+ * Signs @p str using @p digest_ctx, returns `nullptr` on success or a
+ * description of the failure.
+ */
+char const* DigestSign(EVP_MD_CTX* digest_ctx, EVP_MD const* digest_type,
+                       EVP_PKEY* private_key, std::string const& str,
+                       std::vector<unsigned char>& signed_str) {
+  int const digest_sign_success_code = 1;
+  if (digest_sign_success_code !=
+      EVP_DigestSignInit(digest_ctx,
+                         nullptr,  // EVP_PKEY_CTX **pctx
+                         digest_type,
+                         nullptr,  // ENGINE *e
+                         private_key)) {
+    return "Could not initialize PEM digest.";
+  }
+
+  if (digest_sign_success_code !=
+      EVP_DigestSignUpdate(digest_ctx, str.data(), str.length())) {
+    return "Could not update PEM digest.";
+  }
+
+  std::size_t signed_str_size = 0;
+  // Calling this method with a nullptr buffer will populate our size var
+  // with the resulting buffer's size. This allows us to then call it again,
+  // with the correct buffer and size, which actually populates the buffer.
+  if (digest_sign_success_code !=
+      EVP_DigestSignFinal(digest_ctx,
+                          nullptr,  // unsigned char *sig
+                          &signed_str_size)) {
+    return "Could not finalize PEM digest (1/2).";
+  }
+
+  signed_str.resize(signed_str_size);
+  if (digest_sign_success_code != EVP_DigestSignFinal(digest_ctx,
+                                                      signed_str.data(),
+                                                      &signed_str_size)) {
+    return "Could not finalize PEM digest (2/2).";
+  }
+  signed_str.resize(signed_str_size);
+  return nullptr;
+}
+
 #ifndef OPENSSL_IS_BORINGSSL
 /**
  * Build a BIO chain for Base 64 encoding and decoding.
@@ -176,8 +261,6 @@ std::string Base64Encode(std::vector<std::uint8_t> const& bytes) {
 std::vector<std::uint8_t> SignStringWithPem(
     std::string const& str, std::string const& pem_contents,
     storage::oauth2::JwtSigningAlgorithms alg) {
-  using ::google::cloud::storage::oauth2::JwtSigningAlgorithms;
-
   // We check for failures several times, so we shorten this into a lambda
   // to avoid bloating the code with alloc/init checks.
   const char* func_name = __func__;  // Avoid using the lambda name instead.
@@ -194,72 +277,93 @@ std::vector<std::uint8_t> SignStringWithPem(
     handle_openssl_failure("Could not create context for OpenSSL digest.");
   }
 
-  EVP_MD const* digest_type = nullptr;
-  switch (alg) {
-    case JwtSigningAlgorithms::RS256:
-      digest_type = EVP_sha256();
-      break;
-  }
+  EVP_MD const* digest_type = DigestType(alg);
   if (digest_type == nullptr) {
     handle_openssl_failure("Could not find specified digest in OpenSSL.");
   }
 
-  auto pem_buffer = std::unique_ptr<BIO, decltype(&BIO_free)>(
-      BIO_new_mem_buf(pem_contents.data(),
-                      static_cast<int>(pem_contents.length())),
-      &BIO_free);
-  if (!pem_buffer) {
-    handle_openssl_failure("Could not create PEM buffer.");
-  }
-
-  auto private_key = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>(
-      PEM_read_bio_PrivateKey(
-          pem_buffer.get(),
-          nullptr,  // EVP_PKEY **x
-          nullptr,  // pem_password_cb *cb -- a custom callback.
-          // void *u -- this represents the password for the PEM (only
-          // applicable for formats such as PKCS12 (.p12 files) that use
-          // a password, which we don't currently support.
-          nullptr),
-      &EVP_PKEY_free);
+  auto private_key = ParsePemPrivateKey(pem_contents);
   if (!private_key) {
     handle_openssl_failure("Could not parse PEM to get private key.");
   }
 
-  int const digest_sign_success_code = 1;
-  if (digest_sign_success_code !=
-      EVP_DigestSignInit(digest_ctx.get(),
-                         nullptr,  // EVP_PKEY_CTX **pctx
-                         digest_type,
-                         nullptr,  // ENGINE *e
-                         private_key.get())) {
-    handle_openssl_failure("Could not initialize PEM digest.");
+  std::vector<unsigned char> signed_str;
+  auto const* error = DigestSign(digest_ctx.get(), digest_type,
+                                 private_key.get(), str, signed_str);
+  if (error != nullptr) {
+    handle_openssl_failure(error);
   }
 
-  if (digest_sign_success_code !=
-      EVP_DigestSignUpdate(digest_ctx.get(), str.data(), str.length())) {
-    handle_openssl_failure("Could not update PEM digest.");
-  }
+  return {signed_str.begin(), signed_str.end()};
+}
 
-  std::size_t signed_str_size = 0;
-  // Calling this method with a nullptr buffer will populate our size var
-  // with the resulting buffer's size. This allows us to then call it again,
-  // with the correct buffer and size, which actually populates the buffer.
-  if (digest_sign_success_code !=
-      EVP_DigestSignFinal(digest_ctx.get(),
-                          nullptr,  // unsigned char *sig
-                          &signed_str_size)) {
-    handle_openssl_failure("Could not finalize PEM digest (1/2).");
+struct PemSigner::Impl {
+  using DigestCtxPtr = decltype(GetDigestCtx());
+
+  Impl(PrivateKeyPtr key, EVP_MD const* type)
+      : private_key(std::move(key)), digest_type(type) {}
+
+  PrivateKeyPtr private_key;
+  EVP_MD const* digest_type;
+
+  std::mutex mu;
+  // Digest contexts released by previous calls to `Sign()`.
+  std::vector<DigestCtxPtr> contexts;  // GUARDED_BY(mu)
+};
+
+StatusOr<std::unique_ptr<PemSigner>> PemSigner::Create(
+    std::string const& pem_contents,
+    storage::oauth2::JwtSigningAlgorithms alg) {
+  auto const* digest_type = DigestType(alg);
+  if (digest_type == nullptr) {
+    return Status(StatusCode::kInvalidArgument,
+                  "Could not find specified digest in OpenSSL.");
+  }
+  auto private_key = ParsePemPrivateKey(pem_contents);
+  if (!private_key) {
+    return Status(StatusCode::kInvalidArgument,
+                  "Could not parse PEM to get private key.");
   }
+  return std::unique_ptr<PemSigner>(new PemSigner(
+      std::unique_ptr<Impl>(new Impl(std::move(private_key), digest_type))));
+}
 
-  std::vector<unsigned char> signed_str(signed_str_size);
-  if (digest_sign_success_code != EVP_DigestSignFinal(digest_ctx.get(),
-                                                      signed_str.data(),
-                                                      &signed_str_size)) {
-    handle_openssl_failure("Could not finalize PEM digest (2/2).");
+PemSigner::PemSigner(std::unique_ptr<Impl> impl) : impl_(std::move(impl)) {}
+
+PemSigner::~PemSigner() = default;
+
+StatusOr<std::vector<std::uint8_t>> PemSigner::Sign(
+    std::string const& str) const {
+  auto digest_ctx = [this] {
+    std::unique_lock<std::mutex> lk(impl_->mu);
+    if (impl_->contexts.empty()) {
+      lk.unlock();
+      return GetDigestCtx();
+    }
+    auto ctx = std::move(impl_->contexts.back());
+    impl_->contexts.pop_back();
+    return ctx;
+  }();
+  if (!digest_ctx) {
+    return Status(StatusCode::kResourceExhausted,
+                  "Could not create context for OpenSSL digest.");
   }
 
-  return {signed_str.begin(), signed_str.end()};
+  std::vector<unsigned char> signed_str;
+  auto const* error = DigestSign(digest_ctx.get(), impl_->digest_type,
+                                 impl_->private_key.get(), str, signed_str);
+  ResetDigestCtx(digest_ctx.get());
+  {
+    std::lock_guard<std::mutex> lk(impl_->mu);
+    impl_->contexts.push_back(std::move(digest_ctx));
+  }
+  if (error != nullptr) {
+    return Status(StatusCode::kInternal,
+                  std::string("Permanent error in Sign()"
+                              " (failed to sign string with PEM key):\n") +
+                      error);
+  }
+  return std::vector<std::uint8_t>(signed_str.begin(), signed_str.end());
 }
 
 std::vector<std::uint8_t> UrlsafeBase64Decode(std::string const& str) {
@@ -17,7 +17,10 @@
 
 #include "google/cloud/storage/oauth2/credential_constants.h"
 #include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
 #include <algorithm>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace google {
@@ -52,6 +55,42 @@ std::vector<std::uint8_t> SignStringWithPem(
     std::string const& str, std::string const& pem_contents,
     storage::oauth2::JwtSigningAlgorithms alg);
 
+/**
+ * Signs strings with a private key parsed once from a PEM container.
+ *
+ * `SignStringWithPem()` parses the PEM container on each call, which dominates
+ * the cost of signing when many strings are signed with the same key (e.g.
+ * when creating signed URLs at high volume). This class keeps the parsed key,
+ * and reuses the OpenSSL digest contexts across calls.
+ *
+ * `Sign()` is thread-safe, it can be called concurrently from multiple
+ * threads.
+ */
+class PemSigner {
+ public:
+  /// Parse @p pem_contents, returns an error if it does not contain a key.
+  static StatusOr<std::unique_ptr<PemSigner>> Create(
+      std::string const& pem_contents,
+      storage::oauth2::JwtSigningAlgorithms alg =
+          storage::oauth2::JwtSigningAlgorithms::RS256);
+
+  ~PemSigner();
+
+  /**
+   * Signs @p str with the cached key.
+   *
+   * @return the signature as an *unencoded* byte array, same as
+   *     `SignStringWithPem()`.
+   */
+  StatusOr<std::vector<std::uint8_t>> Sign(std::string const& str) const;
+
+ private:
+  struct Impl;
+  explicit PemSigner(std::unique_ptr<Impl> impl);
+
+  std::unique_ptr<Impl> impl_;
+};
+
 /**
  * Returns a Base64-encoded version of @p bytes. Using the URL- and
  * filesystem-safe alphabet, making these adjustments:
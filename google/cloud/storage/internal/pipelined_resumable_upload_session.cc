@@ -0,0 +1,211 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/pipelined_resumable_upload_session.h"
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+PipelinedResumableUploadSession::PipelinedResumableUploadSession(
+    std::unique_ptr<ResumableUploadSession> session,
+    std::size_t max_pending_chunks)
+    : session_(std::move(session)),
+      max_pending_chunks_(max_pending_chunks == 0 ? 1 : max_pending_chunks),
+      done_(session_->done()),
+      next_byte_(session_->next_expected_byte()),
+      committed_byte_(next_byte_),
+      last_response_(session_->last_response()) {}
+
+PipelinedResumableUploadSession::~PipelinedResumableUploadSession() {
+  std::unique_lock<std::mutex> lk(mu_);
+  // Upload any queued data, applications may save `next_expected_byte()` to
+  // resume the upload later, and that value includes the queued data.
+  Drain(lk);
+  shutdown_ = true;
+  lk.unlock();
+  cv_.notify_all();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+StatusOr<ResumableUploadResponse> PipelinedResumableUploadSession::UploadChunk(
+    std::string const& buffer) {
+  return UploadChunkFromBuffer(ConstBuffer(buffer.data(), buffer.size()));
+}
+
+StatusOr<ResumableUploadResponse>
+PipelinedResumableUploadSession::UploadFinalChunk(std::string const& buffer,
+                                                  std::uint64_t upload_size) {
+  return UploadFinalChunkFromBuffer(ConstBuffer(buffer.data(), buffer.size()),
+                                    upload_size);
+}
+
+StatusOr<ResumableUploadResponse>
+PipelinedResumableUploadSession::UploadChunkFromBuffer(ConstBuffer buffer) {
+  std::unique_lock<std::mutex> lk(mu_);
+  cv_.wait(lk, [this] {
+    return !status_.ok() || done_ || pending_.size() < max_pending_chunks_;
+  });
+  if (!status_.ok()) {
+    return status_;
+  }
+  if (done_) {
+    // The upload completed early, e.g., because the application set the
+    // X-Upload-Content-Length header, there is nothing else to upload.
+    return last_response_;
+  }
+  std::string chunk;
+  if (!free_.empty()) {
+    chunk = std::move(free_.back());
+    free_.pop_back();
+  }
+  // Only this thread adds data to the queue, it is safe to release the lock
+  // while copying the data.
+  lk.unlock();
+  chunk.assign(buffer.data(), buffer.size());
+  lk.lock();
+  if (!worker_.joinable()) {
+    worker_ = std::thread([this] { Run(); });
+  }
+  pending_.push_back(std::move(chunk));
+  next_byte_ += buffer.size();
+  auto const last_committed_byte = next_byte_ == 0 ? 0 : next_byte_ - 1;
+  lk.unlock();
+  cv_.notify_all();
+  return ResumableUploadResponse{{},
+                                 last_committed_byte,
+                                 {},
+                                 ResumableUploadResponse::kInProgress,
+                                 {}};
+}
+
+StatusOr<ResumableUploadResponse>
+PipelinedResumableUploadSession::UploadFinalChunkFromBuffer(
+    ConstBuffer buffer, std::uint64_t upload_size) {
+  std::unique_lock<std::mutex> lk(mu_);
+  Drain(lk);
+  if (!status_.ok()) {
+    return status_;
+  }
+  lk.unlock();
+  auto response = session_->UploadFinalChunkFromBuffer(buffer, upload_size);
+  lk.lock();
+  done_ = session_->done();
+  next_byte_ = committed_byte_ = session_->next_expected_byte();
+  last_response_ = response;
+  return response;
+}
+
+StatusOr<ResumableUploadResponse>
+PipelinedResumableUploadSession::ResetSession() {
+  std::unique_lock<std::mutex> lk(mu_);
+  Drain(lk);
+  lk.unlock();
+  auto response = session_->ResetSession();
+  lk.lock();
+  // Any queued data was discarded after an error, the application must resume
+  // from the state reported by the service.
+  status_ = Status();
+  done_ = session_->done();
+  next_byte_ = committed_byte_ = session_->next_expected_byte();
+  last_response_ = response;
+  return response;
+}
+
+std::uint64_t PipelinedResumableUploadSession::next_expected_byte() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return status_.ok() ? next_byte_ : committed_byte_;
+}
+
+std::string const& PipelinedResumableUploadSession::session_id() const {
+  // The session id may change while a chunk is uploaded.
+  std::unique_lock<std::mutex> lk(mu_);
+  Drain(lk);
+  return session_->session_id();
+}
+
+bool PipelinedResumableUploadSession::done() const {
+  std::lock_guard<std::mutex> lk(mu_);
+  return done_;
+}
+
+StatusOr<ResumableUploadResponse> const&
+PipelinedResumableUploadSession::last_response() const {
+  std::unique_lock<std::mutex> lk(mu_);
+  Drain(lk);
+  return last_response_;
+}
+
+void PipelinedResumableUploadSession::Drain(
+    std::unique_lock<std::mutex>& lk) const {
+  cv_.wait(lk, [this] { return pending_.empty() && !busy_; });
+}
+
+void PipelinedResumableUploadSession::Run() {
+  std::unique_lock<std::mutex> lk(mu_);
+  for (;;) {
+    cv_.wait(lk, [this] { return shutdown_ || !pending_.empty(); });
+    if (pending_.empty()) {
+      return;
+    }
+    auto chunk = std::move(pending_.front());
+    pending_.pop_front();
+    busy_ = true;
+    auto const expected_byte = committed_byte_ + chunk.size();
+    lk.unlock();
+    // There is room in the queue for another chunk.
+    cv_.notify_all();
+    auto response = session_->UploadChunk(chunk);
+    auto const actual_byte = session_->next_expected_byte();
+    auto const done = session_->done();
+    lk.lock();
+    busy_ = false;
+    committed_byte_ = actual_byte;
+    done_ = done;
+    last_response_ = response;
+    if (!response) {
+      status_ = std::move(response).status();
+    } else if (!done && actual_byte != expected_byte) {
+      std::ostringstream os;
+      os << "Could not continue upload stream. "
+         << "GCS requested unexpected byte. (expected: " << expected_byte
+         << ", actual: " << actual_byte << ")";
+      status_ = Status(StatusCode::kAborted, std::move(os).str());
+    }
+    // After an error, or if the upload completed early, the queued data
+    // cannot be uploaded.
+    if (!status_.ok() || done_) {
+      for (auto& c : pending_) {
+        free_.push_back(std::move(c));
+      }
+      pending_.clear();
+    }
+    chunk.clear();
+    free_.push_back(std::move(chunk));
+    lk.unlock();
+    cv_.notify_all();
+    lk.lock();
+  }
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,102 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_RESUMABLE_UPLOAD_SESSION_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_RESUMABLE_UPLOAD_SESSION_H
+
+#include "google/cloud/storage/internal/resumable_upload_session.h"
+#include "google/cloud/storage/version.h"
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+/**
+ * Decorates a `ResumableUploadSession` to upload chunks in the background.
+ *
+ * `UploadChunk()` copies the data to a queue and returns immediately, the
+ * chunks are uploaded, in order, by a separate thread. This allows the
+ * application to fill the next chunk while the previous one is in flight.
+ * `UploadChunk()` blocks if there are already @p max_pending_chunks in the
+ * queue.
+ *
+ * The decorated session is only used by one thread at a time, so wrapping a
+ * `RetryResumableUploadSession` keeps its behavior: each chunk is retried
+ * (including short writes) before the next one is uploaded.
+ *
+ * Errors are reported by the next call to `UploadChunk()`, or by
+ * `UploadFinalChunk()`. Until an error is detected `next_expected_byte()`
+ * includes the data waiting in the queue, after an error it returns the
+ * value reported by the decorated session, so applications can resume the
+ * upload from that point.
+ */
+class PipelinedResumableUploadSession : public ResumableUploadSession {
+ public:
+  explicit PipelinedResumableUploadSession(
+      std::unique_ptr<ResumableUploadSession> session,
+      std::size_t max_pending_chunks);
+  ~PipelinedResumableUploadSession() override;
+
+  StatusOr<ResumableUploadResponse> UploadChunk(
+      std::string const& buffer) override;
+  StatusOr<ResumableUploadResponse> UploadFinalChunk(
+      std::string const& buffer, std::uint64_t upload_size) override;
+  StatusOr<ResumableUploadResponse> UploadChunkFromBuffer(
+      ConstBuffer buffer) override;
+  StatusOr<ResumableUploadResponse> UploadFinalChunkFromBuffer(
+      ConstBuffer buffer, std::uint64_t upload_size) override;
+  StatusOr<ResumableUploadResponse> ResetSession() override;
+  std::uint64_t next_expected_byte() const override;
+  std::string const& session_id() const override;
+  bool done() const override;
+  StatusOr<ResumableUploadResponse> const& last_response() const override;
+
+ private:
+  /// Block until all the queued chunks are uploaded, or there is an error.
+  void Drain(std::unique_lock<std::mutex>& lk) const;
+  void Run();
+
+  std::unique_ptr<ResumableUploadSession> session_;
+  std::size_t const max_pending_chunks_;
+
+  mutable std::mutex mu_;
+  mutable std::condition_variable cv_;
+  std::deque<std::string> pending_;  // GUARDED_BY(mu_)
+  std::vector<std::string> free_;    // GUARDED_BY(mu_)
+  bool busy_ = false;                // GUARDED_BY(mu_)
+  bool shutdown_ = false;            // GUARDED_BY(mu_)
+  bool done_ = false;                // GUARDED_BY(mu_)
+  Status status_;                    // GUARDED_BY(mu_)
+  // The next byte after the data sent to the queue.
+  std::uint64_t next_byte_ = 0;  // GUARDED_BY(mu_)
+  // The next byte reported by the decorated session.
+  std::uint64_t committed_byte_ = 0;                 // GUARDED_BY(mu_)
+  StatusOr<ResumableUploadResponse> last_response_;  // GUARDED_BY(mu_)
+  std::thread worker_;
+};
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_PIPELINED_RESUMABLE_UPLOAD_SESSION_H
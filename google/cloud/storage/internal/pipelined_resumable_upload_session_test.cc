@@ -0,0 +1,215 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/internal/pipelined_resumable_upload_session.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <future>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+/**
+ * A fake session that records the uploaded chunks.
+ *
+ * The fake can block the first upload until the test releases it, and return
+ * errors or short writes for a specific chunk.
+ */
+class FakeSession : public ResumableUploadSession {
+ public:
+  FakeSession() : last_response_(ResumableUploadResponse{}) {}
+
+  StatusOr<ResumableUploadResponse> UploadChunk(
+      std::string const& buffer) override {
+    if (gate_ && uploads_.empty()) {
+      gate_->get_future().wait();
+    }
+    uploads_.push_back(buffer);
+    if (uploads_.size() == fail_on_) {
+      last_response_ = PermanentError();
+      return last_response_;
+    }
+    next_expected_ += buffer.size();
+    if (uploads_.size() == short_write_on_) {
+      next_expected_ -= buffer.size() / 2;
+    }
+    last_response_ = ResumableUploadResponse{
+        "fake-url", next_expected_ - 1, {},
+        ResumableUploadResponse::kInProgress, {}};
+    return last_response_;
+  }
+
+  StatusOr<ResumableUploadResponse> UploadFinalChunk(
+      std::string const& buffer, std::uint64_t upload_size) override {
+    uploads_.push_back(buffer);
+    next_expected_ += buffer.size();
+    final_upload_size_ = upload_size;
+    done_ = true;
+    last_response_ = ResumableUploadResponse{
+        "fake-url", next_expected_ - 1, {}, ResumableUploadResponse::kDone, {}};
+    return last_response_;
+  }
+
+  StatusOr<ResumableUploadResponse> ResetSession() override {
+    ++reset_count_;
+    return last_response_ = ResumableUploadResponse{
+               "fake-url", next_expected_ - 1, {},
+               ResumableUploadResponse::kInProgress, {}};
+  }
+
+  std::uint64_t next_expected_byte() const override { return next_expected_; }
+  std::string const& session_id() const override { return session_id_; }
+  bool done() const override { return done_; }
+  StatusOr<ResumableUploadResponse> const& last_response() const override {
+    return last_response_;
+  }
+
+  std::vector<std::string> uploads_;
+  std::uint64_t final_upload_size_ = 0;
+  std::size_t fail_on_ = 0;
+  std::size_t short_write_on_ = 0;
+  int reset_count_ = 0;
+  std::promise<void>* gate_ = nullptr;
+
+ private:
+  std::uint64_t next_expected_ = 0;
+  bool done_ = false;
+  std::string session_id_ = "fake-session-id";
+  StatusOr<ResumableUploadResponse> last_response_;
+};
+
+TEST(PipelinedResumableUploadSessionTest, Simple) {
+  auto fake = google::cloud::internal::make_unique<FakeSession>();
+  auto* session = fake.get();
+  PipelinedResumableUploadSession tested(std::move(fake), 2);
+
+  EXPECT_EQ("fake-session-id", tested.session_id());
+  for (auto const* chunk : {"aaaa", "bbbb", "cccc"}) {
+    auto response = tested.UploadChunk(chunk);
+    ASSERT_STATUS_OK(response);
+    EXPECT_FALSE(tested.done());
+  }
+  EXPECT_EQ(12, tested.next_expected_byte());
+
+  auto response = tested.UploadFinalChunk("dd", 14);
+  ASSERT_STATUS_OK(response);
+  EXPECT_EQ(ResumableUploadResponse::kDone, response->upload_state);
+  EXPECT_TRUE(tested.done());
+  EXPECT_EQ(14, tested.next_expected_byte());
+  EXPECT_EQ(14, session->final_upload_size_);
+  EXPECT_THAT(session->uploads_, ElementsAre("aaaa", "bbbb", "cccc", "dd"));
+}
+
+TEST(PipelinedResumableUploadSessionTest, UploadChunkDoesNotBlock) {
+  std::promise<void> gate;
+  auto fake = google::cloud::internal::make_unique<FakeSession>();
+  fake->gate_ = &gate;
+  auto* session = fake.get();
+  PipelinedResumableUploadSession tested(std::move(fake), 2);
+
+  // The first chunk is blocked in the fake session, the next two fill the
+  // queue. None of these calls should block.
+  for (auto const* chunk : {"aaaa", "bbbb", "cccc"}) {
+    ASSERT_STATUS_OK(tested.UploadChunk(chunk));
+  }
+  EXPECT_EQ(12, tested.next_expected_byte());
+
+  gate.set_value();
+  ASSERT_STATUS_OK(tested.UploadFinalChunk("", 12));
+  EXPECT_THAT(session->uploads_, ElementsAre("aaaa", "bbbb", "cccc", ""));
+}
+
+TEST(PipelinedResumableUploadSessionTest, ErrorReportedLater) {
+  auto fake = google::cloud::internal::make_unique<FakeSession>();
+  fake->fail_on_ = 2;
+  auto* session = fake.get();
+  PipelinedResumableUploadSession tested(std::move(fake), 2);
+
+  ASSERT_STATUS_OK(tested.UploadChunk("aaaa"));
+  ASSERT_STATUS_OK(tested.UploadChunk("bbbb"));
+  auto response = tested.UploadFinalChunk("cc", 10);
+  ASSERT_FALSE(response.ok());
+  EXPECT_EQ(PermanentError().code(), response.status().code());
+  // After an error only the data committed by the service is reported.
+  EXPECT_EQ(4, tested.next_expected_byte());
+  EXPECT_THAT(session->uploads_, ElementsAre("aaaa", "bbbb"));
+
+  response = tested.UploadChunk("dddd");
+  EXPECT_EQ(PermanentError().code(), response.status().code());
+
+  // Resetting the session clears the error.
+  ASSERT_STATUS_OK(tested.ResetSession());
+  EXPECT_EQ(1, session->reset_count_);
+  EXPECT_EQ(4, tested.next_expected_byte());
+  ASSERT_STATUS_OK(tested.UploadFinalChunk("bbbbcc", 10));
+  EXPECT_THAT(session->uploads_, ElementsAre("aaaa", "bbbb", "bbbbcc"));
+}
+
+TEST(PipelinedResumableUploadSessionTest, ShortWrite) {
+  auto fake = google::cloud::internal::make_unique<FakeSession>();
+  fake->short_write_on_ = 1;
+  PipelinedResumableUploadSession tested(std::move(fake), 1);
+
+  ASSERT_STATUS_OK(tested.UploadChunk("aaaa"));
+  auto response = tested.UploadFinalChunk("bb", 6);
+  ASSERT_FALSE(response.ok());
+  EXPECT_EQ(StatusCode::kAborted, response.status().code());
+  EXPECT_THAT(response.status().message(), HasSubstr("unexpected byte"));
+  EXPECT_EQ(2, tested.next_expected_byte());
+}
+
+TEST(PipelinedResumableUploadSessionTest, DestructorUploadsQueuedData) {
+  std::promise<void> gate;
+  auto fake = google::cloud::internal::make_unique<FakeSession>();
+  fake->gate_ = &gate;
+  auto* session = fake.get();
+  std::vector<std::string> uploads;
+  {
+    PipelinedResumableUploadSession tested(std::move(fake), 4);
+    for (auto const* chunk : {"aaaa", "bbbb", "cccc"}) {
+      ASSERT_STATUS_OK(tested.UploadChunk(chunk));
+    }
+    gate.set_value();
+    // Save the uploads before the fake is deleted.
+    auto const& last = tested.last_response();
+    EXPECT_STATUS_OK(last);
+    uploads = session->uploads_;
+  }
+  EXPECT_THAT(uploads, ElementsAre("aaaa", "bbbb", "cccc"));
+}
+
+TEST(PipelinedResumableUploadSessionTest, NoUploads) {
+  auto fake = google::cloud::internal::make_unique<FakeSession>();
+  PipelinedResumableUploadSession tested(std::move(fake), 2);
+  EXPECT_FALSE(tested.done());
+  EXPECT_EQ(0, tested.next_expected_byte());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -16,10 +16,16 @@
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RANGE_FROM_PAGINATION_H
 
 #include "google/cloud/storage/version.h"
+#include "google/cloud/internal/make_unique.h"
 #include "google/cloud/status_or.h"
+#include <condition_variable>
+#include <exception>
 #include <functional>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -100,19 +106,143 @@ class PaginationIterator {
   value_type value_;
 };
 
+/**
+ * Loads the pages prefetched by a `PaginationRange` in a background thread.
+ *
+ * A single thread serves all the prefetches of one range, it is started with
+ * the first prefetch and joined when the range is destroyed. Exceptions raised
+ * by the loader are returned as an error `Status`.
+ */
+template <typename Request, typename Response>
+class PagePrefetcher {
+ public:
+  using Loader = std::function<StatusOr<Response>(Request const& r)>;
+
+  explicit PagePrefetcher(Loader loader)
+      : loader_(std::move(loader)), thread_([this] { Run(); }) {}
+
+  ~PagePrefetcher() {
+    {
+      std::lock_guard<std::mutex> lk(mu_);
+      shutdown_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+  }
+
+  PagePrefetcher(PagePrefetcher const&) = delete;
+  PagePrefetcher& operator=(PagePrefetcher const&) = delete;
+
+  /// Starts loading @p request, discarding any result not yet consumed.
+  void Start(Request request) {
+    std::lock_guard<std::mutex> lk(mu_);
+    request_ = std::move(request);
+    has_request_ = true;
+    has_result_ = false;
+    cv_.notify_all();
+  }
+
+  /// Blocks until the page requested by the last `Start()` is loaded.
+  StatusOr<Response> Get() {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [this] { return has_result_ && !has_request_; });
+    has_result_ = false;
+    return std::move(result_);
+  }
+
+ private:
+  void Run() {
+    std::unique_lock<std::mutex> lk(mu_);
+    for (;;) {
+      cv_.wait(lk, [this] { return shutdown_ || has_request_; });
+      if (shutdown_) return;
+      Request request = std::move(request_);
+      has_request_ = false;
+      lk.unlock();
+      auto response = Load(request);
+      lk.lock();
+      // A newer request may have arrived while loading, its result wins.
+      if (has_request_) continue;
+      result_ = std::move(response);
+      has_result_ = true;
+      cv_.notify_all();
+    }
+  }
+
+  StatusOr<Response> Load(Request const& request) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      return loader_(request);
+    } catch (std::exception const& ex) {
+      return Status(StatusCode::kUnknown, ex.what());
+    } catch (...) {
+      return Status(StatusCode::kUnknown, "unknown exception loading a page");
+    }
+#else
+    return loader_(request);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  }
+
+  Loader loader_;
+  std::mutex mu_;
+  std::condition_variable cv_;
+  Request request_;
+  bool has_request_ = false;
+  StatusOr<Response> result_;
+  bool has_result_ = false;
+  bool shutdown_ = false;
+  // Initialized last, `Run()` uses all the other members.
+  std::thread thread_;
+};
+
+/**
+ * Adapts a paginated list RPC into an input range.
+ *
+ * If @p prefetch_next_page is `true` the range requests page N+1 in a
+ * background thread as soon as page N is received, so the application can
+ * process the current page while the next one is in transit. The loader must
+ * be safe to call from a different thread in this case.
+ */
 template <typename T, typename Request, typename Response>
 class PaginationRange {
  public:
   explicit PaginationRange(
       Request request,
-      std::function<StatusOr<Response>(Request const& r)> loader)
+      std::function<StatusOr<Response>(Request const& r)> loader,
+      bool prefetch_next_page = false)
       : request_(std::move(request)),
         next_page_loader_(std::move(loader)),
         next_page_token_(),
-        on_last_page_(false) {
+        on_last_page_(false),
+        prefetch_next_page_(prefetch_next_page) {
     current_ = current_page_.begin();
   }
 
+  /**
+   * Copies do not share the prefetched page.
+   *
+   * The prefetch thread belongs to a single range, the copy loads the next
+   * page on its own when it needs it.
+   */
+  PaginationRange(PaginationRange const& rhs)
+      : request_(rhs.request_),
+        next_page_loader_(rhs.next_page_loader_),
+        current_page_(rhs.current_page_),
+        current_(current_page_.begin() +
+                 (rhs.current_ - rhs.current_page_.begin())),
+        next_page_token_(rhs.next_page_token_),
+        on_last_page_(rhs.on_last_page_),
+        prefetch_next_page_(rhs.prefetch_next_page_) {}
+
+  PaginationRange& operator=(PaginationRange const& rhs) {
+    PaginationRange tmp(rhs);
+    *this = std::move(tmp);
+    return *this;
+  }
+
+  PaginationRange(PaginationRange&&) = default;
+  PaginationRange& operator=(PaginationRange&&) = default;
+
   /// The iterator type for this Range.
   using iterator = PaginationIterator<T, PaginationRange>;
 
@@ -149,7 +279,7 @@ class PaginationRange {
         return iterator(nullptr, past_the_end_error);
       }
       request_.set_page_token(std::move(next_page_token_));
-      auto response = next_page_loader_(request_);
+      auto response = LoadPage();
       if (!response.ok()) {
         next_page_token_.clear();
         current_page_.clear();
@@ -162,6 +292,8 @@ class PaginationRange {
       current_ = current_page_.begin();
       if (next_page_token_.empty()) {
         on_last_page_ = true;
+      } else if (prefetch_next_page_) {
+        StartPrefetch();
       }
       if (current_page_.end() == current_) {
         return iterator(nullptr, past_the_end_error);
@@ -171,12 +303,36 @@ class PaginationRange {
   }
 
  private:
+  /// Returns the prefetched page if available, otherwise loads it.
+  StatusOr<Response> LoadPage() {
+    if (prefetch_pending_) {
+      prefetch_pending_ = false;
+      return prefetcher_->Get();
+    }
+    return next_page_loader_(request_);
+  }
+
+  void StartPrefetch() {
+    if (!prefetcher_) {
+      using Prefetcher = PagePrefetcher<Request, Response>;
+      prefetcher_ = google::cloud::internal::make_unique<Prefetcher>(
+          next_page_loader_);
+    }
+    Request next = request_;
+    next.set_page_token(next_page_token_);
+    prefetcher_->Start(std::move(next));
+    prefetch_pending_ = true;
+  }
+
   Request request_;
   std::function<StatusOr<Response>(Request const& r)> next_page_loader_;
   std::vector<T> current_page_;
   typename std::vector<T>::iterator current_;
   std::string next_page_token_;
   bool on_last_page_;
+  bool prefetch_next_page_;
+  std::unique_ptr<PagePrefetcher<Request, Response>> prefetcher_;
+  bool prefetch_pending_ = false;
 };
 
 }  // namespace internal
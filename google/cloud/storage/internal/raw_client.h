@@ -35,6 +35,7 @@
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/storage/service_account.h"
 #include "google/cloud/storage/version.h"
+#include "google/cloud/future.h"
 #include "google/cloud/status.h"
 #include "google/cloud/status_or.h"
 
@@ -87,6 +88,9 @@ class RawClient {
       GetObjectMetadataRequest const& request) = 0;
   virtual StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
       ReadObjectRangeRequest const&) = 0;
+  /// Read the full contents of an object (or a range) into memory.
+  virtual future<StatusOr<std::string>> AsyncReadObject(
+      ReadObjectRangeRequest const&) = 0;
   virtual StatusOr<ListObjectsResponse> ListObjects(
       ListObjectsRequest const&) = 0;
   virtual StatusOr<EmptyResponse> DeleteObject(DeleteObjectRequest const&) = 0;
@@ -23,6 +23,17 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+StatusOr<ResumableUploadResponse> ResumableUploadSession::UploadChunkFromBuffer(
+    ConstBuffer buffer) {
+  return UploadChunk(buffer.ToString());
+}
+
+StatusOr<ResumableUploadResponse>
+ResumableUploadSession::UploadFinalChunkFromBuffer(ConstBuffer buffer,
+                                                   std::uint64_t upload_size) {
+  return UploadFinalChunk(buffer.ToString(), upload_size);
+}
+
 StatusOr<ResumableUploadResponse> ResumableUploadResponse::FromHttpResponse(
     HttpResponse response) {
   ResumableUploadResponse result;
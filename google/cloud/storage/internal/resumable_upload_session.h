@@ -15,6 +15,7 @@
 #ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RESUMABLE_UPLOAD_SESSION_H
 #define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_INTERNAL_RESUMABLE_UPLOAD_SESSION_H
 
+#include "google/cloud/storage/internal/const_buffer.h"
 #include "google/cloud/storage/internal/http_response.h"
 #include "google/cloud/storage/object_metadata.h"
 #include "google/cloud/storage/version.h"
@@ -58,6 +59,24 @@ class ResumableUploadSession {
   virtual StatusOr<ResumableUploadResponse> UploadFinalChunk(
       std::string const& buffer, std::uint64_t upload_size) = 0;
 
+  /**
+   * Uploads a chunk referenced by @p buffer.
+   *
+   * Implementations that can send the data without copying it (e.g. directly
+   * from a memory mapped file) should override this function. The default
+   * implementation copies the data and calls `UploadChunk()`.
+   */
+  virtual StatusOr<ResumableUploadResponse> UploadChunkFromBuffer(
+      ConstBuffer buffer);
+
+  /**
+   * Uploads the final chunk referenced by @p buffer.
+   *
+   * The default implementation copies the data and calls `UploadFinalChunk()`.
+   */
+  virtual StatusOr<ResumableUploadResponse> UploadFinalChunkFromBuffer(
+      ConstBuffer buffer, std::uint64_t upload_size);
+
   /// Resets the session by querying its current state.
   virtual StatusOr<ResumableUploadResponse> ResetSession() = 0;
 
@@ -99,6 +99,10 @@ typename Signature<MemberFunction>::ReturnType MakeCall(
       // Exit the loop immediately instead of sleeping before trying again.
       break;
     }
+    auto metrics = client.client_options().request_metrics();
+    if (metrics) {
+      metrics->OnRetry(error_message, last_status);
+    }
     auto delay = backoff_policy.OnCompletion();
     std::this_thread::sleep_for(delay);
   }
@@ -283,6 +287,11 @@ StatusOr<std::unique_ptr<ObjectReadSource>> RetryClient::ReadObject(
       std::move(backoff_policy)));
 }
 
+future<StatusOr<std::string>> RetryClient::AsyncReadObject(
+    ReadObjectRangeRequest const& request) {
+  return client_->AsyncReadObject(request);
+}
+
 StatusOr<ListObjectsResponse> RetryClient::ListObjects(
     ListObjectsRequest const& request) {
   auto retry_policy = retry_policy_prototype_->clone();
@@ -84,6 +84,10 @@ class RetryClient : public RawClient,
       ReadObjectRangeRequest const&, RetryPolicy&, BackoffPolicy&);
   StatusOr<std::unique_ptr<ObjectReadSource>> ReadObject(
       ReadObjectRangeRequest const&) override;
+  /// The asynchronous reads are not retried, the retry loop would block the
+  /// thread satisfying the futures.
+  future<StatusOr<std::string>> AsyncReadObject(
+      ReadObjectRangeRequest const&) override;
 
   StatusOr<ListObjectsResponse> ListObjects(ListObjectsRequest const&) override;
   StatusOr<EmptyResponse> DeleteObject(DeleteObjectRequest const&) override;
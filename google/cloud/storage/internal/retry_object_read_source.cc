@@ -91,6 +91,10 @@ StatusOr<ReadSourceResult> RetryObjectReadSource::Read(char* buf,
     // create a new one and replace it. Should that fail, the retry policy would
     // already be exhausted, so we should fail this operation too.
     child_.reset();
+    auto metrics = client_->client_options().request_metrics();
+    if (metrics) {
+      metrics->OnRetry("ReadObject", result.status());
+    }
 
     if (has_testbench_instructions) {
       request_.set_multiple_options(
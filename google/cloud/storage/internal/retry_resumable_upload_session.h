@@ -45,6 +45,10 @@ class RetryResumableUploadSession : public ResumableUploadSession {
       std::string const& buffer) override;
   StatusOr<ResumableUploadResponse> UploadFinalChunk(
       std::string const& buffer, std::uint64_t upload_size) override;
+  StatusOr<ResumableUploadResponse> UploadChunkFromBuffer(
+      ConstBuffer buffer) override;
+  StatusOr<ResumableUploadResponse> UploadFinalChunkFromBuffer(
+      ConstBuffer buffer, std::uint64_t upload_size) override;
   StatusOr<ResumableUploadResponse> ResetSession() override;
   std::uint64_t next_expected_byte() const override;
   std::string const& session_id() const override;
@@ -54,7 +58,7 @@ class RetryResumableUploadSession : public ResumableUploadSession {
  private:
   // Retry either UploadChunk or either UploadFinalChunk.
   StatusOr<ResumableUploadResponse> UploadGenericChunk(
-      std::string const& buffer, optional<std::uint64_t> const& upload_size);
+      ConstBuffer buffer, optional<std::uint64_t> const& upload_size);
 
   // Reset the current session using previously cloned policies.
   StatusOr<ResumableUploadResponse> ResetSession(RetryPolicy& retry_policy,
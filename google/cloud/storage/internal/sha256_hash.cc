@@ -50,11 +50,12 @@ std::vector<std::uint8_t> Sha256Hash(std::vector<std::uint8_t> const& bytes) {
 }
 
 std::string HexEncode(std::vector<std::uint8_t> const& bytes) {
+  static char const kHexDigits[] = "0123456789abcdef";
   std::string result;
-  std::array<char, sizeof("ff")> buf{};
+  result.reserve(2 * bytes.size());
   for (auto c : bytes) {
-    std::snprintf(buf.data(), buf.size(), "%02x", c);
-    result += buf.data();
+    result.push_back(kHexDigits[(c >> 4) & 0xF]);
+    result.push_back(kHexDigits[c & 0xF]);
   }
   return result;
 }
@@ -13,7 +13,6 @@
 // limitations under the License.
 
 #include "google/cloud/storage/internal/signed_url_requests.h"
-#include "google/cloud/storage/internal/curl_handle.h"
 #include "google/cloud/storage/internal/sha256_hash.h"
 #include "google/cloud/internal/format_time_point.h"
 #include <algorithm>
@@ -26,6 +25,25 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
 
+std::string UrlEscapeString(std::string const& value) {
+  static char const kHexDigits[] = "0123456789ABCDEF";
+  std::string result;
+  result.reserve(value.size());
+  for (unsigned char c : value) {
+    // Avoid std::isalnum(), its result depends on the current locale.
+    if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') ||
+        (c >= '0' && c <= '9') || c == '-' || c == '.' || c == '_' ||
+        c == '~') {
+      result.push_back(static_cast<char>(c));
+      continue;
+    }
+    result.push_back('%');
+    result.push_back(kHexDigits[c >> 4]);
+    result.push_back(kHexDigits[c & 0xF]);
+  }
+  return result;
+}
+
 void SignUrlRequestCommon::SetOption(AddExtensionHeaderOption const& o) {
   if (!o.has_value()) {
     return;
@@ -83,19 +101,18 @@ std::string V2SignUrlRequest::StringToSign() const {
     os << kv.first << ":" << kv.second << "\n";
   }
 
-  CurlHandle curl;
   os << '/' << bucket_name();
   if (!object_name().empty()) {
-    os << '/' << curl.MakeEscapedString(object_name()).get();
+    os << '/' << UrlEscapeString(object_name());
   }
   char const* sep = "?";
   if (!sub_resource().empty()) {
-    os << sep << curl.MakeEscapedString(sub_resource()).get();
+    os << sep << UrlEscapeString(sub_resource());
     sep = "&";
   }
   for (auto const& kv : common_request_.query_parameters()) {
-    os << sep << curl.MakeEscapedString(kv.first).get() << "="
-       << curl.MakeEscapedString(kv.second).get();
+    os << sep << UrlEscapeString(kv.first) << "="
+       << UrlEscapeString(kv.second);
     sep = "&";
   }
 
@@ -108,15 +125,14 @@ std::ostream& operator<<(std::ostream& os, V2SignUrlRequest const& r) {
 
 namespace {
 std::string QueryStringFromParameters(
-    CurlHandle& curl,
     std::multimap<std::string, std::string> const& parameters) {
   std::string result;
   char const* sep = "";
   for (auto const& qp : parameters) {
     result += sep;
-    result += curl.MakeEscapedString(qp.first).get();
+    result += UrlEscapeString(qp.first);
     result += '=';
-    result += curl.MakeEscapedString(qp.second).get();
+    result += UrlEscapeString(qp.second);
     sep = "&";
   }
   return result;
@@ -164,10 +180,9 @@ void V4SignUrlRequest::SetOption(Scheme const& o) {
 
 std::string V4SignUrlRequest::CanonicalQueryString(
     std::string const& client_id) const {
-  CurlHandle curl;
   // Query parameters.
   auto parameters = AllQueryParameters(client_id);
-  return QueryStringFromParameters(curl, parameters);
+  return QueryStringFromParameters(parameters);
 }
 
 std::string V4SignUrlRequest::CanonicalRequest(
@@ -175,21 +190,20 @@ std::string V4SignUrlRequest::CanonicalRequest(
   std::ostringstream os;
 
   os << verb() << "\n";
-  CurlHandle curl;
   if (!SkipBucketInPath()) {
     os << '/' << bucket_name();
   }
   for (auto& part : ObjectNameParts()) {
-    os << '/' << curl.MakeEscapedString(part).get();
+    os << '/' << UrlEscapeString(part);
   }
   if (!sub_resource().empty()) {
-    os << '?' << curl.MakeEscapedString(sub_resource()).get();
+    os << '?' << UrlEscapeString(sub_resource());
   }
   os << "\n";
 
   // Query parameters.
   auto parameters = AllQueryParameters(client_id);
-  os << QueryStringFromParameters(curl, parameters) << "\n";
+  os << QueryStringFromParameters(parameters) << "\n";
 
   // Headers
   for (auto&& kv : common_request_.extension_headers()) {
@@ -281,7 +295,6 @@ V4SignUrlRequest::CanonicalQueryParameters(std::string const& client_id) const {
 
 std::multimap<std::string, std::string> V4SignUrlRequest::AllQueryParameters(
     std::string const& client_id) const {
-  CurlHandle curl;
   // Query parameters.
   auto parameters = common_request_.query_parameters();
   auto canonical_parameters = CanonicalQueryParameters(client_id);
@@ -28,6 +28,15 @@ namespace cloud {
 namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace internal {
+/**
+ * Percent-encode @p value, keeping only the RFC 3986 unreserved characters.
+ *
+ * This produces the same output as `CurlHandle::MakeEscapedString()`, without
+ * creating a CURL handle for each string, which is expensive when creating
+ * many signed URLs.
+ */
+std::string UrlEscapeString(std::string const& value);
+
 /// The common data for SignUrlRequests.
 class SignUrlRequestCommon {
  public:
@@ -27,6 +27,14 @@ namespace {
 
 using ::testing::HasSubstr;
 
+TEST(SignedUrlRequests, UrlEscapeString) {
+  EXPECT_EQ("", UrlEscapeString(""));
+  EXPECT_EQ("AZaz09-._~", UrlEscapeString("AZaz09-._~"));
+  EXPECT_EQ("a%20b%2Fc%3Fd%3De%26f%25", UrlEscapeString("a b/c?d=e&f%"));
+  EXPECT_EQ("%C3%A1%00%FF",
+            UrlEscapeString(std::string("\xC3\xA1\x00\xFF", 4)));
+}
+
 TEST(V2SignedUrlRequests, Sign) {
   V2SignUrlRequest request("GET", "test-bucket", "test-object");
   EXPECT_EQ("GET", request.verb());
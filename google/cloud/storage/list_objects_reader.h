@@ -18,6 +18,7 @@
 #include "google/cloud/storage/internal/object_requests.h"
 #include "google/cloud/storage/internal/range_from_pagination.h"
 #include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/object_summary.h"
 #include "google/cloud/storage/version.h"
 #include "google/cloud/status_or.h"
 #include <iterator>
@@ -32,6 +33,12 @@ using ListObjectsReader =
 
 using ListObjectsIterator = ListObjectsReader::iterator;
 
+using ListObjectSummariesReader =
+    internal::PaginationRange<ObjectSummary, internal::ListObjectsRequest,
+                              internal::ListObjectSummariesResponse>;
+
+using ListObjectSummariesIterator = ListObjectSummariesReader::iterator;
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
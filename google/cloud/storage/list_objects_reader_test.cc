@@ -18,6 +18,8 @@
 #include "google/cloud/storage/testing/mock_client.h"
 #include "google/cloud/testing_util/assert_ok.h"
 #include <gmock/gmock.h>
+#include <stdexcept>
+#include <thread>
 
 namespace google {
 namespace cloud {
@@ -31,6 +33,7 @@ using ::google::cloud::storage::testing::MockClient;
 using ::google::cloud::storage::testing::canonical_errors::PermanentError;
 using ::testing::_;
 using ::testing::ContainerEq;
+using ::testing::ElementsAre;
 using ::testing::HasSubstr;
 using ::testing::Invoke;
 using ::testing::Return;
@@ -91,6 +94,187 @@ TEST(ListObjectsReaderTest, Basic) {
   EXPECT_THAT(actual, ContainerEq(expected));
 }
 
+TEST(ListObjectsReaderTest, Prefetch) {
+  int const page_count = 3;
+  std::vector<ObjectMetadata> expected;
+  for (int i = 0; i != 2 * page_count; ++i) {
+    expected.emplace_back(CreateElement(i));
+  }
+
+  // Each page is requested while the application still has the previous page,
+  // verify the requests are made in order and with the right token.
+  std::vector<std::string> tokens;
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .Times(page_count)
+      .WillRepeatedly(Invoke([&](ListObjectsRequest const& r) {
+        auto const i = static_cast<int>(tokens.size());
+        tokens.push_back(r.page_token());
+        ListObjectsResponse response;
+        if (i != page_count - 1) {
+          response.next_page_token = "page-" + std::to_string(i + 1);
+        }
+        response.items.emplace_back(CreateElement(2 * i));
+        response.items.emplace_back(CreateElement(2 * i + 1));
+        return make_status_or(std::move(response));
+      }));
+
+  ListObjectsReader reader(
+      ListObjectsRequest("foo-bar-baz").set_multiple_options(Prefix("dir/")),
+      [mock](ListObjectsRequest const& r) { return mock->ListObjects(r); },
+      /*prefetch_next_page=*/true);
+  std::vector<ObjectMetadata> actual;
+  for (auto&& object : reader) {
+    ASSERT_STATUS_OK(object);
+    actual.emplace_back(std::move(object).value());
+  }
+  EXPECT_THAT(actual, ContainerEq(expected));
+  EXPECT_THAT(tokens, ElementsAre("", "page-1", "page-2"));
+}
+
+TEST(ListObjectsReaderTest, PrefetchFailure) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const&) {
+        ListObjectsResponse response;
+        response.next_page_token = "page-1";
+        response.items.emplace_back(CreateElement(0));
+        return make_status_or(std::move(response));
+      }))
+      .WillOnce(Invoke([](ListObjectsRequest const&) {
+        return StatusOr<ListObjectsResponse>(PermanentError());
+      }));
+
+  ListObjectsReader reader(
+      ListObjectsRequest("test-bucket"),
+      [mock](ListObjectsRequest const& r) { return mock->ListObjects(r); },
+      /*prefetch_next_page=*/true);
+  auto it = reader.begin();
+  ASSERT_STATUS_OK(*it);
+  EXPECT_EQ(CreateElement(0), **it);
+  ++it;
+  ASSERT_NE(reader.end(), it);
+  EXPECT_EQ(PermanentError().code(), it->status().code());
+  ++it;
+  EXPECT_EQ(reader.end(), it);
+}
+
+TEST(ListObjectsReaderTest, PrefetchReusesThread) {
+  int const page_count = 4;
+  // Only the first page is loaded by the application thread, a single
+  // background thread loads all the other pages.
+  std::vector<std::thread::id> ids;
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .Times(page_count)
+      .WillRepeatedly(Invoke([&](ListObjectsRequest const&) {
+        auto const i = static_cast<int>(ids.size());
+        ids.push_back(std::this_thread::get_id());
+        ListObjectsResponse response;
+        if (i != page_count - 1) {
+          response.next_page_token = "page-" + std::to_string(i + 1);
+        }
+        response.items.emplace_back(CreateElement(i));
+        return make_status_or(std::move(response));
+      }));
+
+  ListObjectsReader reader(
+      ListObjectsRequest("test-bucket"),
+      [mock](ListObjectsRequest const& r) { return mock->ListObjects(r); },
+      /*prefetch_next_page=*/true);
+  int count = 0;
+  for (auto&& object : reader) {
+    ASSERT_STATUS_OK(object);
+    ++count;
+  }
+  EXPECT_EQ(page_count, count);
+  ASSERT_EQ(page_count, ids.size());
+  EXPECT_EQ(std::this_thread::get_id(), ids[0]);
+  EXPECT_NE(std::this_thread::get_id(), ids[1]);
+  for (std::size_t i = 2; i != ids.size(); ++i) {
+    EXPECT_EQ(ids[1], ids[i]);
+  }
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST(ListObjectsReaderTest, PrefetchException) {
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const&) {
+        ListObjectsResponse response;
+        response.next_page_token = "page-1";
+        response.items.emplace_back(CreateElement(0));
+        return make_status_or(std::move(response));
+      }))
+      .WillOnce(Invoke([](ListObjectsRequest const&)
+                           -> StatusOr<ListObjectsResponse> {
+        throw std::runtime_error("uh-oh");
+      }));
+
+  ListObjectsReader reader(
+      ListObjectsRequest("test-bucket"),
+      [mock](ListObjectsRequest const& r) { return mock->ListObjects(r); },
+      /*prefetch_next_page=*/true);
+  auto it = reader.begin();
+  ASSERT_STATUS_OK(*it);
+  ++it;
+  ASSERT_NE(reader.end(), it);
+  EXPECT_EQ(StatusCode::kUnknown, it->status().code());
+  EXPECT_THAT(it->status().message(), HasSubstr("uh-oh"));
+  ++it;
+  EXPECT_EQ(reader.end(), it);
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+TEST(ListObjectsReaderTest, PrefetchCopy) {
+  int const page_count = 3;
+  std::vector<ObjectMetadata> expected;
+  for (int i = 0; i != 2 * page_count; ++i) {
+    expected.emplace_back(CreateElement(i));
+  }
+
+  // The copy and the original both read all the pages, so each page after the
+  // first one is requested twice.
+  auto mock = std::make_shared<MockClient>();
+  EXPECT_CALL(*mock, ListObjects(_))
+      .Times(2 * page_count - 1)
+      .WillRepeatedly(Invoke([&](ListObjectsRequest const& r) {
+        auto const i =
+            r.page_token().empty() ? 0 : std::stoi(r.page_token().substr(5));
+        ListObjectsResponse response;
+        if (i != page_count - 1) {
+          response.next_page_token = "page-" + std::to_string(i + 1);
+        }
+        response.items.emplace_back(CreateElement(2 * i));
+        response.items.emplace_back(CreateElement(2 * i + 1));
+        return make_status_or(std::move(response));
+      }));
+
+  ListObjectsReader reader(
+      ListObjectsRequest("foo-bar-baz"),
+      [mock](ListObjectsRequest const& r) { return mock->ListObjects(r); },
+      /*prefetch_next_page=*/true);
+  std::vector<ObjectMetadata> actual;
+  auto it = reader.begin();
+  ASSERT_STATUS_OK(*it);
+  actual.emplace_back(std::move(*it).value());
+
+  // The copy does not share the page being prefetched by `reader`.
+  ListObjectsReader copy = reader;
+  for (++it; it != reader.end(); ++it) {
+    ASSERT_STATUS_OK(*it);
+    actual.emplace_back(std::move(*it).value());
+  }
+  EXPECT_THAT(actual, ContainerEq(expected));
+
+  std::vector<ObjectMetadata> from_copy{expected.front()};
+  for (auto&& object : copy) {
+    ASSERT_STATUS_OK(object);
+    from_copy.emplace_back(std::move(object).value());
+  }
+  EXPECT_THAT(from_copy, ContainerEq(expected));
+}
+
 TEST(ListObjectsReaderTest, Empty) {
   auto mock = std::make_shared<MockClient>();
   EXPECT_CALL(*mock, ListObjects(_))
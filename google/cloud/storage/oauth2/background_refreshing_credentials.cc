@@ -0,0 +1,105 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/oauth2/background_refreshing_credentials.h"
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace oauth2 {
+
+BackgroundRefreshingCredentials::BackgroundRefreshingCredentials(
+    std::shared_ptr<Credentials> credentials,
+    std::chrono::milliseconds refresh_period,
+    std::chrono::milliseconds max_staleness)
+    : credentials_(std::move(credentials)),
+      refresh_period_(refresh_period),
+      max_staleness_(max_staleness) {
+  refresher_ = std::thread([this] { RefreshLoop(); });
+}
+
+BackgroundRefreshingCredentials::~BackgroundRefreshingCredentials() {
+  {
+    std::lock_guard<std::mutex> lk(mu_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  refresher_.join();
+}
+
+StatusOr<std::string> BackgroundRefreshingCredentials::AuthorizationHeader() {
+  auto cached = std::atomic_load(&cached_);
+  if (cached &&
+      std::chrono::steady_clock::now() - cached->fetched < max_staleness_) {
+    return cached->header;
+  }
+  return Refresh();
+}
+
+StatusOr<std::vector<std::uint8_t>> BackgroundRefreshingCredentials::SignBlob(
+    SigningAccount const& service_account,
+    std::string const& string_to_sign) const {
+  return credentials_->SignBlob(service_account, string_to_sign);
+}
+
+std::string BackgroundRefreshingCredentials::AccountEmail() const {
+  return credentials_->AccountEmail();
+}
+
+std::string BackgroundRefreshingCredentials::KeyId() const {
+  return credentials_->KeyId();
+}
+
+StatusOr<std::string> BackgroundRefreshingCredentials::Refresh() {
+  auto const fetched = std::chrono::steady_clock::now();
+  auto header = credentials_->AuthorizationHeader();
+  if (!header) {
+    return header;
+  }
+  // Several threads may refresh at the same time, never replace a newer value.
+  std::shared_ptr<CachedHeader const> update(
+      new CachedHeader{*header, fetched});
+  auto current = std::atomic_load(&cached_);
+  while (!current || current->fetched < fetched) {
+    if (std::atomic_compare_exchange_weak(&cached_, &current, update)) {
+      break;
+    }
+  }
+  return header;
+}
+
+void BackgroundRefreshingCredentials::RefreshLoop() {
+  std::unique_lock<std::mutex> lk(mu_);
+  while (!shutdown_) {
+    lk.unlock();
+    // Errors are ignored, the cached value remains usable until it is too
+    // stale, and then the callers refresh the credentials (and get the error)
+    // synchronously.
+    (void)Refresh();
+    lk.lock();
+    cv_.wait_for(lk, refresh_period_, [this] { return shutdown_; });
+  }
+}
+
+std::shared_ptr<Credentials> CreateBackgroundRefreshingCredentials(
+    std::shared_ptr<Credentials> credentials) {
+  return std::make_shared<BackgroundRefreshingCredentials>(
+      std::move(credentials));
+}
+
+}  // namespace oauth2
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
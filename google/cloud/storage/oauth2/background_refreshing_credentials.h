@@ -0,0 +1,108 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OAUTH2_BACKGROUND_REFRESHING_CREDENTIALS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OAUTH2_BACKGROUND_REFRESHING_CREDENTIALS_H
+
+#include "google/cloud/storage/oauth2/credential_constants.h"
+#include "google/cloud/storage/oauth2/credentials.h"
+#include "google/cloud/storage/version.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace oauth2 {
+
+/**
+ * Decorates a `Credentials` object to refresh its tokens in the background.
+ *
+ * The refreshing credentials (`ServiceAccountCredentials`,
+ * `ComputeEngineCredentials`, and `AuthorizedUserCredentials`) fetch a new
+ * access token inside `AuthorizationHeader()`, while holding a mutex. When the
+ * token is about to expire all the threads using the client block behind one
+ * request to the token endpoint.
+ *
+ * This decorator calls the wrapped `AuthorizationHeader()` from a background
+ * thread every @p refresh_period, and caches the result in an atomically
+ * swapped `std::shared_ptr`. The wrapped credentials refresh the token
+ * `GoogleOAuthAccessTokenExpirationSlack()` before it expires, so as long as
+ * the refresh period is shorter than that slack the token is renewed by the
+ * background thread, and `AuthorizationHeader()` returns the cached value
+ * without waiting on any lock or network request.
+ *
+ * If the cached value is older than @p max_staleness (for example, because the
+ * background refresh keeps failing) `AuthorizationHeader()` falls back to
+ * calling the wrapped credentials, and reports any errors to the caller.
+ */
+class BackgroundRefreshingCredentials : public Credentials {
+ public:
+  explicit BackgroundRefreshingCredentials(
+      std::shared_ptr<Credentials> credentials,
+      std::chrono::milliseconds refresh_period = std::chrono::seconds(60),
+      std::chrono::milliseconds max_staleness =
+          GoogleOAuthAccessTokenExpirationSlack() / 2);
+  ~BackgroundRefreshingCredentials() override;
+
+  StatusOr<std::string> AuthorizationHeader() override;
+  StatusOr<std::vector<std::uint8_t>> SignBlob(
+      SigningAccount const& service_account,
+      std::string const& string_to_sign) const override;
+  std::string AccountEmail() const override;
+  std::string KeyId() const override;
+
+ private:
+  struct CachedHeader {
+    std::string header;
+    std::chrono::steady_clock::time_point fetched;
+  };
+
+  /// Fetch the header from the wrapped credentials and update the cache.
+  StatusOr<std::string> Refresh();
+  void RefreshLoop();
+
+  std::shared_ptr<Credentials> credentials_;
+  std::chrono::milliseconds const refresh_period_;
+  std::chrono::milliseconds const max_staleness_;
+  // Only accessed using `std::atomic_load()` and `std::atomic_store()`.
+  std::shared_ptr<CachedHeader const> cached_;
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  bool shutdown_ = false;  // GUARDED_BY(mu_)
+  std::thread refresher_;
+};
+
+/**
+ * Wrap @p credentials to refresh their access tokens in the background.
+ *
+ * @see `BackgroundRefreshingCredentials` for details.
+ */
+std::shared_ptr<Credentials> CreateBackgroundRefreshingCredentials(
+    std::shared_ptr<Credentials> credentials);
+
+}  // namespace oauth2
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OAUTH2_BACKGROUND_REFRESHING_CREDENTIALS_H
@@ -0,0 +1,144 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/oauth2/background_refreshing_credentials.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <condition_variable>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace oauth2 {
+namespace {
+
+using ::testing::HasSubstr;
+using ms = std::chrono::milliseconds;
+
+/// Returns "Authorization: Bearer token-<N>", N is the number of calls.
+class CountingCredentials : public Credentials {
+ public:
+  StatusOr<std::string> AuthorizationHeader() override {
+    std::unique_lock<std::mutex> lk(mu_);
+    ++calls_;
+    cv_.notify_all();
+    if (fail_) {
+      return Status(StatusCode::kUnavailable, "token endpoint unavailable");
+    }
+    return "Authorization: Bearer token-" + std::to_string(calls_);
+  }
+
+  std::string AccountEmail() const override { return "test@example.com"; }
+  std::string KeyId() const override { return "test-key-id"; }
+
+  int calls() {
+    std::lock_guard<std::mutex> lk(mu_);
+    return calls_;
+  }
+
+  void WaitForCalls(int n) {
+    std::unique_lock<std::mutex> lk(mu_);
+    cv_.wait(lk, [&] { return calls_ >= n; });
+  }
+
+  void set_fail(bool fail) {
+    std::lock_guard<std::mutex> lk(mu_);
+    fail_ = fail;
+  }
+
+ private:
+  std::mutex mu_;
+  std::condition_variable cv_;
+  int calls_ = 0;
+  bool fail_ = false;
+};
+
+/// @test Verify the header is fetched in the background and then cached.
+TEST(BackgroundRefreshingCredentialsTest, ServesCachedHeader) {
+  auto mock = std::make_shared<CountingCredentials>();
+  BackgroundRefreshingCredentials tested(mock, std::chrono::hours(1),
+                                         std::chrono::hours(1));
+  mock->WaitForCalls(1);
+  // Depending on timing, the first call may need to wait for the initial
+  // token, after that the header is served from the cache.
+  auto first = tested.AuthorizationHeader();
+  ASSERT_STATUS_OK(first);
+  auto const expected = tested.AuthorizationHeader();
+  ASSERT_STATUS_OK(expected);
+  auto const calls = mock->calls();
+  for (int i = 0; i != 10; ++i) {
+    auto header = tested.AuthorizationHeader();
+    ASSERT_STATUS_OK(header);
+    EXPECT_EQ(*expected, *header);
+  }
+  EXPECT_EQ(calls, mock->calls());
+  EXPECT_LE(calls, 2);
+}
+
+/// @test Verify the cached header is periodically refreshed.
+TEST(BackgroundRefreshingCredentialsTest, RefreshesPeriodically) {
+  auto mock = std::make_shared<CountingCredentials>();
+  BackgroundRefreshingCredentials tested(mock, ms(1), std::chrono::hours(1));
+  mock->WaitForCalls(3);
+  // Once the background thread has refreshed the credentials the new header
+  // is returned, without calling the wrapped credentials.
+  auto header = tested.AuthorizationHeader();
+  ASSERT_STATUS_OK(header);
+  EXPECT_THAT(*header, HasSubstr("Authorization: Bearer token-"));
+  EXPECT_NE("Authorization: Bearer token-1", *header);
+}
+
+/// @test Verify stale headers are refreshed synchronously.
+TEST(BackgroundRefreshingCredentialsTest, StaleHeaderRefreshedInline) {
+  auto mock = std::make_shared<CountingCredentials>();
+  BackgroundRefreshingCredentials tested(mock, std::chrono::hours(1), ms(0));
+  mock->WaitForCalls(1);
+  auto header = tested.AuthorizationHeader();
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("Authorization: Bearer token-2", *header);
+  EXPECT_EQ(2, mock->calls());
+}
+
+/// @test Verify errors are reported once the cached header is stale.
+TEST(BackgroundRefreshingCredentialsTest, ErrorWhenStale) {
+  auto mock = std::make_shared<CountingCredentials>();
+  mock->set_fail(true);
+  BackgroundRefreshingCredentials tested(mock, std::chrono::hours(1),
+                                         std::chrono::hours(1));
+  mock->WaitForCalls(1);
+  // Nothing is cached, the error from the wrapped credentials is returned.
+  auto header = tested.AuthorizationHeader();
+  EXPECT_EQ(StatusCode::kUnavailable, header.status().code());
+
+  mock->set_fail(false);
+  header = tested.AuthorizationHeader();
+  ASSERT_STATUS_OK(header);
+  EXPECT_EQ("Authorization: Bearer token-3", *header);
+}
+
+/// @test Verify the other member functions are forwarded.
+TEST(BackgroundRefreshingCredentialsTest, Forwarding) {
+  auto mock = std::make_shared<CountingCredentials>();
+  auto tested = CreateBackgroundRefreshingCredentials(mock);
+  EXPECT_EQ("test@example.com", tested->AccountEmail());
+  EXPECT_EQ("test-key-id", tested->KeyId());
+}
+
+}  // namespace
+}  // namespace oauth2
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
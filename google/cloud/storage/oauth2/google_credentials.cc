@@ -253,6 +253,20 @@ CreateServiceAccountCredentialsFromJsonFilePath(
       std::make_shared<ServiceAccountCredentials<>>(*info, options));
 }
 
+StatusOr<std::shared_ptr<Credentials>>
+CreateServiceAccountSelfSignedJWTCredentialsFromJsonFilePath(
+    std::string const& path, std::string audience) {
+  std::ifstream is(path);
+  std::string contents(std::istreambuf_iterator<char>{is}, {});
+  auto info = ParseServiceAccountCredentials(contents, path);
+  if (!info) {
+    return StatusOr<std::shared_ptr<Credentials>>(info.status());
+  }
+  info->self_signed_jwt_audience = std::move(audience);
+  return StatusOr<std::shared_ptr<Credentials>>(
+      std::make_shared<ServiceAccountCredentials<>>(*info));
+}
+
 StatusOr<std::shared_ptr<Credentials>>
 CreateServiceAccountCredentialsFromP12FilePath(
     std::string const& path,
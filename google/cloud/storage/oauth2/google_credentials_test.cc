@@ -324,6 +324,25 @@ TEST_F(GoogleCredentialsTest,
   EXPECT_EQ(typeid(*ptr), typeid(ServiceAccountCredentials<>));
 }
 
+TEST_F(GoogleCredentialsTest, LoadSelfSignedJWTCredentialsFromFilename) {
+  std::string filename = ::testing::TempDir() + SERVICE_ACCOUNT_CRED_FILENAME;
+  SetupServiceAccountCredentialsFileForTest(filename);
+
+  auto creds = CreateServiceAccountSelfSignedJWTCredentialsFromJsonFilePath(
+      filename);
+  ASSERT_STATUS_OK(creds);
+  auto* ptr = creds->get();
+  EXPECT_EQ(typeid(*ptr), typeid(ServiceAccountCredentials<>));
+  // The header is created locally, without contacting the token endpoint.
+  auto header = (*creds)->AuthorizationHeader();
+  ASSERT_STATUS_OK(header);
+  EXPECT_THAT(*header, ::testing::StartsWith("Authorization: Bearer "));
+
+  creds = CreateServiceAccountSelfSignedJWTCredentialsFromJsonFilePath(
+      ::testing::TempDir() + "does-not-exist.json");
+  EXPECT_FALSE(creds);
+}
+
 TEST_F(GoogleCredentialsTest,
        LoadInvalidServiceAccountCredentialsFromFilename) {
   std::string filename = ::testing::TempDir() + "invalid-credentials.json";
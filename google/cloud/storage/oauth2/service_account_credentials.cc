@@ -74,7 +74,8 @@ StatusOr<ServiceAccountCredentialsInfo> ParseServiceAccountCredentials(
       // the default value.
       credentials.value(token_uri_key, default_token_uri),
       /*scopes*/ {},
-      /*subject*/ {}};
+      /*subject*/ {},
+      /*self_signed_jwt_audience*/ {}};
 }
 
 StatusOr<ServiceAccountCredentialsInfo> ParseServiceAccountP12File(
@@ -181,7 +182,8 @@ StatusOr<ServiceAccountCredentialsInfo> ParseServiceAccountP12File(
                                        std::move(private_key),
                                        default_token_uri,
                                        /*scopes*/ {},
-                                       /*subject*/ {}};
+                                       /*subject*/ {},
+                                       /*self_signed_jwt_audience*/ {}};
 }
 
 std::pair<std::string, std::string> AssertionComponentsFromInfo(
@@ -237,6 +239,48 @@ std::string MakeJWTAssertion(std::string const& header,
   return encoded_header + '.' + encoded_payload + '.' + encoded_signature;
 }
 
+std::pair<std::string, std::string> SelfSignedJWTComponentsFromInfo(
+    ServiceAccountCredentialsInfo const& info,
+    std::chrono::system_clock::time_point now) {
+  storage::internal::nl::json jwt_header = {
+      {"alg", "RS256"}, {"kid", info.private_key_id}, {"typ", "JWT"}};
+
+  auto expiration = now + GoogleOAuthAccessTokenLifetime();
+  auto const now_from_epoch =
+      static_cast<std::intmax_t>(std::chrono::system_clock::to_time_t(now));
+  auto const expiration_from_epoch = static_cast<std::intmax_t>(
+      std::chrono::system_clock::to_time_t(expiration));
+  storage::internal::nl::json jwt_payload = {
+      {"iss", info.client_email},
+      {"sub", info.client_email},
+      {"aud", info.self_signed_jwt_audience.value_or("")},
+      {"iat", now_from_epoch},
+      {"exp", expiration_from_epoch}};
+
+  return std::make_pair(jwt_header.dump(), jwt_payload.dump());
+}
+
+StatusOr<RefreshingCredentialsWrapper::TemporaryToken>
+CreateServiceAccountSelfSignedJWT(ServiceAccountCredentialsInfo const& info,
+                                  std::chrono::system_clock::time_point now) {
+  if (info.subject) {
+    return Status(StatusCode::kInvalidArgument,
+                  "self-signed JWTs do not support domain-wide delegation,"
+                  " the subject must not be set");
+  }
+  if (!info.self_signed_jwt_audience ||
+      info.self_signed_jwt_audience->empty()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "self-signed JWTs require a non-empty audience");
+  }
+  auto components = SelfSignedJWTComponentsFromInfo(info, now);
+  return RefreshingCredentialsWrapper::TemporaryToken{
+      "Authorization: Bearer " + MakeJWTAssertion(components.first,
+                                                  components.second,
+                                                  info.private_key),
+      now + GoogleOAuthAccessTokenLifetime()};
+}
+
 std::string CreateServiceAccountRefreshPayload(
     ServiceAccountCredentialsInfo const& info, std::string const& grant_type,
     std::chrono::system_clock::time_point now) {
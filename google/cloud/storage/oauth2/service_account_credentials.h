@@ -26,6 +26,7 @@
 #include <condition_variable>
 #include <ctime>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <set>
 
@@ -44,6 +45,10 @@ struct ServiceAccountCredentialsInfo {
   google::cloud::optional<std::set<std::string>> scopes;
   // See https://developers.google.com/identity/protocols/OAuth2ServiceAccount.
   google::cloud::optional<std::string> subject;
+  // If set, use self-signed JWTs for this audience (typically the service
+  // endpoint, e.g. "https://storage.googleapis.com/") instead of exchanging
+  // the JWT for an access token.
+  google::cloud::optional<std::string> self_signed_jwt_audience;
 };
 
 /// Parses the contents of a JSON keyfile into a ServiceAccountCredentialsInfo.
@@ -93,6 +98,28 @@ std::string MakeJWTAssertion(std::string const& header,
                              std::string const& payload,
                              std::string const& pem_contents);
 
+/**
+ * Splits a ServiceAccountCredentialsInfo into header and payload components
+ * for a self-signed JWT, using the current time and
+ * `info.self_signed_jwt_audience`.
+ *
+ * @see https://google.aip.dev/auth/4111
+ */
+std::pair<std::string, std::string> SelfSignedJWTComponentsFromInfo(
+    ServiceAccountCredentialsInfo const& info,
+    std::chrono::system_clock::time_point now);
+
+/**
+ * Creates a self-signed JWT and returns it as a temporary token.
+ *
+ * Self-signed JWTs are accepted directly by Google Cloud services, they do not
+ * need to be exchanged for an access token at the token endpoint. They do not
+ * support domain-wide delegation, it is an error if `info.subject` is set.
+ */
+StatusOr<RefreshingCredentialsWrapper::TemporaryToken>
+CreateServiceAccountSelfSignedJWT(ServiceAccountCredentialsInfo const& info,
+                                  std::chrono::system_clock::time_point now);
+
 /// Uses a ServiceAccountCredentialsInfo and the current time to construct a
 /// JWT assertion. The assertion combined with the grant type is used to create
 /// the refresh payload.
@@ -112,6 +139,10 @@ std::string CreateServiceAccountRefreshPayload(
  * can be obtained by calling the AuthorizationHeader() method; if the current
  * access token is invalid or nearing expiration, this will class will first
  * obtain a new access token before returning the Authorization header string.
+ *
+ * If `info.self_signed_jwt_audience` is set the class mints self-signed JWTs
+ * locally instead, and re-signs them before they expire. This avoids any
+ * requests to the token endpoint.
 
  * @see https://developers.google.com/identity/protocols/OAuth2ServiceAccount
  * for an overview of using service accounts with Google's OAuth 2.0 system.
@@ -149,6 +180,13 @@ class ServiceAccountCredentials : public Credentials {
             .get();
     grant_type_ = std::move(grant_type);
     request_ = request_builder.BuildRequest();
+    // Parse the key once, signing many blobs (e.g. to create signed URLs) is
+    // much faster with the cached key. If the key cannot be parsed `SignBlob()`
+    // reports the error.
+    auto signer = internal::PemSigner::Create(info_.private_key);
+    if (signer) {
+      signer_ = *std::move(signer);
+    }
   }
 
   StatusOr<std::string> AuthorizationHeader() override {
@@ -177,6 +215,9 @@ class ServiceAccountCredentials : public Credentials {
                     "The current_credentials cannot sign blobs for " +
                         signing_account.value());
     }
+    if (signer_) {
+      return signer_->Sign(blob);
+    }
     return internal::SignStringWithPem(blob, info_.private_key,
                                        JwtSigningAlgorithms::RS256);
   }
@@ -186,6 +227,9 @@ class ServiceAccountCredentials : public Credentials {
 
  private:
   StatusOr<RefreshingCredentialsWrapper::TemporaryToken> Refresh() {
+    if (info_.self_signed_jwt_audience) {
+      return CreateServiceAccountSelfSignedJWT(info_, clock_.now());
+    }
     auto payload =
         CreateServiceAccountRefreshPayload(info_, grant_type_, clock_.now());
 
@@ -203,6 +247,7 @@ class ServiceAccountCredentials : public Credentials {
   typename HttpRequestBuilderType::RequestType request_;
   std::string grant_type_;
   ServiceAccountCredentialsInfo info_;
+  std::unique_ptr<internal::PemSigner> signer_;
   mutable std::mutex mu_;
   RefreshingCredentialsWrapper refreshing_creds_;
   ClockType clock_;
@@ -438,6 +438,112 @@ TEST_F(ServiceAccountCredentialsTest, RefreshingUpdatesTimestamps) {
             *authorization_header);
 }
 
+/// Decode the payload of a JWT in an `Authorization: Bearer` header.
+internal::nl::json DecodeBearerJWTPayload(std::string const& header) {
+  std::string const prefix = "Authorization: Bearer ";
+  EXPECT_THAT(header, StartsWith(prefix));
+  std::istringstream is(header.substr(prefix.size()));
+  std::string encoded_header;
+  std::getline(is, encoded_header, '.');
+  std::string encoded_payload;
+  std::getline(is, encoded_payload, '.');
+  auto payload_bytes = internal::UrlsafeBase64Decode(encoded_payload);
+  return internal::nl::json::parse(
+      std::string{payload_bytes.begin(), payload_bytes.end()});
+}
+
+/// @test Verify self-signed JWT credentials never use the token endpoint.
+TEST_F(ServiceAccountCredentialsTest, SelfSignedJWT) {
+  auto info = ParseServiceAccountCredentials(kJsonKeyfileContents, "test");
+  ASSERT_STATUS_OK(info);
+  info->self_signed_jwt_audience = "https://storage.googleapis.com/";
+
+  auto mock_request = std::make_shared<MockHttpRequest::Impl>();
+  EXPECT_CALL(*mock_request, MakeRequest(_)).Times(0);
+  auto mock_builder = MockHttpRequestBuilder::mock;
+  EXPECT_CALL(*mock_builder, BuildRequest()).WillOnce(Invoke([mock_request] {
+    MockHttpRequest result;
+    result.mock = mock_request;
+    return result;
+  }));
+  EXPECT_CALL(*mock_builder, AddHeader(_)).Times(1);
+  EXPECT_CALL(*mock_builder, Constructor(GoogleOAuthRefreshEndpoint()))
+      .Times(1);
+  EXPECT_CALL(*mock_builder, MakeEscapedString(An<std::string const&>()))
+      .WillRepeatedly(Invoke([](std::string const& s) {
+        auto t = std::unique_ptr<char[]>(new char[s.size() + 1]);
+        std::copy(s.c_str(), s.c_str() + s.size() + 1, t.get());
+        return t;
+      }));
+
+  auto const clock_value_1 = 10000;
+  auto const clock_value_2 = 20000;
+  FakeClock::now_value = clock_value_1;
+  ServiceAccountCredentials<MockHttpRequestBuilder, FakeClock> credentials(
+      *info);
+  auto header = credentials.AuthorizationHeader();
+  ASSERT_STATUS_OK(header);
+  auto payload = DecodeBearerJWTPayload(*header);
+  EXPECT_EQ(clock_value_1, payload.value("iat", 0));
+  EXPECT_EQ(clock_value_1 + 3600, payload.value("exp", 0));
+  EXPECT_EQ("https://storage.googleapis.com/", payload.value("aud", ""));
+
+  // The JWT is cached until it is about to expire.
+  FakeClock::now_value = clock_value_1 + 60;
+  auto cached = credentials.AuthorizationHeader();
+  ASSERT_STATUS_OK(cached);
+  EXPECT_EQ(*header, *cached);
+
+  // Then a new one is signed.
+  FakeClock::now_value = clock_value_2;
+  header = credentials.AuthorizationHeader();
+  ASSERT_STATUS_OK(header);
+  payload = DecodeBearerJWTPayload(*header);
+  EXPECT_EQ(clock_value_2, payload.value("iat", 0));
+}
+
+/// @test Verify the components of a self-signed JWT.
+TEST_F(ServiceAccountCredentialsTest, SelfSignedJWTComponentsFromInfo) {
+  auto info = ParseServiceAccountCredentials(kJsonKeyfileContents, "test");
+  ASSERT_STATUS_OK(info);
+  info->self_signed_jwt_audience = "https://storage.googleapis.com/";
+  auto const clock_value_1 = 10000;
+  FakeClock::now_value = clock_value_1;
+  auto components = SelfSignedJWTComponentsFromInfo(*info, FakeClock::now());
+
+  auto header = internal::nl::json::parse(components.first);
+  EXPECT_EQ("RS256", header.value("alg", ""));
+  EXPECT_EQ("JWT", header.value("typ", ""));
+  EXPECT_EQ(info->private_key_id, header.value("kid", ""));
+
+  auto payload = internal::nl::json::parse(components.second);
+  EXPECT_EQ(clock_value_1, payload.value("iat", 0));
+  EXPECT_EQ(clock_value_1 + 3600, payload.value("exp", 0));
+  EXPECT_EQ(info->client_email, payload.value("iss", ""));
+  EXPECT_EQ(info->client_email, payload.value("sub", ""));
+  EXPECT_EQ("https://storage.googleapis.com/", payload.value("aud", ""));
+  EXPECT_EQ(0, payload.count("scope"));
+}
+
+/// @test Verify self-signed JWTs reject invalid configurations.
+TEST_F(ServiceAccountCredentialsTest, SelfSignedJWTInvalid) {
+  auto info = ParseServiceAccountCredentials(kJsonKeyfileContents, "test");
+  ASSERT_STATUS_OK(info);
+  auto token = CreateServiceAccountSelfSignedJWT(*info, FakeClock::now());
+  EXPECT_EQ(StatusCode::kInvalidArgument, token.status().code());
+
+  info->self_signed_jwt_audience = "https://storage.googleapis.com/";
+  info->subject = std::string(kSubjectForGrant);
+  token = CreateServiceAccountSelfSignedJWT(*info, FakeClock::now());
+  EXPECT_EQ(StatusCode::kInvalidArgument, token.status().code());
+
+  info->subject = {};
+  token = CreateServiceAccountSelfSignedJWT(*info, FakeClock::now());
+  ASSERT_STATUS_OK(token);
+  EXPECT_EQ(FakeClock::now() + GoogleOAuthAccessTokenLifetime(),
+            token->expiration_time);
+}
+
 /// @test Verify that we can create sign blobs using a service account.
 TEST_F(ServiceAccountCredentialsTest, SignBlob) {
   auto mock_builder = MockHttpRequestBuilder::mock;
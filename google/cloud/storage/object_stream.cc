@@ -45,6 +45,25 @@ ObjectReadStream::~ObjectReadStream() {
 #endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
 }
 
+std::streamsize ObjectReadStream::ReadSome(char* buffer,
+                                           std::streamsize count) {
+  if (!buf_) {
+    setstate(std::ios_base::badbit);
+    return 0;
+  }
+  // Let `std::istream::read()` manage the sentry, the state bits and any
+  // exceptions, the streambuf returns after the first block of data.
+  buf_->set_short_reads(true);
+  read(buffer, count);
+  buf_->set_short_reads(false);
+  auto const n = gcount();
+  // A short read is not a failure, as long as some data was received.
+  if (n != 0 && !bad()) {
+    clear(rdstate() & ~(std::ios_base::failbit | std::ios_base::eofbit));
+  }
+  return n;
+}
+
 void ObjectReadStream::Close() {
   if (!IsOpen()) {
     return;
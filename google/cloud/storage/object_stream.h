@@ -98,6 +98,21 @@ class ObjectReadStream : public std::basic_istream<char> {
 
   bool IsOpen() const { return (bool)buf_ && buf_->IsOpen(); }
 
+  /**
+   * Read up to @p count bytes into @p buffer.
+   *
+   * Unlike `read()`, this function returns as soon as some data is available,
+   * without waiting for all @p count bytes. The data is copied from the
+   * underlying transport directly into @p buffer, so applications reading
+   * large objects at high throughput can avoid any intermediate copies.
+   *
+   * @return the number of bytes read, also available via `gcount()`. A zero
+   *     value indicates that the download completed, or that there was an
+   *     error. In either case `eof()` is set, use `status()` to find out if
+   *     the download was successful.
+   */
+  std::streamsize ReadSome(char* buffer, std::streamsize count);
+
   /**
    * Terminate the download, possibly before completing it.
    */
@@ -14,8 +14,11 @@
 
 #include "google/cloud/storage/object_stream.h"
 #include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/testing/mock_client.h"
 #include "google/cloud/internal/make_unique.h"
+#include "google/cloud/testing_util/assert_ok.h"
 #include <gmock/gmock.h>
+#include <algorithm>
 
 namespace google {
 namespace cloud {
@@ -23,6 +26,8 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 namespace {
 
+using ::testing::Invoke;
+
 ObjectReadStream CreateReader() {
   using google::cloud::internal::make_unique;
   std::shared_ptr<internal::RawClient> client;
@@ -81,6 +86,46 @@ TEST(ObjectStream, ReadMoveAssignment) {
   EXPECT_NE(nullptr, copy.rdbuf());
 }
 
+TEST(ObjectStream, ReadSome) {
+  using google::cloud::internal::make_unique;
+  std::string const payload = "0123456789abcdefghijklmnopqrstuvwxyz";
+  std::size_t offset = 0;
+  auto mock = make_unique<testing::MockObjectReadSource>();
+  EXPECT_CALL(*mock, IsOpen).WillRepeatedly(Invoke([&] {
+    return offset < payload.size();
+  }));
+  EXPECT_CALL(*mock, Read)
+      .WillRepeatedly(Invoke([&](char* buf, std::size_t n) {
+        auto const count =
+            (std::min)({n, std::size_t(16), payload.size() - offset});
+        std::copy(payload.begin() + offset, payload.begin() + offset + count,
+                  buf);
+        offset += count;
+        auto const code = offset < payload.size()
+                              ? internal::HttpStatusCode::kContinue
+                              : internal::HttpStatusCode::kOk;
+        return make_status_or(internal::ReadSourceResult{
+            count, internal::HttpResponse{code, {}, {}}});
+      }));
+  internal::ReadObjectRangeRequest request("test-bucket", "test-object");
+  ObjectReadStream reader(
+      make_unique<internal::ObjectReadStreambuf>(request, std::move(mock)));
+
+  std::string actual;
+  char buffer[32];
+  for (auto n = reader.ReadSome(buffer, sizeof(buffer)); n != 0;
+       n = reader.ReadSome(buffer, sizeof(buffer))) {
+    EXPECT_LE(n, 16);
+    EXPECT_TRUE(reader.good());
+    EXPECT_EQ(n, reader.gcount());
+    actual.append(buffer, static_cast<std::size_t>(n));
+  }
+  EXPECT_EQ(payload, actual);
+  EXPECT_TRUE(reader.eof());
+  EXPECT_FALSE(reader.bad());
+  EXPECT_STATUS_OK(reader.status());
+}
+
 TEST(ObjectStream, WriteMoveConstructor) {
   ObjectWriteStream writer = CreateWriter();
   EXPECT_EQ(StatusCode::kNotFound, writer.metadata().status().code());
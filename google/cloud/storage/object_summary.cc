@@ -0,0 +1,58 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/object_summary.h"
+#include <iostream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+std::ostream& operator<<(std::ostream& os, ObjectSummary const& rhs) {
+  return os << "ObjectSummary={name=" << rhs.name
+            << ", generation=" << rhs.generation << ", size=" << rhs.size
+            << ", crc32c=" << rhs.crc32c << "}";
+}
+
+namespace internal {
+ObjectSummary MakeObjectSummary(ObjectMetadata const& meta) {
+  ObjectSummary result;
+  result.name = meta.name();
+  result.generation = meta.generation();
+  result.size = meta.size();
+  result.crc32c = meta.crc32c();
+  return result;
+}
+
+StatusOr<ListObjectSummariesResponse> ListObjectSummaries(
+    RawClient& client, ListObjectsRequest const& request) {
+  auto response = client.ListObjects(request);
+  if (!response) {
+    return std::move(response).status();
+  }
+  ListObjectSummariesResponse result;
+  result.next_page_token = std::move(response->next_page_token);
+  result.prefixes = std::move(response->prefixes);
+  result.items.reserve(response->items.size());
+  for (auto const& meta : response->items) {
+    result.items.push_back(MakeObjectSummary(meta));
+  }
+  return result;
+}
+}  // namespace internal
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
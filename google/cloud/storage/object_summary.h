@@ -0,0 +1,88 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_SUMMARY_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_SUMMARY_H
+
+#include "google/cloud/storage/internal/object_requests.h"
+#include "google/cloud/storage/internal/raw_client.h"
+#include "google/cloud/storage/object_metadata.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * A compact representation of an object, returned by
+ * `Client::ListObjectSummaries()`.
+ *
+ * `ObjectMetadata` contains all the attributes of an object, including ACLs,
+ * custom metadata, and many strings. Applications that keep the results of
+ * large listings in memory (e.g. to compare the contents of two buckets) only
+ * need a few attributes, and this type requires a fraction of the memory. Note
+ * that `crc32c`, a short Base64-encoded string, does not require an additional
+ * allocation with most C++ standard libraries.
+ */
+struct ObjectSummary {
+  std::string name;
+  std::int64_t generation = 0;
+  std::uint64_t size = 0;
+  std::string crc32c;
+};
+
+inline bool operator==(ObjectSummary const& lhs, ObjectSummary const& rhs) {
+  return std::tie(lhs.name, lhs.generation, lhs.size, lhs.crc32c) ==
+         std::tie(rhs.name, rhs.generation, rhs.size, rhs.crc32c);
+}
+
+inline bool operator!=(ObjectSummary const& lhs, ObjectSummary const& rhs) {
+  return std::rel_ops::operator!=(lhs, rhs);
+}
+
+std::ostream& operator<<(std::ostream& os, ObjectSummary const& rhs);
+
+namespace internal {
+/// The `fields` projection with the attributes in `ObjectSummary`.
+constexpr char kObjectSummaryFields[] =
+    "items(name,generation,size,crc32c),prefixes,nextPageToken";
+
+/// Create the summary for @p meta.
+ObjectSummary MakeObjectSummary(ObjectMetadata const& meta);
+
+/// A page of results for `Client::ListObjectSummaries()`.
+struct ListObjectSummariesResponse {
+  std::string next_page_token;
+  std::vector<ObjectSummary> items;
+  std::vector<std::string> prefixes;
+};
+
+/// Fetch a page of `ObjectSummary` objects using @p client.
+StatusOr<ListObjectSummariesResponse> ListObjectSummaries(
+    RawClient& client, ListObjectsRequest const& request);
+}  // namespace internal
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_OBJECT_SUMMARY_H
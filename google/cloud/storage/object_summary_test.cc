@@ -0,0 +1,174 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/object_summary.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <sstream>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using ::google::cloud::storage::internal::ListObjectsRequest;
+using ::google::cloud::storage::internal::ListObjectsResponse;
+using ::google::cloud::storage::testing::MockClient;
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::ReturnRef;
+
+ObjectMetadata CreateObject(int index) {
+  std::string const name = "object-" + std::to_string(index);
+  return internal::ObjectMetadataParser::FromJson(
+             internal::nl::json{
+                 {"bucket", "test-bucket"},
+                 {"name", name},
+                 {"generation", 1000 + index},
+                 {"size", 10 * index},
+                 {"crc32c", "AAAAAA=="},
+                 {"metadata", {{"key", "value"}}},
+                 {"contentType", "text/plain"},
+             })
+      .value();
+}
+
+ObjectSummary CreateSummary(int index) {
+  ObjectSummary result;
+  result.name = "object-" + std::to_string(index);
+  result.generation = 1000 + index;
+  result.size = 10 * index;
+  result.crc32c = "AAAAAA==";
+  return result;
+}
+
+TEST(ObjectSummaryTest, MakeObjectSummary) {
+  EXPECT_EQ(CreateSummary(3), internal::MakeObjectSummary(CreateObject(3)));
+  EXPECT_NE(CreateSummary(3), internal::MakeObjectSummary(CreateObject(4)));
+}
+
+TEST(ObjectSummaryTest, IOStream) {
+  std::ostringstream os;
+  os << CreateSummary(1);
+  auto actual = os.str();
+  EXPECT_THAT(actual, HasSubstr("name=object-1"));
+  EXPECT_THAT(actual, HasSubstr("generation=1001"));
+  EXPECT_THAT(actual, HasSubstr("size=10"));
+  EXPECT_THAT(actual, HasSubstr("crc32c=AAAAAA=="));
+}
+
+TEST(ObjectSummaryTest, ListObjectSummariesPage) {
+  MockClient mock;
+  EXPECT_CALL(mock, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const& r) {
+        EXPECT_EQ("test-bucket", r.bucket_name());
+        ListObjectsResponse response;
+        response.next_page_token = "next-page";
+        response.items = {CreateObject(0), CreateObject(1)};
+        response.prefixes = {"p/"};
+        return make_status_or(response);
+      }))
+      .WillOnce(Return(StatusOr<ListObjectsResponse>(PermanentError())));
+
+  auto actual =
+      internal::ListObjectSummaries(mock, ListObjectsRequest("test-bucket"));
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("next-page", actual->next_page_token);
+  EXPECT_THAT(actual->items, ElementsAre(CreateSummary(0), CreateSummary(1)));
+  EXPECT_THAT(actual->prefixes, ElementsAre("p/"));
+
+  actual =
+      internal::ListObjectSummaries(mock, ListObjectsRequest("test-bucket"));
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+}
+
+class ListObjectSummariesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock_ = std::make_shared<MockClient>();
+    EXPECT_CALL(*mock_, client_options())
+        .WillRepeatedly(ReturnRef(client_options_));
+    client_.reset(new Client{
+        std::shared_ptr<internal::RawClient>(mock_),
+        LimitedErrorCountRetryPolicy(2),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+
+  std::shared_ptr<MockClient> mock_;
+  std::unique_ptr<Client> client_;
+  ClientOptions client_options_ =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+TEST_F(ListObjectSummariesTest, Basic) {
+  EXPECT_CALL(*mock_, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const& r) {
+        EXPECT_EQ(internal::kObjectSummaryFields,
+                  r.GetOption<Fields>().value());
+        EXPECT_EQ("", r.page_token());
+        ListObjectsResponse response;
+        response.next_page_token = "page-1";
+        response.items = {CreateObject(0), CreateObject(1)};
+        return make_status_or(response);
+      }))
+      .WillOnce(Invoke([](ListObjectsRequest const& r) {
+        EXPECT_EQ("page-1", r.page_token());
+        ListObjectsResponse response;
+        response.items = {CreateObject(2)};
+        return make_status_or(response);
+      }));
+
+  std::vector<ObjectSummary> actual;
+  for (auto& s : client_->ListObjectSummaries("test-bucket")) {
+    ASSERT_STATUS_OK(s);
+    actual.push_back(*std::move(s));
+  }
+  EXPECT_THAT(actual, ElementsAre(CreateSummary(0), CreateSummary(1),
+                                  CreateSummary(2)));
+}
+
+TEST_F(ListObjectSummariesTest, ApplicationFields) {
+  EXPECT_CALL(*mock_, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const& r) {
+        EXPECT_EQ("items(name)", r.GetOption<Fields>().value());
+        EXPECT_EQ("test-prefix/", r.GetOption<Prefix>().value());
+        ListObjectsResponse response;
+        response.items = {CreateObject(0)};
+        return make_status_or(response);
+      }));
+
+  auto reader = client_->ListObjectSummaries(
+      "test-bucket", Fields("items(name)"), Prefix("test-prefix/"));
+  std::vector<StatusOr<ObjectSummary>> actual(reader.begin(), reader.end());
+  ASSERT_EQ(1, actual.size());
+  ASSERT_STATUS_OK(actual[0]);
+  EXPECT_EQ(CreateSummary(0), *actual[0]);
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,545 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_download.h"
+#include "google/cloud/storage/internal/crc32c_combine.h"
+#include "google/cloud/storage/internal/nljson.h"
+#include "google/cloud/storage/internal/object_streambuf.h"
+#include "google/cloud/internal/filesystem.h"
+#include "google/cloud/internal/make_unique.h"
+#include <crc32c/crc32c.h>
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+StatusOr<ParallelDownloadPersistentState> LoadState(
+    std::string const& state_file_name) {
+  std::ifstream is(state_file_name, std::ios::binary);
+  if (!is.is_open()) {
+    return Status(StatusCode::kNotFound,
+                  "cannot open parallel download state file " +
+                      state_file_name);
+  }
+  std::string contents{std::istreambuf_iterator<char>{is},
+                       std::istreambuf_iterator<char>{}};
+  return ParallelDownloadPersistentState::FromString(contents);
+}
+
+Status SaveState(std::string const& state_file_name,
+                 ParallelDownloadPersistentState const& state) {
+  std::ofstream os(state_file_name, std::ios::binary | std::ios::trunc);
+  os << state.ToString();
+  os.close();
+  if (!os.good()) {
+    return Status(StatusCode::kUnknown,
+                  "cannot write parallel download state file " +
+                      state_file_name);
+  }
+  return Status();
+}
+
+ParallelDownloadPersistentState CreateState(
+    ObjectMetadata const& metadata,
+    std::vector<std::uintmax_t> const& split_points) {
+  ParallelDownloadPersistentState state;
+  state.bucket_name = metadata.bucket();
+  state.object_name = metadata.name();
+  state.generation = metadata.generation();
+  state.object_size = static_cast<std::int64_t>(metadata.size());
+  std::int64_t offset = 0;
+  auto add_slice = [&state, &offset](std::int64_t end) {
+    if (end <= offset) return;
+    state.slices.push_back(
+        ParallelDownloadPersistentState::Slice{offset, end - offset, 0, false});
+    offset = end;
+  };
+  for (auto p : split_points) {
+    add_slice(static_cast<std::int64_t>(p));
+  }
+  add_slice(state.object_size);
+  return state;
+}
+
+bool IsCompatible(ParallelDownloadPersistentState const& state,
+                  ObjectMetadata const& metadata,
+                  std::string const& file_name) {
+  if (state.bucket_name != metadata.bucket() ||
+      state.object_name != metadata.name() ||
+      state.generation != metadata.generation() ||
+      state.object_size != static_cast<std::int64_t>(metadata.size())) {
+    return false;
+  }
+  std::error_code ec;
+  auto const file_size = google::cloud::internal::file_size(file_name, ec);
+  return !ec && file_size == metadata.size();
+}
+
+Status CreateDestination(std::string const& file_name,
+                         std::int64_t object_size) {
+  std::ofstream os(file_name, std::ios::binary | std::ios::trunc);
+  if (!os.is_open()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "cannot open download destination file " + file_name);
+  }
+  // Extend the file to its final size, so each slice can be written into its
+  // final position.
+  if (object_size > 0) {
+    os.seekp(object_size - 1);
+    os.put('\0');
+  }
+  os.close();
+  if (!os.good()) {
+    return Status(StatusCode::kUnknown,
+                  "cannot preallocate download destination file " + file_name);
+  }
+  return Status();
+}
+
+StatusOr<std::uint32_t> DownloadSlice(
+    ParallelDownloadPersistentState::Slice const& slice,
+    std::int64_t generation, std::string const& file_name,
+    std::size_t buffer_size, ParallelDownloadSliceReader const& reader) {
+  std::fstream os(file_name, std::ios::binary | std::ios::in | std::ios::out);
+  if (!os.is_open()) {
+    return Status(StatusCode::kInvalidArgument,
+                  "cannot open download destination file " + file_name);
+  }
+  os.seekp(slice.offset);
+
+  auto stream = reader(slice.offset, slice.offset + slice.size, generation);
+  if (!stream.status().ok()) {
+    return stream.status();
+  }
+
+  std::vector<char> buffer(buffer_size);
+  std::uint32_t crc = 0;
+  std::int64_t received = 0;
+  do {
+    stream.read(buffer.data(), buffer.size());
+    auto const n = stream.gcount();
+    crc = crc32c::Extend(crc, reinterpret_cast<std::uint8_t*>(buffer.data()),
+                         static_cast<std::size_t>(n));
+    os.write(buffer.data(), n);
+    received += n;
+  } while (os.good() && stream.good());
+  os.close();
+  if (!os.good()) {
+    return Status(StatusCode::kUnknown,
+                  "cannot write download destination file " + file_name);
+  }
+  if (!stream.status().ok()) {
+    return stream.status();
+  }
+  if (received != slice.size) {
+    std::ostringstream msg;
+    msg << "short read for slice at offset=" << slice.offset
+        << ", expected=" << slice.size << " bytes, received=" << received;
+    return Status(StatusCode::kDataLoss, std::move(msg).str());
+  }
+  return crc;
+}
+
+}  // namespace
+
+std::string ParallelDownloadPersistentState::ToString() const {
+  auto json_slices = internal::nl::json::array();
+  for (auto const& slice : slices) {
+    json_slices.emplace_back(internal::nl::json{{"offset", slice.offset},
+                                                {"size", slice.size},
+                                                {"crc32c", slice.crc32c},
+                                                {"done", slice.done}});
+  }
+  return internal::nl::json{{"bucket", bucket_name},
+                            {"object", object_name},
+                            {"generation", generation},
+                            {"size", object_size},
+                            {"slices", json_slices}}
+      .dump();
+}
+
+StatusOr<ParallelDownloadPersistentState>
+ParallelDownloadPersistentState::FromString(std::string const& json_rep) {
+  auto json = internal::nl::json::parse(json_rep, nullptr, false);
+  if (json.is_discarded()) {
+    return Status(StatusCode::kInternal,
+                  "Parallel download state is not a valid JSON.");
+  }
+  if (!json.is_object()) {
+    return Status(StatusCode::kInternal,
+                  "Parallel download state is not a JSON object.");
+  }
+  auto invalid_field = [](char const* name) {
+    return Status(StatusCode::kInternal,
+                  std::string("Parallel download state has a missing or "
+                              "invalid '") +
+                      name + "'.");
+  };
+  for (auto const* name : {"bucket", "object"}) {
+    if (json.count(name) != 1 || !json[name].is_string()) {
+      return invalid_field(name);
+    }
+  }
+  for (auto const* name : {"generation", "size"}) {
+    if (json.count(name) != 1 || !json[name].is_number_integer()) {
+      return invalid_field(name);
+    }
+  }
+  if (json.count("slices") != 1 || !json["slices"].is_array()) {
+    return invalid_field("slices");
+  }
+
+  ParallelDownloadPersistentState res;
+  res.bucket_name = json["bucket"].get<std::string>();
+  res.object_name = json["object"].get<std::string>();
+  res.generation = json["generation"].get<std::int64_t>();
+  res.object_size = json["size"].get<std::int64_t>();
+  std::int64_t expected_offset = 0;
+  for (auto const& slice_json : json["slices"]) {
+    if (!slice_json.is_object()) return invalid_field("slices");
+    for (auto const* name : {"offset", "size", "crc32c"}) {
+      if (slice_json.count(name) != 1 ||
+          !slice_json[name].is_number_integer()) {
+        return invalid_field(name);
+      }
+    }
+    if (slice_json.count("done") != 1 || !slice_json["done"].is_boolean()) {
+      return invalid_field("done");
+    }
+    Slice slice{slice_json["offset"].get<std::int64_t>(),
+                slice_json["size"].get<std::int64_t>(),
+                slice_json["crc32c"].get<std::uint32_t>(),
+                slice_json["done"].get<bool>()};
+    // The slices must cover the object without gaps or overlaps.
+    if (slice.offset != expected_offset || slice.size <= 0) {
+      return invalid_field("slices");
+    }
+    expected_offset += slice.size;
+    res.slices.push_back(slice);
+  }
+  if (expected_offset != res.object_size) {
+    return invalid_field("slices");
+  }
+  return res;
+}
+
+Status ParallelDownloadFileImpl(ObjectMetadata const& metadata,
+                                std::string const& file_name,
+                                std::vector<std::uintmax_t> const& split_points,
+                                std::string const& state_file_name,
+                                std::size_t buffer_size,
+                                std::size_t max_streams,
+                                ParallelDownloadSliceReader const& reader) {
+  auto report_error = [&metadata, &file_name](char const* what,
+                                              Status const& status) {
+    std::ostringstream msg;
+    msg << "ParallelDownloadFile(" << metadata.bucket() << "/"
+        << metadata.name() << "#" << metadata.generation() << ", " << file_name
+        << "): " << what << " - status.message=" << status.message();
+    return Status(status.code(), std::move(msg).str());
+  };
+
+  bool const persistent = !state_file_name.empty();
+  ParallelDownloadPersistentState state;
+  bool resuming = false;
+  if (persistent) {
+    auto previous = LoadState(state_file_name);
+    if (previous && IsCompatible(*previous, metadata, file_name)) {
+      state = *std::move(previous);
+      resuming = true;
+    }
+  }
+  if (!resuming) {
+    state = CreateState(metadata, split_points);
+    auto status = CreateDestination(file_name, state.object_size);
+    if (!status.ok()) {
+      return report_error("cannot create destination file", status);
+    }
+    if (persistent) {
+      status = SaveState(state_file_name, state);
+      if (!status.ok()) return report_error("cannot save state", status);
+    }
+  }
+
+  std::mutex mu;
+  Status save_status;
+  std::vector<Status> slice_status(state.slices.size());
+  auto download_slice = [&](std::size_t idx) {
+    auto crc = DownloadSlice(state.slices[idx], state.generation, file_name,
+                             buffer_size, reader);
+    if (!crc) {
+      slice_status[idx] = std::move(crc).status();
+      return;
+    }
+    std::lock_guard<std::mutex> lk(mu);
+    state.slices[idx].crc32c = *crc;
+    state.slices[idx].done = true;
+    if (persistent) {
+      auto status = SaveState(state_file_name, state);
+      if (!status.ok()) save_status = std::move(status);
+    }
+  };
+
+  // Report any exceptions as errors in the slice, they would terminate the
+  // process if they escaped the worker threads.
+  auto download = [&](std::size_t idx) {
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+    try {
+      download_slice(idx);
+    } catch (std::exception const& ex) {
+      slice_status[idx] = Status(StatusCode::kUnknown, ex.what());
+    } catch (...) {
+      slice_status[idx] =
+          Status(StatusCode::kUnknown, "unknown exception downloading slice");
+    }
+#else
+    download_slice(idx);
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+  };
+
+  std::vector<std::size_t> pending;
+  for (std::size_t i = 0; i != state.slices.size(); ++i) {
+    if (!state.slices[i].done) pending.push_back(i);
+  }
+  BulkApply(pending.size(), max_streams,
+            [&](std::size_t i) { download(pending[i]); });
+  for (auto const& status : slice_status) {
+    if (!status.ok()) return report_error("error downloading slice", status);
+  }
+  if (!save_status.ok()) {
+    return report_error("cannot save state", save_status);
+  }
+
+  std::uint32_t crc = 0;
+  for (auto const& slice : state.slices) {
+    crc = Crc32cCombine(crc, slice.crc32c, slice.size);
+  }
+  // All the slices are downloaded, the state is no longer needed. Note that
+  // after a checksum mismatch the state is useless too, any new attempt must
+  // start from scratch.
+  if (persistent) std::remove(state_file_name.c_str());
+  auto const computed = Crc32cToBase64(crc);
+  if (!metadata.crc32c().empty() && metadata.crc32c() != computed) {
+    return report_error(
+        "mismatched checksums",
+        Status(StatusCode::kDataLoss, "expected=" + metadata.crc32c() +
+                                          ", computed=" + computed));
+  }
+  return Status();
+}
+
+struct ParallelReadSource::Range {
+  std::int64_t offset;
+  std::int64_t size;
+  std::string data;      // GUARDED_BY(mu_) until `done` is set
+  std::uint32_t crc32c;  // GUARDED_BY(mu_) until `done` is set
+  Status status;         // GUARDED_BY(mu_) until `done` is set
+  bool done;             // GUARDED_BY(mu_)
+  std::thread fetcher;
+};
+
+ParallelReadSource::ParallelReadSource(ObjectMetadata const& metadata,
+                                       std::int64_t range_size,
+                                       std::size_t max_window,
+                                       ParallelDownloadSliceReader reader)
+    : bucket_name_(metadata.bucket()),
+      object_name_(metadata.name()),
+      generation_(metadata.generation()),
+      object_size_(static_cast<std::int64_t>(metadata.size())),
+      expected_crc32c_(metadata.crc32c()),
+      range_size_((std::max<std::int64_t>)(1, range_size)),
+      max_window_((std::max<std::size_t>)(1, max_window)),
+      reader_(std::move(reader)),
+      // Start with a modest window, it grows quickly if the consumer stalls.
+      window_size_((std::min<std::size_t>)(2, max_window_)) {}
+
+ParallelReadSource::~ParallelReadSource() { Cancel(); }
+
+StatusOr<HttpResponse> ParallelReadSource::Close() {
+  Cancel();
+  closed_ = true;
+  return HttpResponse{HttpStatusCode::kOk, {}, {}};
+}
+
+StatusOr<ReadSourceResult> ParallelReadSource::Read(char* buf,
+                                                    std::size_t n) {
+  if (closed_) {
+    return Status(StatusCode::kFailedPrecondition,
+                  "ParallelReadObject(" + bucket_name_ + "/" + object_name_ +
+                      "): the stream is closed");
+  }
+  if (consumed_ == object_size_) return Finish();
+
+  if (head_offset_ == 0) WaitForHead();
+  auto& head = *window_.front();
+  if (!head.status.ok()) {
+    auto status = std::move(head.status);
+    Cancel();
+    closed_ = true;
+    return status;
+  }
+
+  auto const count =
+      (std::min)(n, head.data.size() - head_offset_);
+  std::copy(head.data.begin() + head_offset_,
+            head.data.begin() + head_offset_ + count, buf);
+  head_offset_ += count;
+  consumed_ += static_cast<std::int64_t>(count);
+  if (head_offset_ == head.data.size()) {
+    crc_ = Crc32cCombine(crc_, head.crc32c, head.size);
+    head.fetcher.join();
+    window_.pop_front();
+    head_offset_ = 0;
+    FillWindow();
+  }
+  return ReadSourceResult{count,
+                          HttpResponse{HttpStatusCode::kContinue, {}, {}}};
+}
+
+void ParallelReadSource::FillWindow() {
+  while (window_.size() < window_size_ && next_range_offset_ < object_size_) {
+    auto const size =
+        (std::min)(range_size_, object_size_ - next_range_offset_);
+    std::unique_ptr<Range> range(
+        new Range{next_range_offset_, size, {}, 0, Status(), false, {}});
+    next_range_offset_ += size;
+    auto* r = range.get();
+    range->fetcher = std::thread([this, r] { Fetch(*r); });
+    window_.push_back(std::move(range));
+  }
+}
+
+void ParallelReadSource::Fetch(Range& range) {
+  // Download in chunks, so a cancelled source does not wait for the full
+  // range.
+  auto constexpr kChunkSize = std::size_t{256 * 1024};
+  std::string data(static_cast<std::size_t>(range.size), '\0');
+  std::size_t received = 0;
+  auto stream = reader_(range.offset, range.offset + range.size, generation_);
+  while (stream.status().ok() && received < data.size() && !cancelled_) {
+    auto const chunk = (std::min)(kChunkSize, data.size() - received);
+    stream.read(&data[received], chunk);
+    received += static_cast<std::size_t>(stream.gcount());
+    if (!stream.good()) break;
+  }
+
+  Status status;
+  std::uint32_t crc = 0;
+  if (cancelled_) {
+    status = Status(StatusCode::kCancelled, "the stream was closed");
+  } else if (!stream.status().ok()) {
+    status = stream.status();
+  } else if (received != data.size()) {
+    std::ostringstream msg;
+    msg << "short read for range at offset=" << range.offset
+        << ", expected=" << range.size << " bytes, received=" << received;
+    status = Status(StatusCode::kDataLoss, std::move(msg).str());
+  } else {
+    crc = crc32c::Crc32c(data);
+  }
+
+  std::lock_guard<std::mutex> lk(mu_);
+  range.data = std::move(data);
+  range.crc32c = crc;
+  range.status = std::move(status);
+  range.done = true;
+  cv_.notify_all();
+}
+
+void ParallelReadSource::WaitForHead() {
+  FillWindow();
+  std::unique_lock<std::mutex> lk(mu_);
+  auto& head = *window_.front();
+  if (head.done) {
+    // The consumer is slower than the downloads, shrink the window if all the
+    // ranges are already downloaded.
+    auto all_done = std::all_of(
+        window_.begin(), window_.end(),
+        [](std::unique_ptr<Range> const& r) { return r->done; });
+    if (all_done && window_size_ > 1) --window_size_;
+    return;
+  }
+  // The consumer had to wait, read further ahead.
+  if (window_size_ < max_window_) {
+    ++window_size_;
+    lk.unlock();
+    FillWindow();
+    lk.lock();
+  }
+  cv_.wait(lk, [&head] { return head.done; });
+}
+
+void ParallelReadSource::Cancel() {
+  cancelled_ = true;
+  for (auto& range : window_) {
+    if (range->fetcher.joinable()) range->fetcher.join();
+  }
+  window_.clear();
+}
+
+StatusOr<ReadSourceResult> ParallelReadSource::Finish() {
+  closed_ = true;
+  auto const computed = Crc32cToBase64(crc_);
+  if (!expected_crc32c_.empty() && expected_crc32c_ != computed) {
+    std::ostringstream msg;
+    msg << "ParallelReadObject(" << bucket_name_ << "/" << object_name_ << "#"
+        << generation_ << "): mismatched checksums, expected="
+        << expected_crc32c_ << ", computed=" << computed;
+    return Status(StatusCode::kDataLoss, std::move(msg).str());
+  }
+  return ReadSourceResult{
+      0, HttpResponse{HttpStatusCode::kOk,
+                      {},
+                      {{"x-goog-generation", std::to_string(generation_)}}}};
+}
+
+ObjectReadStream ParallelReadObjectImpl(std::string const& bucket_name,
+                                        std::string const& object_name,
+                                        StatusOr<ObjectMetadata> metadata,
+                                        std::int64_t range_size,
+                                        std::size_t max_window,
+                                        ParallelDownloadSliceReader reader) {
+  // The source validates the CRC32C checksum of the full object, the
+  // streambuf does not need to compute any hashes.
+  ReadObjectRangeRequest request(bucket_name, object_name);
+  request.set_multiple_options(DisableMD5Hash(true),
+                               DisableCrc32cChecksum(true));
+  if (!metadata) {
+    return ObjectReadStream(
+        google::cloud::internal::make_unique<ObjectReadStreambuf>(
+            request, std::move(metadata).status()));
+  }
+  std::unique_ptr<ObjectReadSource> source(new ParallelReadSource(
+      *metadata, range_size, max_window, std::move(reader)));
+  return ObjectReadStream(
+      google::cloud::internal::make_unique<ObjectReadStreambuf>(
+          request, std::move(source)));
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
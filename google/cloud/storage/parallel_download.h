@@ -0,0 +1,350 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_DOWNLOAD_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_DOWNLOAD_H
+
+#include "google/cloud/storage/bulk_operations.h"
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/object_read_source.h"
+#include "google/cloud/storage/internal/tuple_filter.h"
+#include "google/cloud/storage/object_stream.h"
+#include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * A parameter type to make `ParallelDownloadFile` resumable.
+ *
+ * If `ParallelDownloadFile` receives this option it records the progress of
+ * the download in the given file: which slices of the object have been
+ * downloaded and their checksums. If the download is interrupted, calling
+ * `ParallelDownloadFile` again with the same option only downloads the missing
+ * slices, as long as the object generation has not changed. The state file is
+ * removed once the download completes successfully.
+ */
+class ParallelDownloadStateFile {
+ public:
+  ParallelDownloadStateFile(std::string value) : value_(std::move(value)) {}
+  std::string const& value() const { return value_; }
+
+ private:
+  std::string value_;
+};
+
+namespace internal {
+
+/**
+ * The state of a parallel download, as saved in `ParallelDownloadStateFile`.
+ */
+struct ParallelDownloadPersistentState {
+  struct Slice {
+    std::int64_t offset;
+    std::int64_t size;
+    std::uint32_t crc32c;
+    bool done;
+  };
+
+  std::string ToString() const;
+  static StatusOr<ParallelDownloadPersistentState> FromString(
+      std::string const& json_rep);
+
+  std::string bucket_name;
+  std::string object_name;
+  std::int64_t generation;
+  std::int64_t object_size;
+  std::vector<Slice> slices;
+};
+
+// Type-erased function object to execute a ranged `ReadObject` with most
+// arguments bound.
+using ParallelDownloadSliceReader = std::function<ObjectReadStream(
+    std::int64_t begin, std::int64_t end, std::int64_t generation)>;
+
+/**
+ * Download the object described by @p metadata into @p file_name.
+ *
+ * The object is split at @p split_points, up to @p max_streams slices are
+ * downloaded concurrently, each one written directly into its offset in the
+ * destination file. Once all the slices are downloaded their CRC32C checksums
+ * are combined and compared against the checksum in @p metadata.
+ *
+ * If @p state_file_name is not empty the progress is saved into that file,
+ * and a previous (compatible) state is used to skip any slices already
+ * downloaded.
+ */
+Status ParallelDownloadFileImpl(ObjectMetadata const& metadata,
+                                std::string const& file_name,
+                                std::vector<std::uintmax_t> const& split_points,
+                                std::string const& state_file_name,
+                                std::size_t buffer_size,
+                                std::size_t max_streams,
+                                ParallelDownloadSliceReader const& reader);
+
+/**
+ * An `ObjectReadSource` reading several ranges ahead of the consumer.
+ *
+ * The object is split into ranges of @p range_size bytes. Up to a window of
+ * ranges ahead of the consumer position are downloaded concurrently, each in a
+ * separate thread, and returned to the consumer strictly in order.
+ *
+ * The window adapts to the relative speed of the producers and the consumer:
+ * it grows (up to @p max_window ranges) every time the consumer has to wait
+ * for the next range, and shrinks (down to 1 range) when the consumer reaches
+ * a new range and all the ranges in the window are already downloaded.
+ *
+ * The CRC32C checksums of the ranges are combined and compared against the
+ * checksum in @p metadata once the consumer reaches the end of the object.
+ */
+class ParallelReadSource : public ObjectReadSource {
+ public:
+  ParallelReadSource(ObjectMetadata const& metadata, std::int64_t range_size,
+                     std::size_t max_window,
+                     ParallelDownloadSliceReader reader);
+  ~ParallelReadSource() override;
+
+  ParallelReadSource(ParallelReadSource const&) = delete;
+  ParallelReadSource& operator=(ParallelReadSource const&) = delete;
+
+  bool IsOpen() const override { return !closed_; }
+  StatusOr<HttpResponse> Close() override;
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override;
+
+  /// The current target for the number of ranges read ahead.
+  std::size_t window_size() const { return window_size_; }
+
+ private:
+  struct Range;
+
+  void FillWindow();
+  void Fetch(Range& range);
+  void WaitForHead();
+  void Cancel();
+  StatusOr<ReadSourceResult> Finish();
+
+  std::string bucket_name_;
+  std::string object_name_;
+  std::int64_t generation_;
+  std::int64_t object_size_;
+  std::string expected_crc32c_;
+  std::int64_t range_size_;
+  std::size_t max_window_;
+  ParallelDownloadSliceReader reader_;
+
+  std::size_t window_size_;
+  std::int64_t next_range_offset_ = 0;
+  std::int64_t consumed_ = 0;
+  std::size_t head_offset_ = 0;
+  std::uint32_t crc_ = 0;
+  bool closed_ = false;
+  std::atomic<bool> cancelled_{false};
+
+  std::mutex mu_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<Range>> window_;
+};
+
+/**
+ * Create a stream reading the object described by @p metadata using a
+ * `ParallelReadSource`.
+ *
+ * If @p metadata is an error the stream is created in that error state.
+ */
+ObjectReadStream ParallelReadObjectImpl(std::string const& bucket_name,
+                                        std::string const& object_name,
+                                        StatusOr<ObjectMetadata> metadata,
+                                        std::int64_t range_size,
+                                        std::size_t max_window,
+                                        ParallelDownloadSliceReader reader);
+
+}  // namespace internal
+
+/**
+ * Perform a parallel download of an object into a file.
+ *
+ * The object is split in several slices, which are downloaded concurrently
+ * (each using a separate ranged `ReadObject()` request) and written directly
+ * into their position in the destination file. This can achieve much higher
+ * throughput than `Client::DownloadToFile()` for large objects, as the
+ * download is not limited by the throughput of a single connection.
+ *
+ * You can affect how many slices will be created by using the `MaxStreams` and
+ * `MinStreamSize` options. To make the download resumable provide a
+ * `ParallelDownloadStateFile` option.
+ *
+ * All the slices are downloaded from the same object generation. The CRC32C
+ * checksums of the slices are combined and compared against the object's
+ * checksum once the download completes.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket that contains the object.
+ * @param object_name the name of the object to be downloaded.
+ * @param file_name the name of the destination file.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `EncryptionKey`, `Generation`,
+ *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+ *     `IfMetagenerationNotMatch`, `MaxStreams`, `MinStreamSize`,
+ *     `ParallelDownloadStateFile`, and `UserProject`.
+ *
+ * @par Idempotency
+ * This is a read-only operation and is always idempotent.
+ *
+ * @par Example
+ * @snippet storage_object_file_transfer_samples.cc parallel download file
+ */
+template <typename... Options>
+Status ParallelDownloadFile(Client client, std::string const& bucket_name,
+                            std::string const& object_name,
+                            std::string const& file_name,
+                            Options&&... options) {
+  using internal::Among;
+  using internal::StaticTupleFilter;
+
+  auto get_object_meta_options = StaticTupleFilter<
+      Among<Generation, IfGenerationMatch, IfGenerationNotMatch,
+            IfMetagenerationMatch, IfMetagenerationNotMatch,
+            UserProject>::TPred>(std::tie(options...));
+  auto metadata = google::cloud::internal::apply(
+      internal::GetObjectMetadataApplyHelper{client, bucket_name, object_name},
+      std::move(get_object_meta_options));
+  if (!metadata) {
+    return std::move(metadata).status();
+  }
+
+  auto read_options =
+      StaticTupleFilter<Among<EncryptionKey, UserProject>::TPred>(
+          std::tie(options...));
+  internal::ParallelDownloadSliceReader reader =
+      [&client, &bucket_name, &object_name, &read_options](
+          std::int64_t begin, std::int64_t end, std::int64_t generation) {
+        return google::cloud::internal::apply(
+            internal::ReadObjectApplyHelper{client, bucket_name, object_name},
+            std::tuple_cat(
+                std::make_tuple(ReadRange(begin, end), Generation(generation)),
+                read_options));
+      };
+
+  auto const split_points = internal::ComputeParallelFileUploadSplitPoints(
+      metadata->size(), std::tie(options...));
+  auto const state_file =
+      internal::ExtractFirstOccurenceOfType<ParallelDownloadStateFile>(
+          std::tie(options...));
+  return internal::ParallelDownloadFileImpl(
+      *metadata, file_name, split_points,
+      state_file ? state_file->value() : std::string{},
+      client.raw_client()->client_options().download_buffer_size(),
+      internal::BulkMaxStreams(std::tie(options...)), reader);
+}
+
+/**
+ * Read an object using several concurrent ranged reads.
+ *
+ * The returned stream can be used like the stream returned by
+ * `Client::ReadObject()`, but the object is downloaded by issuing several
+ * ranged `ReadObject()` requests ahead of the current position, which are
+ * reassembled in order. This provides most of the throughput of
+ * `ParallelDownloadFile()` to applications that need to consume the data as a
+ * `std::istream`, for example, to decompress it.
+ *
+ * The `MinStreamSize` option controls the size of each range (8MiB by
+ * default), and `MaxStreams` the maximum number of ranges downloaded ahead of
+ * the application (8 by default). The number of ranges read ahead adapts to
+ * the rate at which the application consumes the data.
+ *
+ * All the ranges are read from the same object generation. The CRC32C
+ * checksums of the ranges are combined and compared against the object's
+ * checksum once the stream reaches the end of the object.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket that contains the object.
+ * @param object_name the name of the object to be read.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `EncryptionKey`, `Generation`,
+ *     `IfGenerationMatch`, `IfGenerationNotMatch`, `IfMetagenerationMatch`,
+ *     `IfMetagenerationNotMatch`, `MaxStreams`, `MinStreamSize`, and
+ *     `UserProject`.
+ *
+ * @par Idempotency
+ * This is a read-only operation and is always idempotent.
+ */
+template <typename... Options>
+ObjectReadStream ParallelReadObject(Client client,
+                                    std::string const& bucket_name,
+                                    std::string const& object_name,
+                                    Options&&... options) {
+  using internal::Among;
+  using internal::ExtractFirstOccurenceOfType;
+  using internal::StaticTupleFilter;
+
+  auto get_object_meta_options = StaticTupleFilter<
+      Among<Generation, IfGenerationMatch, IfGenerationNotMatch,
+            IfMetagenerationMatch, IfMetagenerationNotMatch,
+            UserProject>::TPred>(std::tie(options...));
+  auto metadata = google::cloud::internal::apply(
+      internal::GetObjectMetadataApplyHelper{client, bucket_name, object_name},
+      std::move(get_object_meta_options));
+
+  // The source outlives this function, capture copies of the read options.
+  auto const encryption_key =
+      ExtractFirstOccurenceOfType<EncryptionKey>(std::tie(options...))
+          .value_or(EncryptionKey());
+  auto const user_project =
+      ExtractFirstOccurenceOfType<UserProject>(std::tie(options...))
+          .value_or(UserProject());
+  internal::ParallelDownloadSliceReader reader =
+      [client, bucket_name, object_name, encryption_key, user_project](
+          std::int64_t begin, std::int64_t end, std::int64_t generation) {
+        // The checksums are computed and validated by the source.
+        Client c = client;
+        return c.ReadObject(bucket_name, object_name, ReadRange(begin, end),
+                            Generation(generation), DisableMD5Hash(true),
+                            DisableCrc32cChecksum(true), encryption_key,
+                            user_project);
+      };
+
+  auto const range_size =
+      ExtractFirstOccurenceOfType<MinStreamSize>(std::tie(options...))
+          .value_or(MinStreamSize(8 * 1024 * 1024))
+          .value();
+  auto const max_window =
+      ExtractFirstOccurenceOfType<MaxStreams>(std::tie(options...))
+          .value_or(MaxStreams(8))
+          .value();
+  return internal::ParallelReadObjectImpl(
+      bucket_name, object_name, std::move(metadata),
+      static_cast<std::int64_t>(range_size), max_window, std::move(reader));
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_DOWNLOAD_H
@@ -0,0 +1,527 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/parallel_download.h"
+#include "google/cloud/storage/internal/crc32c_combine.h"
+#include "google/cloud/storage/internal/object_streambuf.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/storage/testing/random_names.h"
+#include "google/cloud/internal/make_unique.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <crc32c/crc32c.h>
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::HasSubstr;
+using ::testing::Invoke;
+using ::testing::ReturnRef;
+
+std::string const kBucketName = "test-bucket";
+std::string const kObjectName = "test-object";
+std::int64_t const kGeneration = 1234;
+
+/// Serve a fixed string, filling each buffer like `CurlDownloadRequest` does.
+class FakeReadSource : public ObjectReadSource {
+ public:
+  explicit FakeReadSource(std::string contents)
+      : contents_(std::move(contents)) {}
+
+  bool IsOpen() const override { return open_; }
+  StatusOr<HttpResponse> Close() override {
+    open_ = false;
+    return HttpResponse{200, "", {}};
+  }
+  StatusOr<ReadSourceResult> Read(char* buf, std::size_t n) override {
+    n = (std::min)(n, contents_.size() - offset_);
+    std::copy(contents_.begin() + offset_, contents_.begin() + offset_ + n,
+              buf);
+    offset_ += n;
+    if (offset_ < contents_.size()) {
+      return ReadSourceResult{n, HttpResponse{100, "", {}}};
+    }
+    open_ = false;
+    return ReadSourceResult{n, HttpResponse{200, "", {}}};
+  }
+
+ private:
+  std::string contents_;
+  std::size_t offset_ = 0;
+  bool open_ = true;
+};
+
+ObjectMetadata MockObject(std::string const& contents,
+                          std::string const& crc32c) {
+  auto metadata = internal::ObjectMetadataParser::FromJson(internal::nl::json{
+      {"bucket", kBucketName},
+      {"name", kObjectName},
+      {"generation", kGeneration},
+      {"size", contents.size()},
+      {"crc32c", crc32c},
+  });
+  EXPECT_STATUS_OK(metadata);
+  return *metadata;
+}
+
+std::string ReadFile(std::string const& file_name) {
+  std::ifstream is(file_name, std::ios::binary);
+  return std::string{std::istreambuf_iterator<char>{is},
+                     std::istreambuf_iterator<char>{}};
+}
+
+bool FileExists(std::string const& file_name) {
+  return std::ifstream(file_name).is_open();
+}
+
+/// Read the stream, one character at a time, until it fails or reaches the
+/// end. Bulk reads discard the partial result when the stream fails.
+std::string ReadAll(ObjectReadStream& stream) {
+  std::string result;
+  char c;
+  while (stream.get(c)) result.push_back(c);
+  return result;
+}
+
+class ParallelDownloadTest : public ::testing::Test {
+ protected:
+  ParallelDownloadTest()
+      : generator_(std::random_device{}()),
+        contents_(testing::MakeRandomData(generator_, 1000)),
+        file_name_(testing::MakeRandomFileName(generator_)),
+        state_file_name_(file_name_ + ".state") {}
+
+  void SetUp() override {
+    mock_ = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*mock_, client_options())
+        .WillRepeatedly(ReturnRef(client_options_));
+    client_.reset(new Client{
+        std::shared_ptr<internal::RawClient>(mock_),
+        LimitedErrorCountRetryPolicy(2),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+
+  void TearDown() override {
+    std::remove(file_name_.c_str());
+    std::remove(state_file_name_.c_str());
+    client_.reset();
+    mock_.reset();
+  }
+
+  void ExpectGetMetadata(std::string const& crc32c) {
+    EXPECT_CALL(*mock_, GetObjectMetadata(_))
+        .WillOnce(Invoke([this, crc32c](GetObjectMetadataRequest const& r) {
+          EXPECT_EQ(kBucketName, r.bucket_name());
+          EXPECT_EQ(kObjectName, r.object_name());
+          return make_status_or(MockObject(contents_, crc32c));
+        }));
+  }
+
+  /// Serve the ranged reads, failing for slices starting at @p failing.
+  std::function<StatusOr<std::unique_ptr<ObjectReadSource>>(
+      ReadObjectRangeRequest const&)>
+  ServeRanges(std::set<std::int64_t> failing = {}) {
+    return [this, failing](ReadObjectRangeRequest const& r)
+               -> StatusOr<std::unique_ptr<ObjectReadSource>> {
+      EXPECT_EQ(kBucketName, r.bucket_name());
+      EXPECT_EQ(kObjectName, r.object_name());
+      EXPECT_TRUE(r.HasOption<Generation>());
+      EXPECT_EQ(kGeneration, r.GetOption<Generation>().value());
+      EXPECT_TRUE(r.HasOption<ReadRange>());
+      auto const range = r.GetOption<ReadRange>().value();
+      {
+        std::lock_guard<std::mutex> lk(mu_);
+        requested_.insert(range.begin);
+      }
+      if (failing.count(range.begin) != 0) return PermanentError();
+      return std::unique_ptr<ObjectReadSource>(new FakeReadSource(
+          contents_.substr(static_cast<std::size_t>(range.begin),
+                           static_cast<std::size_t>(range.end - range.begin))));
+    };
+  }
+
+  std::string ExpectedCrc32c() const {
+    return Crc32cToBase64(crc32c::Crc32c(contents_));
+  }
+
+  google::cloud::internal::DefaultPRNG generator_;
+  std::string contents_;
+  std::string file_name_;
+  std::string state_file_name_;
+  std::shared_ptr<testing::MockClient> mock_;
+  ClientOptions client_options_ =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+  std::unique_ptr<Client> client_;
+  std::mutex mu_;
+  std::set<std::int64_t> requested_;
+};
+
+TEST(ParallelDownloadPersistentState, RoundTrip) {
+  ParallelDownloadPersistentState state;
+  state.bucket_name = "b";
+  state.object_name = "o";
+  state.generation = 42;
+  state.object_size = 300;
+  state.slices = {{0, 100, 1, true}, {100, 200, 0xFFFFFFFF, false}};
+
+  auto actual = ParallelDownloadPersistentState::FromString(state.ToString());
+  ASSERT_STATUS_OK(actual);
+  EXPECT_EQ("b", actual->bucket_name);
+  EXPECT_EQ("o", actual->object_name);
+  EXPECT_EQ(42, actual->generation);
+  EXPECT_EQ(300, actual->object_size);
+  ASSERT_EQ(2, actual->slices.size());
+  EXPECT_EQ(100, actual->slices[1].offset);
+  EXPECT_EQ(200, actual->slices[1].size);
+  EXPECT_EQ(0xFFFFFFFF, actual->slices[1].crc32c);
+  EXPECT_TRUE(actual->slices[0].done);
+  EXPECT_FALSE(actual->slices[1].done);
+}
+
+TEST(ParallelDownloadPersistentState, Invalid) {
+  for (auto const* text : {
+           R"""(not-json)""",
+           R"""([])""",
+           R"""({"object": "o", "generation": 1, "size": 0, "slices": []})""",
+           R"""({"bucket": "b", "object": "o", "size": 0, "slices": []})""",
+           R"""({"bucket": "b", "object": "o", "generation": 1, "size": 0})""",
+           R"""({"bucket": "b", "object": "o", "generation": 1, "size": 10,
+                 "slices": [{"offset": 0, "size": 5, "crc32c": 0,
+                             "done": false}]})""",
+           R"""({"bucket": "b", "object": "o", "generation": 1, "size": 10,
+                 "slices": [{"offset": 0, "size": 5, "crc32c": 0,
+                             "done": false},
+                            {"offset": 4, "size": 6, "crc32c": 0,
+                             "done": false}]})""",
+           R"""({"bucket": "b", "object": "o", "generation": 1, "size": 10,
+                 "slices": [{"offset": 0, "size": 10, "crc32c": 0}]})""",
+       }) {
+    auto actual = ParallelDownloadPersistentState::FromString(text);
+    EXPECT_EQ(StatusCode::kInternal, actual.status().code()) << text;
+  }
+}
+
+TEST_F(ParallelDownloadTest, Success) {
+  ExpectGetMetadata(ExpectedCrc32c());
+  EXPECT_CALL(*mock_, ReadObject(_)).WillRepeatedly(Invoke(ServeRanges()));
+
+  auto status = ParallelDownloadFile(*client_, kBucketName, kObjectName,
+                                     file_name_, MaxStreams(4),
+                                     MinStreamSize(100));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(contents_, ReadFile(file_name_));
+  EXPECT_EQ(std::set<std::int64_t>({0, 250, 500, 750}), requested_);
+}
+
+TEST_F(ParallelDownloadTest, EmptyObject) {
+  contents_.clear();
+  ExpectGetMetadata(ExpectedCrc32c());
+  EXPECT_CALL(*mock_, ReadObject(_)).Times(0);
+
+  auto status =
+      ParallelDownloadFile(*client_, kBucketName, kObjectName, file_name_);
+  ASSERT_STATUS_OK(status);
+  EXPECT_TRUE(FileExists(file_name_));
+  EXPECT_EQ("", ReadFile(file_name_));
+}
+
+TEST_F(ParallelDownloadTest, MetadataFailure) {
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .WillOnce(Invoke([](GetObjectMetadataRequest const&) {
+        return StatusOr<ObjectMetadata>(PermanentError());
+      }));
+  EXPECT_CALL(*mock_, ReadObject(_)).Times(0);
+
+  auto status =
+      ParallelDownloadFile(*client_, kBucketName, kObjectName, file_name_);
+  EXPECT_EQ(PermanentError().code(), status.code());
+  EXPECT_FALSE(FileExists(file_name_));
+}
+
+TEST_F(ParallelDownloadTest, ChecksumMismatch) {
+  ExpectGetMetadata(Crc32cToBase64(0));
+  EXPECT_CALL(*mock_, ReadObject(_)).WillRepeatedly(Invoke(ServeRanges()));
+
+  auto status = ParallelDownloadFile(
+      *client_, kBucketName, kObjectName, file_name_, MaxStreams(4),
+      MinStreamSize(100), ParallelDownloadStateFile(state_file_name_));
+  EXPECT_EQ(StatusCode::kDataLoss, status.code());
+  EXPECT_THAT(status.message(), HasSubstr("mismatched checksums"));
+  EXPECT_FALSE(FileExists(state_file_name_));
+}
+
+TEST_F(ParallelDownloadTest, FailureThenResume) {
+  ExpectGetMetadata(ExpectedCrc32c());
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillRepeatedly(Invoke(ServeRanges({250, 750})));
+
+  auto status = ParallelDownloadFile(
+      *client_, kBucketName, kObjectName, file_name_, MaxStreams(4),
+      MinStreamSize(100), ParallelDownloadStateFile(state_file_name_));
+  EXPECT_EQ(PermanentError().code(), status.code());
+  EXPECT_THAT(status.message(), HasSubstr("error downloading slice"));
+  ASSERT_TRUE(FileExists(state_file_name_));
+
+  auto state =
+      ParallelDownloadPersistentState::FromString(ReadFile(state_file_name_));
+  ASSERT_STATUS_OK(state);
+  ASSERT_EQ(4, state->slices.size());
+  EXPECT_TRUE(state->slices[0].done);
+  EXPECT_FALSE(state->slices[1].done);
+  EXPECT_TRUE(state->slices[2].done);
+  EXPECT_FALSE(state->slices[3].done);
+
+  // The second attempt should only download the missing slices, even if the
+  // options would result in a different split.
+  requested_.clear();
+  ExpectGetMetadata(ExpectedCrc32c());
+  EXPECT_CALL(*mock_, ReadObject(_)).WillRepeatedly(Invoke(ServeRanges()));
+  status = ParallelDownloadFile(*client_, kBucketName, kObjectName, file_name_,
+                                MaxStreams(2), MinStreamSize(100),
+                                ParallelDownloadStateFile(state_file_name_));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(contents_, ReadFile(file_name_));
+  EXPECT_EQ(std::set<std::int64_t>({250, 750}), requested_);
+  EXPECT_FALSE(FileExists(state_file_name_));
+}
+
+TEST_F(ParallelDownloadTest, IncompatibleStateIsIgnored) {
+  ParallelDownloadPersistentState state;
+  state.bucket_name = kBucketName;
+  state.object_name = kObjectName;
+  state.generation = kGeneration - 1;
+  state.object_size = static_cast<std::int64_t>(contents_.size());
+  state.slices = {{0, state.object_size, 0, true}};
+  std::ofstream(state_file_name_) << state.ToString();
+
+  ExpectGetMetadata(ExpectedCrc32c());
+  EXPECT_CALL(*mock_, ReadObject(_)).WillRepeatedly(Invoke(ServeRanges()));
+  auto status = ParallelDownloadFile(
+      *client_, kBucketName, kObjectName, file_name_, MaxStreams(2),
+      MinStreamSize(100), ParallelDownloadStateFile(state_file_name_));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(contents_, ReadFile(file_name_));
+  EXPECT_EQ(std::set<std::int64_t>({0, 500}), requested_);
+}
+
+TEST_F(ParallelDownloadTest, ResumeIsLimitedByMaxStreams) {
+  // A previous download with many small slices, none of them downloaded.
+  ParallelDownloadPersistentState state;
+  state.bucket_name = kBucketName;
+  state.object_name = kObjectName;
+  state.generation = kGeneration;
+  state.object_size = static_cast<std::int64_t>(contents_.size());
+  for (std::int64_t offset = 0; offset != state.object_size; offset += 50) {
+    state.slices.push_back({offset, 50, 0, false});
+  }
+  std::ofstream(file_name_) << std::string(contents_.size(), '\0');
+  std::ofstream(state_file_name_) << state.ToString();
+
+  ExpectGetMetadata(ExpectedCrc32c());
+  auto serve = ServeRanges();
+  int running = 0;
+  int max_running = 0;
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillRepeatedly(Invoke([&](ReadObjectRangeRequest const& r) {
+        {
+          std::lock_guard<std::mutex> lk(mu_);
+          max_running = (std::max)(max_running, ++running);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        {
+          std::lock_guard<std::mutex> lk(mu_);
+          --running;
+        }
+        return serve(r);
+      }));
+  auto status = ParallelDownloadFile(
+      *client_, kBucketName, kObjectName, file_name_, MaxStreams(2),
+      MinStreamSize(100), ParallelDownloadStateFile(state_file_name_));
+  ASSERT_STATUS_OK(status);
+  EXPECT_EQ(contents_, ReadFile(file_name_));
+  EXPECT_EQ(20, requested_.size());
+  EXPECT_GE(2, max_running);
+}
+
+#if GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+TEST_F(ParallelDownloadTest, ExceptionIsReported) {
+  ExpectGetMetadata(ExpectedCrc32c());
+  auto serve = ServeRanges();
+  using SourceOrError = StatusOr<std::unique_ptr<ObjectReadSource>>;
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillRepeatedly(
+          Invoke([serve](ReadObjectRangeRequest const& r) -> SourceOrError {
+            if (r.GetOption<ReadRange>().value().begin == 500) {
+              throw std::runtime_error("uh-oh");
+            }
+            return serve(r);
+          }));
+  auto status = ParallelDownloadFile(*client_, kBucketName, kObjectName,
+                                     file_name_, MaxStreams(4),
+                                     MinStreamSize(100));
+  EXPECT_EQ(StatusCode::kUnknown, status.code());
+  EXPECT_THAT(status.message(), HasSubstr("uh-oh"));
+}
+#endif  // GOOGLE_CLOUD_CPP_HAVE_EXCEPTIONS
+
+TEST_F(ParallelDownloadTest, ParallelReadObject) {
+  ExpectGetMetadata(ExpectedCrc32c());
+  EXPECT_CALL(*mock_, ReadObject(_)).WillRepeatedly(Invoke(ServeRanges()));
+
+  auto stream = ParallelReadObject(*client_, kBucketName, kObjectName,
+                                   MaxStreams(4), MinStreamSize(100));
+  EXPECT_EQ(contents_, ReadAll(stream));
+  EXPECT_STATUS_OK(stream.status());
+  EXPECT_FALSE(stream.IsOpen());
+  EXPECT_EQ(std::set<std::int64_t>(
+                {0, 100, 200, 300, 400, 500, 600, 700, 800, 900}),
+            requested_);
+}
+
+TEST_F(ParallelDownloadTest, ParallelReadObjectEmpty) {
+  contents_.clear();
+  ExpectGetMetadata(ExpectedCrc32c());
+  EXPECT_CALL(*mock_, ReadObject(_)).Times(0);
+
+  auto stream = ParallelReadObject(*client_, kBucketName, kObjectName);
+  EXPECT_EQ("", ReadAll(stream));
+  EXPECT_STATUS_OK(stream.status());
+}
+
+TEST_F(ParallelDownloadTest, ParallelReadObjectMetadataFailure) {
+  EXPECT_CALL(*mock_, GetObjectMetadata(_))
+      .WillOnce(Invoke([](GetObjectMetadataRequest const&) {
+        return StatusOr<ObjectMetadata>(PermanentError());
+      }));
+  EXPECT_CALL(*mock_, ReadObject(_)).Times(0);
+
+  auto stream = ParallelReadObject(*client_, kBucketName, kObjectName);
+  EXPECT_EQ("", ReadAll(stream));
+  EXPECT_EQ(PermanentError().code(), stream.status().code());
+}
+
+TEST_F(ParallelDownloadTest, ParallelReadObjectRangeFailure) {
+  ExpectGetMetadata(ExpectedCrc32c());
+  EXPECT_CALL(*mock_, ReadObject(_))
+      .WillRepeatedly(Invoke(ServeRanges({300})));
+
+  auto stream = ParallelReadObject(*client_, kBucketName, kObjectName,
+                                   MaxStreams(4), MinStreamSize(100));
+  EXPECT_EQ(contents_.substr(0, 300), ReadAll(stream));
+  EXPECT_EQ(PermanentError().code(), stream.status().code());
+}
+
+TEST_F(ParallelDownloadTest, ParallelReadObjectChecksumMismatch) {
+  ExpectGetMetadata(Crc32cToBase64(0));
+  EXPECT_CALL(*mock_, ReadObject(_)).WillRepeatedly(Invoke(ServeRanges()));
+
+  auto stream = ParallelReadObject(*client_, kBucketName, kObjectName,
+                                   MaxStreams(4), MinStreamSize(100));
+  EXPECT_EQ(contents_, ReadAll(stream));
+  EXPECT_EQ(StatusCode::kDataLoss, stream.status().code());
+  EXPECT_THAT(stream.status().message(), HasSubstr("mismatched checksums"));
+}
+
+TEST_F(ParallelDownloadTest, ParallelReadObjectEarlyClose) {
+  ExpectGetMetadata(ExpectedCrc32c());
+  EXPECT_CALL(*mock_, ReadObject(_)).WillRepeatedly(Invoke(ServeRanges()));
+
+  auto stream = ParallelReadObject(*client_, kBucketName, kObjectName,
+                                   MaxStreams(4), MinStreamSize(100));
+  std::vector<char> buffer(150);
+  stream.read(buffer.data(), buffer.size());
+  EXPECT_EQ(contents_.substr(0, 150),
+            std::string(buffer.data(), static_cast<std::size_t>(
+                                           stream.gcount())));
+  stream.Close();
+  EXPECT_STATUS_OK(stream.status());
+  EXPECT_FALSE(stream.IsOpen());
+}
+
+class ParallelReadSourceTest : public ParallelDownloadTest {
+ protected:
+  /// Serve ranges from `contents_`, waiting @p delay before each one.
+  ParallelDownloadSliceReader DelayedReader(std::chrono::milliseconds delay) {
+    return [this, delay](std::int64_t begin, std::int64_t end, std::int64_t) {
+      std::this_thread::sleep_for(delay);
+      ReadObjectRangeRequest request(kBucketName, kObjectName);
+      request.set_multiple_options(DisableMD5Hash(true),
+                                   DisableCrc32cChecksum(true));
+      std::unique_ptr<ObjectReadSource> source(new FakeReadSource(
+          contents_.substr(static_cast<std::size_t>(begin),
+                           static_cast<std::size_t>(end - begin))));
+      return ObjectReadStream(
+          google::cloud::internal::make_unique<ObjectReadStreambuf>(
+              request, std::move(source)));
+    };
+  }
+
+  /// Read one chunk from @p source, appending it to @p actual.
+  static bool ReadChunk(ParallelReadSource& source, std::string& actual) {
+    std::vector<char> buffer(1000);
+    auto result = source.Read(buffer.data(), buffer.size());
+    EXPECT_STATUS_OK(result);
+    if (!result) return false;
+    actual.append(buffer.data(), result->bytes_received);
+    return result->response.status_code == HttpStatusCode::kContinue;
+  }
+};
+
+TEST_F(ParallelReadSourceTest, WindowGrowsWhenConsumerWaits) {
+  ParallelReadSource source(MockObject(contents_, ExpectedCrc32c()), 100, 4,
+                            DelayedReader(std::chrono::milliseconds(20)));
+  EXPECT_EQ(2U, source.window_size());
+  std::string actual;
+  EXPECT_TRUE(ReadChunk(source, actual));
+  EXPECT_LT(2U, source.window_size());
+  while (ReadChunk(source, actual)) continue;
+  EXPECT_EQ(contents_, actual);
+  EXPECT_GE(4U, source.window_size());
+  EXPECT_FALSE(source.IsOpen());
+}
+
+TEST_F(ParallelReadSourceTest, WindowShrinksWhenConsumerIsSlow) {
+  ParallelReadSource source(MockObject(contents_, ExpectedCrc32c()), 100, 4,
+                            DelayedReader(std::chrono::milliseconds(0)));
+  std::string actual;
+  do {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  } while (ReadChunk(source, actual));
+  EXPECT_EQ(contents_, actual);
+  EXPECT_EQ(1U, source.window_size());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,119 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/parallel_list_objects.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+std::vector<ListObjectsShardRange> ComputeListObjectsShardRanges(
+    std::vector<std::string> split_points, StartOffset const& start,
+    EndOffset const& end) {
+  auto outside = [&start, &end](std::string const& s) {
+    if (s.empty()) {
+      return true;
+    }
+    if (start.has_value() && s <= start.value()) {
+      return true;
+    }
+    return end.has_value() && s >= end.value();
+  };
+  split_points.erase(
+      std::remove_if(split_points.begin(), split_points.end(), outside),
+      split_points.end());
+  std::sort(split_points.begin(), split_points.end());
+  split_points.erase(std::unique(split_points.begin(), split_points.end()),
+                     split_points.end());
+
+  std::vector<ListObjectsShardRange> ranges;
+  ranges.reserve(split_points.size() + 1);
+  StartOffset lower = start;
+  for (auto& s : split_points) {
+    ranges.emplace_back(std::move(lower), EndOffset(s));
+    lower = StartOffset(std::move(s));
+  }
+  ranges.emplace_back(std::move(lower), end);
+  return ranges;
+}
+
+StatusOr<std::vector<std::string>> ListObjectsPrefixes(
+    RawClient& client, ListObjectsRequest request) {
+  std::vector<std::string> prefixes;
+  do {
+    auto response = client.ListObjects(request);
+    if (!response) {
+      return std::move(response).status();
+    }
+    prefixes.insert(prefixes.end(),
+                    std::make_move_iterator(response->prefixes.begin()),
+                    std::make_move_iterator(response->prefixes.end()));
+    request.set_page_token(std::move(response->next_page_token));
+  } while (!request.page_token().empty());
+  return prefixes;
+}
+
+Status ParallelListObjectsImpl(
+    std::vector<ListObjectsReader> shards, std::size_t max_streams,
+    std::function<void(ObjectMetadata)> const& callback) {
+  std::atomic<std::size_t> next_shard(0);
+  std::atomic<bool> failed(false);
+  std::mutex mu;
+  Status status;  // GUARDED_BY(mu)
+
+  auto worker = [&] {
+    for (auto i = next_shard++; i < shards.size() && !failed;
+         i = next_shard++) {
+      for (auto& object : shards[i]) {
+        if (failed) {
+          return;
+        }
+        if (!object) {
+          std::lock_guard<std::mutex> lk(mu);
+          if (status.ok()) {
+            status = std::move(object).status();
+          }
+          failed = true;
+          return;
+        }
+        callback(*std::move(object));
+      }
+    }
+  };
+
+  auto const thread_count =
+      (std::max<std::size_t>)(1, (std::min)(max_streams, shards.size()));
+  std::vector<std::thread> threads;
+  threads.reserve(thread_count - 1);
+  for (std::size_t i = 1; i != thread_count; ++i) {
+    threads.emplace_back(worker);
+  }
+  // The calling thread also consumes shards.
+  worker();
+  for (auto& t : threads) {
+    t.join();
+  }
+  return status;
+}
+
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
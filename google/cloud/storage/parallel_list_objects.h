@@ -0,0 +1,203 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LIST_OBJECTS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LIST_OBJECTS_H
+
+#include "google/cloud/storage/client.h"
+#include "google/cloud/storage/internal/tuple_filter.h"
+#include "google/cloud/storage/list_objects_reader.h"
+#include "google/cloud/storage/parallel_upload.h"
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status_or.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+
+/// The `[StartOffset, EndOffset)` range listed by each shard.
+using ListObjectsShardRange = std::pair<StartOffset, EndOffset>;
+
+/**
+ * Compute the ranges listed by each shard.
+ *
+ * The split points are sorted and de-duplicated, any split points outside the
+ * `[start, end)` range requested by the application are discarded. The first
+ * and last shards keep the application's @p start and @p end bounds (which
+ * may be unset), so the shards cover exactly the requested range.
+ */
+std::vector<ListObjectsShardRange> ComputeListObjectsShardRanges(
+    std::vector<std::string> split_points, StartOffset const& start,
+    EndOffset const& end);
+
+/// List all the prefixes (aka "directories") returned by @p request.
+StatusOr<std::vector<std::string>> ListObjectsPrefixes(
+    RawClient& client, ListObjectsRequest request);
+
+/**
+ * Consume @p shards using up to @p max_streams threads.
+ *
+ * Each thread picks the next unprocessed shard and calls @p callback for each
+ * object in it. The first error stops all the threads and is returned.
+ */
+Status ParallelListObjectsImpl(
+    std::vector<ListObjectsReader> shards, std::size_t max_streams,
+    std::function<void(ObjectMetadata)> const& callback);
+
+struct ListObjectsApplyHelper {
+  template <typename... Options>
+  ListObjectsReader operator()(Options&&... options) const {
+    return client.ListObjects(bucket_name, std::forward<Options>(options)...);
+  }
+
+  Client& client;
+  std::string const& bucket_name;
+};
+
+}  // namespace internal
+
+/**
+ * Compute split points to list a bucket in parallel.
+ *
+ * Lists the prefixes (the "directories") of the bucket using @p delimiter, the
+ * result can be used as the split points for `ListObjectsSharded()` or
+ * `ParallelListObjects()`. Because all the objects in a prefix sort together,
+ * each shard lists one or more complete prefixes.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket to list.
+ * @param delimiter the delimiter used to compute the prefixes, typically `/`.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include `Prefix`, `StartOffset`,
+ *     `EndOffset`, and `UserProject`.
+ *
+ * @par Idempotency
+ * This is a read-only operation and is always idempotent.
+ */
+template <typename... Options>
+StatusOr<std::vector<std::string>> ComputeListObjectsSplitPoints(
+    Client client, std::string const& bucket_name,
+    std::string const& delimiter, Options&&... options) {
+  internal::ListObjectsRequest request(bucket_name);
+  request.set_multiple_options(std::forward<Options>(options)...,
+                               Delimiter(delimiter));
+  return internal::ListObjectsPrefixes(*client.raw_client(),
+                                       std::move(request));
+}
+
+/**
+ * Split the listing of a bucket into independent readers.
+ *
+ * Returns one `ListObjectsReader` per range between consecutive split points
+ * (one more reader than split points), each restricted with `StartOffset` and
+ * `EndOffset`. Together the readers return the same objects as
+ * `Client::ListObjects()` with the same options, but they can be consumed
+ * concurrently, from different threads.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket to list.
+ * @param split_points the object names where a new shard starts, for example,
+ *     the result of `ComputeListObjectsSplitPoints()`.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include all the options valid for
+ *     `Client::ListObjects()`.
+ *
+ * @par Idempotency
+ * This is a read-only operation and is always idempotent.
+ */
+template <typename... Options>
+std::vector<ListObjectsReader> ListObjectsSharded(
+    Client client, std::string const& bucket_name,
+    std::vector<std::string> split_points, Options&&... options) {
+  using internal::NotAmong;
+  using internal::StaticTupleFilter;
+
+  auto const ranges = internal::ComputeListObjectsShardRanges(
+      std::move(split_points),
+      internal::ExtractFirstOccurenceOfType<StartOffset>(std::tie(options...))
+          .value_or(StartOffset()),
+      internal::ExtractFirstOccurenceOfType<EndOffset>(std::tie(options...))
+          .value_or(EndOffset()));
+  auto list_options =
+      StaticTupleFilter<NotAmong<StartOffset, EndOffset, MaxStreams>::TPred>(
+          std::tie(options...));
+
+  std::vector<ListObjectsReader> shards;
+  shards.reserve(ranges.size());
+  for (auto const& range : ranges) {
+    shards.push_back(google::cloud::internal::apply(
+        internal::ListObjectsApplyHelper{client, bucket_name},
+        std::tuple_cat(list_options,
+                       std::make_tuple(range.first, range.second))));
+  }
+  return shards;
+}
+
+/**
+ * List the objects in a bucket using multiple concurrent streams.
+ *
+ * The keyspace is split at @p split_points, and each shard is listed by a
+ * separate thread, up to `MaxStreams` (64 by default) at a time. This can
+ * list very large buckets much faster than `Client::ListObjects()`, which
+ * is limited by the latency of each page. Combine with `PrefetchNextPage` to
+ * also overlap the requests within each shard.
+ *
+ * @p callback is called once for each object, from multiple threads at the
+ * same time, and in no particular order. It must be thread-safe.
+ *
+ * @param client the client on which to perform the operation.
+ * @param bucket_name the name of the bucket to list.
+ * @param split_points the object names where a new shard starts, for example,
+ *     the result of `ComputeListObjectsSplitPoints()`.
+ * @param callback invoked with the metadata of each object.
+ * @param options a list of optional query parameters and/or request headers.
+ *     Valid types for this operation include all the options valid for
+ *     `Client::ListObjects()`, and `MaxStreams`.
+ *
+ * @return the first error encountered by any of the streams, if any. On
+ *     error, some objects may not be reported to @p callback.
+ *
+ * @par Idempotency
+ * This is a read-only operation and is always idempotent.
+ */
+template <typename... Options>
+Status ParallelListObjects(Client client, std::string const& bucket_name,
+                           std::vector<std::string> split_points,
+                           std::function<void(ObjectMetadata)> const& callback,
+                           Options&&... options) {
+  MaxStreams const kDefaultMaxStreams(64);
+  auto const max_streams =
+      internal::ExtractFirstOccurenceOfType<MaxStreams>(std::tie(options...))
+          .value_or(kDefaultMaxStreams)
+          .value();
+  return internal::ParallelListObjectsImpl(
+      ListObjectsSharded(std::move(client), bucket_name,
+                         std::move(split_points),
+                         std::forward<Options>(options)...),
+      max_streams, callback);
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_PARALLEL_LIST_OBJECTS_H
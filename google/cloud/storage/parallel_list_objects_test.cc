@@ -0,0 +1,222 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "google/cloud/storage/parallel_list_objects.h"
+#include "google/cloud/storage/retry_policy.h"
+#include "google/cloud/storage/testing/canonical_errors.h"
+#include "google/cloud/storage/testing/mock_client.h"
+#include "google/cloud/testing_util/assert_ok.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <mutex>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace internal {
+namespace {
+
+using ::google::cloud::storage::testing::canonical_errors::PermanentError;
+using ::testing::_;
+using ::testing::ElementsAre;
+using ::testing::Invoke;
+using ::testing::ReturnRef;
+using ::testing::UnorderedElementsAreArray;
+
+std::string const kBucketName = "test-bucket";
+
+ObjectMetadata CreateObject(std::string const& name) {
+  return ObjectMetadataParser::FromJson(nl::json{
+                                            {"bucket", kBucketName},
+                                            {"name", name},
+                                        })
+      .value();
+}
+
+/// Simulate a bucket, honoring `StartOffset` and `EndOffset`.
+StatusOr<ListObjectsResponse> ListFakeBucket(
+    std::vector<std::string> const& names, ListObjectsRequest const& r) {
+  auto const start = r.GetOption<StartOffset>();
+  auto const end = r.GetOption<EndOffset>();
+  ListObjectsResponse response;
+  for (auto const& n : names) {
+    if (start.has_value() && n < start.value()) {
+      continue;
+    }
+    if (end.has_value() && n >= end.value()) {
+      continue;
+    }
+    response.items.push_back(CreateObject(n));
+  }
+  return response;
+}
+
+std::vector<std::pair<std::string, std::string>> AsStrings(
+    std::vector<ListObjectsShardRange> const& ranges) {
+  std::vector<std::pair<std::string, std::string>> result;
+  for (auto const& r : ranges) {
+    result.emplace_back(r.first.has_value() ? r.first.value() : "-",
+                        r.second.has_value() ? r.second.value() : "-");
+  }
+  return result;
+}
+
+class ParallelListObjectsTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mock_ = std::make_shared<testing::MockClient>();
+    EXPECT_CALL(*mock_, client_options())
+        .WillRepeatedly(ReturnRef(client_options_));
+    client_.reset(new Client{
+        std::shared_ptr<internal::RawClient>(mock_),
+        LimitedErrorCountRetryPolicy(2),
+        ExponentialBackoffPolicy(std::chrono::milliseconds(1),
+                                 std::chrono::milliseconds(1), 2.0)});
+  }
+
+  std::shared_ptr<testing::MockClient> mock_;
+  std::unique_ptr<Client> client_;
+  ClientOptions client_options_ =
+      ClientOptions(oauth2::CreateAnonymousCredentials());
+};
+
+TEST(ComputeListObjectsShardRangesTest, NoSplitPoints) {
+  auto actual = ComputeListObjectsShardRanges({}, StartOffset(), EndOffset());
+  EXPECT_THAT(AsStrings(actual), ElementsAre(std::make_pair("-", "-")));
+}
+
+TEST(ComputeListObjectsShardRangesTest, SortsAndRemovesDuplicates) {
+  auto actual = ComputeListObjectsShardRanges({"c/", "a/", "", "c/", "b/"},
+                                              StartOffset(), EndOffset());
+  EXPECT_THAT(AsStrings(actual),
+              ElementsAre(std::make_pair("-", "a/"), std::make_pair("a/", "b/"),
+                          std::make_pair("b/", "c/"),
+                          std::make_pair("c/", "-")));
+}
+
+TEST(ComputeListObjectsShardRangesTest, KeepsApplicationBounds) {
+  auto actual = ComputeListObjectsShardRanges(
+      {"a/", "b/", "c/", "d/"}, StartOffset("b/"), EndOffset("c/x"));
+  EXPECT_THAT(AsStrings(actual), ElementsAre(std::make_pair("b/", "c/"),
+                                             std::make_pair("c/", "c/x")));
+}
+
+TEST_F(ParallelListObjectsTest, ComputeSplitPoints) {
+  EXPECT_CALL(*mock_, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const& r) {
+        EXPECT_EQ("/", r.GetOption<Delimiter>().value());
+        EXPECT_EQ("", r.page_token());
+        ListObjectsResponse response;
+        response.next_page_token = "page-1";
+        response.prefixes = {"a/", "b/"};
+        return make_status_or(std::move(response));
+      }))
+      .WillOnce(Invoke([](ListObjectsRequest const& r) {
+        EXPECT_EQ("/", r.GetOption<Delimiter>().value());
+        EXPECT_EQ("page-1", r.page_token());
+        ListObjectsResponse response;
+        response.prefixes = {"c/"};
+        return make_status_or(std::move(response));
+      }));
+
+  auto actual = ComputeListObjectsSplitPoints(*client_, kBucketName, "/");
+  ASSERT_STATUS_OK(actual);
+  EXPECT_THAT(*actual, ElementsAre("a/", "b/", "c/"));
+}
+
+TEST_F(ParallelListObjectsTest, ComputeSplitPointsFailure) {
+  EXPECT_CALL(*mock_, ListObjects(_))
+      .WillOnce(Invoke([](ListObjectsRequest const&) {
+        return StatusOr<ListObjectsResponse>(PermanentError());
+      }));
+
+  auto actual = ComputeListObjectsSplitPoints(*client_, kBucketName, "/");
+  ASSERT_FALSE(actual);
+  EXPECT_EQ(PermanentError().code(), actual.status().code());
+}
+
+TEST_F(ParallelListObjectsTest, Sharded) {
+  std::vector<std::string> const names{"a/1", "a/2", "b/1", "c/1", "d"};
+  EXPECT_CALL(*mock_, ListObjects(_))
+      .Times(3)
+      .WillRepeatedly(Invoke([&names](ListObjectsRequest const& r) {
+        return ListFakeBucket(names, r);
+      }));
+
+  auto shards =
+      ListObjectsSharded(*client_, kBucketName, {"b/", "c/"}, Prefix(""));
+  ASSERT_EQ(3, shards.size());
+  std::vector<std::vector<std::string>> actual;
+  for (auto& shard : shards) {
+    actual.emplace_back();
+    for (auto& o : shard) {
+      ASSERT_STATUS_OK(o);
+      actual.back().push_back(o->name());
+    }
+  }
+  EXPECT_THAT(actual, ElementsAre(ElementsAre("a/1", "a/2"), ElementsAre("b/1"),
+                                  ElementsAre("c/1", "d")));
+}
+
+TEST_F(ParallelListObjectsTest, Parallel) {
+  std::vector<std::string> names;
+  for (char c = 'a'; c <= 'z'; ++c) {
+    names.push_back(std::string(1, c) + "/object");
+  }
+  std::vector<std::string> split_points;
+  for (char c = 'b'; c <= 'z'; ++c) {
+    split_points.push_back(std::string(1, c) + "/");
+  }
+  EXPECT_CALL(*mock_, ListObjects(_))
+      .Times(26)
+      .WillRepeatedly(Invoke([&names](ListObjectsRequest const& r) {
+        return ListFakeBucket(names, r);
+      }));
+
+  std::mutex mu;
+  std::vector<std::string> actual;
+  auto status = ParallelListObjects(
+      *client_, kBucketName, split_points,
+      [&](ObjectMetadata m) {
+        std::lock_guard<std::mutex> lk(mu);
+        actual.push_back(m.name());
+      },
+      MaxStreams(4));
+  ASSERT_STATUS_OK(status);
+  EXPECT_THAT(actual, UnorderedElementsAreArray(names));
+}
+
+TEST_F(ParallelListObjectsTest, ParallelFailure) {
+  std::vector<std::string> const names{"a/1", "b/1", "c/1"};
+  EXPECT_CALL(*mock_, ListObjects(_))
+      .WillRepeatedly(Invoke([&names](ListObjectsRequest const& r) {
+        auto const start = r.GetOption<StartOffset>();
+        if (start.has_value() && start.value() == "b/") {
+          return StatusOr<ListObjectsResponse>(PermanentError());
+        }
+        return ListFakeBucket(names, r);
+      }));
+
+  auto status = ParallelListObjects(
+      *client_, kBucketName, {"b/", "c/"}, [](ObjectMetadata const&) {},
+      MaxStreams(2));
+  EXPECT_EQ(PermanentError().code(), status.code());
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -38,7 +38,7 @@ namespace storage {
 inline namespace STORAGE_CLIENT_NS {
 /**
  * A parameter type indicating the maximum number of streams to
- * `ParallelUploadFile`.
+ * `ParallelUploadFile` or `ParallelDownloadFile`.
  */
 class MaxStreams {
  public:
@@ -50,11 +50,13 @@ class MaxStreams {
 };
 
 /**
- * A parameter type indicating the minimum stream size to `ParallelUploadFile`.
+ * A parameter type indicating the minimum stream size to `ParallelUploadFile`
+ * or `ParallelDownloadFile`.
  *
  * If `ParallelUploadFile`, receives this option it will attempt to make sure
  * that every shard is at least this long. This might not apply to the last
  * shard because it will be the remainder of the division of the file.
+ * `ParallelDownloadFile` applies the same rule to the slices of the object.
  */
 class MinStreamSize {
  public:
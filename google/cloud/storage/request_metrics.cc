@@ -0,0 +1,104 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/request_metrics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+std::size_t BucketIndex(std::chrono::microseconds value) {
+  auto constexpr kLast = LatencyHistogram::kBucketCount - 1;
+  std::size_t index = 0;
+  for (auto v = value.count(); v > 1 && index != kLast; v >>= 1) {
+    ++index;
+  }
+  return index;
+}
+}  // namespace
+
+std::size_t constexpr LatencyHistogram::kBucketCount;
+
+void LatencyHistogram::Record(std::chrono::microseconds value) {
+  if (value.count() < 0) {
+    value = std::chrono::microseconds(0);
+  }
+  ++buckets_[BucketIndex(value)];
+  sum_ += value.count();
+  ++count_;
+}
+
+std::array<std::uint64_t, LatencyHistogram::kBucketCount>
+LatencyHistogram::buckets() const {
+  std::array<std::uint64_t, kBucketCount> result;
+  for (std::size_t i = 0; i != kBucketCount; ++i) {
+    result[i] = buckets_[i].load();
+  }
+  return result;
+}
+
+std::chrono::microseconds LatencyHistogram::Percentile(
+    double percentile) const {
+  auto const counts = buckets();
+  std::uint64_t total = 0;
+  for (auto c : counts) {
+    total += c;
+  }
+  if (total == 0) {
+    return std::chrono::microseconds(0);
+  }
+  percentile = (std::max)(0.0, (std::min)(100.0, percentile));
+  auto const rank = (std::max)(
+      std::uint64_t{1},
+      static_cast<std::uint64_t>(std::ceil(percentile * total / 100.0)));
+  std::uint64_t accumulated = 0;
+  std::size_t i = 0;
+  for (; i + 1 != kBucketCount; ++i) {
+    accumulated += counts[i];
+    if (accumulated >= rank) {
+      break;
+    }
+  }
+  return std::chrono::microseconds(std::int64_t{2} << i);
+}
+
+void HistogramRequestMetrics::OnRequest(RequestMetrics const& metrics) {
+  ++requests_;
+  if (!metrics.status.ok() || metrics.status_code >= 400) {
+    ++errors_;
+  }
+  if (metrics.connection_reused) {
+    ++connections_reused_;
+  }
+  bytes_sent_ += metrics.bytes_sent;
+  bytes_received_ += metrics.bytes_received;
+  name_lookup_.Record(metrics.name_lookup);
+  connect_.Record(metrics.connect);
+  tls_handshake_.Record(metrics.tls_handshake);
+  time_to_first_byte_.Record(metrics.time_to_first_byte);
+  transfer_.Record(metrics.transfer);
+  total_.Record(metrics.total);
+}
+
+void HistogramRequestMetrics::OnRetry(std::string const&, Status const&) {
+  ++retries_;
+}
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -0,0 +1,199 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REQUEST_METRICS_H
+#define GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REQUEST_METRICS_H
+
+#include "google/cloud/storage/version.h"
+#include "google/cloud/status.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+/**
+ * The latency breakdown and size of a single HTTP request.
+ *
+ * The durations are computed from the timing information reported by libcurl,
+ * each one covers a separate phase of the request. The phases that did not
+ * happen, for example, the TLS handshake on a reused connection, are zero.
+ */
+struct RequestMetrics {
+  /// The URL used in the request.
+  std::string url;
+  /// The HTTP status code, or 0 if no response was received.
+  std::int32_t status_code = 0;
+  /// The transport-level status of the request.
+  Status status;
+  /// The time spent resolving the endpoint name.
+  std::chrono::microseconds name_lookup{};
+  /// The time spent establishing the TCP connection.
+  std::chrono::microseconds connect{};
+  /// The time spent in the TLS handshake.
+  std::chrono::microseconds tls_handshake{};
+  /// The time from sending the request until the first byte of the response.
+  std::chrono::microseconds time_to_first_byte{};
+  /// The time from the first byte of the response until the end of the
+  /// transfer.
+  std::chrono::microseconds transfer{};
+  /// The total time for the request, including all the phases above.
+  std::chrono::microseconds total{};
+  /// The number of payload bytes sent.
+  std::uint64_t bytes_sent = 0;
+  /// The number of payload bytes received.
+  std::uint64_t bytes_received = 0;
+  /// True if the request reused an existing connection.
+  bool connection_reused = false;
+};
+
+/**
+ * Receives the metrics for each request made by a `Client`.
+ *
+ * Applications can install an implementation of this class using
+ * `ClientOptions::set_request_metrics()`. The functions are called from the
+ * thread that made the request, possibly from many threads at the same time,
+ * implementations must be thread-safe and should return quickly.
+ *
+ * @see `HistogramRequestMetrics` for the default implementation.
+ */
+class RequestMetricsRecorder {
+ public:
+  virtual ~RequestMetricsRecorder() = default;
+
+  /// Called when each HTTP request completes, successfully or not.
+  virtual void OnRequest(RequestMetrics const& metrics) = 0;
+
+  /**
+   * Called before an operation is retried.
+   *
+   * @param operation the name of the operation, e.g., `"GetObjectMetadata"`.
+   * @param status the error that triggered the retry.
+   */
+  virtual void OnRetry(std::string const& operation, Status const& status) = 0;
+};
+
+/**
+ * A histogram of latencies with exponentially sized buckets.
+ *
+ * The bucket `i` counts the samples in the `[2^i, 2^(i+1))` microseconds
+ * range, the first bucket also counts the samples below 1us, and the last
+ * bucket counts all the samples larger than its lower bound. This is coarse,
+ * but it covers the range from microseconds to hours with a small, fixed
+ * number of counters that can be updated without locks.
+ */
+class LatencyHistogram {
+ public:
+  static std::size_t constexpr kBucketCount = 32;
+
+  LatencyHistogram() = default;
+
+  void Record(std::chrono::microseconds value);
+
+  /// The number of samples recorded.
+  std::uint64_t count() const { return count_.load(); }
+
+  /// The sum of all the samples recorded.
+  std::chrono::microseconds sum() const {
+    return std::chrono::microseconds(sum_.load());
+  }
+
+  /// The number of samples in each bucket.
+  std::array<std::uint64_t, kBucketCount> buckets() const;
+
+  /**
+   * An estimate of the @p percentile latency.
+   *
+   * Returns the upper bound of the bucket containing the percentile, or zero if
+   * there are no samples.
+   *
+   * @param percentile a value in the `[0, 100]` range.
+   */
+  std::chrono::microseconds Percentile(double percentile) const;
+
+ private:
+  std::atomic<std::uint64_t> count_{0};
+  std::atomic<std::int64_t> sum_{0};
+  std::array<std::atomic<std::uint64_t>, kBucketCount> buckets_{};
+};
+
+/**
+ * A `RequestMetricsRecorder` that aggregates the metrics in histograms.
+ *
+ * Keeps one histogram for each phase of the requests, which can be used to
+ * tell if slow requests are caused by name resolution, connection setup, TLS,
+ * the service, or the data transfer. All the accessors are safe to call from
+ * any thread, while the client is still in use.
+ */
+class HistogramRequestMetrics : public RequestMetricsRecorder {
+ public:
+  HistogramRequestMetrics() = default;
+
+  void OnRequest(RequestMetrics const& metrics) override;
+  void OnRetry(std::string const& operation, Status const& status) override;
+
+  /// The number of requests completed.
+  std::uint64_t requests() const { return requests_.load(); }
+
+  /// The number of requests that failed, or returned an HTTP error.
+  std::uint64_t errors() const { return errors_.load(); }
+
+  /// The number of operations retried.
+  std::uint64_t retries() const { return retries_.load(); }
+
+  /// The number of requests that reused an existing connection.
+  std::uint64_t connections_reused() const {
+    return connections_reused_.load();
+  }
+
+  /// The total number of payload bytes sent.
+  std::uint64_t bytes_sent() const { return bytes_sent_.load(); }
+
+  /// The total number of payload bytes received.
+  std::uint64_t bytes_received() const { return bytes_received_.load(); }
+
+  LatencyHistogram const& name_lookup() const { return name_lookup_; }
+  LatencyHistogram const& connect() const { return connect_; }
+  LatencyHistogram const& tls_handshake() const { return tls_handshake_; }
+  LatencyHistogram const& time_to_first_byte() const {
+    return time_to_first_byte_;
+  }
+  LatencyHistogram const& transfer() const { return transfer_; }
+  LatencyHistogram const& total() const { return total_; }
+
+ private:
+  std::atomic<std::uint64_t> requests_{0};
+  std::atomic<std::uint64_t> errors_{0};
+  std::atomic<std::uint64_t> retries_{0};
+  std::atomic<std::uint64_t> connections_reused_{0};
+  std::atomic<std::uint64_t> bytes_sent_{0};
+  std::atomic<std::uint64_t> bytes_received_{0};
+  LatencyHistogram name_lookup_;
+  LatencyHistogram connect_;
+  LatencyHistogram tls_handshake_;
+  LatencyHistogram time_to_first_byte_;
+  LatencyHistogram transfer_;
+  LatencyHistogram total_;
+};
+
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
+
+#endif  // GOOGLE_CLOUD_CPP_GOOGLE_CLOUD_STORAGE_REQUEST_METRICS_H
@@ -0,0 +1,142 @@
+// Copyright 2020 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "google/cloud/storage/request_metrics.h"
+#include <gmock/gmock.h>
+
+namespace google {
+namespace cloud {
+namespace storage {
+inline namespace STORAGE_CLIENT_NS {
+namespace {
+
+using us = std::chrono::microseconds;
+
+TEST(RequestMetricsTest, Defaults) {
+  RequestMetrics metrics;
+  EXPECT_EQ(0, metrics.status_code);
+  EXPECT_TRUE(metrics.status.ok());
+  EXPECT_EQ(us(0), metrics.name_lookup);
+  EXPECT_EQ(us(0), metrics.connect);
+  EXPECT_EQ(us(0), metrics.tls_handshake);
+  EXPECT_EQ(us(0), metrics.time_to_first_byte);
+  EXPECT_EQ(us(0), metrics.transfer);
+  EXPECT_EQ(us(0), metrics.total);
+  EXPECT_EQ(0, metrics.bytes_sent);
+  EXPECT_EQ(0, metrics.bytes_received);
+  EXPECT_FALSE(metrics.connection_reused);
+}
+
+TEST(LatencyHistogramTest, Empty) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.count());
+  EXPECT_EQ(us(0), histogram.sum());
+  EXPECT_EQ(us(0), histogram.Percentile(50.0));
+  for (auto c : histogram.buckets()) {
+    EXPECT_EQ(0, c);
+  }
+}
+
+TEST(LatencyHistogramTest, Buckets) {
+  LatencyHistogram histogram;
+  for (auto v : {-5, 0, 1, 2, 3, 4, 7, 8}) {
+    histogram.Record(us(v));
+  }
+  EXPECT_EQ(8, histogram.count());
+  EXPECT_EQ(us(25), histogram.sum());
+  auto const buckets = histogram.buckets();
+  EXPECT_EQ(3, buckets[0]);
+  EXPECT_EQ(2, buckets[1]);
+  EXPECT_EQ(2, buckets[2]);
+  EXPECT_EQ(1, buckets[3]);
+  EXPECT_EQ(0, buckets[4]);
+}
+
+TEST(LatencyHistogramTest, LargeValues) {
+  LatencyHistogram histogram;
+  histogram.Record(std::chrono::hours(24 * 365));
+  EXPECT_EQ(1, histogram.buckets().back());
+  EXPECT_EQ(us(std::int64_t{1} << LatencyHistogram::kBucketCount),
+            histogram.Percentile(100.0));
+}
+
+TEST(LatencyHistogramTest, Percentile) {
+  LatencyHistogram histogram;
+  for (int i = 0; i != 90; ++i) {
+    histogram.Record(us(100));
+  }
+  for (int i = 0; i != 10; ++i) {
+    histogram.Record(us(5000));
+  }
+  EXPECT_EQ(us(128), histogram.Percentile(0.0));
+  EXPECT_EQ(us(128), histogram.Percentile(50.0));
+  EXPECT_EQ(us(128), histogram.Percentile(90.0));
+  EXPECT_EQ(us(8192), histogram.Percentile(95.0));
+  EXPECT_EQ(us(8192), histogram.Percentile(100.0));
+  EXPECT_EQ(us(8192), histogram.Percentile(200.0));
+}
+
+TEST(HistogramRequestMetricsTest, OnRequest) {
+  HistogramRequestMetrics metrics;
+  RequestMetrics m;
+  m.url = "https://storage.googleapis.com/storage/v1/b/test-bucket";
+  m.status_code = 200;
+  m.name_lookup = us(10);
+  m.connect = us(100);
+  m.tls_handshake = us(1000);
+  m.time_to_first_byte = us(20000);
+  m.transfer = us(3000);
+  m.total = us(24110);
+  m.bytes_sent = 16;
+  m.bytes_received = 1024;
+  m.connection_reused = false;
+  metrics.OnRequest(m);
+
+  m.status_code = 503;
+  m.connection_reused = true;
+  metrics.OnRequest(m);
+
+  m.status_code = 0;
+  m.status = Status(StatusCode::kUnavailable, "connection reset");
+  metrics.OnRequest(m);
+
+  EXPECT_EQ(3, metrics.requests());
+  EXPECT_EQ(2, metrics.errors());
+  EXPECT_EQ(2, metrics.connections_reused());
+  EXPECT_EQ(3 * 16, metrics.bytes_sent());
+  EXPECT_EQ(3 * 1024, metrics.bytes_received());
+  EXPECT_EQ(0, metrics.retries());
+  EXPECT_EQ(3, metrics.name_lookup().count());
+  EXPECT_EQ(us(30), metrics.name_lookup().sum());
+  EXPECT_EQ(us(300), metrics.connect().sum());
+  EXPECT_EQ(us(3000), metrics.tls_handshake().sum());
+  EXPECT_EQ(us(60000), metrics.time_to_first_byte().sum());
+  EXPECT_EQ(us(9000), metrics.transfer().sum());
+  EXPECT_EQ(us(3 * 24110), metrics.total().sum());
+  EXPECT_EQ(us(32768), metrics.total().Percentile(50.0));
+}
+
+TEST(HistogramRequestMetricsTest, OnRetry) {
+  HistogramRequestMetrics metrics;
+  metrics.OnRetry("GetObjectMetadata", Status(StatusCode::kUnavailable, "try"));
+  metrics.OnRetry("ReadObject", Status(StatusCode::kUnavailable, "try again"));
+  EXPECT_EQ(2, metrics.retries());
+  EXPECT_EQ(0, metrics.requests());
+}
+
+}  // namespace
+}  // namespace STORAGE_CLIENT_NS
+}  // namespace storage
+}  // namespace cloud
+}  // namespace google
@@ -19,22 +19,28 @@
 storage_client_hdrs = [
     "bucket_access_control.h",
     "bucket_metadata.h",
+    "bulk_operations.h",
     "client.h",
     "client_options.h",
     "download_options.h",
     "hashing_options.h",
+    "hedging_options.h",
     "hmac_key_metadata.h",
     "iam_policy.h",
     "idempotency_policy.h",
     "internal/access_control_common.h",
+    "internal/adaptive_chunk_size.h",
     "internal/binary_data_as_debug_string.h",
     "internal/bucket_acl_requests.h",
     "internal/bucket_requests.h",
     "internal/common_metadata.h",
     "internal/complex_option.h",
     "internal/compute_engine_util.h",
+    "internal/const_buffer.h",
+    "internal/crc32c_combine.h",
     "internal/curl_client.h",
     "internal/curl_download_request.h",
+    "internal/curl_event_loop.h",
     "internal/curl_handle.h",
     "internal/curl_handle_factory.h",
     "internal/curl_request.h",
@@ -48,10 +54,13 @@ storage_client_hdrs = [
     "internal/generic_request.h",
     "internal/hash_validator.h",
     "internal/hash_validator_impl.h",
+    "internal/hedged_request.h",
     "internal/hmac_key_requests.h",
     "internal/http_response.h",
+    "internal/list_response_parser.h",
     "internal/logging_client.h",
     "internal/logging_resumable_upload_session.h",
+    "internal/mapped_file.h",
     "internal/metadata_parser.h",
     "internal/nljson.h",
     "internal/notification_requests.h",
@@ -62,6 +71,7 @@ storage_client_hdrs = [
     "internal/openssl_util.h",
     "internal/parameter_pack_validation.h",
     "internal/patch_builder.h",
+    "internal/pipelined_resumable_upload_session.h",
     "internal/policy_document_request.h",
     "internal/range_from_pagination.h",
     "internal/raw_client.h",
@@ -78,12 +88,14 @@ storage_client_hdrs = [
     "lifecycle_rule.h",
     "list_buckets_reader.h",
     "list_hmac_keys_reader.h",
+    "list_objects_options.h",
     "list_objects_reader.h",
     "notification_event_type.h",
     "notification_metadata.h",
     "notification_payload_format.h",
     "oauth2/anonymous_credentials.h",
     "oauth2/authorized_user_credentials.h",
+    "oauth2/background_refreshing_credentials.h",
     "oauth2/compute_engine_credentials.h",
     "oauth2/credential_constants.h",
     "oauth2/credentials.h",
@@ -95,9 +107,13 @@ storage_client_hdrs = [
     "object_metadata.h",
     "object_rewriter.h",
     "object_stream.h",
+    "object_summary.h",
     "override_default_project.h",
+    "parallel_download.h",
+    "parallel_list_objects.h",
     "parallel_upload.h",
     "policy_document.h",
+    "request_metrics.h",
     "retry_policy.h",
     "service_account.h",
     "signed_url_options.h",
@@ -112,19 +128,24 @@ storage_client_hdrs = [
 storage_client_srcs = [
     "bucket_access_control.cc",
     "bucket_metadata.cc",
+    "bulk_operations.cc",
     "client.cc",
     "client_options.cc",
     "hashing_options.cc",
+    "hedging_options.cc",
     "hmac_key_metadata.cc",
     "iam_policy.cc",
     "idempotency_policy.cc",
     "internal/access_control_common.cc",
+    "internal/adaptive_chunk_size.cc",
     "internal/binary_data_as_debug_string.cc",
     "internal/bucket_acl_requests.cc",
     "internal/bucket_requests.cc",
     "internal/compute_engine_util.cc",
+    "internal/crc32c_combine.cc",
     "internal/curl_client.cc",
     "internal/curl_download_request.cc",
+    "internal/curl_event_loop.cc",
     "internal/curl_handle.cc",
     "internal/curl_handle_factory.cc",
     "internal/curl_request.cc",
@@ -135,16 +156,20 @@ storage_client_srcs = [
     "internal/empty_response.cc",
     "internal/hash_validator.cc",
     "internal/hash_validator_impl.cc",
+    "internal/hedged_request.cc",
     "internal/hmac_key_requests.cc",
     "internal/http_response.cc",
+    "internal/list_response_parser.cc",
     "internal/logging_client.cc",
     "internal/logging_resumable_upload_session.cc",
+    "internal/mapped_file.cc",
     "internal/metadata_parser.cc",
     "internal/notification_requests.cc",
     "internal/object_acl_requests.cc",
     "internal/object_requests.cc",
     "internal/object_streambuf.cc",
     "internal/openssl_util.cc",
+    "internal/pipelined_resumable_upload_session.cc",
     "internal/policy_document_request.cc",
     "internal/resumable_upload_session.cc",
     "internal/retry_client.cc",
@@ -161,6 +186,7 @@ storage_client_srcs = [
     "notification_metadata.cc",
     "oauth2/anonymous_credentials.cc",
     "oauth2/authorized_user_credentials.cc",
+    "oauth2/background_refreshing_credentials.cc",
     "oauth2/compute_engine_credentials.cc",
     "oauth2/credentials.cc",
     "oauth2/google_application_default_credentials_file.cc",
@@ -171,8 +197,12 @@ storage_client_srcs = [
     "object_metadata.cc",
     "object_rewriter.cc",
     "object_stream.cc",
+    "object_summary.cc",
+    "parallel_download.cc",
+    "parallel_list_objects.cc",
     "parallel_upload.cc",
     "policy_document.cc",
+    "request_metrics.cc",
     "service_account.cc",
     "version.cc",
     "well_known_headers.cc",
@@ -20,6 +20,7 @@ storage_client_unit_tests = [
     "bucket_access_control_test.cc",
     "bucket_metadata_test.cc",
     "bucket_test.cc",
+    "bulk_operations_test.cc",
     "client_bucket_acl_test.cc",
     "client_default_object_acl_test.cc",
     "client_notifications_test.cc",
@@ -32,14 +33,18 @@ storage_client_unit_tests = [
     "client_test.cc",
     "client_write_object_test.cc",
     "hashing_options_test.cc",
+    "hedging_options_test.cc",
     "hmac_key_metadata_test.cc",
     "idempotency_policy_test.cc",
     "internal/access_control_common_test.cc",
+    "internal/adaptive_chunk_size_test.cc",
     "internal/binary_data_as_debug_string_test.cc",
     "internal/bucket_acl_requests_test.cc",
     "internal/bucket_requests_test.cc",
     "internal/compute_engine_util_test.cc",
+    "internal/crc32c_combine_test.cc",
     "internal/curl_client_test.cc",
+    "internal/curl_event_loop_test.cc",
     "internal/curl_handle_factory_test.cc",
     "internal/curl_handle_test.cc",
     "internal/curl_resumable_upload_session_test.cc",
@@ -52,10 +57,13 @@ storage_client_unit_tests = [
     "internal/generate_message_boundary_test.cc",
     "internal/generic_request_test.cc",
     "internal/hash_validator_test.cc",
+    "internal/hedged_request_test.cc",
     "internal/hmac_key_requests_test.cc",
     "internal/http_response_test.cc",
+    "internal/list_response_parser_test.cc",
     "internal/logging_client_test.cc",
     "internal/logging_resumable_upload_session_test.cc",
+    "internal/mapped_file_test.cc",
     "internal/metadata_parser_test.cc",
     "internal/nljson_use_after_third_party_test.cc",
     "internal/nljson_use_third_party_test.cc",
@@ -66,6 +74,7 @@ storage_client_unit_tests = [
     "internal/openssl_util_test.cc",
     "internal/parameter_pack_validation_test.cc",
     "internal/patch_builder_test.cc",
+    "internal/pipelined_resumable_upload_session_test.cc",
     "internal/policy_document_request_test.cc",
     "internal/resumable_upload_session_test.cc",
     "internal/retry_client_test.cc",
@@ -83,6 +92,7 @@ storage_client_unit_tests = [
     "notification_metadata_test.cc",
     "oauth2/anonymous_credentials_test.cc",
     "oauth2/authorized_user_credentials_test.cc",
+    "oauth2/background_refreshing_credentials_test.cc",
     "oauth2/compute_engine_credentials_test.cc",
     "oauth2/google_application_default_credentials_file_test.cc",
     "oauth2/google_credentials_test.cc",
@@ -90,9 +100,13 @@ storage_client_unit_tests = [
     "object_access_control_test.cc",
     "object_metadata_test.cc",
     "object_stream_test.cc",
+    "object_summary_test.cc",
     "object_test.cc",
+    "parallel_download_test.cc",
+    "parallel_list_objects_test.cc",
     "parallel_uploads_test.cc",
     "policy_document_test.cc",
+    "request_metrics_test.cc",
     "retry_policy_test.cc",
     "service_account_test.cc",
     "signed_url_options_test.cc",
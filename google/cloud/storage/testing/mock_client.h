@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/internal/raw_client.h"
 #include "google/cloud/storage/internal/resumable_upload_session.h"
+#include "google/cloud/storage/oauth2/google_credentials.h"
 #include <gmock/gmock.h>
 
 namespace google {
@@ -26,6 +27,13 @@ namespace testing {
 
 class MockClient : public google::cloud::storage::internal::RawClient {
  public:
+  MockClient() : default_options_(oauth2::CreateAnonymousCredentials()) {
+    // The retry loops query the options, e.g., to report retries, return
+    // something usable even if the test does not set any expectations.
+    ON_CALL(*this, client_options())
+        .WillByDefault(::testing::ReturnRef(default_options_));
+  }
+
   MOCK_CONST_METHOD0(client_options, ClientOptions const&());
   MOCK_METHOD1(ListBuckets, StatusOr<internal::ListBucketsResponse>(
                                 internal::ListBucketsRequest const&));
@@ -68,6 +76,9 @@ class MockClient : public google::cloud::storage::internal::RawClient {
   MOCK_METHOD1(ReadObject,
                StatusOr<std::unique_ptr<internal::ObjectReadSource>>(
                    internal::ReadObjectRangeRequest const&));
+  MOCK_METHOD1(AsyncReadObject,
+               future<StatusOr<std::string>>(
+                   internal::ReadObjectRangeRequest const&));
   MOCK_METHOD1(ListObjects, StatusOr<internal::ListObjectsResponse>(
                                 internal::ListObjectsRequest const&));
   MOCK_METHOD1(DeleteObject, StatusOr<internal::EmptyResponse>(
@@ -163,6 +174,9 @@ class MockClient : public google::cloud::storage::internal::RawClient {
       AuthorizationHeader,
       StatusOr<std::string>(
           std::shared_ptr<google::cloud::storage::oauth2::Credentials> const&));
+
+ private:
+  ClientOptions default_options_;
 };
 
 class MockResumableUploadSession
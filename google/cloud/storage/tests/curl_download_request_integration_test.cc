@@ -78,6 +78,32 @@ TEST(CurlDownloadRequestTest, SimpleStream) {
   EXPECT_EQ(kDownloadedLines, count);
 }
 
+TEST(CurlDownloadRequestTest, BlocksLargerThanFreeSpace) {
+  // Use a buffer that is not a multiple of the chunk size, so libcurl often
+  // delivers blocks larger than the space left in the application buffer.
+  // Those blocks pause the transfer, and the next `Read()` must resume it.
+  constexpr std::size_t kDownloadedBytes = 96 * 1024;
+  storage::internal::CurlRequestBuilder request(
+      HttpBinEndpoint() + "/stream-bytes/" +
+          std::to_string(kDownloadedBytes) + "?chunk_size=7000&seed=1",
+      storage::internal::GetDefaultCurlHandleFactory());
+
+  auto download = request.BuildDownloadRequest(std::string{});
+
+  StatusOr<ReadSourceResult> result;
+  char buffer[10000];
+  std::size_t total = 0;
+  do {
+    result = download.Read(buffer, sizeof(buffer));
+    ASSERT_STATUS_OK(result);
+    ASSERT_LE(result->bytes_received, sizeof(buffer));
+    total += result->bytes_received;
+  } while (result->response.status_code == 100);
+
+  EXPECT_EQ(200, result->response.status_code);
+  EXPECT_EQ(kDownloadedBytes, total);
+}
+
 }  // namespace
 }  // namespace internal
 }  // namespace STORAGE_CLIENT_NS
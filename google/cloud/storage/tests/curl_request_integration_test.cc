@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "google/cloud/storage/internal/curl_event_loop.h"
 #include "google/cloud/storage/internal/curl_request_builder.h"
 #include "google/cloud/storage/internal/nljson.h"
 #include "google/cloud/storage/oauth2/anonymous_credentials.h"
@@ -54,6 +55,23 @@ TEST(CurlRequestTest, SimpleGET) {
   EXPECT_EQ("bar1==bar2=", args["bar"].get<std::string>());
 }
 
+TEST(CurlRequestTest, PooledConnectionReuse) {
+  auto stats = std::make_shared<ConnectionPoolStats>();
+  auto factory = std::make_shared<PooledCurlHandleFactory>(
+      2, ChannelOptions{}, true, stats);
+  for (int i = 0; i != 3; ++i) {
+    storage::internal::CurlRequestBuilder request(HttpBinEndpoint() + "/get",
+                                                  factory);
+    auto response = request.BuildRequest().MakeRequest(std::string{});
+    ASSERT_STATUS_OK(response);
+    EXPECT_EQ(200, response->status_code);
+  }
+  EXPECT_EQ(1, stats->misses());
+  EXPECT_EQ(2, stats->hits());
+  EXPECT_EQ(1, stats->connections_created());
+  EXPECT_EQ(2, stats->connections_reused());
+}
+
 TEST(CurlRequestTest, FailedGET) {
   // This test fails if somebody manages to run a https server on port 0 (you
   // can't, but just documenting the assumptions in this test).
@@ -64,6 +82,28 @@ TEST(CurlRequestTest, FailedGET) {
   EXPECT_FALSE(response.ok());
 }
 
+TEST(CurlRequestTest, AsyncGET) {
+  auto loop = CurlEventLoop::Create();
+  std::vector<future<StatusOr<HttpResponse>>> pending;
+  for (int i = 0; i != 8; ++i) {
+    storage::internal::CurlRequestBuilder request(
+        HttpBinEndpoint() + "/get",
+        storage::internal::GetDefaultCurlHandleFactory());
+    request.AddQueryParameter("foo", std::to_string(i));
+    request.AddHeader("Accept: application/json");
+    pending.push_back(
+        loop->MakeRequest(request.BuildRequest(), std::string{}));
+  }
+  for (int i = 0; i != 8; ++i) {
+    auto response = pending[i].get();
+    ASSERT_STATUS_OK(response);
+    EXPECT_EQ(200, response->status_code);
+    nl::json parsed = nl::json::parse(response->payload);
+    EXPECT_EQ(std::to_string(i), parsed["args"]["foo"].get<std::string>());
+  }
+  loop->Shutdown();
+}
+
 TEST(CurlRequestTest, RepeatedGET) {
   storage::internal::CurlRequestBuilder request(
       HttpBinEndpoint() + "/get",
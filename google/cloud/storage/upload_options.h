@@ -17,6 +17,7 @@
 
 #include "google/cloud/storage/internal/complex_option.h"
 #include "google/cloud/storage/version.h"
+#include <cstddef>
 #include <string>
 
 namespace google {
@@ -54,6 +55,52 @@ inline UseResumableUploadSession NewResumableUploadSession() {
   return UseResumableUploadSession("");
 }
 
+/**
+ * Upload data in the background while the application writes more data.
+ *
+ * By default `Client::WriteObject()` uploads each chunk as soon as the
+ * internal buffer is full, and the application must wait for the upload to
+ * complete before it can write more data. With this option the chunks are
+ * uploaded by a separate thread, and the application can fill up to the given
+ * number of chunks while the upload is in progress. Each chunk is still
+ * uploaded (and retried if needed) in order.
+ *
+ * Errors are reported once they are detected, typically one or more chunks
+ * after the chunk that failed. A value of `0` disables this feature.
+ */
+struct UploadPipelineDepth
+    : public internal::ComplexOption<UploadPipelineDepth, std::size_t> {
+  using ComplexOption<UploadPipelineDepth, std::size_t>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  UploadPipelineDepth() = default;
+  static char const* name() { return "upload-pipeline-depth"; }
+};
+
+/**
+ * Read the file uploaded by `Client::UploadFile()` via a memory mapping.
+ *
+ * With this option `Client::UploadFile()` maps the file into memory and
+ * uploads each chunk directly from the mapping, instead of copying the data to
+ * an intermediate buffer. This reduces memory bandwidth and allocations for
+ * large files. The option has no effect on small files uploaded in a single
+ * request.
+ *
+ * The file must not be truncated while the upload is in progress. On POSIX
+ * systems accessing the truncated pages terminates the application with a
+ * `SIGBUS` signal. If the file cannot be mapped (e.g. it is not a regular
+ * file, or memory mapping is not supported on the platform) the file is read
+ * as a stream, as if the option was not set.
+ */
+struct UseMemoryMappedFile
+    : public internal::ComplexOption<UseMemoryMappedFile, bool> {
+  using ComplexOption<UseMemoryMappedFile, bool>::ComplexOption;
+  // GCC <= 7.0 does not use the inherited default constructor, redeclare it
+  // explicitly
+  UseMemoryMappedFile() = default;
+  static char const* name() { return "use-memory-mapped-file"; }
+};
+
 }  // namespace STORAGE_CLIENT_NS
 }  // namespace storage
 }  // namespace cloud
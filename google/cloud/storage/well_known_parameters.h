@@ -448,6 +448,37 @@ struct Delimiter : public internal::WellKnownParameter<Delimiter, std::string> {
   static char const* well_known_parameter_name() { return "delimiter"; }
 };
 
+/**
+ * Restrict list operations to objects whose names are greater than or equal to
+ * this value.
+ *
+ * Used in `Client::ListObjects` to list a portion of the bucket, for example,
+ * to list different portions of a large bucket in parallel.
+ *
+ * @see https://cloud.google.com/storage/docs/json_api/v1/objects/list for more
+ *   information.
+ */
+struct StartOffset
+    : public internal::WellKnownParameter<StartOffset, std::string> {
+  using WellKnownParameter<StartOffset, std::string>::WellKnownParameter;
+  static char const* well_known_parameter_name() { return "startOffset"; }
+};
+
+/**
+ * Restrict list operations to objects whose names are lexicographically before
+ * this value.
+ *
+ * Used in `Client::ListObjects` to list a portion of the bucket, for example,
+ * to list different portions of a large bucket in parallel.
+ *
+ * @see https://cloud.google.com/storage/docs/json_api/v1/objects/list for more
+ *   information.
+ */
+struct EndOffset : public internal::WellKnownParameter<EndOffset, std::string> {
+  using WellKnownParameter<EndOffset, std::string>::WellKnownParameter;
+  static char const* well_known_parameter_name() { return "endOffset"; }
+};
+
 /**
  * Controls what metadata fields are included in the response.
  *